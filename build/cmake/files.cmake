@@ -466,6 +466,7 @@ set(BASE_CMN_SRC
     src/common/tarstrm.cpp
     src/common/textbuf.cpp
     src/common/textfile.cpp
+    src/common/threadpool.cpp
     src/common/time.cpp
     src/common/timercmn.cpp
     src/common/timerimpl.cpp
@@ -512,6 +513,7 @@ set(BASE_CMN_HDR
     wx/beforestd.h
     wx/buffer.h
     wx/build.h
+    wx/channel.h
     wx/chartype.h
     wx/checkeddelete.h
     wx/chkconf.h
@@ -585,6 +587,7 @@ set(BASE_CMN_HDR
     wx/mstream.h
     wx/numformatter.h
     wx/object.h
+    wx/parallel.h
     wx/platform.h
     wx/platinfo.h
     wx/process.h
@@ -617,6 +620,7 @@ set(BASE_CMN_HDR
     wx/textfile.h
     wx/thread.h
     wx/thrimpl.cpp
+    wx/threadpool.h
     wx/time.h
     wx/timer.h
     wx/tls.h
@@ -1045,6 +1049,7 @@ set(GUI_CMN_HDR
     wx/textctrl.h
     wx/textdlg.h
     wx/textentry.h
+    wx/textextentcache.h
     wx/textwrapper.h
     wx/toolbar.h
     wx/validate.h
@@ -578,6 +578,7 @@ else()
     check_include_file(sys/epoll.h wxUSE_EPOLL_DISPATCHER)
 endif()
 check_include_file(sys/select.h HAVE_SYS_SELECT_H)
+check_include_file(sys/eventfd.h HAVE_SYS_EVENTFD_H)
 
 if(wxUSE_FSWATCHER)
     check_include_file(sys/inotify.h wxHAS_INOTIFY)
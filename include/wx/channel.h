@@ -0,0 +1,687 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/channel.h
+// Purpose:     Bounded lock-free channels for inter-thread communication
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_CHANNEL_H_
+#define _WX_CHANNEL_H_
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "wx/thread.h"
+
+#if wxUSE_THREADS
+
+#include "wx/msgqueue.h"        // for wxMessageQueueError
+#include "wx/stopwatch.h"
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#if defined(__VISUALC__) && (defined(_M_IX86) || defined(_M_X64))
+    #include <intrin.h>
+#endif
+
+namespace wxPrivate
+{
+
+// Size used for padding the data accessed by different threads to avoid false
+// sharing between them.
+const size_t CHANNEL_CACHE_LINE_SIZE = 64;
+
+// Tell the CPU that we're busy waiting.
+inline void ChannelCpuRelax()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif defined(__VISUALC__) && (defined(_M_IX86) || defined(_M_X64))
+    _mm_pause();
+#endif
+}
+
+// Return the smallest power of 2 greater than or equal to the given value.
+inline size_t ChannelRoundCapacity(size_t capacity)
+{
+    // Larger values can't be rounded up to a power of 2 representable as
+    // size_t and the loop below would never terminate for them.
+    wxASSERT_MSG( capacity <= static_cast<size_t>(-1) / 2 + 1,
+                  "channel capacity too big" );
+
+    size_t n = 2;
+    while ( n < capacity )
+        n *= 2;
+
+    return n;
+}
+
+// ----------------------------------------------------------------------------
+// ChannelWaiter: spin-then-park waiting strategy used by the channels
+// ----------------------------------------------------------------------------
+
+// This class allows the threads to wait until some condition, which is
+// checked by calling a function, becomes true.
+//
+// The waiting threads first spin for some time, as the channels are typically
+// used for exchanging many messages quickly and going to sleep and waking up
+// would be much more expensive than spinning in this case, and only block on
+// a condition if spinning didn't help. The duration of spinning is adjusted
+// depending on whether it was successful the last time.
+//
+// Notify() must be called after changing the state checked by the condition
+// function and is very cheap if there are no blocked threads.
+class ChannelWaiter
+{
+public:
+    ChannelWaiter()
+        : m_cond(m_mutex),
+          m_sleeping(0),
+          m_generation(0),
+          m_spinLimit(wxThread::GetCPUCount() > 1 ? SPIN_INITIAL : 0)
+    {
+    }
+
+    // Wait until pred() returns true or the timeout (in milliseconds, or -1
+    // for waiting indefinitely) expires.
+    //
+    // Returns wxMSGQUEUE_NO_ERROR if pred() returned true.
+    template <typename P>
+    wxMessageQueueError Wait(P& pred, long timeout = -1)
+    {
+        if ( pred() )
+            return wxMSGQUEUE_NO_ERROR;
+
+        if ( !timeout )
+            return wxMSGQUEUE_TIMEOUT;
+
+        const int spinLimit = m_spinLimit.load(std::memory_order_relaxed);
+        for ( int n = 0; n < spinLimit; n++ )
+        {
+            ChannelCpuRelax();
+
+            if ( pred() )
+            {
+                // Spinning was useful, so spin longer the next time.
+                if ( spinLimit < SPIN_MAX )
+                    m_spinLimit.store(2*spinLimit, std::memory_order_relaxed);
+
+                return wxMSGQUEUE_NO_ERROR;
+            }
+        }
+
+        // Spinning didn't help, so don't waste as much time on it next time.
+        if ( spinLimit > SPIN_MIN )
+            m_spinLimit.store(spinLimit / 2, std::memory_order_relaxed);
+
+        return Park(pred, timeout);
+    }
+
+    // Wake up the threads blocked in Wait(), if any.
+    void Notify()
+    {
+        // This fence pairs with the one in Park() and ensures that either we
+        // see the sleeping thread here or it sees the state change done
+        // before calling us when it checks the condition.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        if ( m_sleeping.load(std::memory_order_relaxed) )
+        {
+            wxMutexLocker lock(m_mutex);
+
+            // Reset the counter to avoid waking up the same threads again if
+            // we're called more times before they get to run: they will
+            // increment it again if they need to go back to sleep.
+            m_sleeping = 0;
+            m_generation++;
+
+            m_cond.Broadcast();
+        }
+    }
+
+    bool IsOk() const { return m_cond.IsOk(); }
+
+private:
+    enum
+    {
+        SPIN_MIN = 16,
+        SPIN_INITIAL = 256,
+        SPIN_MAX = 8192
+    };
+
+    template <typename P>
+    wxMessageQueueError Park(P& pred, long timeout)
+    {
+        wxMutexLocker lock(m_mutex);
+
+        wxCHECK( lock.IsOk(), wxMSGQUEUE_MISC_ERROR );
+
+        wxMessageQueueError rc = wxMSGQUEUE_NO_ERROR;
+
+        const wxMilliClock_t waitUntil = wxGetLocalTimeMillis() + timeout;
+
+        // Notify() increments the generation when it resets m_sleeping, so if
+        // it didn't change, we're still counted there.
+        bool registered = false;
+        size_t generation = 0;
+        for ( ;; )
+        {
+            if ( registered && m_generation != generation )
+                registered = false;
+
+            if ( !registered )
+            {
+                registered = true;
+                generation = m_generation;
+
+                m_sleeping++;
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+            }
+
+            if ( pred() )
+                break;
+
+            if ( timeout < 0 )
+            {
+                if ( m_cond.Wait() != wxCOND_NO_ERROR )
+                {
+                    rc = wxMSGQUEUE_MISC_ERROR;
+                    break;
+                }
+
+                continue;
+            }
+
+            const wxCondError result = m_cond.WaitTimeout(timeout);
+            if ( result == wxCOND_NO_ERROR )
+                continue;
+
+            if ( result != wxCOND_TIMEOUT )
+            {
+                rc = wxMSGQUEUE_MISC_ERROR;
+                break;
+            }
+
+            const wxMilliClock_t now = wxGetLocalTimeMillis();
+            if ( now >= waitUntil )
+            {
+                rc = pred() ? wxMSGQUEUE_NO_ERROR : wxMSGQUEUE_TIMEOUT;
+                break;
+            }
+
+            timeout = (waitUntil - now).ToLong();
+        }
+
+        if ( m_generation == generation )
+            m_sleeping--;
+
+        return rc;
+    }
+
+    wxMutex m_mutex;
+    wxCondition m_cond;
+
+    // The number of threads blocked in (or about to block in) m_cond which
+    // haven't been woken up by Notify() yet.
+    std::atomic<int> m_sleeping;
+
+    // Incremented by Notify() every time it wakes up the threads, protected
+    // by m_mutex.
+    size_t m_generation;
+
+    // The current number of iterations to spin for before blocking.
+    std::atomic<int> m_spinLimit;
+
+    wxDECLARE_NO_COPY_CLASS(ChannelWaiter);
+};
+
+// ----------------------------------------------------------------------------
+// ChannelBase: implements the public API of the channels
+// ----------------------------------------------------------------------------
+
+// The derived class must implement DoTryPush() and DoTryPop() functions, which
+// must only modify their argument if they succeed, and this class implements
+// all the blocking and batch operations in terms of them.
+template <typename Derived, typename T>
+class ChannelBase
+{
+public:
+    // The type of the messages transported by this channel
+    typedef T Message;
+
+    // Push the message if there is space for it in the channel and return
+    // true or return false immediately if the channel is full.
+    bool TryPush(const T& msg) { return DoPush(msg); }
+    bool TryPush(T&& msg) { return DoPush(std::move(msg)); }
+
+    // Pop the message if there is one and return true or return false
+    // immediately if the channel is empty.
+    bool TryPop(T& msg)
+    {
+        if ( !Self().DoTryPop(msg) )
+            return false;
+
+        m_notFull.Notify();
+
+        return true;
+    }
+
+    // Push the message, waiting until there is space for it if necessary.
+    wxMessageQueueError Push(const T& msg) { return PushTimeout(-1, msg); }
+    wxMessageQueueError Push(T&& msg) { return PushTimeout(-1, std::move(msg)); }
+
+    // Wait no more than timeout milliseconds until there is space for the
+    // message. Timeout of -1 means waiting indefinitely and 0 is the same as
+    // calling TryPush().
+    wxMessageQueueError PushTimeout(long timeout, const T& msg)
+    {
+        return DoPushWait(timeout, msg);
+    }
+
+    wxMessageQueueError PushTimeout(long timeout, T&& msg)
+    {
+        return DoPushWait(timeout, std::move(msg));
+    }
+
+    // Wait until a message becomes available and pop it.
+    wxMessageQueueError Pop(T& msg) { return PopTimeout(-1, msg); }
+
+    // Wait no more than timeout milliseconds until a message becomes
+    // available. Timeout values have the same meaning as for PushTimeout().
+    wxMessageQueueError PopTimeout(long timeout, T& msg)
+    {
+        auto pred = [this, &msg]() { return Self().DoTryPop(msg); };
+
+        const wxMessageQueueError rc = m_notEmpty.Wait(pred, timeout);
+        if ( rc == wxMSGQUEUE_NO_ERROR )
+            m_notFull.Notify();
+
+        return rc;
+    }
+
+    // Push as many of the given messages as fit into the channel without
+    // waiting and return their number.
+    //
+    // The consumers are notified only once for the entire batch.
+    size_t TryPushBatch(const T* msgs, size_t count)
+    {
+        size_t n = 0;
+        while ( n < count && Self().DoTryPush(msgs[n]) )
+            n++;
+
+        if ( n )
+            m_notEmpty.Notify();
+
+        return n;
+    }
+
+    // Push all the given messages, waiting for space for them if necessary.
+    wxMessageQueueError PushBatch(const T* msgs, size_t count)
+    {
+        for ( ;; )
+        {
+            const size_t n = TryPushBatch(msgs, count);
+
+            msgs += n;
+            count -= n;
+            if ( !count )
+                return wxMSGQUEUE_NO_ERROR;
+
+            auto pred = [this, msgs]() { return Self().DoTryPush(*msgs); };
+
+            const wxMessageQueueError rc = m_notFull.Wait(pred);
+            if ( rc != wxMSGQUEUE_NO_ERROR )
+                return rc;
+
+            m_notEmpty.Notify();
+
+            msgs++;
+            if ( !--count )
+                return wxMSGQUEUE_NO_ERROR;
+        }
+    }
+
+    // Pop up to maxCount messages without waiting and return their number.
+    size_t TryPopBatch(T* msgs, size_t maxCount)
+    {
+        size_t n = 0;
+        while ( n < maxCount && Self().DoTryPop(msgs[n]) )
+            n++;
+
+        if ( n )
+            m_notFull.Notify();
+
+        return n;
+    }
+
+    // Wait until at least one message is available and pop up to maxCount of
+    // them. Returns the number of messages popped, which is 0 only in case of
+    // an error.
+    size_t PopBatch(T* msgs, size_t maxCount)
+    {
+        if ( !maxCount || Pop(msgs[0]) != wxMSGQUEUE_NO_ERROR )
+            return 0;
+
+        return 1 + TryPopBatch(msgs + 1, maxCount - 1);
+    }
+
+    // Return false only if there was a fatal error in ctor
+    bool IsOk() const
+    {
+        return m_notEmpty.IsOk() && m_notFull.IsOk();
+    }
+
+protected:
+    ChannelBase() = default;
+
+private:
+    Derived& Self() { return static_cast<Derived&>(*this); }
+
+    template <typename U>
+    bool DoPush(U&& msg)
+    {
+        if ( !Self().DoTryPush(std::forward<U>(msg)) )
+            return false;
+
+        m_notEmpty.Notify();
+
+        return true;
+    }
+
+    template <typename U>
+    wxMessageQueueError DoPushWait(long timeout, U&& msg)
+    {
+        // Notice that DoTryPush() only moves from msg if it succeeds, so it's
+        // fine to call it repeatedly here.
+        auto pred = [this, &msg]()
+        {
+            return Self().DoTryPush(std::forward<U>(msg));
+        };
+
+        const wxMessageQueueError rc = m_notFull.Wait(pred, timeout);
+        if ( rc == wxMSGQUEUE_NO_ERROR )
+            m_notEmpty.Notify();
+
+        return rc;
+    }
+
+    ChannelWaiter m_notEmpty,
+                  m_notFull;
+
+    wxDECLARE_NO_COPY_TEMPLATE_CLASS_2(ChannelBase, Derived, T);
+};
+
+} // namespace wxPrivate
+
+// ---------------------------------------------------------------------------
+// wxSPSCChannel: bounded single producer, single consumer channel
+// ---------------------------------------------------------------------------
+
+// This is the most efficient channel, but it can only be used if there is
+// only one thread pushing the messages into it and only one thread popping
+// them from it (which may be the same or different threads).
+//
+// The capacity is rounded up to the next power of 2.
+template <typename T>
+class wxSPSCChannel : public wxPrivate::ChannelBase<wxSPSCChannel<T>, T>
+{
+public:
+    explicit wxSPSCChannel(size_t capacity)
+        : m_capacity(wxPrivate::ChannelRoundCapacity(capacity)),
+          m_slots(new Slot[m_capacity]),
+          m_head(0),
+          m_tailCached(0),
+          m_tail(0),
+          m_headCached(0)
+    {
+    }
+
+    ~wxSPSCChannel()
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        for ( size_t n = m_head.load(std::memory_order_relaxed); n != tail; n++ )
+            GetSlot(n)->~T();
+
+        delete [] m_slots;
+    }
+
+    size_t GetCapacity() const { return m_capacity; }
+
+    // Return the number of messages in the channel. This is only approximate
+    // if the channel is used by other threads concurrently.
+    size_t GetSize() const
+    {
+        // Notice that the head may be read after the consumer advanced it
+        // past the previously read tail, so don't return a negative value.
+        const size_t end = m_tail.load(std::memory_order_acquire),
+                     start = m_head.load(std::memory_order_acquire);
+
+        return end > start ? end - start : 0;
+    }
+
+    bool IsEmpty() const { return GetSize() == 0; }
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char data[sizeof(T)];
+    };
+
+    T* GetSlot(size_t n) const
+    {
+        return reinterpret_cast<T*>(m_slots[n & (m_capacity - 1)].data);
+    }
+
+    template <typename U>
+    bool DoTryPush(U&& msg)
+    {
+        const size_t tail = m_tail.load(std::memory_order_relaxed);
+        if ( tail - m_headCached == m_capacity )
+        {
+            m_headCached = m_head.load(std::memory_order_acquire);
+            if ( tail - m_headCached == m_capacity )
+                return false;
+        }
+
+        new(GetSlot(tail)) T(std::forward<U>(msg));
+
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool DoTryPop(T& msg)
+    {
+        const size_t head = m_head.load(std::memory_order_relaxed);
+        if ( head == m_tailCached )
+        {
+            m_tailCached = m_tail.load(std::memory_order_acquire);
+            if ( head == m_tailCached )
+                return false;
+        }
+
+        T* const p = GetSlot(head);
+        msg = std::move(*p);
+        p->~T();
+
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    const size_t m_capacity;
+    Slot* const m_slots;
+
+    // The fields used by the consumer: the index of the next message to pop
+    // and the last seen value of m_tail, to avoid reading it (and hence
+    // accessing the cache line modified by the producer) every time.
+    char m_padConsumer[wxPrivate::CHANNEL_CACHE_LINE_SIZE];
+    std::atomic<size_t> m_head;
+    size_t m_tailCached;
+
+    // And the same fields for the producer.
+    char m_padProducer[wxPrivate::CHANNEL_CACHE_LINE_SIZE];
+    std::atomic<size_t> m_tail;
+    size_t m_headCached;
+
+    char m_padEnd[wxPrivate::CHANNEL_CACHE_LINE_SIZE];
+
+    friend class wxPrivate::ChannelBase<wxSPSCChannel<T>, T>;
+};
+
+// ---------------------------------------------------------------------------
+// wxMPMCChannel: bounded multiple producers, multiple consumers channel
+// ---------------------------------------------------------------------------
+
+// This channel can be used by any number of threads concurrently.
+//
+// It is implemented as an array of cells with sequence numbers indicating
+// whether each cell is full or empty, allowing the producers and the consumers
+// to claim the cells using a single CAS operation.
+//
+// The capacity is rounded up to the next power of 2.
+template <typename T>
+class wxMPMCChannel : public wxPrivate::ChannelBase<wxMPMCChannel<T>, T>
+{
+public:
+    explicit wxMPMCChannel(size_t capacity)
+        : m_capacity(wxPrivate::ChannelRoundCapacity(capacity)),
+          m_cells(new Cell[m_capacity]),
+          m_enqueuePos(0),
+          m_dequeuePos(0)
+    {
+        for ( size_t n = 0; n < m_capacity; n++ )
+            m_cells[n].seq.store(n, std::memory_order_relaxed);
+    }
+
+    ~wxMPMCChannel()
+    {
+        const size_t end = m_enqueuePos.load(std::memory_order_relaxed);
+        for ( size_t n = m_dequeuePos.load(std::memory_order_relaxed); n != end; n++ )
+            m_cells[n & (m_capacity - 1)].GetData()->~T();
+
+        delete [] m_cells;
+    }
+
+    size_t GetCapacity() const { return m_capacity; }
+
+    // Return the number of messages in the channel. This is only approximate
+    // if the channel is used by other threads concurrently.
+    size_t GetSize() const
+    {
+        const size_t end = m_enqueuePos.load(std::memory_order_acquire),
+                     start = m_dequeuePos.load(std::memory_order_acquire);
+
+        return end > start ? end - start : 0;
+    }
+
+    bool IsEmpty() const { return GetSize() == 0; }
+
+private:
+    struct Cell
+    {
+        T* GetData() { return reinterpret_cast<T*>(data); }
+
+        // The cell is empty and can be written to if seq is equal to the
+        // position of the producer and is full and can be read from if it is
+        // equal to the position of the consumer plus 1.
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char data[sizeof(T)];
+    };
+
+    template <typename U>
+    bool DoTryPush(U&& msg)
+    {
+        Cell* cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+        for ( ;; )
+        {
+            cell = &m_cells[pos & (m_capacity - 1)];
+
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if ( diff == 0 )
+            {
+                if ( m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed) )
+                    break;
+            }
+            else if ( diff < 0 )
+            {
+                // The cell still contains the message from the previous lap.
+                return false;
+            }
+            else
+            {
+                // Another producer has already taken this cell.
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new(cell->GetData()) T(std::forward<U>(msg));
+
+        cell->seq.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    bool DoTryPop(T& msg)
+    {
+        Cell* cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+        for ( ;; )
+        {
+            cell = &m_cells[pos & (m_capacity - 1)];
+
+            const size_t seq = cell->seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if ( diff == 0 )
+            {
+                if ( m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                                        std::memory_order_relaxed) )
+                    break;
+            }
+            else if ( diff < 0 )
+            {
+                // The cell hasn't been filled yet.
+                return false;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* const p = cell->GetData();
+        msg = std::move(*p);
+        p->~T();
+
+        // Make the cell available to the producers during the next lap.
+        cell->seq.store(pos + m_capacity, std::memory_order_release);
+
+        return true;
+    }
+
+    const size_t m_capacity;
+    Cell* const m_cells;
+
+    char m_padEnqueue[wxPrivate::CHANNEL_CACHE_LINE_SIZE];
+    std::atomic<size_t> m_enqueuePos;
+
+    char m_padDequeue[wxPrivate::CHANNEL_CACHE_LINE_SIZE];
+    std::atomic<size_t> m_dequeuePos;
+
+    char m_padEnd[wxPrivate::CHANNEL_CACHE_LINE_SIZE];
+
+    friend class wxPrivate::ChannelBase<wxMPMCChannel<T>, T>;
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_CHANNEL_H_
@@ -126,6 +126,11 @@ public:
 
     virtual void Resort() = 0;
 
+    // called when the model starts and finishes a batch of changes, the
+    // notifications received in between may be processed lazily
+    virtual void BeginBatch() { }
+    virtual void EndBatch() { }
+
     void SetOwner( wxDataViewModel *owner ) { m_owner = owner; }
     wxDataViewModel *GetOwner() const       { return m_owner; }
 
@@ -264,6 +269,12 @@ public:
     // delegated action
     virtual void Resort();
 
+    // group many notifications together, allowing the controls to update
+    // themselves only once at the end, these calls may be nested
+    void BeginBatch();
+    void EndBatch();
+    bool IsInBatch() const { return m_batchCount > 0; }
+
     void AddNotifier( wxDataViewModelNotifier *notifier );
     void RemoveNotifier( wxDataViewModelNotifier *notifier );
 
@@ -272,6 +283,13 @@ public:
                          unsigned int column, bool ascending ) const;
     virtual bool HasDefaultCompare() const { return false; }
 
+    // return true if Compare() can be called concurrently from several threads
+    virtual bool IsCompareThreadSafe() const { return false; }
+
+    // return true if Compare() is not overridden and so sorts the items by
+    // their values and then by their IDs
+    virtual bool UsesDefaultCompare() const { return false; }
+
     // internal
     virtual bool IsListModel() const { return false; }
     virtual bool IsVirtualListModel() const { return false; }
@@ -304,6 +322,9 @@ protected:
 
 private:
     wxDataViewModelNotifiers  m_notifiers;
+
+    // the nesting level of BeginBatch() calls
+    int                       m_batchCount;
 };
 
 // ----------------------------------------------------------------------------
@@ -87,12 +87,22 @@ enum wxGridRenderStyle
                           wxGRID_DRAW_BOX_RECT
 };
 
+// Modes used by wxGrid::SetAutoSizeMode() to select the cells measured when
+// auto-sizing the rows or columns.
+enum wxGridAutoSizeMode
+{
+    wxGRID_AUTOSIZE_ALL,        // measure all cells (default)
+    wxGRID_AUTOSIZE_VISIBLE,    // measure only the currently visible cells
+    wxGRID_AUTOSIZE_SAMPLE      // measure a uniform sample of the cells
+};
+
 // ----------------------------------------------------------------------------
 // forward declarations
 // ----------------------------------------------------------------------------
 
 class WXDLLIMPEXP_FWD_CORE wxGrid;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttr;
+class WXDLLIMPEXP_FWD_CORE wxGridBlockCoords;
 class WXDLLIMPEXP_FWD_CORE wxGridCellAttrProviderData;
 class WXDLLIMPEXP_FWD_CORE wxGridColLabelWindow;
 class WXDLLIMPEXP_FWD_CORE wxGridCornerLabelWindow;
@@ -120,6 +130,7 @@ class wxGridOperations;
 class wxGridRowOperations;
 class wxGridColumnOperations;
 class wxGridDirectionOperations;
+class wxGridTextExtentCache;
 
 #if wxUSE_ACCESSIBILITY
 class WXDLLIMPEXP_FWD_CORE wxGridAccessible;
@@ -981,6 +992,8 @@ public:
     // all these functions take ownership of the pointer, don't call DecRef()
     // on it
     virtual void SetAttr(wxGridCellAttr *attr, int row, int col);
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
@@ -1375,6 +1388,8 @@ public:
 
     // these functions take ownership of the pointer
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
     virtual void SetColAttr(wxGridCellAttr *attr, int col);
 
@@ -1504,6 +1519,113 @@ private:
     wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridStringTable);
 };
 
+// ----------------------------------------------------------------------------
+// wxGridColumnarTable: table storing typed values column by column
+// ----------------------------------------------------------------------------
+
+// Types of the columns of wxGridColumnarTable.
+enum wxGridColumnType
+{
+    wxGRID_COLUMN_STRING,   // dictionary-encoded strings
+    wxGRID_COLUMN_INT,      // 64-bit integers
+    wxGRID_COLUMN_DOUBLE,   // floating point numbers
+    wxGRID_COLUMN_BOOL      // boolean values
+};
+
+class WXDLLIMPEXP_CORE wxGridColumnarTable : public wxGridTableBase
+{
+public:
+    wxGridColumnarTable();
+    explicit wxGridColumnarTable( int numRows );
+    virtual ~wxGridColumnarTable();
+
+    // Add a column of the given type, the columns added by the base class
+    // InsertCols() and AppendCols() always contain strings.
+    void AppendColumn( wxGridColumnType type,
+                       const wxString& label = wxString() );
+    bool InsertColumn( size_t pos,
+                       wxGridColumnType type,
+                       const wxString& label = wxString() );
+
+    wxGridColumnType GetColumnType( int col ) const;
+
+    // Preallocate memory for the given number of rows.
+    void ReserveRows( size_t numRows );
+
+    // Make the given cell empty.
+    void ClearCell( int row, int col );
+
+    // Direct access to the values of wxGRID_COLUMN_INT columns, which can't
+    // be represented as long on all platforms.
+    wxLongLong_t GetValueAsInt64( int row, int col );
+    void SetValueAsInt64( int row, int col, wxLongLong_t value );
+
+    // these are pure virtual in wxGridTableBase
+    //
+    virtual int GetNumberRows() override { return static_cast<int>(m_numRows); }
+    virtual int GetNumberCols() override { return wxSsize(m_columns); }
+    virtual wxString GetValue( int row, int col ) override;
+    virtual void SetValue( int row, int col, const wxString& s ) override;
+
+    // overridden functions from wxGridTableBase
+    //
+    virtual bool IsEmptyCell( int row, int col ) override;
+
+    virtual wxString GetTypeName( int row, int col ) override;
+    virtual bool CanGetValueAs( int row, int col, const wxString& typeName ) override;
+    virtual bool CanSetValueAs( int row, int col, const wxString& typeName ) override;
+
+    virtual long GetValueAsLong( int row, int col ) override;
+    virtual double GetValueAsDouble( int row, int col ) override;
+    virtual bool GetValueAsBool( int row, int col ) override;
+
+    virtual void SetValueAsLong( int row, int col, long value ) override;
+    virtual void SetValueAsDouble( int row, int col, double value ) override;
+    virtual void SetValueAsBool( int row, int col, bool value ) override;
+
+    void Clear() override;
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 ) override;
+    bool AppendRows( size_t numRows = 1 ) override;
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 ) override;
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 ) override;
+    bool AppendCols( size_t numCols = 1 ) override;
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 ) override;
+
+    void SetRowLabelValue( int row, const wxString& ) override;
+    void SetColLabelValue( int col, const wxString& ) override;
+    void SetCornerLabelValue( const wxString& ) override;
+    wxString GetRowLabelValue( int row ) override;
+    wxString GetColLabelValue( int col ) override;
+    wxString GetCornerLabelValue() const override;
+
+private:
+    class Column;
+    template <typename T> class ChunkedColumn;
+    template <typename T> class ValueColumn;
+    class StringColumn;
+
+    // Return the column containing the given cell or null if the cell
+    // coordinates are invalid.
+    Column* GetColumnForCell( int row, int col ) const;
+
+    // Helper of InsertColumn() and InsertCols() which doesn't notify the view.
+    void DoInsertColumns( size_t pos, size_t numCols, wxGridColumnType type );
+
+    // All columns are stored independently of each other, so inserting or
+    // deleting them doesn't need to touch the data of the other columns.
+    std::vector<std::unique_ptr<Column>> m_columns;
+
+    size_t m_numRows;
+
+    // Row labels, only used if they were explicitly set, just as in
+    // wxGridStringTable, while the column labels are stored in the columns.
+    wxArrayString m_rowLabels;
+
+    wxString m_cornerLabel;
+
+    wxDECLARE_DYNAMIC_CLASS_NO_COPY(wxGridColumnarTable);
+};
+
 
 
 // ============================================================================
@@ -1542,6 +1664,69 @@ struct WXDLLIMPEXP_CORE wxGridSizesInfo
     wxUnsignedToIntHashMap m_customSizes;
 };
 
+// ----------------------------------------------------------------------------
+// wxGridLineEnds stores the sizes of the rows or columns in display order.
+//
+// The sizes are stored in a Fenwick tree (binary indexed tree), allowing to
+// find the end coordinate of any line, to change the size of a line and to
+// find the line at the given coordinate in O(log n) time.
+//
+// This class is an implementation detail of wxGrid and is not part of the
+// public API.
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_CORE wxGridLineEnds
+{
+public:
+    wxGridLineEnds() = default;
+
+    bool empty() const { return m_tree.empty(); }
+    size_t size() const { return m_tree.size(); }
+    void clear() { m_tree.clear(); }
+
+    // Initialize all lines to have the same size.
+    void Assign(size_t count, int size);
+
+    // Initialize the lines using the given sizes, indexed by line index and
+    // negative for the hidden lines, and the indices of the lines at each
+    // position, which may be empty if the lines are not reordered.
+    void Assign(const wxArrayInt& sizes, const wxArrayInt& lineAt);
+
+    // Return the sum of sizes of the given number of the first lines.
+    int GetSum(size_t count) const;
+
+    // Return the start or the end of the line at the given position.
+    int GetStart(size_t pos) const { return GetSum(pos); }
+    int GetEnd(size_t pos) const { return GetSum(pos + 1); }
+
+    // Return the sum of the sizes of all lines.
+    int GetTotal() const { return GetSum(m_tree.size()); }
+
+    // Change the size of the line at the given position by the given amount.
+    void Add(size_t pos, int diff);
+
+    // Return the position of the line containing the given coordinate, i.e.
+    // the first line ending after it, or size() if there is none.
+    size_t FindLine(int coord) const;
+
+    // Insert the given number of lines of the given size at the given
+    // position. This is done in O(log n) per line when appending, but takes
+    // linear time when inserting lines before the end.
+    void Insert(size_t pos, size_t count, int size);
+
+    // Remove the lines at the given position in linear time.
+    void Remove(size_t pos, size_t count);
+
+private:
+    // Convert m_tree containing the sizes of the lines to the tree and back.
+    void MakeTree();
+    void MakeSizes();
+
+    // The tree element with 1-based index i contains the sum of the sizes of
+    // the lines in the (i - LowestBit(i), i] range.
+    std::vector<int> m_tree;
+};
+
 // ----------------------------------------------------------------------------
 // wxGrid
 // ----------------------------------------------------------------------------
@@ -1768,6 +1953,17 @@ public:
     // Refresh one or more areas (a combination of wxGridArea enums) entirely.
     void RefreshArea(int areas);
 
+    // Mark the given cells as needing to be repainted: unlike RefreshBlock(),
+    // this doesn't refresh them immediately but remembers them and refreshes
+    // all the cells passed to this function at once a bit later, which is
+    // much more efficient when many scattered cells change frequently.
+    void RefreshCells(const wxGridCellCoordsVector& cells);
+
+    // Enable or disable keeping the rendered cells in a bitmap and reusing it
+    // for repainting the cells which didn't change, e.g. when scrolling.
+    void EnableRenderCache(bool enable = true);
+    bool IsRenderCacheEnabled() const { return m_useRenderCache; }
+
 
     // ------
     // Code that does a lot of grid modification can be enclosed
@@ -2084,8 +2280,10 @@ public:
     // attributes
     // ----------
 
-    // this sets the specified attribute for this cell or in this row/col
+    // this sets the specified attribute for this cell, block of cells or in
+    // this row/col
     void     SetAttr(int row, int col, wxGridCellAttr *attr);
+    void     SetBlockAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr);
     void     SetRowAttr(int row, wxGridCellAttr *attr);
     void     SetColAttr(int col, wxGridCellAttr *attr);
 
@@ -2267,6 +2465,24 @@ public:
     // autosize column width depending on label text
     void     AutoSizeColLabelSize( int col );
 
+    // select the cells measured by the auto-sizing functions above: by
+    // default all of them are, which may be slow for big grids
+    void SetAutoSizeMode(wxGridAutoSizeMode mode, int sampleSize = 1000);
+    wxGridAutoSizeMode GetAutoSizeMode() const { return m_autoSizeMode; }
+    int GetAutoSizeSampleSize() const { return m_autoSizeSampleSize; }
+
+    // use the given percentile of the cell extents instead of their maximum
+    // (corresponding to 100, which is the default) when auto-sizing
+    void SetAutoSizePercentile(int percentile);
+    int GetAutoSizePercentile() const { return m_autoSizePercentile; }
+
+    // return the extent of the (possibly multiline) text using the given font,
+    // this is used by the renderers to measure the cells contents and caches
+    // the extents of the same strings while auto-sizing is in progress
+    wxSize GetCellTextExtent(wxReadOnlyDC& dc,
+                             const wxFont& font,
+                             const wxString& text) const;
+
     // column won't be resized to be lesser width - this must be called during
     // the grid creation because it won't resize the column if it's already
     // narrower than the minimal width
@@ -2599,16 +2815,22 @@ protected:
 
     int        m_defaultRowHeight;
     int        m_minAcceptableRowHeight;
+
+    // row heights indexed by row index, negative for the hidden rows
     wxArrayInt m_rowHeights;
-    wxArrayInt m_rowBottoms;
+
+    // visible row heights indexed by row position, used to find the bottoms
+    wxGridLineEnds m_rowBottoms;
 
     // init the m_colWidths/Rights arrays
     void InitColWidths();
 
     int        m_defaultColWidth;
     int        m_minAcceptableColWidth;
+
+    // same as m_rowHeights and m_rowBottoms but for the columns
     wxArrayInt m_colWidths;
-    wxArrayInt m_colRights;
+    wxGridLineEnds m_colRights;
 
     int m_sortCol;
     bool m_sortIsAscending;
@@ -2667,6 +2889,14 @@ protected:
     // common part of AutoSizeColumn/Row()
     void AutoSizeColOrRow(int n, bool setAsMin, wxGridDirection direction);
 
+    // parameters set by SetAutoSizeMode() and SetAutoSizePercentile()
+    wxGridAutoSizeMode m_autoSizeMode;
+    int m_autoSizeSampleSize;
+    int m_autoSizePercentile;
+
+    // the cache used by GetCellTextExtent(), only non-null while auto-sizing
+    wxGridTextExtentCache *m_autoSizeExtents;
+
     // Calculate the minimum acceptable size for labels area
     wxCoord CalcColOrRowLabelAreaMinSize(wxGridDirection direction);
 
@@ -2690,6 +2920,17 @@ protected:
         wxGridCellAttr *attr;
     } m_attrCache;
 
+    // cache of the attributes of the cells being repainted, which are needed
+    // several times during painting: m_paintAttrs contains the attributes of
+    // all cells of m_paintAttrsBlock, row by row, or null pointers for the
+    // cells whose attributes were not retrieved yet
+    wxGridBlockCoords m_paintAttrsBlock;
+    mutable std::vector<wxGridCellAttr*> m_paintAttrs;
+
+    // start or stop using the cache above for the given cells
+    void StartCachingAttrs(const wxGridCellCoordsVector& cells);
+    void StopCachingAttrs();
+
     // invalidates the attribute cache
     void ClearAttrCache();
 
@@ -2983,6 +3224,20 @@ private:
         return !GetBatchCount() && IsShownOnScreen();
     }
 
+    // refresh all the cells accumulated by RefreshCells()
+    void RefreshDirtyCells();
+
+    // return true if the contents of the given cell may overflow into the
+    // neighbouring cells, meaning that the entire row needs to be refreshed
+    // when it changes
+    bool CellMayOverflow(int row, int col) const;
+
+    // the cells passed to RefreshCells() and not refreshed yet
+    wxGridCellCoordsVector m_dirtyCells;
+
+    // true if EnableRenderCache() was called
+    bool m_useRenderCache;
+
 
     // return the position (not index) of the row or column at the given logical
     // pixel position
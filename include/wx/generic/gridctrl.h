@@ -54,6 +54,12 @@ protected:
     wxSize DoGetBestSize(const wxGridCellAttr& attr,
                          wxReadOnlyDC& dc,
                          const wxString& text);
+
+    // same as above, but reuses the extents cached by the grid if possible
+    wxSize DoGetBestSize(const wxGrid& grid,
+                         const wxGridCellAttr& attr,
+                         wxReadOnlyDC& dc,
+                         const wxString& text);
 };
 
 // the default renderer for the cells containing numeric (long) data
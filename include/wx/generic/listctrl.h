@@ -165,6 +165,10 @@ public:
 
     virtual void EnableBellOnNoMatch(bool on = true) override;
 
+    virtual void EnableVirtualCache(bool enable = true,
+                                    bool prefetch = false) override;
+    virtual void InvalidateVirtualCache() override;
+
     // overridden base class virtuals
     // ------------------------------
 
@@ -18,7 +18,9 @@
 #include "wx/headerctrl.h"
 
 #ifndef WX_PRECOMP
+    #include "wx/bitmap.h"
     #include "wx/dc.h"
+    #include "wx/region.h"
 #endif // WX_PRECOMP
 
 // for wxGridOperations
@@ -28,6 +30,7 @@
 #include <iterator>
 #include <set>
 #include <map>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // array classes
@@ -423,13 +426,34 @@ public:
 
     virtual void ScrollWindow( int dx, int dy, const wxRect *rect ) override;
 
+    virtual void Refresh( bool eraseBackground = true,
+                          const wxRect *rect = nullptr ) override;
+
     virtual bool AcceptsFocus() const override { return true; }
 
     wxGridWindowType GetType() const { return m_type; }
 
+    // Forget the cached rendering of the given part of the window or all of
+    // it if the rectangle is null.
+    void InvalidateRenderCache(const wxRect *rect = nullptr);
+
+    // Free the render cache, if any.
+    void ResetRenderCache();
+
 private:
     const wxGridWindowType m_type;
 
+    // Draw the given part of the window using the render cache, updating it
+    // if necessary.
+    void PaintUsingRenderCache(wxDC& dc, const wxRegion& region);
+
+    // The rendered contents of the window used if render cache is enabled in
+    // wxGrid, the region of this bitmap which is up to date and the logical
+    // position of the top left corner of the window when it was rendered.
+    wxBitmap m_renderCache;
+    wxRegion m_renderCacheValid;
+    wxPoint m_renderCacheOrigin;
+
     void OnPaint( wxPaintEvent &event );
     void OnMouseWheel( wxMouseEvent& event );
     void OnMouseEvent( wxMouseEvent& event );
@@ -481,12 +505,61 @@ private:
     wxArrayAttrs m_attrs;
 };
 
-// NB: this is just a wrapper around 3 objects: one which stores cell
-//     attributes, and 2 others for row/col ones
+// this class stores attributes set for rectangular blocks of cells
+//
+// each block uses the same amount of memory independently of its size, and the
+// blocks are indexed by rows to avoid checking all of them when looking up the
+// attribute of a cell
+class WXDLLIMPEXP_ADV wxGridBlockAttrData
+{
+public:
+    wxGridBlockAttrData() = default;
+    ~wxGridBlockAttrData();
+
+    void SetAttr(wxGridCellAttr *attr, const wxGridBlockCoords& block);
+    wxGridCellAttr *GetAttr(int row, int col) const;
+    void UpdateAttrRows( size_t pos, int numRows );
+    void UpdateAttrCols( size_t pos, int numCols );
+
+private:
+    struct Entry
+    {
+        wxGridBlockCoords block;
+
+        // May be null if the entry only resets the attributes of the blocks
+        // added before it.
+        wxGridCellAttr *attr;
+    };
+
+    // Common part of UpdateAttrRows() and UpdateAttrCols().
+    void UpdateAttrRowsOrCols(int pos, int numRowsOrCols, bool rows);
+
+    // (Re)build the index below if necessary.
+    void UpdateIndex() const;
+
+    // The blocks in the order in which they were added: the attributes of the
+    // later blocks take precedence over those of the earlier ones.
+    std::vector<Entry> m_entries;
+
+    // Index of m_entries by rows: m_indexRows contains the sorted rows at
+    // which the set of blocks containing the row changes and m_indexEntries
+    // contains, for each of the half-open ranges defined by the consecutive
+    // elements of m_indexRows, the sorted indices of the entries covering it.
+    mutable std::vector<int> m_indexRows;
+    mutable std::vector<std::vector<size_t>> m_indexEntries;
+    mutable bool m_indexValid = true;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridBlockAttrData);
+};
+
+// NB: this is just a wrapper around 4 objects: one which stores cell
+//     attributes, one for the attributes of blocks of cells and 2 others for
+//     row/col ones
 class WXDLLIMPEXP_ADV wxGridCellAttrProviderData
 {
 public:
     wxGridCellAttrData m_cellAttrs;
+    wxGridBlockAttrData m_blockAttrs;
     wxGridRowOrColAttrData m_rowAttrs,
                            m_colAttrs;
 };
@@ -587,8 +660,8 @@ public:
     // Get the height/width of the given row/column
     virtual int GetLineSize(const wxGrid *grid, int line) const = 0;
 
-    // Get wxGrid::m_rowBottoms/m_colRights array
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const = 0;
+    // Get wxGrid::m_rowBottoms/m_colRights
+    virtual const wxGridLineEnds& GetLineEnds(const wxGrid *grid) const = 0;
 
     // Get default height row height or column width
     virtual int GetDefaultLineSize(const wxGrid *grid) const = 0;
@@ -747,7 +820,7 @@ public:
         { return grid->GetRowBottom(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const override
         { return grid->GetRowHeight(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const override
+    virtual const wxGridLineEnds& GetLineEnds(const wxGrid *grid) const override
         { return grid->m_rowBottoms; }
     virtual int GetDefaultLineSize(const wxGrid *grid) const override
         { return grid->GetDefaultRowSize(); }
@@ -903,7 +976,7 @@ public:
         { return grid->GetColRight(line); }
     virtual int GetLineSize(const wxGrid *grid, int line) const override
         { return grid->GetColWidth(line); }
-    virtual const wxArrayInt& GetLineEnds(const wxGrid *grid) const override
+    virtual const wxGridLineEnds& GetLineEnds(const wxGrid *grid) const override
         { return grid->m_colRights; }
     virtual int GetDefaultLineSize(const wxGrid *grid) const override
         { return grid->GetDefaultColSize(); }
@@ -1262,6 +1335,38 @@ private:
     wxGridDataTypeInfoArray m_typeinfo;
 };
 
+// Cache of the text extents used while auto-sizing rows or columns: the same
+// strings are often repeated in many cells and measuring them is relatively
+// slow, so remember the extents of the strings already measured with each font.
+class wxGridTextExtentCache
+{
+public:
+    wxGridTextExtentCache() = default;
+
+    wxSize GetMultiLineTextExtent(wxReadOnlyDC& dc,
+                                  const wxFont& font,
+                                  const wxString& text);
+
+private:
+    // Maximal number of strings cached for each font, to avoid using too much
+    // memory for the columns containing only unique values.
+    static constexpr size_t MAX_STRINGS_PER_FONT = 100000;
+
+    struct FontExtents
+    {
+        explicit FontExtents(const wxFont& font_) : font(font_) { }
+
+        wxFont font;
+        std::unordered_map<wxString, wxSize> extents;
+    };
+
+    // There are typically very few different fonts, so just search for the
+    // font linearly.
+    std::vector<FontExtents> m_fonts;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridTextExtentCache);
+};
+
 // Returns the rectangle for showing something of the given size in a cell with
 // the given alignment.
 //
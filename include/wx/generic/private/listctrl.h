@@ -19,7 +19,12 @@
 #include "wx/timer.h"
 #include "wx/settings.h"
 
+#include "wx/threadpool.h"
+
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 // ============================================================================
 // private classes
@@ -44,77 +49,6 @@ struct wxColWidthInfo
 
 using ColWidthArray = std::vector<wxColWidthInfo>;
 
-//-----------------------------------------------------------------------------
-//  wxListItemData (internal)
-//-----------------------------------------------------------------------------
-
-class wxListItemData
-{
-public:
-    wxListItemData(wxListMainWindow *owner);
-    wxListItemData(const wxListItemData&) = delete;
-    wxListItemData(wxListItemData&&);
-    wxListItemData& operator=(const wxListItemData&) = delete;
-    wxListItemData& operator=(wxListItemData&&);
-    ~wxListItemData();
-
-    void SetItem( const wxListItem &info );
-    void SetImage( int image ) { m_image = image; }
-    void SetData( wxUIntPtr data ) { m_data = data; }
-    void SetPosition( int x, int y );
-    void SetSize( int width, int height );
-
-    bool HasText() const { return !m_text.empty(); }
-    const wxString& GetText() const { return m_text; }
-    void SetText(const wxString& text) { m_text = text; }
-
-    // we can't use empty string for measuring the string width/height, so
-    // always return something
-    wxString GetTextForMeasuring() const
-    {
-        wxString s = GetText();
-        if ( s.empty() )
-            s = wxT('H');
-
-        return s;
-    }
-
-    bool IsHit( int x, int y ) const;
-
-    int GetX() const;
-    int GetY() const;
-    int GetWidth() const;
-    int GetHeight() const;
-
-    int GetImage() const { return m_image; }
-    bool HasImage() const { return GetImage() != -1; }
-
-    void GetItem( wxListItem &info ) const;
-
-    void SetAttr(wxItemAttr *attr) { m_attr = attr; }
-    wxItemAttr *GetAttr() const { return m_attr; }
-
-public:
-    // the item image or -1
-    int m_image = -1;
-
-    // user data associated with the item
-    wxUIntPtr m_data = 0;
-
-    // the item coordinates are not used in report mode; instead this pointer is
-    // null and the owner window is used to retrieve the item position and size
-    wxRect *m_rect = nullptr;
-
-    // the list ctrl we are in
-    wxListMainWindow *m_owner;
-
-    // custom attributes or nullptr
-    wxItemAttr *m_attr = nullptr;
-
-protected:
-    wxString m_text;
-};
-
 //-----------------------------------------------------------------------------
 //  wxListHeaderData (internal)
 //-----------------------------------------------------------------------------
@@ -166,9 +100,6 @@ private:
 class wxListLineData
 {
 public:
-    // the list of subitems: only may have more than one item in report mode
-    std::vector<wxListItemData> m_items;
-
     // this is not used in report view
     struct GeometryInfo
     {
@@ -211,12 +142,12 @@ public:
 public:
     wxListLineData(wxListMainWindow *owner);
     wxListLineData(const wxListLineData&) = delete;
-    wxListLineData(wxListLineData&& other) = default;
+    wxListLineData(wxListLineData&& other);
 
     wxListLineData& operator=(const wxListLineData&) = delete;
-    wxListLineData& operator=(wxListLineData&&) = default;
+    wxListLineData& operator=(wxListLineData&& other);
 
-    ~wxListLineData() = default;
+    ~wxListLineData();
 
     // called by the owner when it toggles report view
     void SetReportView(bool inReportView)
@@ -251,7 +182,8 @@ public:
     bool IsChecked() { return m_checked; }
 
     bool HasImage() const { return GetImage() != -1; }
-    bool HasText() const { return !GetText(0).empty(); }
+    bool HasText() const { return HasText(0); }
+    bool HasText(int index) const;
 
     void SetItem( int index, const wxListItem &info );
     void GetItem( int index, wxListItem &info ) const;
@@ -259,9 +191,29 @@ public:
     wxString GetText(int index) const;
     void SetText( int index, const wxString& s );
 
-    wxItemAttr *GetAttr() const;
+    // we can't use empty string for measuring the string width/height, so
+    // always return something
+    wxString GetTextForMeasuring() const
+    {
+        wxString s = GetText(0);
+        if ( s.empty() )
+            s = wxT('H');
+
+        return s;
+    }
+
+    // the attributes of the first subitem, used for the entire line
+    wxItemAttr *GetAttr() const { return m_attr; }
     void SetAttr(wxItemAttr *attr);
 
+    // the number of subitems: only may be more than one in report mode
+    size_t GetSubItemCount() const { return m_subitems.size(); }
+
+    // insert a new empty subitem at the given position or delete an existing
+    // one, used when the columns are inserted or deleted
+    void InsertSubItem(size_t index);
+    void DeleteSubItem(size_t index);
+
     // return true if the highlighting really changed
     bool Highlight( bool on );
 
@@ -287,6 +239,47 @@ public:
                            bool checked );
 
 private:
+    // The subitems are stored in a compact form as there may be millions of
+    // them: their texts are stored one after another in UTF-8 in a single
+    // buffer and only the image and the end of the text in this buffer is
+    // stored for each of them.
+    struct SubItem
+    {
+        wxUint32 textEnd;
+        int image;
+    };
+
+    std::vector<SubItem> m_subitems;
+    std::string m_texts;
+
+    // the user data and the attributes of the first subitem, or nullptr
+    // (notice that the attributes are not owned by us in virtual mode)
+    wxUIntPtr m_data;
+    wxItemAttr *m_attr;
+
+    // the user data and the attributes of the other subitems, which are
+    // almost never used and so are only allocated if necessary
+    struct SubItemExtra
+    {
+        wxUIntPtr data = 0;
+        std::unique_ptr<wxItemAttr> attr;
+    };
+
+    std::unique_ptr< std::vector<SubItemExtra> > m_extra;
+
+    // get the extra data for the given subitem, which must be > 0, creating
+    // it if necessary
+    SubItemExtra& GetExtra(int index);
+
+    // get the attributes of the given subitem, possibly nullptr
+    wxItemAttr *GetSubItemAttr(int index) const;
+
+    // get the start of the text of the given subitem in m_texts
+    size_t GetTextStart(int index) const
+    {
+        return index ? m_subitems[index - 1].textEnd : 0;
+    }
+
     // set the line to contain num items (only can be > 1 in report mode)
     void InitItems( int num );
 
@@ -310,6 +303,100 @@ private:
                            int width);
 };
 
+//-----------------------------------------------------------------------------
+//  wxListVirtualCache (internal)
+//-----------------------------------------------------------------------------
+
+// Cache of the items returned by OnGetItemXXX() functions of a virtual list
+// control, used if wxListCtrl::EnableVirtualCache() was called.
+//
+// The items are cached in pages of consecutive lines. The cache has a
+// generation which changes whenever the cached items become invalid, which
+// allows to discard the pages prefetched in background for an older one.
+class wxListVirtualCache
+{
+public:
+    // the number of lines in a page and the maximal number of cached pages
+    enum
+    {
+        PAGE_SIZE = 64,
+        MAX_PAGES = 32
+    };
+
+    // the data of a single line
+    struct Line
+    {
+        std::vector<wxString> texts;
+        std::vector<int> images;
+        wxItemAttr attr;
+        bool hasAttr = false;
+        bool checked = false;
+    };
+
+    typedef std::vector<Line> Lines;
+
+    wxListVirtualCache(bool prefetch, size_t numColumns, bool hasCheckBoxes)
+        : m_prefetch(prefetch),
+          m_numColumns(numColumns),
+          m_hasCheckBoxes(hasCheckBoxes)
+    {
+    }
+
+    bool ShouldPrefetch() const { return m_prefetch; }
+
+    // return true if the cached items were retrieved using the same layout
+    bool HasLayout(size_t numColumns, bool hasCheckBoxes) const
+    {
+        return numColumns == m_numColumns && hasCheckBoxes == m_hasCheckBoxes;
+    }
+
+    unsigned GetGeneration() const { return m_generation; }
+
+    // return the cached line or nullptr if its page is not in the cache
+    Line* GetLine(size_t line);
+
+    bool HasPage(size_t page) const { return m_pages.count(page) != 0; }
+
+    // add a new page, removing the least recently used one if necessary
+    void AddPage(size_t page, Lines&& lines);
+
+    // functions for the pages which are being fetched in background
+    bool IsFetching(size_t page) const { return m_fetching.count(page) != 0; }
+    void SetFetching(size_t page) { m_fetching.insert(page); }
+
+    // forget all the cached pages or only those containing the given lines
+    void Invalidate();
+    void Invalidate(size_t lineFrom, size_t lineTo);
+
+#if wxUSE_THREADS
+    // Cancelled when the pages being fetched in background are not needed
+    // anymore, this is done while holding the mutex, which is locked by the
+    // background tasks while they call OnGetItemXXX(), to ensure that they
+    // don't do it any more after the cache is destroyed.
+    wxCancellationSource m_cancel;
+    std::shared_ptr<wxMutex> m_fetchMutex = std::make_shared<wxMutex>();
+#endif // wxUSE_THREADS
+
+private:
+    struct Page
+    {
+        Lines lines;
+        unsigned lastUsed;
+    };
+
+    std::unordered_map<size_t, Page> m_pages;
+    std::unordered_set<size_t> m_fetching;
+
+    unsigned m_generation = 0;
+    unsigned m_lastUsed = 0;
+
+    const bool m_prefetch;
+    const size_t m_numColumns;
+    const bool m_hasCheckBoxes;
+
+    wxDECLARE_NO_COPY_CLASS(wxListVirtualCache);
+};
+
 //-----------------------------------------------------------------------------
 //  wxListHeaderWindow (internal)
 //-----------------------------------------------------------------------------
@@ -731,6 +818,11 @@ public:
         m_extendRulesAndAlternateColour = extend;
     }
 
+    // virtual items cache support
+    void EnableVirtualCache(bool enable, bool prefetch);
+    void InvalidateVirtualCache();
+    void InvalidateVirtualCache(size_t lineFrom, size_t lineTo);
+
 
     // these are for wxListLineData usage only
 
@@ -868,6 +960,28 @@ protected:
     // cache the line data of the n-th line in m_lines[0]
     void CacheLineData(size_t line);
 
+    // get the data of the given line from the virtual cache, which must be
+    // enabled, retrieving it if it's not cached yet
+    wxListVirtualCache::Line& GetVirtualCacheLine(size_t line);
+
+    // start retrieving the pages adjacent to the given range of lines in
+    // background if prefetching is enabled
+    void PrefetchVirtualCache(size_t lineFrom, size_t lineTo);
+
+    // retrieve the data of the given lines from the control: this can be done
+    // in any thread if prefetching is enabled, except for the attributes,
+    // which are only retrieved if withAttrs is true
+    static void FetchVirtualLines(const wxGenericListCtrl* listctrl,
+                                  size_t lineFrom,
+                                  size_t count,
+                                  size_t numColumns,
+                                  bool hasCheckBoxes,
+                                  bool withAttrs,
+                                  wxListVirtualCache::Lines& lines);
+
+    // retrieve the attributes of the lines fetched without them
+    void FetchVirtualAttrs(size_t lineFrom, wxListVirtualCache::Lines& lines);
+
     // get the range of visible lines
     void GetVisibleLinesRange(size_t *from, size_t *to);
 
@@ -940,6 +1054,9 @@ private:
     // rulers on empty rows
     bool m_extendRulesAndAlternateColour;
 
+    // the cache of the items of a virtual control or null if not enabled
+    std::unique_ptr<wxListVirtualCache> m_virtualCache;
+
     wxDECLARE_EVENT_TABLE();
 
     friend class wxGenericListCtrl;
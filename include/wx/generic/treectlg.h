@@ -245,6 +245,7 @@ protected:
                         *m_select_me;
     unsigned int         m_indent;
     int                  m_lineHeight;
+    int                  m_itemsWidth;  // of the widest item shown so far
     wxPen                m_dottedPen;
     wxBrush              m_hilightBrush,
                          m_hilightUnfocusedBrush;
@@ -326,11 +327,31 @@ protected:
 
     void CalculateLineHeight();
     int  GetLineHeight(wxGenericTreeItem *item) const;
-    void PaintLevel( wxGenericTreeItem *item, wxDC& dc, int level, int &y );
-    void PaintItem( wxGenericTreeItem *item, wxDC& dc);
-
-    void CalculateLevel( wxGenericTreeItem *item, wxReadOnlyDC &dc, int level, int &y );
-    void CalculatePositions();
+    void PaintRow( wxGenericTreeItem *item, wxDC& dc, int y );
+    void PaintItem( wxGenericTreeItem *item, wxDC& dc, const wxPoint& pos );
+    void PaintChildrenLine( wxGenericTreeItem *item, wxDC& dc );
+
+    // The items positions are not stored but computed using the heights of
+    // the subtrees of all items, which are updated incrementally when the
+    // tree changes and can be used to find the position of any item, or the
+    // item at the given position, in logarithmic time.
+    bool ShowsChildren(const wxGenericTreeItem *item) const;
+    int  GetRowHeight(wxGenericTreeItem *item) const;
+    int  GetSubtreeHeight(wxGenericTreeItem *item) const;
+    void UpdateChildrenIndex(wxGenericTreeItem *item) const;
+    void AdjustSubtreeHeight(wxGenericTreeItem *item, int delta);
+    void InvalidateSubtreeHeight(wxGenericTreeItem *item);
+    void UpdateSubtreeHeight(wxGenericTreeItem *item);
+    void UpdateRowHeight(wxGenericTreeItem *item);
+    void UpdateLayoutAfterInsert(wxGenericTreeItem *item, size_t index);
+    void InvalidateLayout();
+
+    int  GetItemX(wxGenericTreeItem *item) const;
+    void UpdateShownItemsWidth();
+    int  GetItemY(wxGenericTreeItem *item) const;
+    wxGenericTreeItem *FindItemAtY(int y, int *top = nullptr) const;
+    wxGenericTreeItem *GetNextShown(wxGenericTreeItem *item) const;
+    wxGenericTreeItem *HitTestItem(const wxPoint& point, int& flags) const;
 
     void RefreshSubtree( wxGenericTreeItem *item );
     void RefreshLine( wxGenericTreeItem *item );
@@ -336,6 +336,11 @@ public:
     // This if for internal usage only and may disappear in future versions!
     virtual bool IsTerminalCell() const { return true; }
 
+    // Returns true if calling DrawInvisible() for this cell may have any
+    // effect, this must be overridden together with DrawInvisible().
+    // This if for internal usage only and may disappear in future versions!
+    virtual bool NeedsDrawInvisible() const { return true; }
+
     // Find a cell inside this cell positioned at the given coordinates
     // (relative to this's positions). Returns nullptr if no such cell exists.
     // The flag can be used to specify whether to look for terminal or
@@ -456,6 +461,9 @@ public:
     virtual wxString ConvertToText(wxHtmlSelection *sel) const override;
     bool IsLinebreakAllowed() const override { return m_allowLinebreak; }
 
+    // words don't do anything in DrawInvisible()
+    virtual bool NeedsDrawInvisible() const override { return false; }
+
     void SetPreviousWord(wxHtmlWordCell *cell);
 
 protected:
@@ -573,6 +581,16 @@ public:
     // see comment in wxHtmlCell about this method
     virtual bool IsTerminalCell() const override { return false; }
 
+    // returns true if any of the children needs DrawInvisible()
+    virtual bool NeedsDrawInvisible() const override;
+
+    // Returns true if the children of this container are positioned by the
+    // layout algorithm of this class, which allows to lay them out lazily.
+    // This is only the case for the containers created by wxHTML itself, as
+    // the derived classes may override Layout(), but they can override this
+    // function to return true if they don't do it.
+    virtual bool CanLayoutChildrenLazily() const { return false; }
+
     virtual wxHtmlCell *FindCellByPos(wxCoord x, wxCoord y,
                                   unsigned flags = wxHTML_FIND_EXACT) const override;
 
@@ -590,6 +608,33 @@ public:
 
     virtual wxString Dump(int indent = 0) const override;
 
+    // Lazy layout support, see wxHtmlWindow::EnableLazyLayout(). For internal
+    // use only.
+    //
+    // When lazy layout is enabled, Layout() only lays out exactly the child
+    // containers intersecting the range set by SetLayoutViewport(), in this
+    // container coordinates, and uses their sizes cached for the same width
+    // or estimated from their contents for all the other ones.
+    void EnableLazyLayout(bool enable = true);
+    bool IsLazyLayoutEnabled() const;
+
+    // Set the range to lay out exactly and, if the container had been already
+    // laid out, lay out the cells in this range which were not laid out yet.
+    // Returns true if the size of the container changed.
+    bool SetLayoutViewport(int top, int bottom);
+
+    // Returns true if some cells still need to be laid out exactly.
+    bool HasPendingLayout() const;
+
+    // Lay out exactly up to the given number of the cells which haven't been
+    // laid out yet, returns true if the size of the container changed.
+    bool LayoutPending(int maxCells);
+
+    // Ensure that the position of the given cell, which must be a descendant
+    // of this container, is exact, returns true if the size of the container
+    // changed.
+    bool EnsureLaidOut(const wxHtmlCell *cell);
+
 protected:
     void UpdateRenderingStatePre(wxHtmlRenderingInfo& info,
                                  wxHtmlCell *cell) const;
@@ -633,6 +678,77 @@ protected:
 private:
     void InitParent(wxHtmlContainerCell *parent);
 
+    // Range of the coordinates to lay out exactly when using lazy layout.
+    struct LayoutRange
+    {
+        int top, bottom;
+    };
+
+    // Data used by the lazy layout, defined in the implementation file.
+    struct LayoutData;
+
+    LayoutData& GetLayoutData();
+
+    // Lay out the container exactly if range is null or only lay out exactly
+    // the child containers intersecting it otherwise.
+    void DoLayout(int w, const LayoutRange *range);
+
+    // Set the size of the container for the given width without laying out
+    // its children.
+    void EstimateLayout(int w);
+
+    // Position the children, which must have been already laid out, and
+    // compute the size of the container.
+    void PlaceChildren(int w);
+
+    // Lay out the child containers intersecting the given range which are not
+    // laid out exactly yet, returns true if the size of any of them changed.
+    bool LayoutChildrenInRange(const LayoutRange& range);
+
+    // Lay out exactly up to the given number of the cells not laid out yet,
+    // decrementing it by the number of the cells laid out.
+    void DoLayoutPending(int& maxCells);
+
+    // Lay out the container again for the same width, only laying out exactly
+    // the cells in the given range, returns true if its size changed.
+    bool Relayout(const LayoutRange *range);
+
+    // Update m_layoutState after laying out the children.
+    void UpdateLayoutState();
+
+    // Return the width of the container before adjusting it to its contents
+    // and the width available to its children for the given layout width.
+    int GetAdjustedWidth(int w) const;
+    int GetChildrenWidth(int w) const;
+
+    enum LayoutState
+    {
+        Layout_Exact,       // Container and all its children are laid out.
+        Layout_Estimated,   // Only container size is known.
+        Layout_Partial      // Some of the children are not laid out.
+    };
+
+    LayoutState m_layoutState = Layout_Exact;
+    LayoutData *m_layoutData = nullptr;
+
+    // Index of the children positions, defined in the implementation file.
+    struct ChildrenIndex;
+
+    // Return the index of the children, creating it if necessary, or null if
+    // this container doesn't use it, e.g. because it has too few children.
+    const ChildrenIndex *GetChildrenIndex() const;
+
+    // Delete the index, it will be recreated when it's needed again.
+    void InvalidateChildrenIndex();
+
+    // Must be called when the children of this container change.
+    void OnChildrenChanged();
+
+    mutable ChildrenIndex *m_childrenIndex = nullptr;
+
+    // Cached result of NeedsDrawInvisible() for this container or -1.
+    mutable int m_needsDrawInvisible = -1;
+
     wxDECLARE_ABSTRACT_CLASS(wxHtmlContainerCell);
     wxDECLARE_NO_COPY_CLASS(wxHtmlContainerCell);
 };
@@ -16,6 +16,7 @@
 #include "wx/filesys.h"
 #include "wx/vector.h"
 #include "wx/fontenc.h"
+#include "wx/hashmap.h"
 
 #include <memory>
 #include <stack>
@@ -30,7 +31,10 @@ class WXDLLIMPEXP_FWD_HTML wxHtmlEntitiesParser;
 class wxHtmlTextPieces;
 class wxHtmlParserState;
 
-using wxHtmlTagHandlersHash = std::unordered_map<wxString, wxHtmlTagHandler*>;
+// Use wxStringHash which, unlike std::hash<wxString>, doesn't need to copy the
+// string, as this hash is used for every tag.
+using wxHtmlTagHandlersHash = std::unordered_map<wxString, wxHtmlTagHandler*,
+                                                 wxStringHash, wxStringEqual>;
 
 
 enum wxHtmlURLType
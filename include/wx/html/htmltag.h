@@ -15,6 +15,7 @@
 
 #include "wx/object.h"
 #include "wx/arrstr.h"
+#include "wx/vector.h"
 
 class WXDLLIMPEXP_FWD_CORE wxColour;
 class WXDLLIMPEXP_FWD_HTML wxHtmlEntitiesParser;
@@ -25,6 +26,8 @@ class WXDLLIMPEXP_FWD_HTML wxHtmlEntitiesParser;
 //-----------------------------------------------------------------------------
 
 class wxHtmlTagsCacheData;
+class wxHtmlTagParam;
+typedef wxVector<wxHtmlTagParam> wxHtmlTagParams;
 
 class WXDLLIMPEXP_HTML wxHtmlTagsCache
 {
@@ -34,6 +37,10 @@ private:
 
     wxHtmlTagsCacheData& Cache() { return *m_Cache; }
 
+    // Makes m_CachePos point to the tag starting at the given position and
+    // returns true or returns false if there is no such tag.
+    bool LocateTag(const wxString::const_iterator& at);
+
 public:
     wxHtmlTagsCache() {m_Cache = nullptr;}
     wxHtmlTagsCache(const wxString& source);
@@ -46,10 +53,63 @@ public:
                   wxString::const_iterator *end2,
                   bool *hasEnding);
 
+    // Moves the name and parameters of the tag starting at the given position
+    // and its inner text start, all found when creating the cache, to the
+    // output parameters if the tag ends before inputEnd and returns true, or
+    // returns false if the tag must be parsed again.
+    bool TakeTagData(const wxString::const_iterator& at,
+                     const wxString::const_iterator& inputEnd,
+                     wxString *name,
+                     wxHtmlTagParams *params,
+                     wxString::const_iterator *begin);
+
     wxDECLARE_NO_COPY_CLASS(wxHtmlTagsCache);
 };
 
 
+//-----------------------------------------------------------------------------
+// wxHtmlTagParam
+//          - internal wxHTML class, do not use!
+//-----------------------------------------------------------------------------
+
+// Parameter of a tag: its name and value are stored as positions in the source
+// string and are only converted to strings when they're requested, except for
+// the parameters added by wxHTML itself, which store the strings directly.
+class wxHtmlTagParam
+{
+public:
+    enum
+    {
+        // The value was not quoted and must be converted to upper case.
+        Value_Upper = 1,
+
+        // The value contains '&' and must be processed by entities parser.
+        Value_HasEntities = 2,
+
+        // The name and value are stored in m_name and m_value.
+        Value_Owned = 4
+    };
+
+    wxHtmlTagParam() = default;
+
+    wxHtmlTagParam(const wxString& name, const wxString& value)
+        : m_flags(Value_Owned), m_name(name), m_value(value)
+    {
+    }
+
+    // Return true if the name is the same as the given one, ignoring case.
+    bool IsNamed(const wxString& name) const;
+
+    wxString GetName() const;
+    wxString GetValue(const wxHtmlEntitiesParser *entParser) const;
+
+    wxString::const_iterator m_nameBegin, m_nameEnd,
+                             m_valueBegin, m_valueEnd;
+    int m_flags = 0;
+
+    wxString m_name, m_value;
+};
+
 //--------------------------------------------------------------------------------
 // wxHtmlTag
 //                  This represents single tag. It is used as internal structure
@@ -82,7 +142,7 @@ public:
     wxHtmlTag *GetNextTag() const;
 
     // Returns tag's name in uppercase.
-    inline wxString GetName() const {return m_Name;}
+    const wxString& GetName() const {return m_Name;}
 
     // Returns true if the tag has given parameter. Parameter
     // should always be in uppercase.
@@ -139,10 +199,16 @@ public:
     wxString::const_iterator GetEndIter2() const { return m_End2; }
 
 private:
+    // Return the index of the given parameter or wxNOT_FOUND.
+    int FindParam(const wxString& par) const;
+
     wxString m_Name;
     bool m_hasEnding;
     wxString::const_iterator m_Begin, m_End1, m_End2;
-    wxArrayString m_ParamNames, m_ParamValues;
+    wxHtmlTagParams m_Params;
+
+    // Used to replace entities in the parameter values when they're retrieved.
+    const wxHtmlEntitiesParser *m_entParser;
 
     // DOM tree relations:
     wxHtmlTag *m_Next;
@@ -335,6 +335,11 @@ public:
     // Resets history
     void HistoryClear();
 
+    // Enable or disable laying out only the visible part of the page
+    // immediately and the rest of it in idle time.
+    void EnableLazyLayout(bool enable = true);
+    bool IsLazyLayoutEnabled() const { return m_lazyLayout; }
+
     // Returns pointer to conteiners/cells structure.
     // It should be used ONLY when printing
     wxHtmlContainerCell* GetInternalRepresentation() const {return m_Cell;}
@@ -403,6 +408,13 @@ protected:
     // actual size of window. This method also setup scrollbars
     void CreateLayout();
 
+    // Update the range to lay out exactly when using lazy layout, returns
+    // true if the size of the page changed.
+    bool UpdateLayoutViewport();
+
+    // Lay out some of the cells not laid out yet when using lazy layout.
+    void DoLayoutPending();
+
     void OnPaint(wxPaintEvent& event);
     void OnEraseBackground(wxEraseEvent& event);
     void OnSize(wxSizeEvent& event);
@@ -553,6 +565,9 @@ private:
     // the comments near its use.
     bool m_isBgReallyErased;
 
+    // true if only the visible part of the page is laid out immediately
+    bool m_lazyLayout;
+
     wxDECLARE_EVENT_TABLE();
     wxDECLARE_NO_COPY_CLASS(wxHtmlWindow);
 };
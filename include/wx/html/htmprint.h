@@ -198,6 +198,27 @@ private:
 private:
     wxVector<int> m_PageBreaks;
 
+    // Parameters affecting the layout of the document the last time it was
+    // laid out in OnPreparePrinting(), allowing to avoid doing it again if
+    // they didn't change.
+    struct LayoutParams
+    {
+        const wxClassInfo *dcClass;
+        int width, height;
+        int ppiPrinter, ppiScreen;
+
+        bool operator==(const LayoutParams& other) const
+        {
+            return dcClass == other.dcClass &&
+                   width == other.width && height == other.height &&
+                   ppiPrinter == other.ppiPrinter &&
+                   ppiScreen == other.ppiScreen;
+        }
+    };
+
+    LayoutParams m_layoutParams;
+    bool m_layoutDone = false;
+
     wxString m_Document, m_BasePath;
     bool m_BasePathIsDir;
     wxString m_Headers[2], m_Footers[2];
@@ -0,0 +1,39 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/html/private/htmlcell.h
+// Purpose:     Private wxHtmlCell-related classes
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_HTML_PRIVATE_HTMLCELL_H_
+#define _WX_HTML_PRIVATE_HTMLCELL_H_
+
+#include "wx/html/htmlcell.h"
+
+// ----------------------------------------------------------------------------
+// wxHtmlPlainContainerCell: container created by wxHTML itself
+// ----------------------------------------------------------------------------
+
+// This class is used instead of wxHtmlContainerCell itself for all the
+// containers created by wxHTML: as we know that their children are always
+// positioned by wxHtmlContainerCell::Layout(), they can be laid out lazily.
+//
+// Notice that wxHtmlContainerCell objects created by the application, or
+// objects of classes deriving from it, are never laid out lazily, as they
+// could override Layout() to position their children differently.
+class wxHtmlPlainContainerCell : public wxHtmlContainerCell
+{
+public:
+    explicit wxHtmlPlainContainerCell(wxHtmlContainerCell* parent)
+        : wxHtmlContainerCell(parent)
+    {
+    }
+
+    virtual bool CanLayoutChildrenLazily() const override { return true; }
+
+    wxDECLARE_NO_COPY_CLASS(wxHtmlPlainContainerCell);
+};
+
+#endif // _WX_HTML_PRIVATE_HTMLCELL_H_
@@ -430,6 +430,12 @@ public:
     // Only implemented in the generic version currently.
     virtual void EnableBellOnNoMatch(bool WXUNUSED(on) = true) { }
 
+    // Enable or disable caching the items of a virtual control, possibly
+    // retrieving them in background. Only implemented in the generic version.
+    virtual void EnableVirtualCache(bool WXUNUSED(enable) = true,
+                                    bool WXUNUSED(prefetch) = false) { }
+    virtual void InvalidateVirtualCache() { }
+
     void EnableAlternateRowColours(bool enable = true);
     void SetAlternateRowColour(const wxColour& colour);
     wxColour GetAlternateRowColour() const { return m_alternateRowColour.GetBackgroundColour(); }
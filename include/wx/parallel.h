@@ -0,0 +1,200 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/parallel.h
+// Purpose:     Parallel algorithms using wxThreadPool
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_PARALLEL_H_
+#define _WX_PARALLEL_H_
+
+#include "wx/defs.h"
+
+#include "wx/threadpool.h"
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+
+namespace wxPrivate
+{
+
+// Don't bother using multiple threads for sorting less than this number of
+// elements, as the overhead of doing it would outweigh any gains.
+const size_t PARALLEL_SORT_MIN_SIZE = 16384;
+
+// Also don't create chunks smaller than this when sorting in parallel.
+const size_t PARALLEL_SORT_MIN_CHUNK = 4096;
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// wxParallelFor: call a function for all indices in the given range
+// ----------------------------------------------------------------------------
+
+// The function is called with each index in [begin, end) exactly once, from
+// the current thread or from the worker threads of the given pool (or the
+// global pool if it's null). It must be safe to call it concurrently.
+//
+// The range is split into chunks containing at least grainSize indices, so
+// grainSize should be big enough to make the overhead of executing each chunk
+// in a separate task negligible.
+//
+// If the function throws, the exception is rethrown by wxParallelFor() after
+// all the chunks finish executing.
+template <typename F>
+void wxParallelFor(size_t begin, size_t end, const F& func,
+                   size_t grainSize = 1, wxThreadPool* pool = nullptr)
+{
+    if ( end <= begin )
+        return;
+
+    const size_t count = end - begin;
+
+#if wxUSE_THREADS
+    if ( !pool )
+        pool = wxThreadPool::GetIfAvailable();
+
+    if ( pool && pool->GetThreadCount() > 1 )
+    {
+        if ( !grainSize )
+            grainSize = 1;
+
+        // Use more chunks than threads to balance the load better if some
+        // chunks take longer than others.
+        const size_t numChunks = std::min(4*static_cast<size_t>(pool->GetThreadCount()),
+                                          (count + grainSize - 1) / grainSize);
+        if ( numChunks > 1 )
+        {
+            std::vector<wxFuture<void>> futures;
+            futures.reserve(numChunks - 1);
+
+            for ( size_t n = 1; n < numChunks; n++ )
+            {
+                const size_t from = begin + count*n/numChunks,
+                             to = begin + count*(n + 1)/numChunks;
+
+                futures.push_back(pool->Submit([&func, from, to]()
+                    {
+                        for ( size_t i = from; i < to; i++ )
+                            func(i);
+                    }));
+            }
+
+            // Execute the first chunk in this thread, but make sure to wait
+            // for all the other ones before returning, even if it throws, as
+            // they use func.
+            const size_t firstEnd = begin + count/numChunks;
+
+#if wxUSE_EXCEPTIONS
+            try
+            {
+#endif // wxUSE_EXCEPTIONS
+                for ( size_t i = begin; i < firstEnd; i++ )
+                    func(i);
+#if wxUSE_EXCEPTIONS
+            }
+            catch ( ... )
+            {
+                for ( size_t n = 0; n < futures.size(); n++ )
+                    futures[n].Wait();
+
+                throw;
+            }
+#endif // wxUSE_EXCEPTIONS
+
+            for ( size_t n = 0; n < futures.size(); n++ )
+                futures[n].Wait();
+
+            // Rethrow the exception from the first failed chunk, if any.
+            for ( size_t n = 0; n < futures.size(); n++ )
+                futures[n].Get();
+
+            return;
+        }
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(grainSize);
+    wxUnusedVar(pool);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    for ( size_t i = begin; i < end; i++ )
+        func(i);
+}
+
+// ----------------------------------------------------------------------------
+// wxParallelSort: stable sort using multiple threads
+// ----------------------------------------------------------------------------
+
+// Sort the range using the given comparator, which must be safe to call
+// concurrently from multiple threads.
+//
+// This sort is stable and its result doesn't depend on the number of threads
+// used, i.e. it is always the same as the result of std::stable_sort().
+template <typename RandomIt, typename Compare>
+void wxParallelSort(RandomIt first, RandomIt last, Compare comp,
+                    wxThreadPool* pool = nullptr)
+{
+#if wxUSE_THREADS
+    const size_t count = last - first;
+    if ( count >= wxPrivate::PARALLEL_SORT_MIN_SIZE )
+    {
+        if ( !pool )
+            pool = wxThreadPool::GetIfAvailable();
+
+        if ( pool && pool->GetThreadCount() > 1 )
+        {
+            // Use a power of 2 number of chunks to merge them pairwise.
+            const size_t numThreads = pool->GetThreadCount();
+            size_t numChunks = 1;
+            while ( numChunks < numThreads &&
+                        count/(2*numChunks) >= wxPrivate::PARALLEL_SORT_MIN_CHUNK )
+            {
+                numChunks *= 2;
+            }
+
+            std::vector<RandomIt> bounds(numChunks + 1);
+            for ( size_t n = 0; n <= numChunks; n++ )
+                bounds[n] = first + count*n/numChunks;
+
+            wxParallelFor(0, numChunks, [&bounds, &comp](size_t n)
+                {
+                    std::stable_sort(bounds[n], bounds[n + 1], comp);
+                }, 1, pool);
+
+            for ( size_t width = 1; width < numChunks; width *= 2 )
+            {
+                wxParallelFor(0, numChunks/(2*width), [&bounds, &comp, width](size_t n)
+                    {
+                        const size_t lo = 2*width*n;
+                        std::inplace_merge(bounds[lo],
+                                           bounds[lo + width],
+                                           bounds[lo + 2*width],
+                                           comp);
+                    }, 1, pool);
+            }
+
+            return;
+        }
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(pool);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+
+    std::stable_sort(first, last, comp);
+}
+
+template <typename RandomIt>
+void wxParallelSort(RandomIt first, RandomIt last, wxThreadPool* pool = nullptr)
+{
+    typedef typename std::iterator_traits<RandomIt>::value_type T;
+
+    wxParallelSort(first, last, std::less<T>(), pool);
+}
+
+#endif // _WX_PARALLEL_H_
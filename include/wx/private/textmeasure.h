@@ -14,6 +14,37 @@ class WXDLLIMPEXP_FWD_CORE wxDC;
 class WXDLLIMPEXP_FWD_CORE wxFont;
 class WXDLLIMPEXP_FWD_CORE wxWindow;
 
+// ----------------------------------------------------------------------------
+// wxTextMeasureCacheContext: identifies the results stored in the text cache
+// ----------------------------------------------------------------------------
+
+// This contains everything affecting the results of measuring the text except
+// the text itself and is used as part of the key in wxTextExtentCache.
+struct wxTextMeasureCacheContext
+{
+    // The font ref data: it's kept alive by the cache entries using it, so it
+    // can't be reused by another font while they exist.
+    const void* font = nullptr;
+
+    // The scale and resolution of the DC or the DPI scale of the window.
+    double scaleX = 1.0,
+           scaleY = 1.0,
+           contentScale = 1.0;
+    int ppi = 0;
+
+    bool forWindow = false;
+
+    bool operator==(const wxTextMeasureCacheContext& other) const
+    {
+        return font == other.font &&
+               scaleX == other.scaleX &&
+               scaleY == other.scaleY &&
+               contentScale == other.contentScale &&
+               ppi == other.ppi &&
+               forWindow == other.forWindow;
+    }
+};
+
 // ----------------------------------------------------------------------------
 // wxTextMeasure: class used to measure text extent.
 // ----------------------------------------------------------------------------
@@ -118,8 +149,8 @@ protected:
                                          wxArrayInt& widths,
                                          double scaleX) = 0;
 
-    // Call either DoGetTextExtent() or wxDC::GetTextExtent() depending on the
-    // value of m_useDCImpl.
+    // Return the cached extent of the string, if any, otherwise call
+    // MeasureTextExtent().
     //
     // This must be always used instead of calling DoGetTextExtent() directly!
     void CallGetTextExtent(const wxString& string,
@@ -128,6 +159,32 @@ protected:
                            wxCoord *descent = nullptr,
                            wxCoord *externalLeading = nullptr);
 
+    // Call either DoGetTextExtent() or wxDC::GetTextExtent() depending on the
+    // value of m_useDCImpl and store the result in the cache if possible.
+    void MeasureTextExtent(const wxString& string,
+                           wxCoord *width,
+                           wxCoord *height,
+                           wxCoord *descent,
+                           wxCoord *externalLeading);
+
+    // Return true and fill in the output parameters if the extent of this
+    // string is already in wxTextExtentCache. Only width and height must be
+    // non-null.
+    bool GetCachedTextExtent(const wxString& string,
+                             wxCoord *width,
+                             wxCoord *height,
+                             wxCoord *descent,
+                             wxCoord *externalLeading);
+
+    // Return true if the results of measuring can be stored in the cache,
+    // i.e. if the cache is enabled and they only depend on the values in
+    // the cache context returned by GetCacheContext().
+    bool CanUseCache();
+
+    // Return the context to use for the cache lookups, computing it on the
+    // first call. This can only be called if CanUseCache() returned true.
+    const wxTextMeasureCacheContext& GetCacheContext();
+
     // Get line height: used when the line is empty because CallGetTextExtent()
     // would just return (0, 0) in this case.
     int GetEmptyLineHeight();
@@ -155,6 +212,13 @@ protected:
     // This one can be null or not.
     const wxFont* const m_font;
 
+    // These fields are only valid after calling CanUseCache() and, for the
+    // context, GetCacheContext().
+    wxTextMeasureCacheContext m_cacheContext;
+    bool m_cacheChecked = false;
+    bool m_useCache = false;
+    bool m_cacheContextComplete = false;
+
     wxDECLARE_NO_COPY_CLASS(wxTextMeasureBase);
 };
 
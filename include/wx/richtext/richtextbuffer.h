@@ -3214,6 +3214,11 @@ public:
     virtual void Move(const wxPoint& pt) override;
 
 protected:
+    /**
+        Called whenever children are added to or removed from this object.
+    */
+    virtual void OnChildrenChanged() {}
+
     wxRichTextObjectList    m_children;
 };
 
@@ -3248,6 +3253,8 @@ public:
 
     virtual bool GetRangeSize(const wxRichTextRange& range, wxSize& size, int& descent, wxReadOnlyDC& dc, wxRichTextDrawingContext& context, int flags, const wxPoint& position = wxPoint(0,0), const wxSize& parentSize = wxDefaultSize, wxArrayInt* partialExtents = nullptr) const override;
 
+    virtual void CalculateRange(long start, long& end) override;
+
     virtual bool DeleteRange(const wxRichTextRange& range) override;
 
     virtual wxString GetTextForRange(const wxRichTextRange& range) const override;
@@ -3793,6 +3800,31 @@ public:
     */
     bool IsDirty() const { return m_invalidRange != wxRICHTEXT_NONE; }
 
+    /**
+        Sets the vertical position below which the paragraphs needing layout
+        are not laid out by Layout(), but only have their size estimated.
+        The default value of -1 means that all paragraphs are laid out.
+    */
+    void SetLazyLayoutLimit(int y) { m_lazyLayoutLimit = y; }
+
+    /**
+        Returns the vertical position below which the paragraphs are not laid
+        out, or -1 if all of them are.
+    */
+    int GetLazyLayoutLimit() const { return m_lazyLayoutLimit; }
+
+    /**
+        Returns @true if some paragraphs were not laid out by the last call to
+        Layout() because they were below the lazy layout limit.
+    */
+    bool HasPendingLayout() const { return m_pendingLayoutPosition != -1; }
+
+    /**
+        Returns the vertical position of the first paragraph which was not laid
+        out, or -1 if there is none.
+    */
+    int GetPendingLayoutPosition() const { return m_pendingLayoutPosition; }
+
     /**
         Returns the wxRichTextFloatCollector of this object.
     */
@@ -3820,6 +3852,27 @@ protected:
 
     // The floating layout state
     wxRichTextFloatCollector* m_floatCollector;
+
+    // Lazy layout state: the position below which paragraphs are not laid out
+    // and the position of the first paragraph not laid out, if any.
+    int             m_lazyLayoutLimit;
+    int             m_pendingLayoutPosition;
+
+    // The average height and number of characters of the lines laid out so
+    // far, used to estimate the height of the paragraphs not laid out yet.
+    int             m_averageLineHeight;
+    int             m_averageLineLength;
+
+    virtual void OnChildrenChanged() override;
+
+private:
+    // The index of the paragraphs used to find them by position, built on
+    // demand and destroyed whenever the children or their ranges change.
+    struct PositionIndex;
+    const PositionIndex* GetPositionIndex() const;
+    void InvalidatePositionIndex();
+
+    mutable PositionIndex* m_positionIndex = nullptr;
 };
 
 /**
@@ -4710,7 +4763,7 @@ public:
 
     virtual bool DeleteRange(const wxRichTextRange& range) override;
 
-    virtual bool IsEmpty() const override { return m_text.empty(); }
+    virtual bool IsEmpty() const override { return GetText().empty(); }
 
     virtual bool CanMerge(wxRichTextObject* object, wxRichTextDrawingContext& context) const override;
 
@@ -4749,12 +4802,19 @@ public:
     /**
         Returns the text.
     */
-    const wxString& GetText() const { return m_text; }
+    const wxString& GetText() const;
 
     /**
         Sets the text.
     */
-    void SetText(const wxString& text) { m_text = text; }
+    void SetText(const wxString& text);
+
+    /**
+        Inserts the text at the given position, which must be inside the range
+        of this object or just after its end. Returns false if the position is
+        invalid.
+    */
+    bool InsertText(long pos, const wxString& text);
 
 // Operations
 
@@ -4768,7 +4828,10 @@ private:
     bool DrawTabbedString(wxDC& dc, const wxRichTextAttr& attr, const wxRect& rect, wxString& str, wxCoord& x, wxCoord& y, bool selected);
 
 protected:
-    wxString    m_text;
+    // Replaces len characters starting at the given index with the new text.
+    // If the text is shared with other objects, the new string is built
+    // directly instead of copying the old one first.
+    void DoReplaceText(size_t start, size_t len, const wxString& text);
 };
 
 /**
@@ -80,6 +80,8 @@ class WXDLLIMPEXP_FWD_RICHTEXT wxRichTextStyleDefinition;
 #define wxRICHTEXT_DEFAULT_LAYOUT_INTERVAL 50
 // Milliseconds before delayed image processing occurs
 #define wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL 200
+// Number of pages laid out in idle time at once when using lazy layout
+#define wxRICHTEXT_DEFAULT_LAZY_LAYOUT_PAGES 10
 
 /* Identifiers
  */
@@ -386,10 +388,24 @@ public:
 
     /**
         Forces any pending layout due to delayed, partial layout when the control
-        was resized.
+        was resized or due to lazy layout.
     */
     void ForceDelayedLayout();
 
+    /**
+        Enables or disables lazy layout of the buffer.
+
+        When lazy layout is enabled, only the paragraphs up to one page below
+        the visible part of the buffer are laid out immediately, while the size
+        of the rest of them is estimated and they are laid out in idle time.
+    */
+    void EnableLazyLayout(bool enable = true) { m_lazyLayout = enable; }
+
+    /**
+        Returns @true if lazy layout is enabled.
+    */
+    bool IsLazyLayoutEnabled() const { return m_lazyLayout; }
+
     /**
         Sets the text (normal) cursor.
     */
@@ -2315,6 +2331,18 @@ protected:
 
     virtual void DoThaw() override;
 
+    // Lay out the buffer, without laying out the paragraphs below the given
+    // position if it is not -1.
+    void DoLayoutContent(bool onlyVisibleRect, int lazyLayoutLimit);
+
+    // Return the position below which the paragraphs are not laid out
+    // immediately if lazy layout is enabled or -1 otherwise.
+    int GetLazyLayoutLimit() const;
+
+    // Return true if the paragraphs which were not laid out yet need to be
+    // laid out now when using the given lazy layout limit.
+    bool NeedsPendingLayout(int lazyLayoutLimit) const;
+
 
 // Data members
 protected:
@@ -2386,6 +2414,9 @@ protected:
     /// Threshold for doing delayed layout
     long                    m_delayedLayoutThreshold;
 
+    /// Is lazy layout enabled?
+    bool                    m_lazyLayout;
+
     /// Cursors
     wxCursor                m_textCursor;
     wxCursor                m_urlCursor;
@@ -0,0 +1,61 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/textextentcache.h
+// Purpose:     declaration of wxTextExtentCache class
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_TEXTEXTENTCACHE_H_
+#define _WX_TEXTEXTENTCACHE_H_
+
+#include "wx/defs.h"
+
+// ----------------------------------------------------------------------------
+// wxTextExtentCache: controls the cache of measured text extents
+// ----------------------------------------------------------------------------
+
+// The cache itself is used by wxTextMeasure, i.e. by wxDC and wxWindow text
+// measuring functions, this class only allows to configure it and to retrieve
+// its statistics, so it only has static functions.
+class WXDLLIMPEXP_CORE wxTextExtentCache
+{
+public:
+    struct Stats
+    {
+        // Number of the lookups which found or didn't find the result.
+        unsigned long hits = 0;
+        unsigned long misses = 0;
+
+        // Number of the entries removed to stay under the memory limit.
+        unsigned long evictions = 0;
+
+        // Current number of entries and the memory used by them.
+        size_t entries = 0;
+        size_t memoryUsed = 0;
+
+        // Return the ratio of hits to all lookups or 0 if there were none.
+        double GetHitRate() const
+        {
+            const unsigned long lookups = hits + misses;
+            return lookups ? static_cast<double>(hits) / lookups : 0.;
+        }
+    };
+
+    // Set the maximal amount of memory, in bytes, used by the cache. Setting
+    // it to 0 disables the cache entirely.
+    static void SetMaxMemory(size_t bytes);
+    static size_t GetMaxMemory();
+
+    // Return the statistics of the cache use or reset them.
+    static Stats GetStats();
+    static void ResetStats();
+
+    // Remove all entries from the cache.
+    static void Clear();
+
+    wxTextExtentCache() = delete;
+};
+
+#endif // _WX_TEXTEXTENTCACHE_H_
@@ -107,7 +107,12 @@ enum wxMutexType
     wxMUTEX_DEFAULT,
 
     // recursive mutex: don't use these ones with wxCondition
-    wxMUTEX_RECURSIVE
+    wxMUTEX_RECURSIVE,
+
+    // normal mutex which spins for a short time before blocking when it is
+    // locked by another thread: this is more efficient for the mutexes which
+    // are only held for very short periods of time
+    wxMUTEX_ADAPTIVE
 };
 
 // forward declarations
@@ -115,6 +120,7 @@ class WXDLLIMPEXP_FWD_BASE wxThreadHelper;
 class WXDLLIMPEXP_FWD_BASE wxConditionInternal;
 class WXDLLIMPEXP_FWD_BASE wxMutexInternal;
 class WXDLLIMPEXP_FWD_BASE wxSemaphoreInternal;
+class WXDLLIMPEXP_FWD_BASE wxSharedMutexInternal;
 class WXDLLIMPEXP_FWD_BASE wxThreadInternal;
 
 // ----------------------------------------------------------------------------
@@ -208,17 +214,33 @@ private:
 //     which makes it possible to have static globals of this class
 // ----------------------------------------------------------------------------
 
-// in order to avoid any overhead under platforms where critical sections are
-// just mutexes make all wxCriticalSection class functions inline
-#if !defined(__WINDOWS__)
+// Under Unix critical sections are implemented using a lock word manipulated
+// with atomic operations directly, so that entering and leaving an
+// uncontended critical section doesn't require any function calls, and all
+// wxCriticalSection class functions are inline. Only the contended case is
+// handled by the functions implemented in the library.
+//
+// Under Cygwin, thread_local variables can't be exported from the DLL, so
+// critical sections are just mutexes there and the functions are inline too
+// to avoid any overhead.
+#if defined(__WINDOWS__)
+    #define wxCRITSECT_IS_MUTEX 0
+    #define wxCRITSECT_IS_LOCKWORD 0
+
+    #define wxCRITSECT_INLINE
+#elif defined(__CYGWIN__)
     #define wxCRITSECT_IS_MUTEX 1
+    #define wxCRITSECT_IS_LOCKWORD 0
 
     #define wxCRITSECT_INLINE WXEXPORT inline
-#else // MSW
+#else // Unix
     #define wxCRITSECT_IS_MUTEX 0
+    #define wxCRITSECT_IS_LOCKWORD 1
 
-    #define wxCRITSECT_INLINE
-#endif // MSW/!MSW
+    #define wxCRITSECT_INLINE WXEXPORT inline
+
+    #include <atomic>
+#endif // MSW/Cygwin/Unix
 
 enum wxCriticalSectionType
 {
@@ -247,7 +269,65 @@ public:
     wxCRITSECT_INLINE void Leave();
 
 private:
-#if wxCRITSECT_IS_MUTEX
+#if wxCRITSECT_IS_LOCKWORD
+    // Called by Enter() and TryEnter() when the critical section is already
+    // locked, either by another thread or, for the recursive critical
+    // sections, by the current one, and by Leave() if there may be waiters.
+    void DoEnterContended();
+    bool DoTryEnterContended();
+    void DoLeaveContended();
+
+    // Return a value identifying the current thread.
+    //
+    // This is called on every entry into a recursive critical section, so
+    // avoid accessing a thread_local variable, which requires a function call
+    // for a variable defined in a shared library, when we can read the thread
+    // pointer, which is unique for all existing threads, directly.
+    static const void* GetCurrentThreadTag()
+    {
+        const void* tag;
+#if defined(__linux__) && defined(__GNUC__) && defined(__x86_64__)
+        __asm__("mov %%fs:0, %0" : "=r" (tag));
+#elif defined(__linux__) && defined(__GNUC__) && defined(__i386__)
+        __asm__("mov %%gs:0, %0" : "=r" (tag));
+#elif defined(__linux__) && defined(__GNUC__) && defined(__aarch64__)
+        __asm__("mrs %0, tpidr_el0" : "=r" (tag));
+#else
+        tag = DoGetCurrentThreadTag();
+#endif
+        return tag;
+    }
+
+    // Fallback for GetCurrentThreadTag() used under the other platforms.
+    static const void* DoGetCurrentThreadTag();
+
+    // Remember the current thread as the owner of a recursive critical
+    // section after locking it.
+    void SetOwner()
+    {
+        if ( m_recursive )
+        {
+            m_owner.store(GetCurrentThreadTag(), std::memory_order_relaxed);
+            m_recursionCount = 1;
+        }
+    }
+
+    // The lock word: 0 if the critical section is not locked, 1 if it is
+    // locked and there are no threads waiting for it and 2 if it is locked
+    // and there may be threads waiting for it.
+    std::atomic<int> m_state;
+
+    // The tag of the thread owning the critical section, only used for the
+    // recursive critical sections. It is only written by the owning thread
+    // and so can't be equal to the current thread tag unless the current
+    // thread had written it.
+    std::atomic<const void*> m_owner;
+
+    // The number of times the owning thread entered the critical section.
+    unsigned m_recursionCount;
+
+    const bool m_recursive;
+#elif wxCRITSECT_IS_MUTEX
     wxMutex m_mutex;
 #elif defined(__WINDOWS__)
     // we can't allocate any memory in the ctor, so use placement new -
@@ -283,10 +363,66 @@ private:
     inline void wxCriticalSection::Enter() { (void)m_mutex.Lock(); }
     inline bool wxCriticalSection::TryEnter() { return m_mutex.TryLock() == wxMUTEX_NO_ERROR; }
     inline void wxCriticalSection::Leave() { (void)m_mutex.Unlock(); }
-#endif // wxCRITSECT_IS_MUTEX
+#elif wxCRITSECT_IS_LOCKWORD
+    inline wxCriticalSection::wxCriticalSection( wxCriticalSectionType critSecType )
+       : m_state(0),
+         m_owner(nullptr),
+         m_recursionCount(0),
+         m_recursive(critSecType == wxCRITSEC_DEFAULT)
+    {
+    }
+
+    inline wxCriticalSection::~wxCriticalSection() { }
+
+    inline void wxCriticalSection::Enter()
+    {
+        // Notice that we don't check if we already own a recursive critical
+        // section before trying to lock it: this is rare and will be detected
+        // by DoEnterContended() as the lock word is already set in this case.
+        int unlocked = 0;
+        if ( !m_state.compare_exchange_strong(unlocked, 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed) )
+        {
+            DoEnterContended();
+            return;
+        }
+
+        SetOwner();
+    }
+
+    inline bool wxCriticalSection::TryEnter()
+    {
+        int unlocked = 0;
+        if ( !m_state.compare_exchange_strong(unlocked, 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed) )
+            return m_recursive && DoTryEnterContended();
+
+        SetOwner();
+
+        return true;
+    }
+
+    inline void wxCriticalSection::Leave()
+    {
+        if ( m_recursive )
+        {
+            if ( --m_recursionCount )
+                return;
+
+            m_owner.store(nullptr, std::memory_order_relaxed);
+        }
+
+        // If the previous state was 2, there may be waiting threads.
+        if ( m_state.fetch_sub(1, std::memory_order_release) != 1 )
+            DoLeaveContended();
+    }
+#endif // wxCRITSECT_IS_MUTEX/wxCRITSECT_IS_LOCKWORD
 
 #undef wxCRITSECT_INLINE
 #undef wxCRITSECT_IS_MUTEX
+#undef wxCRITSECT_IS_LOCKWORD
 
 // wxCriticalSectionLocker is the same to critical sections as wxMutexLocker is
 // to mutexes
@@ -310,6 +446,106 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxCriticalSectionLocker);
 };
 
+// ----------------------------------------------------------------------------
+// wxSharedMutex: a mutex which can be locked either exclusively, by a single
+// thread, or in shared mode, by any number of threads at the same time
+// ----------------------------------------------------------------------------
+
+// This is typically used for protecting the data which is read much more often
+// than it is modified: the readers lock the mutex in shared mode and can access
+// the data concurrently, while the writers lock it exclusively.
+//
+// Shared mutexes are not recursive and the threads waiting for the exclusive
+// lock are preferred to the new readers when possible.
+class WXDLLIMPEXP_BASE wxSharedMutex
+{
+public:
+    wxSharedMutex();
+    ~wxSharedMutex();
+
+    // test if the mutex has been created successfully
+    bool IsOk() const;
+
+    // Lock the mutex exclusively, blocking until all the other threads unlock
+    // it.
+    wxMutexError Lock();
+
+    // Try to lock the mutex exclusively, return wxMUTEX_BUSY if it is locked
+    // by any other thread.
+    wxMutexError TryLock();
+
+    // Unlock the mutex locked by Lock() or TryLock().
+    wxMutexError Unlock();
+
+    // Lock the mutex in shared mode, blocking only while it is locked
+    // exclusively by another thread.
+    wxMutexError LockShared();
+
+    // Try to lock the mutex in shared mode, return wxMUTEX_BUSY if it is
+    // locked exclusively.
+    wxMutexError TryLockShared();
+
+    // Unlock the mutex locked by LockShared() or TryLockShared().
+    wxMutexError UnlockShared();
+
+private:
+    wxSharedMutexInternal *m_internal;
+
+    wxDECLARE_NO_COPY_CLASS(wxSharedMutex);
+};
+
+// Lock the shared mutex in shared mode for reading in the ctor and unlock it
+// in the dtor.
+class WXDLLIMPEXP_BASE wxReadLocker
+{
+public:
+    explicit wxReadLocker(wxSharedMutex& mutex)
+        : m_mutex(mutex)
+    {
+        m_isOk = m_mutex.LockShared() == wxMUTEX_NO_ERROR;
+    }
+
+    bool IsOk() const { return m_isOk; }
+
+    ~wxReadLocker()
+    {
+        if ( m_isOk )
+            m_mutex.UnlockShared();
+    }
+
+private:
+    wxSharedMutex& m_mutex;
+    bool m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxReadLocker);
+};
+
+// Lock the shared mutex exclusively for writing in the ctor and unlock it in
+// the dtor.
+class WXDLLIMPEXP_BASE wxWriteLocker
+{
+public:
+    explicit wxWriteLocker(wxSharedMutex& mutex)
+        : m_mutex(mutex)
+    {
+        m_isOk = m_mutex.Lock() == wxMUTEX_NO_ERROR;
+    }
+
+    bool IsOk() const { return m_isOk; }
+
+    ~wxWriteLocker()
+    {
+        if ( m_isOk )
+            m_mutex.Unlock();
+    }
+
+private:
+    wxSharedMutex& m_mutex;
+    bool m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxWriteLocker);
+};
+
 // ----------------------------------------------------------------------------
 // wxCondition models a POSIX condition variable which allows one (or more)
 // thread(s) to wait until some condition is fulfilled
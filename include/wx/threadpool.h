@@ -0,0 +1,486 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     wxThreadPool and related classes for running background tasks
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef _WX_THREADPOOL_H_
+#define _WX_THREADPOOL_H_
+
+#include "wx/defs.h"
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if wxUSE_EXCEPTIONS
+    #include <exception>
+#endif // wxUSE_EXCEPTIONS
+
+class WXDLLIMPEXP_FWD_BASE wxEvtHandler;
+class WXDLLIMPEXP_FWD_BASE wxThreadPool;
+
+// The type of the tasks executed by wxThreadPool.
+typedef std::function<void()> wxTask;
+
+// ----------------------------------------------------------------------------
+// wxCancellationToken: allows the tasks to check if they should stop
+// ----------------------------------------------------------------------------
+
+// Tokens are cheap to copy and all copies of the token created by the same
+// wxCancellationSource share the same state.
+class wxCancellationToken
+{
+public:
+    // Default constructed token is never cancelled.
+    wxCancellationToken() = default;
+
+    // Return true if the source of this token has been cancelled.
+    bool IsCancelled() const
+    {
+        return m_cancelled && m_cancelled->load(std::memory_order_relaxed);
+    }
+
+    // Return true if this token can ever become cancelled.
+    bool CanBeCancelled() const { return m_cancelled != nullptr; }
+
+private:
+    explicit wxCancellationToken(const std::shared_ptr<std::atomic<bool>>& cancelled)
+        : m_cancelled(cancelled)
+    {
+    }
+
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+
+    friend class wxCancellationSource;
+};
+
+// ----------------------------------------------------------------------------
+// wxCancellationSource: creates cancellation tokens and cancels them
+// ----------------------------------------------------------------------------
+
+class wxCancellationSource
+{
+public:
+    wxCancellationSource()
+        : m_cancelled(std::make_shared<std::atomic<bool>>(false))
+    {
+    }
+
+    // Request cancellation of all the tasks using the tokens from this source.
+    //
+    // This can be called from any thread.
+    void Cancel() { m_cancelled->store(true, std::memory_order_relaxed); }
+
+    bool IsCancelled() const
+    {
+        return m_cancelled->load(std::memory_order_relaxed);
+    }
+
+    wxCancellationToken GetToken() const
+    {
+        return wxCancellationToken(m_cancelled);
+    }
+
+private:
+    std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+// ----------------------------------------------------------------------------
+// Implementation helpers for wxFuture<T>
+// ----------------------------------------------------------------------------
+
+namespace wxPrivate
+{
+
+// Non-template part of the state shared by wxFuture<T> and the task computing
+// its value.
+class WXDLLIMPEXP_BASE FutureStateBase
+{
+public:
+    FutureStateBase();
+    virtual ~FutureStateBase();
+
+    bool IsReady() const { return m_ready.load(std::memory_order_acquire); }
+
+    bool IsCancelled() const { return m_cancelled; }
+
+    // Wait until the state becomes ready.
+    //
+    // If called from a thread pool worker thread, executes the other pending
+    // tasks of this pool while waiting, to avoid deadlocks if all the worker
+    // threads wait for the tasks which can't be executed because of this.
+    void Wait();
+
+    // Wait for at most the given number of milliseconds.
+    bool WaitTimeout(unsigned long milliseconds);
+
+    // Called by the task when it finishes executing.
+    void MarkReady();
+
+    // Called instead of executing the task if it was cancelled before it
+    // could start.
+    void MarkCancelled();
+
+#if wxUSE_EXCEPTIONS
+    void SetException(std::exception_ptr exception) { m_exception = exception; }
+
+    void RethrowIfNeeded() const
+    {
+        if ( m_exception )
+            std::rethrow_exception(m_exception);
+    }
+#endif // wxUSE_EXCEPTIONS
+
+private:
+    std::atomic<bool> m_ready;
+    bool m_cancelled;
+
+#if wxUSE_EXCEPTIONS
+    std::exception_ptr m_exception;
+#endif // wxUSE_EXCEPTIONS
+
+    wxMutex m_mutex;
+    wxCondition m_cond;
+
+    // The pools whose worker threads are waiting for this state, protected by
+    // m_mutex. The same pool can occur more than once if several of its
+    // workers are waiting.
+    std::vector<wxThreadPool*> m_waitingPools;
+
+    wxDECLARE_NO_COPY_CLASS(FutureStateBase);
+};
+
+template <typename T>
+class FutureState : public FutureStateBase
+{
+public:
+    FutureState() = default;
+
+    template <typename F>
+    void Compute(F& func) { m_value = func(); }
+
+    const T& GetValue() const { return m_value; }
+
+private:
+    T m_value{};
+};
+
+template <>
+class FutureState<void> : public FutureStateBase
+{
+public:
+    FutureState() = default;
+
+    template <typename F>
+    void Compute(F& func) { func(); }
+
+    void GetValue() const { }
+};
+
+} // namespace wxPrivate
+
+// ----------------------------------------------------------------------------
+// wxFuture<T>: result of a task submitted to wxThreadPool
+// ----------------------------------------------------------------------------
+
+// Notice that T must be default-constructible (or void).
+template <typename T>
+class wxFuture
+{
+public:
+    typedef T ValueType;
+
+    // Default constructed future is invalid and can't be used.
+    wxFuture() = default;
+
+    bool IsValid() const { return m_state != nullptr; }
+
+    // Return true if the task has finished executing or was cancelled.
+    bool IsReady() const
+    {
+        wxCHECK_MSG( m_state, false, "invalid future" );
+
+        return m_state->IsReady();
+    }
+
+    // Return true if the task was never executed because its cancellation
+    // token had been cancelled before the task could start.
+    //
+    // Notice that this is only meaningful when IsReady() returns true.
+    bool IsCancelled() const
+    {
+        wxCHECK_MSG( m_state, false, "invalid future" );
+
+        return m_state->IsCancelled();
+    }
+
+    // Wait until the task finishes executing.
+    void Wait() const
+    {
+        wxCHECK_RET( m_state, "invalid future" );
+
+        m_state->Wait();
+    }
+
+    // Wait for at most the given time, return true if the task finished.
+    bool WaitTimeout(unsigned long milliseconds) const
+    {
+        wxCHECK_MSG( m_state, false, "invalid future" );
+
+        return m_state->WaitTimeout(milliseconds);
+    }
+
+    // Wait until the task finishes executing and return its result.
+    //
+    // If the task threw an exception, it is rethrown by this function. If the
+    // task was cancelled, default-constructed value is returned.
+    auto Get() const -> decltype(std::declval<wxPrivate::FutureState<T>&>().GetValue())
+    {
+        Wait();
+
+#if wxUSE_EXCEPTIONS
+        m_state->RethrowIfNeeded();
+#endif // wxUSE_EXCEPTIONS
+
+        return m_state->GetValue();
+    }
+
+private:
+    typedef wxPrivate::FutureState<T> State;
+
+    explicit wxFuture(const std::shared_ptr<State>& state) : m_state(state) { }
+
+    std::shared_ptr<State> m_state;
+
+    friend class wxThreadPool;
+};
+
+// ----------------------------------------------------------------------------
+// wxThreadPool: runs the tasks using a fixed number of worker threads
+// ----------------------------------------------------------------------------
+
+class WXDLLIMPEXP_BASE wxThreadPool
+{
+public:
+    // Create the pool with the given number of worker threads, by default as
+    // many as there are CPUs.
+    explicit wxThreadPool(int numThreads = 0);
+
+    // Destroying the pool waits until all the tasks posted to it complete.
+    ~wxThreadPool();
+
+    // Return the global pool shared by the entire application.
+    //
+    // This pool is created on first use and destroyed on program shutdown.
+    static wxThreadPool& Get();
+
+    // Return the global pool if it can be used, i.e. if the library is
+    // initialized and not being shut down, or null otherwise.
+    //
+    // This is useful for the code which can be executed during the program
+    // initialization or shutdown and can fall back to doing its work in the
+    // current thread.
+    static wxThreadPool* GetIfAvailable();
+
+    // Return the number of worker threads in this pool.
+    int GetThreadCount() const { return static_cast<int>(m_workers.size()); }
+
+    // Return the number of tasks waiting for execution or executing.
+    size_t GetUnfinishedCount() const
+    {
+        return m_unfinished.load(std::memory_order_relaxed);
+    }
+
+
+    // Post a task for execution in one of the worker threads.
+    //
+    // This is the most basic function, which doesn't provide any way of
+    // retrieving the result of the task, see Submit() for this.
+    //
+    // If the task throws an exception, wxApp::OnUnhandledException() is
+    // called.
+    void Post(wxTask task);
+
+    // Post a task for execution and return the future which can be used to
+    // retrieve its result.
+    //
+    // If the token is cancelled before the task starts executing, the task is
+    // not executed at all. Otherwise it can also check the token itself.
+    template <typename F>
+    auto Submit(F func,
+                const wxCancellationToken& token = wxCancellationToken())
+        -> wxFuture<decltype(func())>
+    {
+        typedef decltype(func()) R;
+        typedef wxPrivate::FutureState<R> State;
+
+        std::shared_ptr<State> state(new State);
+
+        Post([func, state, token]() mutable
+            {
+                if ( token.IsCancelled() )
+                {
+                    state->MarkCancelled();
+                    return;
+                }
+
+#if wxUSE_EXCEPTIONS
+                try
+                {
+#endif // wxUSE_EXCEPTIONS
+                    state->Compute(func);
+#if wxUSE_EXCEPTIONS
+                }
+                catch ( ... )
+                {
+                    state->SetException(std::current_exception());
+                }
+#endif // wxUSE_EXCEPTIONS
+
+                state->MarkReady();
+            });
+
+        return wxFuture<R>(state);
+    }
+
+    // Execute the given function in a worker thread and then call the
+    // continuation with its result (or without any arguments, if the function
+    // doesn't return anything) in the main thread.
+    //
+    // The continuation is executed using CallAfter() on the given handler or
+    // wxTheApp if it is null, so the handler must remain alive until it is
+    // called. If the token is cancelled, neither the function nor the
+    // continuation are called.
+    template <typename F, typename C>
+    void SubmitThen(F func,
+                    C continuation,
+                    wxEvtHandler* handler = nullptr,
+                    const wxCancellationToken& token = wxCancellationToken())
+    {
+        Post([func, continuation, handler, token]() mutable
+            {
+                if ( token.IsCancelled() )
+                    return;
+
+                DoSubmitThen(func, continuation, handler, token,
+                             std::is_void<decltype(func())>());
+            });
+    }
+
+
+    // Wait until all the tasks posted to this pool complete.
+    //
+    // This function can't be called from the worker threads.
+    void WaitAll();
+
+    // Execute a single pending task of this pool in the current thread.
+    //
+    // Returns false if there were no pending tasks.
+    bool RunPendingTask();
+
+    // Return the pool of the current worker thread or null if the current
+    // thread is not a thread pool worker.
+    static wxThreadPool* GetCurrent();
+
+private:
+    class Worker;
+    class WorkQueue;
+
+    friend class wxPrivate::FutureStateBase;
+
+    // Used to create the pool without any worker threads, which executes all
+    // the tasks synchronously.
+    struct NoThreadsTag { };
+    explicit wxThreadPool(NoThreadsTag);
+
+    // Non-template helper calling the function in the main thread.
+    static void CallInMainThread(wxEvtHandler* handler, wxTask func);
+
+    template <typename F, typename C>
+    static void DoSubmitThen(F& func, C& continuation,
+                             wxEvtHandler* handler,
+                             const wxCancellationToken& token,
+                             std::false_type)
+    {
+        auto result = func();
+
+        CallInMainThread(handler, [continuation, result, token]() mutable
+            {
+                if ( !token.IsCancelled() )
+                    continuation(std::move(result));
+            });
+    }
+
+    template <typename F, typename C>
+    static void DoSubmitThen(F& func, C& continuation,
+                             wxEvtHandler* handler,
+                             const wxCancellationToken& token,
+                             std::true_type)
+    {
+        func();
+
+        CallInMainThread(handler, [continuation, token]() mutable
+            {
+                if ( !token.IsCancelled() )
+                    continuation();
+            });
+    }
+
+    // Find a task to execute in the worker thread with the given index (which
+    // may be -1 if the current thread is not one of our workers).
+    bool PopTask(int index, wxTask& task);
+
+    // Execute the task and update the counters.
+    void ExecuteTask(wxTask& task);
+
+    // Main function of the worker threads.
+    void WorkerMain(int index);
+
+    // Block the current worker thread until either a new task is posted to
+    // this pool or the given state becomes ready.
+    void WaitForTaskOrReady(const wxPrivate::FutureStateBase& state);
+
+    // Wake up all the worker threads waiting for the new tasks.
+    void WakeUpWaiting();
+
+
+    // The workers and their queues, indexed by the same index. The last queue
+    // (with the index equal to the number of workers) is used for the tasks
+    // posted from outside of the worker threads.
+    std::vector<Worker*> m_workers;
+    std::vector<std::unique_ptr<WorkQueue>> m_queues;
+
+    // The number of tasks in all the queues.
+    std::atomic<size_t> m_pending;
+
+    // The number of tasks posted but not finished yet.
+    std::atomic<size_t> m_unfinished;
+
+    // The number of workers waiting for m_condTask.
+    std::atomic<int> m_sleeping;
+
+    // Set when the pool is being destroyed.
+    bool m_stopping;
+
+    // Used to wait for new tasks and for all the tasks to complete.
+    wxMutex m_mutex;
+    wxCondition m_condTask,
+                m_condDone;
+
+    wxDECLARE_NO_COPY_CLASS(wxThreadPool);
+};
+
+#endif // wxUSE_THREADS
+
+#endif // _WX_THREADPOOL_H_
@@ -66,6 +66,79 @@ wxMutexError wxMutex::Unlock()
     return m_internal->Unlock();
 }
 
+// ----------------------------------------------------------------------------
+// wxSharedMutex
+// ----------------------------------------------------------------------------
+
+wxSharedMutex::wxSharedMutex()
+{
+    m_internal = new wxSharedMutexInternal();
+
+    if ( !m_internal->IsOk() )
+    {
+        delete m_internal;
+        m_internal = nullptr;
+    }
+}
+
+wxSharedMutex::~wxSharedMutex()
+{
+    delete m_internal;
+}
+
+bool wxSharedMutex::IsOk() const
+{
+    return m_internal != nullptr;
+}
+
+wxMutexError wxSharedMutex::Lock()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxSharedMutex::Lock(): not initialized") );
+
+    return m_internal->Lock();
+}
+
+wxMutexError wxSharedMutex::TryLock()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxSharedMutex::TryLock(): not initialized") );
+
+    return m_internal->TryLock();
+}
+
+wxMutexError wxSharedMutex::Unlock()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxSharedMutex::Unlock(): not initialized") );
+
+    return m_internal->Unlock();
+}
+
+wxMutexError wxSharedMutex::LockShared()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxSharedMutex::LockShared(): not initialized") );
+
+    return m_internal->LockShared();
+}
+
+wxMutexError wxSharedMutex::TryLockShared()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxSharedMutex::TryLockShared(): not initialized") );
+
+    return m_internal->TryLockShared();
+}
+
+wxMutexError wxSharedMutex::UnlockShared()
+{
+    wxCHECK_MSG( m_internal, wxMUTEX_INVALID,
+                 wxT("wxSharedMutex::UnlockShared(): not initialized") );
+
+    return m_internal->UnlockShared();
+}
+
 // --------------------------------------------------------------------------
 // wxConditionInternal
 // --------------------------------------------------------------------------
@@ -13,12 +13,17 @@
 #include "wx/unix/pipe.h"
 #include "wx/evtloopsrc.h"
 
+#include <atomic>
+
 // ----------------------------------------------------------------------------
 // wxWakeUpPipe: allows to wake up the event loop by writing to it
 // ----------------------------------------------------------------------------
 
 // This class is not MT-safe, see wxWakeUpPipeMT below for a wake up pipe
 // usable from other threads.
+//
+// Notice that under Linux, if eventfd() is available, it is used instead of a
+// real pipe: this uses a single descriptor instead of two and is cheaper.
 
 class wxWakeUpPipe : public wxEventLoopSourceHandler
 {
@@ -29,18 +34,30 @@ public:
     // returned by GetReadFd(), to the code blocking on input.
     wxWakeUpPipe();
 
+    virtual ~wxWakeUpPipe();
+
     // Wake up the blocking operation involving this pipe.
     //
-    // It simply writes to the write end of the pipe.
+    // It simply writes to the write end of the pipe, unless it had been
+    // already done and the pipe hadn't been read from since then.
     //
-    // As indicated by its name, this method does no locking and so can be
-    // called only from the main thread.
+    // This method doesn't use any locks and is async-signal-safe, so it can
+    // be called from signal handlers too.
     void WakeUpNoLock();
 
-    // Same as WakeUp() but without locking.
-
     // Return the read end of the pipe.
-    int GetReadFd() { return m_pipe[wxPipe::Read]; }
+    int GetReadFd() const
+    {
+        return m_eventFD != wxPipe::INVALID_FD ? m_eventFD
+                                               : m_pipe[wxPipe::Read];
+    }
+
+    // Return the write end of the pipe.
+    int GetWriteFd() const
+    {
+        return m_eventFD != wxPipe::INVALID_FD ? m_eventFD
+                                               : m_pipe[wxPipe::Write];
+    }
 
 
     // Implement wxEventLoopSourceHandler pure virtual methods
@@ -49,13 +66,24 @@ public:
     virtual void OnExceptionWaiting() override { }
 
 private:
+    // Try to create the eventfd descriptor, return false if it's not
+    // supported and we need to fall back to using a pipe.
+    bool CreateEventFD();
+
     wxPipe m_pipe;
 
+    // The eventfd descriptor used instead of m_pipe, if it's valid.
+    int m_eventFD;
+
     // This flag is set to true after writing to the pipe and reset to false
     // after reading from it in the main thread. Having it allows us to avoid
-    // overflowing the pipe with too many writes if the main thread can't keep
-    // up with reading from it.
-    bool m_pipeIsEmpty;
+    // both overflowing the pipe with too many writes if the main thread can't
+    // keep up with reading from it and making a system call for every wake up
+    // request when many of them arrive in a quick succession.
+    //
+    // It is atomic to allow WakeUpNoLock() to be called from any thread
+    // without locking.
+    std::atomic<bool> m_signalled;
 };
 
 // ----------------------------------------------------------------------------
@@ -64,34 +92,25 @@ private:
 
 // This class can be used from multiple threads, i.e. its WakeUp() can be
 // called concurrently.
+//
+// As wxWakeUpPipe itself doesn't need any locking any more, this class is
+// trivial now and only exists for compatibility and to make the intention to
+// use the pipe from multiple threads explicit.
 
 class wxWakeUpPipeMT : public wxWakeUpPipe
 {
-#if wxUSE_THREADS
 public:
     wxWakeUpPipeMT() = default;
 
-    // Thread-safe wrapper around WakeUpNoLock(): can be called from another
-    // thread to wake up the main one.
+    // Thread-safe function which can be called from another thread to wake up
+    // the main one.
+    //
+    // Only the first call after the pipe was last read from results in a
+    // system call, all the subsequent ones are almost free.
     void WakeUp()
     {
-        wxCriticalSectionLocker lock(m_pipeLock);
-
         WakeUpNoLock();
     }
-
-    virtual void OnReadWaiting() override
-    {
-        wxCriticalSectionLocker lock(m_pipeLock);
-
-        wxWakeUpPipe::OnReadWaiting();
-    }
-
-private:
-    // Protects access to m_pipeIsEmpty.
-    wxCriticalSection m_pipeLock;
-
-#endif // wxUSE_THREADS
 };
 
 #endif // _WX_UNIX_PRIVATE_WAKEUPPIPE_H_
@@ -232,6 +232,25 @@ struct wxXmlParseError
     wxFileOffset offset = 0;
 };
 
+// Derive from this class and pass it to wxXmlDocument::Load() to process the
+// elements as soon as they are parsed, without waiting for the entire document
+// to be loaded.
+class WXDLLIMPEXP_XML wxXmlParseHandler
+{
+public:
+    wxXmlParseHandler() = default;
+    virtual ~wxXmlParseHandler() = default;
+
+    // Called when the element and all of its children have been parsed, the
+    // node is still part of the document when this function is called.
+    //
+    // Return true if the node is not needed any more, it is then removed from
+    // the document and deleted.
+    virtual bool OnElementEnd(wxXmlNode* node) = 0;
+
+    wxDECLARE_NO_COPY_CLASS(wxXmlParseHandler);
+};
+
 // This class holds XML data/document as parsed by XML parser.
 
 class WXDLLIMPEXP_XML wxXmlDocument : public wxObject
@@ -250,6 +269,10 @@ public:
     bool Load(const wxString& filename, int flags = wxXMLDOC_NONE, wxXmlParseError* err = nullptr);
     bool Load(wxInputStream& stream, int flags = wxXMLDOC_NONE, wxXmlParseError* err = nullptr);
 
+    // Same as above but calls the handler for each element once it is parsed.
+    bool Load(wxInputStream& stream, wxXmlParseHandler& handler,
+              int flags = wxXMLDOC_NONE, wxXmlParseError* err = nullptr);
+
     // Saves document as .xml file.
     virtual bool Save(const wxString& filename, int indentstep = 2) const;
     virtual bool Save(wxOutputStream& stream, int indentstep = 2) const;
@@ -326,6 +349,9 @@ private:
 
     void DoCopy(const wxXmlDocument& doc);
 
+    bool DoLoad(wxInputStream& stream, wxXmlParseHandler* handler,
+                int flags, wxXmlParseError* err);
+
     wxDECLARE_CLASS(wxXmlDocument);
 };
 
@@ -0,0 +1,283 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/channel.h
+// Purpose:     interface of wxSPSCChannel<T> and wxMPMCChannel<T>
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    wxSPSCChannel is a bounded channel for passing messages from a single
+    producer thread to a single consumer thread.
+
+    Unlike wxMessageQueue, this class doesn't use any locks nor allocates any
+    memory when passing the messages: they are stored in a fixed size ring
+    buffer allocated when the channel is created. This makes it much faster
+    when a lot of messages need to be exchanged between the threads.
+
+    As the channel is bounded, pushing a message into it may need to wait
+    until there is space for it. All the operations come in 3 variants: the
+    ones which don't wait at all, e.g. TryPush(), the ones which wait for no
+    longer than the given timeout, e.g. PushTimeout(), and the ones which wait
+    for as long as necessary, e.g. Push(). The waiting threads spin for a short
+    time before blocking, as the other thread is typically going to pop or
+    push a message very soon, and the duration of spinning adapts to the
+    actual behaviour of the program.
+
+    Batch functions such as PushBatch() and PopBatch() can be used to reduce
+    the overhead of waking up the other thread even further.
+
+    Notice that this class can only be used by one producer thread and one
+    consumer thread at any given time. Use wxMPMCChannel if more threads need
+    to push or pop messages concurrently.
+
+    Example:
+    @code
+    wxSPSCChannel<Sample> channel(4096);
+
+    // In the acquisition thread:
+    channel.Push(sample);
+
+    // In the processing thread:
+    Sample samples[256];
+    for ( ;; ) {
+        const size_t count = channel.PopBatch(samples, WXSIZEOF(samples));
+        ... process the samples ...
+    }
+    @endcode
+
+    @tparam T
+        The type of the messages, which must be movable (or copyable).
+
+    @since 3.3.2
+
+    @nolibrary
+    @category{threading}
+
+    @see wxMPMCChannel, wxMessageQueue
+*/
+template <typename T>
+class wxSPSCChannel<T>
+{
+public:
+    /**
+        Create a channel able to hold the given number of messages.
+
+        The capacity is rounded up to the next power of 2.
+    */
+    explicit wxSPSCChannel(size_t capacity);
+
+    /**
+        Destroys the channel and all the messages still remaining in it.
+    */
+    ~wxSPSCChannel();
+
+    /**
+        Return the capacity of the channel.
+    */
+    size_t GetCapacity() const;
+
+    /**
+        Return the number of messages in the channel.
+
+        If the channel is being used by other threads, the returned value may
+        become out of date by the time the caller uses it.
+    */
+    size_t GetSize() const;
+
+    /**
+        Return @true if the channel doesn't contain any messages.
+
+        The same remark as for GetSize() applies to this function.
+    */
+    bool IsEmpty() const;
+
+    /**
+        Return @false only if there was a fatal error in constructor.
+    */
+    bool IsOk() const;
+
+    /**
+        Push the message into the channel if it is not full.
+
+        Return @true if the message was pushed or @false if the channel is
+        full. In the latter case, the message is not moved from.
+    */
+    bool TryPush(const T& msg);
+
+    /// @overload
+    bool TryPush(T&& msg);
+
+    /**
+        Push the message into the channel, waiting until there is space for it.
+
+        Returns wxMSGQUEUE_NO_ERROR or wxMSGQUEUE_MISC_ERROR in case of an
+        unexpected error.
+    */
+    wxMessageQueueError Push(const T& msg);
+
+    /// @overload
+    wxMessageQueueError Push(T&& msg);
+
+    /**
+        Push the message, waiting no more than the given number of
+        milliseconds for space for it.
+
+        @param timeout
+            Timeout in milliseconds. If it is 0, this function doesn't wait at
+            all, just as TryPush(). If it is -1, it waits indefinitely, just as
+            Push().
+        @param msg
+            The message to push.
+        @return wxMSGQUEUE_NO_ERROR if the message was pushed,
+            wxMSGQUEUE_TIMEOUT if the channel remained full until the timeout
+            expiration or wxMSGQUEUE_MISC_ERROR in case of an unexpected error.
+    */
+    wxMessageQueueError PushTimeout(long timeout, const T& msg);
+
+    /// @overload
+    wxMessageQueueError PushTimeout(long timeout, T&& msg);
+
+    /**
+        Push as many of the given messages as possible without waiting.
+
+        Returns the number of the messages pushed, which may be less than
+        @a count (and even 0) if the channel doesn't have enough space.
+    */
+    size_t TryPushBatch(const T* msgs, size_t count);
+
+    /**
+        Push all the given messages, waiting for space for them if necessary.
+    */
+    wxMessageQueueError PushBatch(const T* msgs, size_t count);
+
+    /**
+        Pop a message from the channel if it is not empty.
+
+        Return @true if a message was popped or @false if the channel is
+        empty.
+    */
+    bool TryPop(T& msg);
+
+    /**
+        Pop a message from the channel, waiting until one is available.
+    */
+    wxMessageQueueError Pop(T& msg);
+
+    /**
+        Pop a message, waiting no more than the given number of milliseconds
+        for one to become available.
+
+        The @a timeout parameter and the return value have the same meaning as
+        for PushTimeout().
+    */
+    wxMessageQueueError PopTimeout(long timeout, T& msg);
+
+    /**
+        Pop up to @a maxCount messages without waiting.
+
+        Returns the number of messages popped.
+    */
+    size_t TryPopBatch(T* msgs, size_t maxCount);
+
+    /**
+        Wait until at least one message becomes available and pop up to
+        @a maxCount messages.
+
+        Returns the number of messages popped, which can be 0 only if an
+        unexpected error occurred.
+    */
+    size_t PopBatch(T* msgs, size_t maxCount);
+};
+
+/**
+    wxMPMCChannel is a bounded channel for passing messages between any number
+    of producer and consumer threads.
+
+    This class has exactly the same API as wxSPSCChannel, please see its
+    documentation, but, unlike it, can be used by any number of threads
+    concurrently. It is still lock-free and doesn't allocate memory after
+    creation, but is slightly slower than wxSPSCChannel, so the latter should
+    be preferred when there is only a single producer and single consumer.
+
+    @tparam T
+        The type of the messages, which must be movable (or copyable).
+
+    @since 3.3.2
+
+    @nolibrary
+    @category{threading}
+
+    @see wxSPSCChannel, wxMessageQueue
+*/
+template <typename T>
+class wxMPMCChannel<T>
+{
+public:
+    /**
+        Create a channel able to hold the given number of messages.
+
+        The capacity is rounded up to the next power of 2.
+    */
+    explicit wxMPMCChannel(size_t capacity);
+
+    /**
+        Destroys the channel and all the messages still remaining in it.
+    */
+    ~wxMPMCChannel();
+
+    /// See wxSPSCChannel::GetCapacity().
+    size_t GetCapacity() const;
+
+    /// See wxSPSCChannel::GetSize().
+    size_t GetSize() const;
+
+    /// See wxSPSCChannel::IsEmpty().
+    bool IsEmpty() const;
+
+    /// See wxSPSCChannel::IsOk().
+    bool IsOk() const;
+
+    /// See wxSPSCChannel::TryPush().
+    bool TryPush(const T& msg);
+
+    /// @overload
+    bool TryPush(T&& msg);
+
+    /// See wxSPSCChannel::Push().
+    wxMessageQueueError Push(const T& msg);
+
+    /// @overload
+    wxMessageQueueError Push(T&& msg);
+
+    /// See wxSPSCChannel::PushTimeout().
+    wxMessageQueueError PushTimeout(long timeout, const T& msg);
+
+    /// @overload
+    wxMessageQueueError PushTimeout(long timeout, T&& msg);
+
+    /**
+        See wxSPSCChannel::TryPushBatch().
+
+        Notice that the messages pushed by the other producers concurrently
+        may be interleaved with the messages of the batch.
+    */
+    size_t TryPushBatch(const T* msgs, size_t count);
+
+    /// See wxSPSCChannel::PushBatch().
+    wxMessageQueueError PushBatch(const T* msgs, size_t count);
+
+    /// See wxSPSCChannel::TryPop().
+    bool TryPop(T& msg);
+
+    /// See wxSPSCChannel::Pop().
+    wxMessageQueueError Pop(T& msg);
+
+    /// See wxSPSCChannel::PopTimeout().
+    wxMessageQueueError PopTimeout(long timeout, T& msg);
+
+    /// See wxSPSCChannel::TryPopBatch().
+    size_t TryPopBatch(T* msgs, size_t maxCount);
+
+    /// See wxSPSCChannel::PopBatch().
+    size_t PopBatch(T* msgs, size_t maxCount);
+};
@@ -109,6 +109,42 @@ public:
     */
     void AddNotifier(wxDataViewModelNotifier* notifier);
 
+    /**
+        Start a batch of changes to the model.
+
+        All the notifications, such as ItemAdded() or ItemChanged(), sent
+        until the matching call to EndBatch() may be processed lazily by the
+        controls associated with this model. For example, the generic version
+        of wxDataViewCtrl doesn't sort the changed items nor refresh them
+        individually, but does it only once when the batch ends, which is much
+        faster when many items are added or changed at once.
+
+        Calls to this function may be nested and each of them must be
+        matched by a call to EndBatch().
+
+        Notice that ItemsAdded(), ItemsChanged() and ItemsDeleted() already
+        use a batch for all the items passed to them.
+
+        @since 3.3.2
+     */
+    void BeginBatch();
+
+    /**
+        End the batch of changes started by BeginBatch().
+
+        The associated controls are updated when the outermost batch ends.
+
+        @since 3.3.2
+     */
+    void EndBatch();
+
+    /**
+        Return @true if BeginBatch() was called without matching EndBatch().
+
+        @since 3.3.2
+     */
+    bool IsInBatch() const;
+
     /**
         Change the value of the given item and update the control to reflect
         it.
@@ -295,6 +331,55 @@ public:
     */
     virtual bool HasDefaultCompare() const;
 
+    /**
+        Override this to indicate that Compare() can be safely called from
+        multiple threads concurrently.
+
+        If this function returns @true, the generic implementation of
+        wxDataViewCtrl may sort large numbers of items using several worker
+        threads, which can be much faster. Notice that the default Compare()
+        implementation is not thread-safe as it copies wxVariant objects, so
+        this function should only be overridden if Compare() itself is
+        overridden too and doesn't modify any shared state.
+
+        The default implementation returns @false.
+
+        @since 3.3.2
+
+        @see Compare(), wxParallelSort()
+     */
+    virtual bool IsCompareThreadSafe() const;
+
+    /**
+        Override this to indicate that the default Compare() implementation is
+        used by this model.
+
+        If this function returns @true, the generic implementation of
+        wxDataViewCtrl doesn't call Compare() at all when sorting the items by
+        the value of a column, but retrieves all the values of this column
+        only once instead and compares them directly, which is much faster.
+        Moreover, sorting many items is then done in a worker thread, so that
+        the UI doesn't freeze while sorting them, with the items remaining in
+        their previous order until sorting finishes.
+
+        Notice that this is only done if all the values in the column have
+        the same type among the types handled by Compare() itself, i.e. not
+        by DoCompareValues(), and the model is sorted by the values of a
+        column.
+
+        The default implementation returns @false, as it can't know whether
+        Compare() is overridden in the derived class, so you need to override
+        this function to return @true to enable this optimization for your
+        model, including when using wxDataViewListStore directly or deriving
+        from it. Note that the model used by wxDataViewListCtrl by default
+        already does this.
+
+        @since 3.3.2
+
+        @see Compare(), IsCompareThreadSafe()
+     */
+    virtual bool UsesDefaultCompare() const;
+
     /**
         Return true if there is a value in the given column of this item.
 
@@ -1851,6 +1936,27 @@ public:
     */
     virtual void Resort() = 0;
 
+    /**
+        Called by owning model when the outermost batch of changes starts.
+
+        The notifications received until EndBatch() is called may be
+        processed lazily. Default implementation does nothing.
+
+        @see wxDataViewModel::BeginBatch()
+
+        @since 3.3.2
+    */
+    virtual void BeginBatch();
+
+    /**
+        Called by owning model when the outermost batch of changes ends.
+
+        Default implementation does nothing.
+
+        @since 3.3.2
+    */
+    virtual void EndBatch();
+
     /**
         Set owner of this notifier. Used internally.
     */
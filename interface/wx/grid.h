@@ -1732,9 +1732,10 @@ public:
         Get the attribute to use for the specified cell.
 
         If wxGridCellAttr::Any is used as @a kind value, this function combines
-        the attributes set for this cell using SetAttr() and those for its row
-        or column (set with SetRowAttr() or SetColAttr() respectively), with
-        the cell attribute having the highest precedence.
+        the attributes set for this cell using SetAttr(), for the block
+        containing it using SetBlockAttr() and those for its row or column (set
+        with SetRowAttr() or SetColAttr() respectively), with the cell
+        attribute having the highest precedence, followed by the block one.
 
         Notice that the caller must call DecRef() on the returned pointer if it
         is non-null. GetAttrPtr() method can be used to do this automatically.
@@ -1776,6 +1777,25 @@ public:
     /// Set attribute for the specified cell.
     virtual void SetAttr(wxGridCellAttr *attr, int row, int col);
 
+    /**
+        Set attribute for all cells of the specified block.
+
+        Unlike calling SetAttr() for all cells of the block, this function
+        uses the same, small, amount of memory independently of the block
+        size. If several blocks overlap, the attribute of the block set last
+        is used for the cells in their intersection and passing @NULL
+        attribute removes the attributes of the blocks previously set for the
+        cells of this block.
+
+        The block attributes are used for the cells which don't have their own
+        attribute set by SetAttr() or for the attribute properties not set in
+        the cell attribute, but take precedence over the row and column ones.
+
+        @since 3.3.2
+     */
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
+
     /// Set attribute for the specified row.
     virtual void SetRowAttr(wxGridCellAttr *attr, int row);
 
@@ -1943,6 +1963,209 @@ public:
     wxString GetCornerLabelValue() const;
 };
 
+/**
+    Types of the columns of wxGridColumnarTable.
+
+    @since 3.3.2
+ */
+enum wxGridColumnType
+{
+    /**
+        Column containing strings.
+
+        The strings are dictionary-encoded, i.e. each distinct string is
+        stored only once, which is very efficient for the columns containing
+        a limited number of distinct values.
+     */
+    wxGRID_COLUMN_STRING,
+
+    /**
+        Column containing 64-bit integer values.
+
+        The cells of this column use wxGRID_VALUE_NUMBER type.
+     */
+    wxGRID_COLUMN_INT,
+
+    /**
+        Column containing floating point values.
+
+        The cells of this column use wxGRID_VALUE_FLOAT type.
+     */
+    wxGRID_COLUMN_DOUBLE,
+
+    /**
+        Column containing boolean values.
+
+        The cells of this column use wxGRID_VALUE_BOOL type.
+     */
+    wxGRID_COLUMN_BOOL
+};
+
+/**
+    Data table storing typed values in memory column by column.
+
+    Unlike wxGridStringTable, which stores all values as strings, this class
+    stores the values of each column using the type of the column, see
+    wxGridColumnType. This uses much less memory, e.g. a cell of an integer
+    column takes just 8 bytes, and allows the renderers and editors for the
+    cells to use the values directly, without converting them from and to
+    strings, so this class is much more suitable for storing large amounts of
+    data in memory.
+
+    The values are stored in chunks of consecutive rows, which are allocated
+    only when a value is set in one of their cells and freed when all of them
+    become empty again, so large empty areas of the table take almost no
+    memory. However the chunks containing at least one value use the full
+    amount of memory for all of their cells.
+
+    The number of rows can be specified initially and changed later, while
+    the columns can be added with AppendColumn() or InsertColumn(). Inserting
+    or deleting the columns is fast, independently of the number of rows, as
+    each column is stored separately. The columns added by the base class
+    InsertCols() and AppendCols() functions are always string columns.
+
+    Example of using this class:
+    @code
+    wxGridColumnarTable* table = new wxGridColumnarTable(records.size());
+    table->AppendColumn(wxGRID_COLUMN_STRING, "City");
+    table->AppendColumn(wxGRID_COLUMN_INT, "Population");
+
+    for ( size_t n = 0; n < records.size(); n++ )
+    {
+        table->SetValue(n, 0, records[n].city);
+        table->SetValueAsInt64(n, 1, records[n].population);
+    }
+
+    grid->AssignTable(table);
+    @endcode
+
+    @since 3.3.2
+ */
+class wxGridColumnarTable : public wxGridTableBase
+{
+public:
+    /**
+        Default constructor creates an empty table.
+     */
+    wxGridColumnarTable();
+
+    /**
+        Constructor creating a table with the given number of rows but without
+        any columns.
+     */
+    explicit wxGridColumnarTable( int numRows );
+
+    /**
+        Add a new column of the given type at the end of the table.
+
+        All cells of the new column are empty.
+
+        @param type
+            The type of the values of the new column.
+        @param label
+            The label of the new column, if empty the default label, as
+            returned by wxGridTableBase::GetColLabelValue(), is used.
+     */
+    void AppendColumn( wxGridColumnType type,
+                       const wxString& label = wxString() );
+
+    /**
+        Insert a new column of the given type at the specified position.
+
+        This function is similar to AppendColumn() but allows to insert the
+        column at any position. It returns @false if the position is invalid.
+     */
+    bool InsertColumn( size_t pos,
+                       wxGridColumnType type,
+                       const wxString& label = wxString() );
+
+    /**
+        Return the type of the given column.
+     */
+    wxGridColumnType GetColumnType( int col ) const;
+
+    /**
+        Preallocate memory for the given number of rows.
+
+        Calling this function is optional, but avoids reallocations when
+        appending many rows to the table one by one.
+     */
+    void ReserveRows( size_t numRows );
+
+    /**
+        Make the given cell empty.
+
+        This is the same as calling SetValue() with an empty string.
+     */
+    void ClearCell( int row, int col );
+
+    /**
+        Get the value of a cell in an integer column.
+
+        This function allows to retrieve the values which can't be represented
+        by @c long, as returned by GetValueAsLong(), on the platforms where it
+        is a 32-bit type.
+
+        Returns 0 if the cell is empty.
+     */
+    wxLongLong_t GetValueAsInt64( int row, int col );
+
+    /**
+        Set the value of a cell in an integer column.
+
+        If the column is of another type, the value is converted to it.
+     */
+    void SetValueAsInt64( int row, int col, wxLongLong_t value );
+
+    virtual int GetNumberRows();
+    virtual int GetNumberCols();
+
+    /**
+        Return the value of the cell as a string.
+
+        Returns an empty string if the cell is empty.
+     */
+    virtual wxString GetValue( int row, int col );
+
+    /**
+        Set the value of the cell from a string.
+
+        The string is converted to the type of the column. If it is empty or
+        can't be converted, e.g. because it doesn't contain a number for an
+        integer column, the cell becomes empty.
+     */
+    virtual void SetValue( int row, int col, const wxString& s );
+
+    virtual bool IsEmptyCell( int row, int col );
+
+    virtual wxString GetTypeName( int row, int col );
+    virtual bool CanGetValueAs( int row, int col, const wxString& typeName );
+    virtual bool CanSetValueAs( int row, int col, const wxString& typeName );
+
+    virtual long GetValueAsLong( int row, int col );
+    virtual double GetValueAsDouble( int row, int col );
+    virtual bool GetValueAsBool( int row, int col );
+
+    virtual void SetValueAsLong( int row, int col, long value );
+    virtual void SetValueAsDouble( int row, int col, double value );
+    virtual void SetValueAsBool( int row, int col, bool value );
+
+    void Clear();
+    bool InsertRows( size_t pos = 0, size_t numRows = 1 );
+    bool AppendRows( size_t numRows = 1 );
+    bool DeleteRows( size_t pos = 0, size_t numRows = 1 );
+    bool InsertCols( size_t pos = 0, size_t numCols = 1 );
+    bool AppendCols( size_t numCols = 1 );
+    bool DeleteCols( size_t pos = 0, size_t numCols = 1 );
+
+    void SetRowLabelValue( int row, const wxString& );
+    void SetColLabelValue( int col, const wxString& );
+    void SetCornerLabelValue( const wxString& );
+    wxString GetRowLabelValue( int row );
+    wxString GetColLabelValue( int col );
+    wxString GetCornerLabelValue() const;
+};
+
 /**
     Represents coordinates of a grid cell.
 
@@ -2682,6 +2905,19 @@ public:
      */
     virtual void SetAttr(wxGridCellAttr* attr, int row, int col);
 
+    /**
+        Set attribute of all cells in the specified block.
+
+        By default this function is simply forwarded to
+        wxGridCellAttrProvider::SetBlockAttr().
+
+        The table takes ownership of @a attr, i.e. will call DecRef() on it.
+
+        @since 3.3.2
+     */
+    virtual void SetBlockAttr(wxGridCellAttr *attr,
+                              const wxGridBlockCoords& block);
+
     /**
         Set attribute of the specified row.
 
@@ -2864,6 +3100,34 @@ enum wxGridRenderStyle
                           wxGRID_DRAW_BOX_RECT
 };
 
+/**
+    Modes selecting the cells measured by wxGrid::AutoSizeColumns() and the
+    related functions.
+
+    @see wxGrid::SetAutoSizeMode()
+
+    @since 3.3.2
+ */
+enum wxGridAutoSizeMode
+{
+    /// Measure all cells of the row or column, this is the default.
+    wxGRID_AUTOSIZE_ALL,
+
+    /**
+        Measure only the cells which are currently visible.
+
+        If the grid window is not visible yet, this mode behaves in the same
+        way as wxGRID_AUTOSIZE_SAMPLE.
+     */
+    wxGRID_AUTOSIZE_VISIBLE,
+
+    /**
+        Measure the given number of cells uniformly distributed over the
+        entire row or column.
+     */
+    wxGRID_AUTOSIZE_SAMPLE
+};
+
 
 
 /**
@@ -4087,6 +4351,86 @@ public:
     */
     void AutoSizeRows(bool setAsMin = true);
 
+    /**
+        Selects the cells measured when auto-sizing the rows or columns.
+
+        By default, all cells of the row or column are measured by
+        AutoSizeColumn(), AutoSizeColumns() and the similar functions for the
+        rows, which may take a long time for the grids with many rows. This
+        function allows to measure only the cells currently visible on screen
+        or only a sample of the cells instead.
+
+        Notice that the cells spanning several rows or columns and the hidden
+        cells are handled in the same way in all modes and that
+        wxGridTableBase::CanMeasureColUsingSameAttr() optimization is still
+        used, if possible.
+
+        @param mode
+            The mode to use, see wxGridAutoSizeMode.
+        @param sampleSize
+            The number of cells to measure in wxGRID_AUTOSIZE_SAMPLE mode. Must
+            be positive.
+
+        @see SetAutoSizePercentile()
+
+        @since 3.3.2
+     */
+    void SetAutoSizeMode(wxGridAutoSizeMode mode, int sampleSize = 1000);
+
+    /**
+        Returns the mode set by SetAutoSizeMode().
+
+        @since 3.3.2
+     */
+    wxGridAutoSizeMode GetAutoSizeMode() const;
+
+    /**
+        Returns the sample size set by SetAutoSizeMode().
+
+        @since 3.3.2
+     */
+    int GetAutoSizeSampleSize() const;
+
+    /**
+        Sets the percentile of the cell extents used when auto-sizing.
+
+        By default, the rows and columns are auto-sized to fit their largest
+        cell, which corresponds to the percentile of 100. Using a smaller
+        value, e.g. 95, allows to ignore a few outliers that would otherwise
+        make the column much wider than necessary for most of its cells.
+
+        @param percentile
+            A value in 1..100 range.
+
+        @since 3.3.2
+     */
+    void SetAutoSizePercentile(int percentile);
+
+    /**
+        Returns the percentile set by SetAutoSizePercentile().
+
+        @since 3.3.2
+     */
+    int GetAutoSizePercentile() const;
+
+    /**
+        Returns the extent of the given, possibly multiline, text.
+
+        This function is used by the standard renderers to implement their
+        wxGridCellRenderer::GetBestSize() and may be used by the custom
+        renderers too. While the rows or columns are being auto-sized, it
+        remembers the extents of the strings it has already measured with the
+        given font, which makes auto-sizing the grids containing the same
+        values in many cells significantly faster.
+
+        The font of @a dc may be changed by this function.
+
+        @since 3.3.2
+     */
+    wxSize GetCellTextExtent(wxReadOnlyDC& dc,
+                             const wxFont& font,
+                             const wxString& text) const;
+
     /**
         Returns the cell fitting mode.
 
@@ -5966,6 +6310,51 @@ public:
     void RefreshBlock(int topRow, int leftCol,
                       int bottomRow, int rightCol);
 
+    /**
+        Redraw the given, not necessarily adjacent, cells.
+
+        This function is meant to be used when many individual cells change,
+        e.g. when their values are updated from a data feed. Unlike calling
+        RefreshBlock() for each of them, it doesn't refresh the cells
+        immediately but collects them and refreshes all the changed cells at
+        once slightly later, merging the adjacent ones together.
+
+        Nothing is done if this function is called between BeginBatch() and
+        EndBatch(), as the entire grid is refreshed by the latter anyhow.
+
+        @since 3.3.2
+     */
+    void RefreshCells(const wxGridCellCoordsVector& cells);
+
+    /**
+        Enable or disable caching the rendered grid contents.
+
+        When the render cache is enabled, the grid keeps a bitmap with the
+        contents of its cells area and only redraws the parts of it which
+        were explicitly refreshed, e.g. by RefreshCells() or RefreshBlock(),
+        or became visible due to scrolling. This makes repainting the grid
+        much faster when only a small number of its cells change, e.g. when
+        the grid shows frequently updated values, at the price of the memory
+        used by the bitmap.
+
+        Notice that when this option is enabled, the grid must be explicitly
+        refreshed whenever its appearance changes.
+
+        The render cache is disabled by default.
+
+        @since 3.3.2
+     */
+    void EnableRenderCache(bool enable = true);
+
+    /**
+        Return @true if the render cache is enabled.
+
+        @see EnableRenderCache()
+
+        @since 3.3.2
+     */
+    bool IsRenderCacheEnabled() const;
+
     /**
         Draws part or all of a wxGrid on a wxDC for printing or display.
 
@@ -6009,6 +6398,18 @@ public:
     */
     void SetAttr(int row, int col, wxGridCellAttr *attr);
 
+    /**
+        Sets the cell attributes for all cells in the specified block.
+
+        This is much more efficient than calling SetAttr() for all cells of a
+        big block, see wxGridCellAttrProvider::SetBlockAttr() for more details.
+
+        The grid takes ownership of the attribute pointer.
+
+        @since 3.3.2
+    */
+    void SetBlockAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr);
+
     /**
         Sets the cell attributes for all cells in the specified column.
 
@@ -6316,6 +6717,21 @@ protected:
     */
     int GetColLeft(int col) const;
 
+    /**
+        Returns the coordinate of the top border of the specified row.
+    */
+    int GetRowTop(int row) const;
+
+    /**
+        Returns the coordinate of the bottom border of the specified row.
+
+        This function, together with GetColRight(), should be used in the
+        derived classes instead of accessing @c m_rowBottoms and @c m_colRights
+        members directly, as they are not arrays indexed by row or column index
+        any longer.
+    */
+    int GetRowBottom(int row) const;
+
     /**
         Returns the minimal size for the given column.
 
@@ -204,6 +204,11 @@ public:
         pageHeight @endcode and less or equal to @c *pagebreak for the value of
         @a pagebreak on input.
 
+        Since wxWidgets 3.3.2, this function is only called for the cells
+        intersecting the current page, i.e. starting at or above @a pagebreak
+        and ending below @code *pagebreak - pageHeight @endcode, as the other
+        cells can't affect the page break position.
+
         @param pagebreak
             position in pixels of the pagebreak.
         @param pageHeight
@@ -480,6 +485,25 @@ public:
     */
     explicit wxHtmlContainerCell(wxHtmlContainerCell* parent);
 
+    /**
+        Returns @true if the children of this container are positioned by the
+        default layout algorithm.
+
+        Such containers can be laid out lazily, i.e. only the part of them
+        which is currently needed is laid out, without calling Layout() at
+        all.
+
+        The default implementation returns @false, as the derived classes may
+        override Layout() to position the children differently, but the
+        containers created by wxHTML itself, e.g. by
+        wxHtmlWinParser::OpenContainer(), return @true. A class deriving from
+        wxHtmlContainerCell which doesn't override Layout() may override this
+        function to return @true too, to benefit from the lazy layout.
+
+        @since 3.3.2
+     */
+    virtual bool CanLayoutChildrenLazily() const;
+
     /**
         Detach a child cell.
 
@@ -540,6 +564,32 @@ public:
     */
     void SetAlign(const wxHtmlTag& tag);
 
+    /**
+        Returns @true if some of the cells inside this container have not been
+        laid out yet.
+
+        This can only be the case if lazy layout is used, see
+        wxHtmlWindow::EnableLazyLayout().
+
+        @since 3.3.2
+    */
+    bool HasPendingLayout() const;
+
+    /**
+        Lay out some of the cells which have not been laid out yet.
+
+        This function is called by wxHtmlWindow in idle time when lazy layout
+        is used, but can also be called explicitly, e.g. in a loop until
+        HasPendingLayout() returns @false, to finish laying out the container.
+
+        @param maxCells
+            The maximal number of the nested containers to lay out.
+        @return @true if the size of this container changed.
+
+        @since 3.3.2
+    */
+    bool LayoutPending(int maxCells);
+
     /**
         Sets the container's @e horizontal alignment.
         During wxHtmlCell::Layout each line is aligned according to @a al value.
@@ -75,7 +75,7 @@ public:
         &quot; or '/' characters. (So the name of \<FONT SIZE=+2\> tag is "FONT"
         and name of \</table\> is "TABLE").
     */
-    wxString GetName() const;
+    const wxString& GetName() const;
 
     /**
         Returns the value of the parameter.
@@ -194,6 +194,37 @@ public:
     */
     bool AppendToPage(const wxString& source);
 
+    /**
+        Enable or disable lazy layout of the page contents.
+
+        By default, the entire page is laid out when it is loaded and every
+        time the window is resized, which may take noticeable time for very
+        long pages, e.g. big logs. When lazy layout is enabled, only the part
+        of the page shown in the window, with a margin of one page above and
+        below it, is laid out immediately, while the size of the rest of it is
+        estimated from its contents and it is laid out in idle time. The sizes
+        of the already laid out paragraphs are also remembered for the last
+        few window widths, so that resizing the window back to its previous
+        size doesn't require estimating them again.
+
+        Notice that when lazy layout is enabled, the positions of the cells
+        returned by GetInternalRepresentation() may be inexact until the
+        entire page is laid out, i.e. until
+        wxHtmlContainerCell::HasPendingLayout() returns @false.
+
+        @since 3.3.2
+    */
+    void EnableLazyLayout(bool enable = true);
+
+    /**
+        Returns @true if lazy layout is enabled.
+
+        @see EnableLazyLayout()
+
+        @since 3.3.2
+    */
+    bool IsLazyLayoutEnabled() const;
+
     /**
         Returns pointer to the top-level container.
 
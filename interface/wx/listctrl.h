@@ -507,6 +507,52 @@ public:
     */
     void EnableBellOnNoMatch(bool on = true);
 
+    /**
+        Enable or disable caching the items of a virtual list control.
+
+        By default, a virtual list control calls OnGetItemText() and the
+        other @c OnGetItemXXX() functions for the items every time it needs
+        to draw them. If the cache is enabled, the items are retrieved in pages
+        of consecutive items instead and kept in the cache until they're
+        invalidated by calling RefreshItem(), RefreshItems(), SetItemCount(),
+        Refresh() or InvalidateVirtualCache().
+
+        If @a prefetch is @true, the pages of items just before and after the
+        visible ones are also retrieved in background, so that they're already
+        available when the control is scrolled. In this case OnGetItemText(),
+        OnGetItemImage(), OnGetItemColumnImage() and OnGetItemIsChecked() may
+        be called from worker threads and so must be thread-safe. Notice that
+        OnGetItemAttr() is still only called from the main thread.
+
+        Moreover, when using prefetching, the derived class destructor must
+        call @c EnableVirtualCache(false) to cancel any pending background
+        requests and wait for the ones in progress to complete, as otherwise
+        they could call the virtual functions of a partially destroyed object.
+        For example:
+        @code
+        class MyListCtrl : public wxListCtrl
+        {
+        public:
+            ...
+
+            ~MyListCtrl()
+            {
+                EnableVirtualCache(false);
+            }
+
+        protected:
+            wxString OnGetItemText(long item, long column) const override;
+        };
+        @endcode
+
+        This function can only be used with the controls with @c wxLC_VIRTUAL
+        style and is currently only implemented in the generic version, it
+        does nothing in wxMSW, which has its own cache of the items.
+
+        @since 3.3.2
+    */
+    void EnableVirtualCache(bool enable = true, bool prefetch = false);
+
     /**
         Finish editing the label.
 
@@ -1036,6 +1082,18 @@ public:
      */
     bool IsVirtual() const;
 
+    /**
+        Discard all the items cached by a virtual list control.
+
+        This only needs to be called if the virtual cache was enabled with
+        EnableVirtualCache() and the items changed without calling any of the
+        functions invalidating the cache automatically, e.g. if the control
+        is going to be refreshed later.
+
+        @since 3.3.2
+    */
+    void InvalidateVirtualCache();
+
     /**
         Redraws the given @e item.
 
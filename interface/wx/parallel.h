@@ -0,0 +1,87 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/parallel.h
+// Purpose:     interface of parallel algorithms
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/** @addtogroup group_funcmacro_thread */
+///@{
+
+/**
+    Call the given function for all indices in the given range using multiple
+    threads.
+
+    The function @a func is called exactly once for each index in the range
+    from @a begin (included) to @a end (excluded). The range is split into
+    several chunks which are executed by the worker threads of the thread pool
+    and the current thread, and this function returns only once all of them
+    are done.
+
+    As @a func is called from multiple threads concurrently, it must not
+    modify any shared state without synchronization.
+
+    If @a func throws an exception, the exception is rethrown by this function
+    after all the chunks finish executing.
+
+    If @c wxUSE_THREADS is 0, or the pool has a single thread, or the pool is
+    not available because the library is not initialized yet, the function is
+    simply called for all indices in order in the current thread.
+
+    @param begin
+        The first index to call the function for.
+    @param end
+        One past the last index to call the function for.
+    @param func
+        Callable object taking a single @c size_t argument.
+    @param grainSize
+        Minimal number of indices processed by each chunk, this should be big
+        enough to make the overhead of executing a separate task for each
+        chunk negligible compared to the cost of calling @a func.
+    @param pool
+        The pool to use, if @NULL, the global pool returned by
+        wxThreadPool::GetIfAvailable() is used.
+
+    @since 3.3.2
+
+    @header{wx/parallel.h}
+ */
+template <typename F>
+void wxParallelFor(size_t begin, size_t end, const F& func,
+                   size_t grainSize = 1, wxThreadPool* pool = nullptr);
+
+/**
+    Sort the elements in the given range using multiple threads.
+
+    This function sorts the range in chunks, using a separate thread for each
+    of them, and then merges the sorted chunks. Small ranges are sorted in the
+    current thread.
+
+    The sort is stable and its result is deterministic, i.e. it is always the
+    same as the result of @c std::stable_sort() independently of the number of
+    threads used.
+
+    Notice that @a comp may be called from multiple threads concurrently and so
+    must not modify any shared state.
+
+    @param first
+        Random access iterator pointing to the start of the range.
+    @param last
+        Random access iterator pointing one past the end of the range.
+    @param comp
+        Comparator returning @true if its first argument is less than the
+        second one, as used by the standard library algorithms. If omitted,
+        @c std::less is used.
+    @param pool
+        The pool to use, if @NULL, the global pool returned by
+        wxThreadPool::GetIfAvailable() is used.
+
+    @since 3.3.2
+
+    @header{wx/parallel.h}
+ */
+template <typename RandomIt, typename Compare>
+void wxParallelSort(RandomIt first, RandomIt last, Compare comp,
+                    wxThreadPool* pool = nullptr);
+
+///@}
@@ -3053,6 +3053,17 @@ public:
     virtual void Move(const wxPoint& pt);
 
 protected:
+    /**
+        Called whenever children are added to or removed from this object.
+
+        The default implementation does nothing, wxRichTextParagraphLayoutBox
+        overrides it to discard the data it uses to find its paragraphs by
+        position quickly.
+
+        @since 3.3.2
+    */
+    virtual void OnChildrenChanged();
+
     wxRichTextObjectList    m_children;
 };
 
@@ -3086,6 +3097,8 @@ public:
 
     virtual bool GetRangeSize(const wxRichTextRange& range, wxSize& size, int& descent, wxDC& dc, wxRichTextDrawingContext& context, int flags, const wxPoint& position = wxPoint(0,0), const wxSize& parentSize = wxDefaultSize, wxArrayInt* partialExtents = nullptr) const;
 
+    virtual void CalculateRange(long start, long& end);
+
     virtual bool DeleteRange(const wxRichTextRange& range);
 
     virtual wxString GetTextForRange(const wxRichTextRange& range) const;
@@ -3630,6 +3643,47 @@ public:
     */
     bool IsDirty() const { return m_invalidRange != wxRICHTEXT_NONE; }
 
+    /**
+        Sets the vertical position below which the paragraphs needing layout
+        are not laid out by Layout().
+
+        The paragraphs below this position only have their height estimated
+        from the size of the already laid out ones and will be laid out by the
+        next call to Layout(). This is used by wxRichTextCtrl when lazy layout
+        is enabled, see wxRichTextCtrl::EnableLazyLayout().
+
+        @param y
+            The position in the coordinates of this object or -1, which is
+            the default, to lay out all paragraphs.
+
+        @since 3.3.2
+    */
+    void SetLazyLayoutLimit(int y);
+
+    /**
+        Returns the vertical position below which the paragraphs are not laid
+        out, or -1 if all of them are.
+
+        @since 3.3.2
+    */
+    int GetLazyLayoutLimit() const;
+
+    /**
+        Returns @true if some paragraphs were not laid out by the last call to
+        Layout() because they were below the lazy layout limit.
+
+        @since 3.3.2
+    */
+    bool HasPendingLayout() const;
+
+    /**
+        Returns the vertical position of the first paragraph which was not laid
+        out, or -1 if there is none.
+
+        @since 3.3.2
+    */
+    int GetPendingLayoutPosition() const;
+
     /**
         Returns the wxRichTextFloatCollector of this object.
     */
@@ -4535,7 +4589,7 @@ public:
 
     virtual bool DeleteRange(const wxRichTextRange& range);
 
-    virtual bool IsEmpty() const { return m_text.empty(); }
+    virtual bool IsEmpty() const { return GetText().empty(); }
 
     virtual bool CanMerge(wxRichTextObject* object, wxRichTextDrawingContext& context) const;
 
@@ -4572,12 +4626,29 @@ public:
     /**
         Returns the text.
     */
-    const wxString& GetText() const { return m_text; }
+    const wxString& GetText() const;
 
     /**
         Sets the text.
     */
-    void SetText(const wxString& text) { m_text = text; }
+    void SetText(const wxString& text);
+
+    /**
+        Inserts the text at the given position.
+
+        The position must be inside the range of this object or immediately
+        after its end.
+
+        Note that the text objects share their text with their copies, e.g.
+        the ones stored in the undo history, and only copy it when it is
+        modified, so inserting text in an object which is not shared doesn't
+        copy the existing text.
+
+        @return @false if the position is invalid.
+
+        @since 3.3.2
+    */
+    bool InsertText(long pos, const wxString& text);
 
 // Operations
 
@@ -4589,9 +4660,6 @@ public:
 
 private:
     bool DrawTabbedString(wxDC& dc, const wxRichTextAttr& attr, const wxRect& rect, wxString& str, wxCoord& x, wxCoord& y, bool selected);
-
-protected:
-    wxString    m_text;
 };
 
 /**
@@ -356,6 +356,35 @@ public:
     */
     void ForceDelayedLayout();
 
+    /**
+        Enables or disables lazy layout of the buffer.
+
+        By default, the entire buffer is laid out when it is loaded or
+        modified, which may take noticeable time for very long documents. When
+        lazy layout is enabled, only the paragraphs up to one page below the
+        visible part of the buffer are laid out immediately. The height of the
+        rest of them is estimated from the already laid out paragraphs and they
+        are laid out in idle time, with the scrollbar range being updated as
+        the layout progresses.
+
+        Notice that when lazy layout is enabled, the positions of the
+        paragraphs below the visible part of the buffer may be inexact until
+        wxRichTextParagraphLayoutBox::HasPendingLayout() returns @false. Call
+        ForceDelayedLayout() to finish laying out the entire buffer immediately.
+
+        @since 3.3.2
+    */
+    void EnableLazyLayout(bool enable = true);
+
+    /**
+        Returns @true if lazy layout is enabled.
+
+        @see EnableLazyLayout()
+
+        @since 3.3.2
+    */
+    bool IsLazyLayoutEnabled() const;
+
     /**
         Sets the text (normal) cursor.
     */
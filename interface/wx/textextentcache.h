@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/textextentcache.h
+// Purpose:     interface of wxTextExtentCache
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    wxTextExtentCache allows to configure the cache of the measured text
+    extents used by wxWidgets.
+
+    The results of wxDC::GetTextExtent(), wxDC::GetPartialTextExtents(),
+    wxWindow::GetTextExtent() and the related functions are stored in a
+    process-wide cache, keyed by the font, the scale of the DC or window and
+    the string itself, so that measuring the same strings again, as is
+    typically done by the controls such as wxGrid, wxListCtrl or wxHtmlWindow
+    every time they lay out their contents, doesn't require calling the
+    platform text measuring functions again. The cache keeps the most recently
+    used results and discards the least recently used ones when the memory
+    used by it exceeds the limit set by SetMaxMemory().
+
+    The cache is only used by the platforms using native text measuring, i.e.
+    wxMSW and wxGTK, and only for the native DCs. Just as the DCs themselves,
+    it can only be used from the main thread.
+
+    This class only contains static functions and can't be instantiated.
+
+    @since 3.3.2
+
+    @library{wxcore}
+    @category{dc}
+
+    @see wxDC::GetTextExtent(), wxWindow::GetTextExtent()
+*/
+class wxTextExtentCache
+{
+public:
+    /**
+        Statistics of the cache use returned by GetStats().
+    */
+    struct Stats
+    {
+        /// Number of the lookups which found the result in the cache.
+        unsigned long hits;
+
+        /// Number of the lookups which didn't find the result in the cache.
+        unsigned long misses;
+
+        /// Number of the entries removed to stay under the memory limit.
+        unsigned long evictions;
+
+        /// Current number of entries in the cache.
+        size_t entries;
+
+        /// Approximate amount of memory, in bytes, used by the entries.
+        size_t memoryUsed;
+
+        /**
+            Return the ratio of the hits to all the lookups.
+
+            Returns 0 if there were no lookups at all.
+        */
+        double GetHitRate() const;
+    };
+
+    /**
+        Set the maximal amount of memory used by the cache.
+
+        If the cache currently uses more memory than the new limit, the
+        least recently used entries are removed from it immediately.
+
+        The default limit is 4MiB.
+
+        @param bytes
+            The maximal amount of memory, in bytes, or 0 to disable the cache.
+    */
+    static void SetMaxMemory(size_t bytes);
+
+    /**
+        Return the maximal amount of memory used by the cache.
+
+        Returns 0 if the cache is disabled.
+    */
+    static size_t GetMaxMemory();
+
+    /**
+        Return the statistics of the cache use.
+
+        The statistics are accumulated since the program start or the last
+        call to ResetStats().
+    */
+    static Stats GetStats();
+
+    /**
+        Reset the hits, misses and evictions counters to 0.
+    */
+    static void ResetStats();
+
+    /**
+        Remove all the entries from the cache.
+
+        This may be useful to free the memory used by the cache or if the
+        text measuring results may have changed for some external reason,
+        e.g. because the system font configuration was modified.
+    */
+    static void Clear();
+};
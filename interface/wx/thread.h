@@ -594,6 +594,13 @@ enum wxCriticalSectionType
           initialized. In particular, it's safe to create global
           wxCriticalSection instances.
 
+    Under Unix systems, critical sections are implemented directly using
+    atomic operations and entering and leaving a critical section which is not
+    used by any other thread doesn't involve any function calls. If it is used
+    by another thread, the thread trying to enter it spins for a short time
+    before blocking, so critical sections are a good choice for protecting
+    the data which is only accessed for short periods of time.
+
     @see wxThread, wxCondition, wxCriticalSectionLocker
 */
 class wxCriticalSection
@@ -1563,7 +1570,22 @@ enum wxMutexType
     wxMUTEX_DEFAULT,
 
     /** Recursive mutex: don't use these ones with wxCondition. */
-    wxMUTEX_RECURSIVE
+    wxMUTEX_RECURSIVE,
+
+    /**
+        Normal non-recursive mutex spinning for a short time before blocking.
+
+        If the mutex is locked by another thread, Lock() first tries to
+        acquire it repeatedly for a short time before blocking on it. This is
+        more efficient for the mutexes which are held only for very short
+        periods of time, as blocking and waking up the thread is relatively
+        expensive, but wastes CPU time otherwise.
+
+        Under Windows this is the same as ::wxMUTEX_DEFAULT.
+
+        @since 3.3.2
+     */
+    wxMUTEX_ADAPTIVE
 };
 
 
@@ -1718,6 +1740,194 @@ public:
 
 
 
+/**
+    @class wxSharedMutex
+
+    A shared mutex can be locked either exclusively, by a single thread, or
+    in shared mode, by any number of threads at once.
+
+    This is also known as readers-writer lock and is typically used to protect
+    data which is read much more often than modified: the threads reading the
+    data lock the mutex in shared mode, using LockShared(), and can do it
+    concurrently, while the threads modifying it lock the mutex exclusively,
+    using Lock(), which waits until all the readers unlock it.
+
+    The threads waiting for an exclusive lock are preferred to the new readers
+    whenever this is supported by the platform, to avoid starving the
+    writers when the mutex is continuously locked by some readers.
+
+    Shared mutexes are not recursive, i.e. the thread owning the lock must not
+    try to lock the mutex again, in either mode.
+
+    It is recommended to use wxReadLocker and wxWriteLocker instead of calling
+    the locking functions of this class directly.
+
+    Example:
+    @code
+    wxSharedMutex s_mutex;
+    std::map<wxString, int> s_values;
+
+    int GetValue(const wxString& key)
+    {
+        wxReadLocker lock(s_mutex);
+
+        const auto it = s_values.find(key);
+        return it == s_values.end() ? 0 : it->second;
+    }
+
+    void SetValue(const wxString& key, int value)
+    {
+        wxWriteLocker lock(s_mutex);
+
+        s_values[key] = value;
+    }
+    @endcode
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxMutex, wxReadLocker, wxWriteLocker
+*/
+class wxSharedMutex
+{
+public:
+    /**
+        Default constructor.
+    */
+    wxSharedMutex();
+
+    /**
+        Destroys the mutex.
+
+        The mutex must not be locked when it is destroyed.
+    */
+    ~wxSharedMutex();
+
+    /**
+        Returns @true if the mutex was successfully initialized.
+    */
+    bool IsOk() const;
+
+    /**
+        Locks the mutex exclusively.
+
+        Blocks until no other thread holds the lock, either in shared or
+        exclusive mode.
+
+        @return One of: @c wxMUTEX_NO_ERROR, @c wxMUTEX_DEAD_LOCK.
+    */
+    wxMutexError Lock();
+
+    /**
+        Tries to lock the mutex exclusively without blocking.
+
+        @return One of: @c wxMUTEX_NO_ERROR, @c wxMUTEX_BUSY.
+    */
+    wxMutexError TryLock();
+
+    /**
+        Unlocks the mutex locked by Lock() or TryLock().
+
+        @return One of: @c wxMUTEX_NO_ERROR, @c wxMUTEX_UNLOCKED.
+    */
+    wxMutexError Unlock();
+
+    /**
+        Locks the mutex in shared mode.
+
+        Blocks only if another thread holds an exclusive lock or, possibly, is
+        waiting for it.
+
+        @return One of: @c wxMUTEX_NO_ERROR, @c wxMUTEX_DEAD_LOCK.
+    */
+    wxMutexError LockShared();
+
+    /**
+        Tries to lock the mutex in shared mode without blocking.
+
+        @return One of: @c wxMUTEX_NO_ERROR, @c wxMUTEX_BUSY.
+    */
+    wxMutexError TryLockShared();
+
+    /**
+        Unlocks the mutex locked by LockShared() or TryLockShared().
+
+        @return One of: @c wxMUTEX_NO_ERROR, @c wxMUTEX_UNLOCKED.
+    */
+    wxMutexError UnlockShared();
+};
+
+/**
+    @class wxReadLocker
+
+    This is a helper class locking wxSharedMutex in shared mode in its
+    constructor and unlocking it in its destructor.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxSharedMutex, wxWriteLocker
+*/
+class wxReadLocker
+{
+public:
+    /**
+        Locks the given mutex in shared mode.
+
+        Call IsOk() to check if the mutex was successfully locked.
+    */
+    explicit wxReadLocker(wxSharedMutex& mutex);
+
+    /**
+        Unlocks the mutex if it was successfully locked in the constructor.
+    */
+    ~wxReadLocker();
+
+    /**
+        Returns @true if mutex was locked in the constructor.
+    */
+    bool IsOk() const;
+};
+
+/**
+    @class wxWriteLocker
+
+    This is a helper class locking wxSharedMutex exclusively in its
+    constructor and unlocking it in its destructor.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxSharedMutex, wxReadLocker
+*/
+class wxWriteLocker
+{
+public:
+    /**
+        Locks the given mutex exclusively.
+
+        Call IsOk() to check if the mutex was successfully locked.
+    */
+    explicit wxWriteLocker(wxSharedMutex& mutex);
+
+    /**
+        Unlocks the mutex if it was successfully locked in the constructor.
+    */
+    ~wxWriteLocker();
+
+    /**
+        Returns @true if mutex was locked in the constructor.
+    */
+    bool IsOk() const;
+};
+
+
 // ============================================================================
 // Global functions/macros
 // ============================================================================
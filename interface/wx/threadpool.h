@@ -0,0 +1,339 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        wx/threadpool.h
+// Purpose:     interface of wxThreadPool and related classes
+// Author:      wxWidgets team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+/**
+    The type of the tasks executed by wxThreadPool.
+
+    Any callable object without parameters and returning @c void can be used
+    as a task.
+
+    @since 3.3.2
+ */
+typedef std::function<void()> wxTask;
+
+/**
+    Token used by the tasks to check if they should stop.
+
+    Tokens are created by wxCancellationSource and all the copies of a token
+    share the state of the source that created them, so they can be freely
+    copied and passed to the tasks.
+
+    Tasks running for a long time should periodically check IsCancelled() and
+    stop if it returns @true.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxCancellationSource, wxThreadPool
+ */
+class wxCancellationToken
+{
+public:
+    /**
+        Default constructor creates a token which can never be cancelled.
+     */
+    wxCancellationToken();
+
+    /**
+        Return @true if the source of this token has been cancelled.
+
+        This function can be called from any thread.
+     */
+    bool IsCancelled() const;
+
+    /**
+        Return @true if this token was created by wxCancellationSource.
+
+        Default-constructed tokens can never be cancelled.
+     */
+    bool CanBeCancelled() const;
+};
+
+/**
+    Object allowing to cancel the tasks using its tokens.
+
+    Example:
+    @code
+    wxCancellationSource source;
+    pool.Submit([token = source.GetToken()]() {
+        while ( !token.IsCancelled() ) {
+            ... do some work ...
+        }
+    });
+
+    // Later:
+    source.Cancel();
+    @endcode
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxCancellationToken, wxThreadPool
+ */
+class wxCancellationSource
+{
+public:
+    /**
+        Create a new, not cancelled, source.
+     */
+    wxCancellationSource();
+
+    /**
+        Request cancellation of all the tasks using tokens of this source.
+
+        This function can be called from any thread.
+     */
+    void Cancel();
+
+    /**
+        Return @true if Cancel() had been called.
+     */
+    bool IsCancelled() const;
+
+    /**
+        Return a new token associated with this source.
+     */
+    wxCancellationToken GetToken() const;
+};
+
+/**
+    Result of a task submitted to wxThreadPool.
+
+    Objects of this class are returned by wxThreadPool::Submit() and can be
+    used to wait until the task completes and retrieve its result. They can be
+    copied and all the copies refer to the same result.
+
+    @tparam T
+        The type of the result, which must be default-constructible, or
+        @c void.
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxThreadPool
+ */
+template <typename T>
+class wxFuture
+{
+public:
+    /**
+        Default constructor creates an invalid object.
+
+        Such objects can't be used, except for calling IsValid() on them.
+     */
+    wxFuture();
+
+    /**
+        Return @true if this object is associated with a task.
+     */
+    bool IsValid() const;
+
+    /**
+        Return @true if the task finished executing or was cancelled.
+
+        This function doesn't block.
+     */
+    bool IsReady() const;
+
+    /**
+        Return @true if the task was not executed because its token had been
+        cancelled before it could start.
+     */
+    bool IsCancelled() const;
+
+    /**
+        Wait until the task finishes executing.
+
+        If this function is called from a worker thread of wxThreadPool, it
+        executes the other pending tasks while waiting, so it's safe to wait
+        for the tasks submitted from inside another task.
+     */
+    void Wait() const;
+
+    /**
+        Wait until the task finishes executing, but for no more than the
+        given number of milliseconds.
+
+        Return @true if the task has finished or @false on timeout.
+     */
+    bool WaitTimeout(unsigned long milliseconds) const;
+
+    /**
+        Wait for the task to finish and return its result.
+
+        If the task threw an exception, this function rethrows it.
+
+        If the task was cancelled, the default-constructed value is returned.
+     */
+    const T& Get() const;
+};
+
+/**
+    Pool of worker threads executing the tasks.
+
+    Using a thread pool avoids the overhead of creating a new thread for each
+    background operation and, if the same pool is used by the entire
+    application, oversubscribing the CPU cores.
+
+    Each worker thread has its own queue of tasks and the tasks posted from the
+    worker threads themselves are added to it, while the tasks posted from the
+    other threads are added to a shared queue. When the worker doesn't have
+    any tasks in its own queue, it takes them from the shared queue or steals
+    them from the queues of the other workers.
+
+    Most applications should use the global pool returned by Get(), but it's
+    also possible to create pools with a specific number of threads.
+
+    Example of computing something in background and showing the result in
+    the main thread:
+    @code
+    wxThreadPool::Get().SubmitThen(
+        [path]() { return ComputeChecksum(path); },
+        [this](const wxString& checksum) { m_text->SetValue(checksum); },
+        this
+    );
+    @endcode
+
+    @since 3.3.2
+
+    @library{wxbase}
+    @category{threading}
+
+    @see wxFuture, wxCancellationToken, wxThread
+ */
+class wxThreadPool
+{
+public:
+    /**
+        Create a new thread pool.
+
+        @param numThreads
+            Number of worker threads to create. If it is 0, as by default,
+            the number of CPUs (as returned by wxThread::GetCPUCount()) is
+            used.
+     */
+    explicit wxThreadPool(int numThreads = 0);
+
+    /**
+        Destroy the pool.
+
+        Waits until all the tasks posted to it complete before returning.
+     */
+    ~wxThreadPool();
+
+    /**
+        Return the global thread pool.
+
+        This pool has as many threads as there are CPUs. It is created when
+        this function is called for the first time and destroyed when the
+        library is shut down.
+
+        This function must not be called after the library shutdown started,
+        it asserts and executes all the tasks synchronously in the calling
+        thread if it is. Use GetIfAvailable() in the code which can be
+        executed at that time.
+     */
+    static wxThreadPool& Get();
+
+    /**
+        Return the global thread pool if it can be used or @NULL otherwise.
+
+        This function returns @NULL if it is called before the library is
+        initialized or after it started shutting down. It is useful in the
+        code which can be executed at any time and can fall back to doing its
+        work in the current thread if the pool is not available.
+     */
+    static wxThreadPool* GetIfAvailable();
+
+    /**
+        Return the pool of the current thread, if it is a worker thread of a
+        thread pool, or @NULL otherwise.
+     */
+    static wxThreadPool* GetCurrent();
+
+    /**
+        Return the number of worker threads.
+     */
+    int GetThreadCount() const;
+
+    /**
+        Return the number of tasks posted to this pool which haven't finished
+        executing yet.
+     */
+    size_t GetUnfinishedCount() const;
+
+    /**
+        Post a task for execution in one of the worker threads.
+
+        If the task throws an exception, wxApp::OnUnhandledException() is
+        called.
+
+        This function can be called from any thread.
+     */
+    void Post(wxTask task);
+
+    /**
+        Post a task for execution and return an object which can be used for
+        retrieving its result.
+
+        @param func
+            Callable object without parameters, returning either @c void or a
+            value of a default-constructible type.
+        @param token
+            Optional cancellation token: if it is cancelled before the task
+            starts executing, @a func is not called at all.
+     */
+    template <typename F>
+    wxFuture<R> Submit(F func,
+                       const wxCancellationToken& token = wxCancellationToken());
+
+    /**
+        Execute a function in a worker thread and then pass its result to
+        another function executed in the main thread.
+
+        @param func
+            Callable object without parameters, executed in a worker thread.
+        @param continuation
+            Callable object taking the value returned by @a func, or no
+            parameters at all if @a func returns @c void, executed in the
+            main thread.
+        @param handler
+            The object used to execute the continuation using
+            wxEvtHandler::CallAfter(). If it is @NULL, ::wxTheApp is used.
+            Notice that this object must remain alive until the continuation
+            is called.
+        @param token
+            Optional cancellation token: if it is cancelled, neither @a func
+            nor @a continuation are called (if they hadn't been called yet).
+     */
+    template <typename F, typename C>
+    void SubmitThen(F func,
+                    C continuation,
+                    wxEvtHandler* handler = nullptr,
+                    const wxCancellationToken& token = wxCancellationToken());
+
+    /**
+        Wait until all the tasks posted to this pool complete.
+
+        This function must not be called from the worker threads of this
+        pool.
+     */
+    void WaitAll();
+
+    /**
+        Execute a single pending task in the current thread.
+
+        Return @false if there were no pending tasks.
+     */
+    bool RunPendingTask();
+};
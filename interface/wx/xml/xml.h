@@ -572,6 +572,51 @@ struct wxXmlParseError
 };
 
 
+/**
+    @class wxXmlParseHandler
+
+    Base class for the objects processing the elements of an XML document
+    while it is being loaded.
+
+    An object of a class deriving from this one can be passed to
+    wxXmlDocument::Load() to process the elements as soon as they are parsed.
+    This is useful for loading big documents, as the elements which were
+    already processed can be removed from the document immediately, so that
+    the entire tree never needs to be kept in memory.
+
+    @since 3.3.2
+
+    @library{wxxml}
+    @category{xml}
+*/
+class wxXmlParseHandler
+{
+public:
+    /// Default constructor.
+    wxXmlParseHandler();
+
+    /// Trivial but virtual destructor.
+    virtual ~wxXmlParseHandler();
+
+    /**
+        Called when the element has been parsed.
+
+        This function is called after parsing the end tag of the element, so
+        the node has all of its attributes and children, and it is still
+        attached to its parent at this time. Note that the ancestors of the
+        node are only partially parsed yet, i.e. they don't have any children
+        following this node.
+
+        @param node
+            The element node, never @NULL.
+        @return
+            @true if the node is not needed any more, in which case it is
+            removed from the document and deleted, or @false to keep it.
+    */
+    virtual bool OnElementEnd(wxXmlNode* node) = 0;
+};
+
+
 /**
     @class wxXmlDocument
 
@@ -857,6 +902,18 @@ public:
     bool Load(wxInputStream& stream, int flags = wxXMLDOC_NONE,
               wxXmlParseError* err = nullptr);
 
+    /**
+        Like Load(wxInputStream&, int, wxXmlParseError*) but calls the given
+        handler for every element as soon as it is parsed.
+
+        The handler may process the elements during loading and remove the ones
+        it doesn't need any more from the document, see wxXmlParseHandler.
+
+        @since 3.3.2
+    */
+    bool Load(wxInputStream& stream, wxXmlParseHandler& handler,
+              int flags = wxXMLDOC_NONE, wxXmlParseError* err = nullptr);
+
     /**
         Saves XML tree creating a file named with given string.
 
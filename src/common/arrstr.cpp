@@ -16,6 +16,7 @@
 
 
 #include "wx/arrstr.h"
+#include "wx/parallel.h"
 #include "wx/scopedarray.h"
 #include "wx/wxcrt.h"
 
@@ -72,6 +73,8 @@ int wxArrayString::Index(const wxString& str, bool bCase, bool bFromEnd) const
 
 void wxArrayString::Sort(CompareFunction function)
 {
+    // Don't use wxParallelSort() here as the user-defined comparison function
+    // is not necessarily safe to call from multiple threads.
     std::sort(begin(), end(),
               [function](const wxString& s1, const wxString& s2)
               {
@@ -84,11 +87,11 @@ void wxArrayString::Sort(bool reverseOrder)
 {
     if (reverseOrder)
     {
-        std::sort(begin(), end(), std::greater<wxString>());
+        wxParallelSort(begin(), end(), std::greater<wxString>());
     }
     else
     {
-        std::sort(begin(), end());
+        wxParallelSort(begin(), end());
     }
 }
 
@@ -467,6 +470,7 @@ void wxArrayString::Sort(CompareFunction compareFunction)
 {
     wxCHECK_RET( !m_autoSort, wxT("can't use this method with sorted arrays") );
 
+    // As above, don't call the user-defined function from multiple threads.
     std::sort(m_pItems, m_pItems + m_nCount,
                 wxSortPredicateAdaptor(compareFunction));
 }
@@ -496,9 +500,9 @@ void wxArrayString::Sort(CompareFunction2 compareFunction)
 void wxArrayString::Sort(bool reverseOrder)
 {
     if ( reverseOrder )
-        std::sort(m_pItems, m_pItems + m_nCount, std::greater<wxString>());
+        wxParallelSort(m_pItems, m_pItems + m_nCount, std::greater<wxString>());
     else // normal sort
-        std::sort(m_pItems, m_pItems + m_nCount);
+        wxParallelSort(m_pItems, m_pItems + m_nCount);
 }
 
 bool wxArrayString::operator==(const wxArrayString& a) const
@@ -142,6 +142,7 @@ bool wxDataViewModelNotifier::ItemsChanged( const wxDataViewItemArray &items )
 
 wxDataViewModel::wxDataViewModel()
 {
+    m_batchCount = 0;
 }
 
 wxDataViewModel::~wxDataViewModel()
@@ -202,6 +203,9 @@ bool wxDataViewModel::ItemsAdded( const wxDataViewItem &parent, const wxDataView
 {
     bool ret = true;
 
+    // Process all the items at once.
+    BeginBatch();
+
     wxDataViewModelNotifiers::iterator iter;
     for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
     {
@@ -210,6 +214,8 @@ bool wxDataViewModel::ItemsAdded( const wxDataViewItem &parent, const wxDataView
             ret = false;
     }
 
+    EndBatch();
+
     return ret;
 }
 
@@ -217,6 +223,9 @@ bool wxDataViewModel::ItemsDeleted( const wxDataViewItem &parent, const wxDataVi
 {
     bool ret = true;
 
+    // Process all the items at once.
+    BeginBatch();
+
     wxDataViewModelNotifiers::iterator iter;
     for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
     {
@@ -225,6 +234,8 @@ bool wxDataViewModel::ItemsDeleted( const wxDataViewItem &parent, const wxDataVi
             ret = false;
     }
 
+    EndBatch();
+
     return ret;
 }
 
@@ -232,6 +243,9 @@ bool wxDataViewModel::ItemsChanged( const wxDataViewItemArray &items )
 {
     bool ret = true;
 
+    // Process all the items at once.
+    BeginBatch();
+
     wxDataViewModelNotifiers::iterator iter;
     for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
     {
@@ -240,6 +254,8 @@ bool wxDataViewModel::ItemsChanged( const wxDataViewItemArray &items )
             ret = false;
     }
 
+    EndBatch();
+
     return ret;
 }
 
@@ -313,10 +329,42 @@ void wxDataViewModel::Resort()
     }
 }
 
+void wxDataViewModel::BeginBatch()
+{
+    if ( m_batchCount++ )
+        return;
+
+    wxDataViewModelNotifiers::iterator iter;
+    for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
+    {
+        wxDataViewModelNotifier* notifier = *iter;
+        notifier->BeginBatch();
+    }
+}
+
+void wxDataViewModel::EndBatch()
+{
+    wxCHECK_RET( m_batchCount > 0, "EndBatch() without matching BeginBatch()" );
+
+    if ( --m_batchCount )
+        return;
+
+    wxDataViewModelNotifiers::iterator iter;
+    for (iter = m_notifiers.begin(); iter != m_notifiers.end(); ++iter)
+    {
+        wxDataViewModelNotifier* notifier = *iter;
+        notifier->EndBatch();
+    }
+}
+
 void wxDataViewModel::AddNotifier( wxDataViewModelNotifier *notifier )
 {
     m_notifiers.push_back( notifier );
     notifier->SetOwner( this );
+
+    // The new notifier must be in the same state as the existing ones.
+    if ( m_batchCount )
+        notifier->BeginBatch();
 }
 
 void wxDataViewModel::RemoveNotifier( wxDataViewModelNotifier *notifier )
@@ -326,6 +374,10 @@ void wxDataViewModel::RemoveNotifier( wxDataViewModelNotifier *notifier )
     {
         if ( *iter == notifier )
         {
+            // Don't leave the notifier in the middle of the batch.
+            if ( m_batchCount )
+                notifier->EndBatch();
+
             delete notifier;
             m_notifiers.erase(iter);
 
@@ -2457,6 +2509,21 @@ bool wxDataViewListStore::SetValueByRow( const wxVariant &value, unsigned int ro
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxDataViewListCtrl,wxDataViewCtrl);
 
+namespace
+{
+
+// The store used by wxDataViewListCtrl: as it's created by the control itself,
+// we know that it doesn't override Compare() and so can be sorted faster.
+class wxDataViewListCtrlStore : public wxDataViewListStore
+{
+public:
+    wxDataViewListCtrlStore() = default;
+
+    virtual bool UsesDefaultCompare() const override { return true; }
+};
+
+} // anonymous namespace
+
 wxDataViewListCtrl::wxDataViewListCtrl()
 {
 }
@@ -2480,7 +2547,7 @@ bool wxDataViewListCtrl::Create( wxWindow *parent, wxWindowID id,
     if ( !wxDataViewCtrl::Create( parent, id, pos, size, style, validator ) )
         return false;
 
-    wxDataViewListStore *store = new wxDataViewListStore;
+    wxDataViewListStore *store = new wxDataViewListCtrlStore;
     AssociateModel( store );
     store->DecRef();
 
@@ -21,10 +21,354 @@
 #ifndef WX_PRECOMP
     #include "wx/dc.h"
     #include "wx/window.h"
+    #include "wx/hashmap.h"
+    #include "wx/module.h"
 #endif //WX_PRECOMP
 
 #include "wx/private/textmeasure.h"
 
+#include "wx/textextentcache.h"
+
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+// ============================================================================
+// wxTextExtentCache implementation
+// ============================================================================
+
+namespace
+{
+
+// The cache used by default is big enough for a few tens of thousands of short
+// strings, which is enough for the typical lists, grids or documents.
+const size_t DEFAULT_CACHE_MEMORY = 4*1024*1024;
+
+// The extents of a single line of text.
+struct TextExtent
+{
+    wxCoord width = 0,
+            height = 0,
+            descent = 0,
+            externalLeading = 0;
+};
+
+// This is a simple LRU cache: the entries are stored in a list ordered by the
+// time of their last use, with the most recently used ones at the front, and
+// are indexed by a hash map referencing them.
+//
+// Notice that it is not thread-safe and, as the DCs themselves, can only be
+// used from the main thread: the entries contain wxFont objects, which can't
+// be copied or destroyed from the other threads.
+class TextExtentCacheImpl
+{
+public:
+    static TextExtentCacheImpl& Get()
+    {
+        static TextExtentCacheImpl s_cache;
+        return s_cache;
+    }
+
+    bool IsEnabled() const { return m_maxMemory != 0; }
+
+    bool FindExtent(const wxTextMeasureCacheContext& context,
+                    const wxString& text,
+                    TextExtent& extent)
+    {
+        const Entry* const entry = Find(KeyRef(context, NO_PARTIAL, text));
+        if ( !entry )
+            return false;
+
+        extent = entry->extent;
+        return true;
+    }
+
+    void StoreExtent(const wxTextMeasureCacheContext& context,
+                     const wxFont& font,
+                     const wxString& text,
+                     const TextExtent& extent)
+    {
+        Entry* const entry = Add(context, NO_PARTIAL, font, text);
+        if ( entry )
+            entry->extent = extent;
+    }
+
+    bool FindPartialExtents(const wxTextMeasureCacheContext& context,
+                            double scaleX,
+                            const wxString& text,
+                            wxArrayInt& widths)
+    {
+        const Entry* const entry = Find(KeyRef(context, scaleX, text));
+        if ( !entry )
+            return false;
+
+        widths.assign(entry->widths.begin(), entry->widths.end());
+        return true;
+    }
+
+    void StorePartialExtents(const wxTextMeasureCacheContext& context,
+                             double scaleX,
+                             const wxFont& font,
+                             const wxString& text,
+                             const wxArrayInt& widths)
+    {
+        Entry* const entry = Add(context, scaleX, font, text);
+        if ( entry )
+        {
+            // The entry may already exist and contain the widths, don't
+            // account for them twice.
+            const size_t oldSize = entry->widths.size()*sizeof(int);
+            entry->size -= oldSize;
+            m_stats.memoryUsed -= oldSize;
+
+            entry->widths.assign(widths.begin(), widths.end());
+            entry->size += widths.size()*sizeof(int);
+            m_stats.memoryUsed += widths.size()*sizeof(int);
+
+            Shrink();
+        }
+    }
+
+    void SetMaxMemory(size_t bytes)
+    {
+        m_maxMemory = bytes;
+        Shrink();
+    }
+
+    size_t GetMaxMemory() const
+    {
+        return m_maxMemory;
+    }
+
+    wxTextExtentCache::Stats GetStats()
+    {
+        return m_stats;
+    }
+
+    void ResetStats()
+    {
+        m_stats.hits =
+        m_stats.misses =
+        m_stats.evictions = 0;
+    }
+
+    void Clear()
+    {
+        m_index.clear();
+        m_entries.clear();
+
+        m_stats.entries =
+        m_stats.memoryUsed = 0;
+    }
+
+private:
+    TextExtentCacheImpl() : m_maxMemory(DEFAULT_CACHE_MEMORY) { }
+
+    // Special value of the partial extents scale used for the entries storing
+    // the extent of the entire string.
+    static constexpr double NO_PARTIAL = -1.0;
+
+    // The key used for the lookups: it doesn't own the string to avoid copying
+    // it, the index keys point to the string stored in the entry itself.
+    struct KeyRef
+    {
+        KeyRef(const wxTextMeasureCacheContext& context_,
+               double partialScale_,
+               const wxString& text_)
+            : context(context_),
+              partialScale(partialScale_),
+              text(&text_)
+        {
+        }
+
+        wxTextMeasureCacheContext context;
+        double partialScale;
+        const wxString* text;
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const KeyRef& key) const
+        {
+            size_t h = wxStringHash()(*key.text);
+            h = h*31 + std::hash<const void*>()(key.context.font);
+            h = h*31 + std::hash<double>()(key.context.scaleX);
+            h = h*31 + std::hash<double>()(key.partialScale);
+            return h;
+        }
+    };
+
+    struct KeyEqual
+    {
+        bool operator()(const KeyRef& key1, const KeyRef& key2) const
+        {
+            return key1.context == key2.context &&
+                   key1.partialScale == key2.partialScale &&
+                   *key1.text == *key2.text;
+        }
+    };
+
+    struct Entry
+    {
+        Entry(const wxTextMeasureCacheContext& context,
+              double partialScale,
+              const wxFont& font_,
+              const wxString& text_)
+            : font(font_),
+              text(text_),
+              key(context, partialScale, text)
+        {
+        }
+
+        // Keep the font alive to ensure that its ref data pointer, used in the
+        // key, is not reused for another font.
+        wxFont font;
+
+        wxString text;
+        KeyRef key;
+
+        TextExtent extent;
+        std::vector<int> widths;
+
+        // Approximate amount of memory used by this entry.
+        size_t size = 0;
+    };
+
+    using Entries = std::list<Entry>;
+    using Index = std::unordered_map<KeyRef, Entries::iterator, KeyHash, KeyEqual>;
+
+    const Entry* Find(const KeyRef& key)
+    {
+        const auto it = m_index.find(key);
+        if ( it == m_index.end() )
+        {
+            m_stats.misses++;
+            return nullptr;
+        }
+
+        m_stats.hits++;
+
+        // Move the entry to the front as it's the most recently used one now.
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+
+        return &*it->second;
+    }
+
+    // Add a new entry or return the existing one with the same key.
+    Entry* Add(const wxTextMeasureCacheContext& context,
+               double partialScale,
+               const wxFont& font,
+               const wxString& text)
+    {
+        if ( !m_maxMemory )
+            return nullptr;
+
+        const auto it = m_index.find(KeyRef(context, partialScale, text));
+        if ( it != m_index.end() )
+            return &*it->second;
+
+        m_entries.emplace_front(context, partialScale, font, text);
+
+        Entry& entry = m_entries.front();
+        m_index.emplace(entry.key, m_entries.begin());
+
+        // Account for the list and hash map nodes in addition to the entry.
+        entry.size = sizeof(Entry) + 6*sizeof(void*) + sizeof(KeyRef) +
+                        text.length()*sizeof(wxStringCharType);
+
+        m_stats.entries++;
+        m_stats.memoryUsed += entry.size;
+
+        Shrink();
+
+        return &entry;
+    }
+
+    // Remove the least recently used entries until we're under the limit.
+    void Shrink()
+    {
+        // Never remove the most recently added entry, even if it's too big.
+        while ( m_stats.memoryUsed > m_maxMemory && m_stats.entries > 1 )
+        {
+            const Entry& entry = m_entries.back();
+
+            m_stats.memoryUsed -= entry.size;
+            m_stats.entries--;
+            m_stats.evictions++;
+
+            m_index.erase(entry.key);
+            m_entries.pop_back();
+        }
+
+        if ( !m_maxMemory && m_stats.entries )
+        {
+            m_index.clear();
+            m_entries.clear();
+
+            m_stats.entries =
+            m_stats.memoryUsed = 0;
+        }
+    }
+
+
+    Entries m_entries;
+    Index m_index;
+
+    size_t m_maxMemory;
+
+    wxTextExtentCache::Stats m_stats;
+
+    wxDECLARE_NO_COPY_CLASS(TextExtentCacheImpl);
+};
+
+} // anonymous namespace
+
+/* static */
+void wxTextExtentCache::SetMaxMemory(size_t bytes)
+{
+    TextExtentCacheImpl::Get().SetMaxMemory(bytes);
+}
+
+/* static */
+size_t wxTextExtentCache::GetMaxMemory()
+{
+    return TextExtentCacheImpl::Get().GetMaxMemory();
+}
+
+/* static */
+wxTextExtentCache::Stats wxTextExtentCache::GetStats()
+{
+    return TextExtentCacheImpl::Get().GetStats();
+}
+
+/* static */
+void wxTextExtentCache::ResetStats()
+{
+    TextExtentCacheImpl::Get().ResetStats();
+}
+
+/* static */
+void wxTextExtentCache::Clear()
+{
+    TextExtentCacheImpl::Get().Clear();
+}
+
+// Module ensuring that the fonts kept alive by the cache are destroyed before
+// the library is shut down.
+class wxTextExtentCacheModule : public wxModule
+{
+public:
+    wxTextExtentCacheModule() = default;
+
+    bool OnInit() override { return true; }
+    void OnExit() override { wxTextExtentCache::Clear(); }
+
+private:
+    wxDECLARE_DYNAMIC_CLASS(wxTextExtentCacheModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxTextExtentCacheModule, wxModule);
+
 // ============================================================================
 // wxTextMeasureBase implementation
 // ============================================================================
@@ -59,16 +403,126 @@ wxFont wxTextMeasureBase::GetFont() const
                           : m_dc->GetFont();
 }
 
-void wxTextMeasureBase::CallGetTextExtent(const wxString& string,
+bool wxTextMeasureBase::CanUseCache()
+{
+    if ( m_cacheChecked )
+        return m_useCache;
+
+    m_cacheChecked = true;
+
+    // We can't know what affects the results of a non-native DC.
+    if ( m_useDCImpl || !TextExtentCacheImpl::Get().IsEnabled() )
+        return false;
+
+    const wxFont font = GetFont();
+    if ( !font.IsOk() )
+        return false;
+
+    m_cacheContext.font = font.GetRefData();
+
+    m_useCache = true;
+
+    return true;
+}
+
+const wxTextMeasureCacheContext& wxTextMeasureBase::GetCacheContext()
+{
+    // Querying the DC properties, and especially its PPI, is not free, so
+    // only do it when we really need to look up or store something.
+    if ( m_cacheContextComplete )
+        return m_cacheContext;
+
+    m_cacheContextComplete = true;
+
+    if ( m_win )
+    {
+        m_cacheContext.forWindow = true;
+        m_cacheContext.scaleX =
+        m_cacheContext.scaleY = m_win->GetDPIScaleFactor();
+    }
+    else // m_dc
+    {
+        // Native DCs may return the extents in logical coordinates, so take
+        // everything affecting them into account.
+        double userX, userY, logicalX, logicalY;
+        m_dc->GetUserScale(&userX, &userY);
+        m_dc->GetLogicalScale(&logicalX, &logicalY);
+
+        m_cacheContext.scaleX = userX*logicalX;
+        m_cacheContext.scaleY = userY*logicalY;
+        m_cacheContext.contentScale = m_dc->GetContentScaleFactor();
+        m_cacheContext.ppi = m_dc->GetPPI().y;
+    }
+
+    return m_cacheContext;
+}
+
+bool wxTextMeasureBase::GetCachedTextExtent(const wxString& string,
+                                            wxCoord *width,
+                                            wxCoord *height,
+                                            wxCoord *descent,
+                                            wxCoord *externalLeading)
+{
+    if ( !CanUseCache() )
+        return false;
+
+    TextExtent extent;
+    if ( !TextExtentCacheImpl::Get().FindExtent(GetCacheContext(), string, extent) )
+        return false;
+
+    *width = extent.width;
+    *height = extent.height;
+    if ( descent )
+        *descent = extent.descent;
+    if ( externalLeading )
+        *externalLeading = extent.externalLeading;
+
+    return true;
+}
+
+void wxTextMeasureBase::MeasureTextExtent(const wxString& string,
                                           wxCoord *width,
                                           wxCoord *height,
                                           wxCoord *descent,
                                           wxCoord *externalLeading)
 {
     if ( m_useDCImpl )
+    {
         m_dc->GetTextExtent(string, width, height, descent, externalLeading);
-    else
+        return;
+    }
+
+    if ( !CanUseCache() )
+    {
         DoGetTextExtent(string, width, height, descent, externalLeading);
+        return;
+    }
+
+    // Always get all the values to be able to return them from the cache
+    // later, even if they're not needed right now.
+    TextExtent extent;
+    DoGetTextExtent(string, &extent.width, &extent.height,
+                    &extent.descent, &extent.externalLeading);
+
+    TextExtentCacheImpl::Get().StoreExtent(GetCacheContext(), GetFont(),
+                                           string, extent);
+
+    *width = extent.width;
+    *height = extent.height;
+    if ( descent )
+        *descent = extent.descent;
+    if ( externalLeading )
+        *externalLeading = extent.externalLeading;
+}
+
+void wxTextMeasureBase::CallGetTextExtent(const wxString& string,
+                                          wxCoord *width,
+                                          wxCoord *height,
+                                          wxCoord *descent,
+                                          wxCoord *externalLeading)
+{
+    if ( !GetCachedTextExtent(string, width, height, descent, externalLeading) )
+        MeasureTextExtent(string, width, height, descent, externalLeading);
 }
 
 void wxTextMeasureBase::GetTextExtent(const wxString& string,
@@ -95,9 +549,13 @@ void wxTextMeasureBase::GetTextExtent(const wxString& string,
         return;
     }
 
+    // Don't set up the DC for measuring if the result is already known.
+    if ( GetCachedTextExtent(string, width, height, descent, externalLeading) )
+        return;
+
     MeasuringGuard guard(*this);
 
-    CallGetTextExtent(string, width, height, descent, externalLeading);
+    MeasureTextExtent(string, width, height, descent, externalLeading);
 }
 
 int wxTextMeasureBase::GetEmptyLineHeight()
@@ -216,11 +674,28 @@ bool wxTextMeasureBase::GetPartialTextExtents(const wxString& text,
     if ( text.empty() )
         return true;
 
+    const bool useCache = CanUseCache();
+    if ( useCache &&
+            TextExtentCacheImpl::Get().FindPartialExtents(GetCacheContext(), scaleX,
+                                                          text, widths) )
+    {
+        return true;
+    }
+
     MeasuringGuard guard(*this);
 
     widths.Add(0, text.length());
 
-    return DoGetPartialTextExtents(text, widths, scaleX);
+    if ( !DoGetPartialTextExtents(text, widths, scaleX) )
+        return false;
+
+    if ( useCache )
+    {
+        TextExtentCacheImpl::Get().StorePartialExtents(GetCacheContext(), scaleX,
+                                                       GetFont(), text, widths);
+    }
+
+    return true;
 }
 
 // ----------------------------------------------------------------------------
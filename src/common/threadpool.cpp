@@ -0,0 +1,572 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        src/common/threadpool.cpp
+// Purpose:     wxThreadPool implementation
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ============================================================================
+// declarations
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+// for compilers that support precompilation, includes "wx.h".
+#include "wx/wxprec.h"
+
+
+#include "wx/threadpool.h"
+
+#if wxUSE_THREADS
+
+#ifndef WX_PRECOMP
+    #include "wx/app.h"
+    #include "wx/log.h"
+    #include "wx/module.h"
+#endif // WX_PRECOMP
+
+#include "wx/stopwatch.h"
+
+#include "wx/private/safecall.h"
+
+#include <algorithm>
+#include <deque>
+
+// ----------------------------------------------------------------------------
+// globals
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The pool and the index of the current worker thread, if any.
+thread_local wxThreadPool* gs_currentPool = nullptr;
+thread_local int gs_currentIndex = -1;
+
+// The global pool returned by wxThreadPool::Get().
+std::atomic<wxThreadPool*> gs_defaultPool(nullptr);
+
+// Set when the global pool is destroyed during the library shutdown.
+std::atomic<bool> gs_defaultPoolDestroyed(false);
+
+wxCriticalSection gs_csDefaultPool;
+
+} // anonymous namespace
+
+// ----------------------------------------------------------------------------
+// private classes
+// ----------------------------------------------------------------------------
+
+// Queue of the tasks associated with a single worker thread.
+//
+// The worker itself takes the tasks from the back of its queue, as they're
+// the most recently posted ones and so are more likely to be still in the
+// cache, while the other workers "steal" the tasks from the front of it when
+// they don't have anything else to do.
+class wxThreadPool::WorkQueue
+{
+public:
+    WorkQueue() = default;
+
+    void Push(wxTask& task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        m_tasks.push_back(std::move(task));
+    }
+
+    bool PopBack(wxTask& task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_tasks.empty() )
+            return false;
+
+        task = std::move(m_tasks.back());
+        m_tasks.pop_back();
+
+        return true;
+    }
+
+    bool PopFront(wxTask& task)
+    {
+        wxCriticalSectionLocker lock(m_cs);
+
+        if ( m_tasks.empty() )
+            return false;
+
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+
+        return true;
+    }
+
+private:
+    wxCriticalSection m_cs;
+    std::deque<wxTask> m_tasks;
+
+    wxDECLARE_NO_COPY_CLASS(WorkQueue);
+};
+
+class wxThreadPool::Worker : public wxThread
+{
+public:
+    explicit Worker(wxThreadPool& pool)
+        : wxThread(wxTHREAD_JOINABLE),
+          m_pool(pool)
+    {
+        m_index = -1;
+    }
+
+    void SetIndex(int index) { m_index = index; }
+
+protected:
+    virtual void* Entry() override
+    {
+        m_pool.WorkerMain(m_index);
+
+        return nullptr;
+    }
+
+private:
+    wxThreadPool& m_pool;
+    int m_index;
+
+    wxDECLARE_NO_COPY_CLASS(Worker);
+};
+
+// ----------------------------------------------------------------------------
+// module cleaning up the global pool
+// ----------------------------------------------------------------------------
+
+class wxThreadPoolModule : public wxModule
+{
+public:
+    wxThreadPoolModule()
+    {
+        // The pool threads must be destroyed before the threads support is
+        // cleaned up.
+        AddDependency("wxThreadModule");
+    }
+
+    virtual bool OnInit() override
+    {
+        // The library may be initialized again after being shut down.
+        gs_defaultPoolDestroyed = false;
+
+        return true;
+    }
+
+    virtual void OnExit() override
+    {
+        gs_defaultPoolDestroyed = true;
+
+        delete gs_defaultPool.exchange(nullptr);
+    }
+
+    wxDECLARE_DYNAMIC_CLASS(wxThreadPoolModule);
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxThreadPoolModule, wxModule);
+
+// ============================================================================
+// wxPrivate::FutureStateBase implementation
+// ============================================================================
+
+namespace wxPrivate
+{
+
+FutureStateBase::FutureStateBase()
+    : m_ready(false),
+      m_cancelled(false),
+      m_cond(m_mutex)
+{
+}
+
+FutureStateBase::~FutureStateBase()
+{
+}
+
+void FutureStateBase::MarkReady()
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_ready.store(true, std::memory_order_release);
+
+    m_cond.Broadcast();
+
+    // The worker threads waiting for this state wait for the new tasks of
+    // their pool too, so they need to be woken up separately.
+    for ( size_t n = 0; n < m_waitingPools.size(); n++ )
+        m_waitingPools[n]->WakeUpWaiting();
+}
+
+void FutureStateBase::MarkCancelled()
+{
+    m_cancelled = true;
+
+    MarkReady();
+}
+
+void FutureStateBase::Wait()
+{
+    if ( IsReady() )
+        return;
+
+    if ( wxThreadPool* const pool = wxThreadPool::GetCurrent() )
+    {
+        // Blocking a worker thread could result in a deadlock if the task we
+        // wait for is still in a queue and all the other workers are blocked
+        // too, so execute the pending tasks instead of just waiting.
+        while ( !IsReady() )
+        {
+            if ( pool->RunPendingTask() )
+                continue;
+
+            {
+                wxMutexLocker lock(m_mutex);
+                m_waitingPools.push_back(pool);
+            }
+
+            pool->WaitForTaskOrReady(*this);
+
+            {
+                wxMutexLocker lock(m_mutex);
+                m_waitingPools.erase(std::find(m_waitingPools.begin(),
+                                               m_waitingPools.end(),
+                                               pool));
+            }
+        }
+
+        return;
+    }
+
+    wxMutexLocker lock(m_mutex);
+
+    while ( !IsReady() )
+    {
+        if ( m_cond.Wait() != wxCOND_NO_ERROR )
+        {
+            wxFAIL_MSG( "waiting for the future failed" );
+            return;
+        }
+    }
+}
+
+bool FutureStateBase::WaitTimeout(unsigned long milliseconds)
+{
+    if ( IsReady() )
+        return true;
+
+    wxMutexLocker lock(m_mutex);
+
+    const wxMilliClock_t waitUntil = wxGetLocalTimeMillis() + milliseconds;
+    while ( !IsReady() )
+    {
+        const wxCondError rc = m_cond.WaitTimeout(milliseconds);
+        if ( rc == wxCOND_NO_ERROR )
+            continue;
+
+        wxCHECK_MSG( rc == wxCOND_TIMEOUT, false, "waiting for the future failed" );
+
+        const wxMilliClock_t now = wxGetLocalTimeMillis();
+        if ( now >= waitUntil )
+            return IsReady();
+
+        milliseconds = (waitUntil - now).ToLong();
+    }
+
+    return true;
+}
+
+} // namespace wxPrivate
+
+// ============================================================================
+// wxThreadPool implementation
+// ============================================================================
+
+// ----------------------------------------------------------------------------
+// ctor and dtor
+// ----------------------------------------------------------------------------
+
+wxThreadPool::wxThreadPool(NoThreadsTag)
+    : m_pending(0),
+      m_unfinished(0),
+      m_sleeping(0),
+      m_stopping(false),
+      m_condTask(m_mutex),
+      m_condDone(m_mutex)
+{
+    // Notice that we don't need any queues as the tasks are never queued when
+    // there are no workers.
+}
+
+wxThreadPool::wxThreadPool(int numThreads)
+    : wxThreadPool(NoThreadsTag())
+{
+    if ( numThreads <= 0 )
+    {
+        numThreads = wxThread::GetCPUCount();
+        if ( numThreads <= 0 )
+            numThreads = 1;
+    }
+
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        Worker* const worker = new Worker(*this);
+        if ( worker->Create() != wxTHREAD_NO_ERROR )
+        {
+            wxLogDebug("Failed to create thread pool worker thread.");
+            delete worker;
+            break;
+        }
+
+        worker->SetIndex(static_cast<int>(m_workers.size()));
+        m_workers.push_back(worker);
+    }
+
+    // One queue per worker and one more for the tasks posted from the other
+    // threads.
+    for ( size_t n = 0; n <= m_workers.size(); n++ )
+        m_queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue));
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+        m_workers[n]->Run();
+}
+
+wxThreadPool::~wxThreadPool()
+{
+    WaitAll();
+
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_stopping = true;
+
+        m_condTask.Broadcast();
+    }
+
+    for ( size_t n = 0; n < m_workers.size(); n++ )
+    {
+        m_workers[n]->Wait();
+        delete m_workers[n];
+    }
+}
+
+/* static */
+wxThreadPool& wxThreadPool::Get()
+{
+    if ( gs_defaultPoolDestroyed )
+    {
+        wxFAIL_MSG( "global thread pool can't be used after the library "
+                    "shutdown, use GetIfAvailable() instead" );
+
+        // Don't create a new pool which would never be destroyed, but use the
+        // one executing all the tasks synchronously in the current thread.
+        static wxThreadPool s_poolNoThreads{NoThreadsTag()};
+        return s_poolNoThreads;
+    }
+
+    wxThreadPool* pool = gs_defaultPool.load(std::memory_order_acquire);
+    if ( !pool )
+    {
+        wxCriticalSectionLocker lock(gs_csDefaultPool);
+
+        pool = gs_defaultPool.load(std::memory_order_acquire);
+        if ( !pool )
+        {
+            pool = new wxThreadPool;
+            gs_defaultPool.store(pool, std::memory_order_release);
+        }
+    }
+
+    return *pool;
+}
+
+/* static */
+wxThreadPool* wxThreadPool::GetIfAvailable()
+{
+    if ( !wxModule::AreInitialized() || gs_defaultPoolDestroyed )
+        return nullptr;
+
+    return &Get();
+}
+
+/* static */
+wxThreadPool* wxThreadPool::GetCurrent()
+{
+    return gs_currentPool;
+}
+
+// ----------------------------------------------------------------------------
+// tasks management
+// ----------------------------------------------------------------------------
+
+void wxThreadPool::Post(wxTask task)
+{
+    wxCHECK_RET( task, "can't post an empty task" );
+
+    m_unfinished++;
+
+    if ( m_workers.empty() )
+    {
+        // We couldn't create any threads, so execute the task synchronously
+        // rather than never executing it at all.
+        ExecuteTask(task);
+        return;
+    }
+
+    // Tasks posted by a worker go into its own queue, all the other ones go
+    // into the shared queue.
+    const int index = gs_currentPool == this ? gs_currentIndex
+                                             : GetThreadCount();
+
+    // Notice that the counter must be incremented before checking whether
+    // there are any sleeping workers, as they do it in the reverse order,
+    // to ensure that we never miss waking up a worker.
+    m_pending++;
+
+    m_queues[index]->Push(task);
+
+    if ( m_sleeping.load() > 0 )
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_condTask.Signal();
+    }
+}
+
+bool wxThreadPool::PopTask(int index, wxTask& task)
+{
+    const int numWorkers = GetThreadCount();
+
+    bool found = false;
+
+    // Start with our own queue, taking the most recently posted task.
+    if ( index != -1 )
+        found = m_queues[index]->PopBack(task);
+
+    // Then take the oldest task posted from outside.
+    if ( !found )
+        found = m_queues[numWorkers]->PopFront(task);
+
+    // Finally try stealing the oldest task from another worker, starting with
+    // the next one to avoid all workers trying to steal from the same one.
+    for ( int n = 1; !found && n <= numWorkers; n++ )
+    {
+        const int other = (index + n + numWorkers) % numWorkers;
+        if ( other != index )
+            found = m_queues[other]->PopFront(task);
+    }
+
+    if ( found )
+        m_pending--;
+
+    return found;
+}
+
+void wxThreadPool::ExecuteTask(wxTask& task)
+{
+    wxSafeCall(task);
+
+    // Destroy the task before signalling its completion to ensure that any
+    // objects captured by it are released by then.
+    task = wxTask();
+
+    if ( --m_unfinished == 0 )
+    {
+        wxMutexLocker lock(m_mutex);
+
+        m_condDone.Broadcast();
+    }
+}
+
+bool wxThreadPool::RunPendingTask()
+{
+    wxTask task;
+    if ( !PopTask(gs_currentPool == this ? gs_currentIndex : -1, task) )
+        return false;
+
+    ExecuteTask(task);
+
+    return true;
+}
+
+void wxThreadPool::WaitAll()
+{
+    wxCHECK_RET( gs_currentPool != this,
+                 "can't wait for all tasks from a worker thread" );
+
+    wxMutexLocker lock(m_mutex);
+
+    while ( m_unfinished.load() )
+        m_condDone.Wait();
+}
+
+void wxThreadPool::WorkerMain(int index)
+{
+    gs_currentPool = this;
+    gs_currentIndex = index;
+
+    wxTask task;
+    for ( ;; )
+    {
+        if ( PopTask(index, task) )
+        {
+            ExecuteTask(task);
+            continue;
+        }
+
+        wxMutexLocker lock(m_mutex);
+
+        m_sleeping++;
+
+        while ( !m_pending.load() && !m_stopping )
+            m_condTask.Wait();
+
+        m_sleeping--;
+
+        if ( m_stopping && !m_pending.load() )
+            break;
+    }
+
+    gs_currentPool = nullptr;
+    gs_currentIndex = -1;
+}
+
+void wxThreadPool::WaitForTaskOrReady(const wxPrivate::FutureStateBase& state)
+{
+    wxMutexLocker lock(m_mutex);
+
+    // Counting this thread as sleeping ensures that Post() wakes it up.
+    m_sleeping++;
+
+    while ( !m_pending.load() && !state.IsReady() && !m_stopping )
+        m_condTask.Wait();
+
+    m_sleeping--;
+}
+
+void wxThreadPool::WakeUpWaiting()
+{
+    wxMutexLocker lock(m_mutex);
+
+    m_condTask.Broadcast();
+}
+
+/* static */
+void wxThreadPool::CallInMainThread(wxEvtHandler* handler, wxTask func)
+{
+    if ( !handler )
+        handler = wxTheApp;
+
+    wxCHECK_RET( handler, "no handler to call the continuation on" );
+
+    handler->CallAfter(func);
+}
+
+#endif // wxUSE_THREADS
@@ -44,12 +44,19 @@
 #include "wx/imaglist.h"
 #include "wx/headerctrl.h"
 #include "wx/dnd.h"
+#include "wx/parallel.h"
 #include "wx/selstore.h"
 #include "wx/stopwatch.h"
 #include "wx/weakref.h"
 #include "wx/generic/private/markuptext.h"
 #include "wx/generic/private/rowheightcache.h"
 #include "wx/generic/private/widthcalc.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #if wxUSE_ACCESSIBILITY
 #include "wx/private/markupparser.h"
 #endif // wxUSE_ACCESSIBILITY
@@ -72,11 +79,11 @@ static const int PADDING_RIGHTLEFT = 3;
 namespace
 {
 
-// Flags for Walker() function defined below.
+// Flags for GetRowByItem() function.
 enum WalkFlags
 {
-    Walk_All,               // Visit all items.
-    Walk_ExpandedOnly       // Visit only expanded items.
+    Walk_All,               // Consider all items.
+    Walk_ExpandedOnly       // Consider only expanded items.
 };
 
 // The column is either the index of the column to be used for sorting or one
@@ -495,7 +502,8 @@ public:
     wxDataViewTreeNode(wxDataViewTreeNode *parent, const wxDataViewItem& item)
         : m_parent(parent),
           m_item(item),
-          m_branchData(nullptr)
+          m_branchData(nullptr),
+          m_indexInParent(0)
     {
     }
 
@@ -539,6 +547,49 @@ public:
         m_branchData->RemoveChild(index);
     }
 
+    // returns position of the given child node in children list
+    unsigned GetChildIndex(const wxDataViewTreeNode* node) const
+    {
+        wxASSERT( m_branchData && node->m_parent == this );
+
+        // Avoid updating the offsets of the following children if we don't
+        // need them.
+        const unsigned index = node->m_indexInParent;
+        if ( index < m_branchData->validRowOffsets &&
+                m_branchData->children[index] == node )
+            return index;
+
+        m_branchData->UpdateRowOffsets();
+
+        wxASSERT( m_branchData->children[node->m_indexInParent] == node );
+
+        return node->m_indexInParent;
+    }
+
+    // returns the number of rows between this node and the given child
+    int GetChildRowOffset(const wxDataViewTreeNode* node) const
+    {
+        return m_branchData->rowOffsets[GetChildIndex(node)] + 1;
+    }
+
+    // returns the child containing the given row, which is relative to this
+    // node and must be less than GetSubTreeCount(), in its subtree and
+    // adjusts the row to be relative to this child
+    wxDataViewTreeNode* FindChildByRow(int& row) const
+    {
+        wxASSERT( m_branchData && !m_branchData->children.empty() );
+
+        m_branchData->UpdateRowOffsets();
+
+        const std::vector<int>& offsets = m_branchData->rowOffsets;
+        const unsigned index =
+            std::upper_bound(offsets.begin(), offsets.end(), row)
+                - offsets.begin() - 1;
+
+        row -= offsets[index];
+        return m_branchData->children[index];
+    }
+
     // returns position of child node for given item in children list or wxNOT_FOUND
     int FindChildByItem(const wxDataViewItem& item) const
     {
@@ -645,11 +696,26 @@ public:
         wxASSERT( m_branchData->subTreeCount >= 0 );
 
         if( m_parent )
+        {
+            // The rows of all our siblings following us have changed.
+            m_parent->m_branchData->InvalidateRowOffsets(
+                m_parent->GetChildIndex(this) + 1);
+
             m_parent->ChangeSubTreeCount(num);
+        }
     }
 
     void Resort(wxDataViewMainWindow* window);
 
+    // Sort the children of this node using the given order synchronously,
+    // without resorting their own children, unlike Resort().
+    void SortChildren(wxDataViewMainWindow* window, const SortOrder& sortOrder);
+
+    // Reorder the children of this node as returned by a background sort,
+    // i.e. put the child with the index order[n] in the n-th position.
+    void SetChildrenOrder(const std::vector<unsigned>& order,
+                          const SortOrder& sortOrder);
+
     // Should be called after changing the item value to update its position in
     // the control if necessary.
     void PutInSortOrder(wxDataViewMainWindow* window)
@@ -658,6 +724,22 @@ public:
             m_parent->PutChildInSortOrder(window, this);
     }
 
+    // Append the child without looking for its correct position, which must
+    // be done later by calling either Resort() or PutChildrenInModelOrder().
+    void AppendChildUnsorted(wxDataViewMainWindow* window,
+                             wxDataViewTreeNode* node);
+
+    // Forget the sort order of the children, so that the next call to
+    // Resort() sorts them again.
+    void InvalidateSortOrder()
+    {
+        if ( m_branchData )
+            m_branchData->sortOrder = SortOrder();
+    }
+
+    // Reorder the children to have the same order as in the model.
+    void PutChildrenInModelOrder(const wxDataViewModel* model);
+
 private:
     // Called by the child after it has been updated to put it in the right
     // place among its siblings, depending on the sort order.
@@ -678,18 +760,57 @@ private:
     {
         BranchNodeData()
             : open(false),
-              subTreeCount(0)
+              subTreeCount(0),
+              validRowOffsets(0)
         {
         }
 
         void InsertChild(wxDataViewTreeNode* node, unsigned index)
         {
             children.insert(children.begin() + index, node);
+            InvalidateRowOffsets(index);
         }
 
         void RemoveChild(unsigned index)
         {
             children.erase(children.begin() + index);
+            InvalidateRowOffsets(index);
+        }
+
+        // Must be called when the children order or the number of rows in
+        // the subtree of the child with the given index changes.
+        void InvalidateRowOffsets(unsigned index)
+        {
+            if ( index < validRowOffsets )
+                validRowOffsets = index;
+        }
+
+        // Recompute the invalidated row offsets. This is done lazily because
+        // many consecutive changes are typically done to the same node, e.g.
+        // when inserting many items into it.
+        void UpdateRowOffsets()
+        {
+            const unsigned count = children.size();
+            if ( validRowOffsets == count )
+                return;
+
+            rowOffsets.resize(count);
+
+            unsigned n = validRowOffsets;
+            int offset = n ? rowOffsets[n - 1] +
+                                children[n - 1]->GetSubTreeCount() + 1
+                           : 0;
+            for ( ; n < count; n++ )
+            {
+                wxDataViewTreeNode* const child = children[n];
+
+                rowOffsets[n] = offset;
+                child->m_indexInParent = n;
+
+                offset += child->GetSubTreeCount() + 1;
+            }
+
+            validRowOffsets = count;
         }
 
         // Child nodes. Note that this may be empty even if m_hasChildren in
@@ -707,9 +828,20 @@ private:
         // 0 for leaves and is the number of rows the subtree occupies for
         // branch nodes.
         int                  subTreeCount;
+
+        // Offsets of the first row of each child relative to the first row
+        // after this node, allowing to find the row of any child and the child
+        // containing the given row quickly. Only the first validRowOffsets
+        // elements of this vector are up to date.
+        std::vector<int>     rowOffsets;
+        unsigned             validRowOffsets;
     };
 
     BranchNodeData *m_branchData;
+
+    // Position of this node among its parent children, only valid if the
+    // parent row offsets are up to date.
+    unsigned m_indexInParent;
 };
 
 
@@ -740,16 +872,50 @@ public:
     }
     bool ValueChanged( const wxDataViewItem &item, unsigned int model_column );
     bool Cleared();
+    void BeginBatch() { m_batchCount++; }
+    void EndBatch();
+    bool IsInBatch() const { return m_batchCount > 0; }
     void Resort()
     {
+        if ( IsInBatch() )
+        {
+            m_batchResort = true;
+            return;
+        }
+
         ClearRowHeightCache();
 
         if (!IsVirtualList())
         {
+            // The pending sorts are not needed any more, we're going to sort
+            // everything again anyhow.
+            CancelBackgroundSorts();
+
             m_root->Resort(this);
         }
         UpdateDisplay();
     }
+
+    // Start sorting the children of the given node in a worker thread if
+    // possible and worth it and return true or just return false otherwise.
+    bool StartBackgroundSort(wxDataViewTreeNode* node,
+                             const SortOrder& sortOrder);
+
+    // Synchronously finish all the background sorts still in progress. This
+    // must be called before modifying the tree structure as it relies on the
+    // children being sorted in the current order.
+    void CompleteBackgroundSorts();
+
+    // Cancel all the background sorts without applying their results.
+    void CancelBackgroundSorts();
+
+    // Reordering the nodes changes the rows of the items, so these functions
+    // are used to remember the selected and current items before doing it and
+    // to restore them after it.
+    void SaveSelection(wxDataViewItemArray& selected,
+                       wxDataViewItem& current);
+    void RestoreSelection(const wxDataViewItemArray& selected,
+                          const wxDataViewItem& current);
     void ClearRowHeightCache()
     {
         if ( m_rowHeightCache )
@@ -894,8 +1060,15 @@ public:
                       WalkFlags flags = Walk_All ) const;
 
     wxDataViewTreeNode * GetTreeNodeByRow( unsigned int row ) const;
-    // We did not need this temporarily
-    // wxDataViewTreeNode * GetTreeNodeByItem( const wxDataViewItem & item );
+
+    // Returns the node for the given item if it's already in the tree.
+    wxDataViewTreeNode * GetTreeNodeByItem( const wxDataViewItem & item ) const;
+
+    // Must be called when a node is added to the tree or before deleting it
+    // (which removes the entire subtree of this node) to update the index
+    // used by GetTreeNodeByItem().
+    void OnTreeNodeAdded( wxDataViewTreeNode * node );
+    void OnTreeNodeDeleted( wxDataViewTreeNode * node );
 
     // Methods for building the mapping tree
     void BuildTree( wxDataViewModel  * model );
@@ -1066,6 +1239,33 @@ private:
     wxDataViewTreeNode * m_root;
     int m_count;
 
+    // Index of all the nodes in the tree by their items.
+    std::unordered_map<void*, wxDataViewTreeNode*> m_itemToNode;
+
+    // Nesting level of the model batches, see wxDataViewModel::BeginBatch().
+    int m_batchCount;
+
+    // Items whose children must be put in the right order at the end of the
+    // current batch and whether the entire tree must be resorted.
+    std::unordered_set<void*> m_batchParents;
+    bool m_batchResort;
+
+#if wxUSE_THREADS
+    // Background sort of the children of a node which is still in progress.
+    struct BackgroundSort
+    {
+        wxCancellationSource cancel;
+        SortOrder sortOrder;
+    };
+
+    std::unordered_map<wxDataViewTreeNode*, BackgroundSort> m_backgroundSorts;
+
+    // Called in the main thread when the background sort completes.
+    void ApplyBackgroundSort(wxDataViewTreeNode* node,
+                             const SortOrder& sortOrder,
+                             const std::vector<unsigned>& order);
+#endif // wxUSE_THREADS
+
     // This is the tree node under the cursor
     wxDataViewTreeNode * m_underMouse;
 
@@ -1102,6 +1302,10 @@ public:
         { return m_mainWindow->Cleared(); }
     virtual void Resort() override
         { m_mainWindow->Resort(); }
+    virtual void BeginBatch() override
+        { m_mainWindow->BeginBatch(); }
+    virtual void EndBatch() override
+        { m_mainWindow->EndBatch(); }
 
     wxDataViewMainWindow    *m_mainWindow;
 };
@@ -1849,6 +2053,170 @@ private:
     const SortOrder m_sortOrder;
 };
 
+// Minimal number of children of a node for sorting them in background.
+const size_t BACKGROUND_SORT_MIN_ITEMS = 50000;
+
+// Sort key used for sorting the items without calling the model: it contains
+// the value of the item in the sort column and uses the item ID as secondary
+// key, exactly as the default wxDataViewModel::Compare() does.
+template <typename T>
+struct KeySortItem
+{
+    T value;
+    wxUIntPtr id;
+    unsigned index;
+
+    bool operator<(const KeySortItem& other) const
+    {
+        if ( value < other.value )
+            return true;
+        if ( other.value < value )
+            return false;
+
+        return id < other.id;
+    }
+};
+
+// Fill the keys vector with the values returned by the given function from
+// the values of the items in the given column, which must all be of the
+// given type. Returns false if any of the items doesn't have the value of
+// this type.
+template <typename T, typename F>
+bool
+ExtractSortKeys(const wxDataViewModel* model,
+                const wxDataViewTreeNodes& nodes,
+                unsigned column,
+                const wxString& type,
+                const F& getKey,
+                std::vector< KeySortItem<T> >& keys)
+{
+    keys.reserve(nodes.size());
+
+    wxVariant value;
+    for ( size_t n = 0; n < nodes.size(); n++ )
+    {
+        const wxDataViewItem& item = nodes[n]->GetItem();
+        if ( !model->HasValue(item, column) )
+            return false;
+
+        model->GetValue(value, item, column);
+        if ( value.GetType() != type )
+            return false;
+
+        keys.push_back({getKey(value), wxPtrToUInt(item.GetID()), unsigned(n)});
+    }
+
+    return true;
+}
+
+// Helper of MakeKeySortFunction() for the keys of the given type.
+template <typename T, typename F>
+std::function<std::vector<unsigned>()>
+DoMakeKeySortFunction(const wxDataViewModel* model,
+                      const wxDataViewTreeNodes& nodes,
+                      const SortOrder& sortOrder,
+                      const wxString& type,
+                      const F& getKey)
+{
+    // Use shared_ptr as std::function must be copyable.
+    auto keys = std::make_shared< std::vector< KeySortItem<T> > >();
+    if ( !ExtractSortKeys(model, nodes, sortOrder.GetColumn(), type, getKey, *keys) )
+        return {};
+
+    const bool ascending = sortOrder.IsAscending();
+    return [keys, ascending]()
+    {
+        if ( ascending )
+        {
+            wxParallelSort(keys->begin(), keys->end(), std::less< KeySortItem<T> >());
+        }
+        else
+        {
+            wxParallelSort(keys->begin(), keys->end(),
+                           [](const KeySortItem<T>& k1, const KeySortItem<T>& k2)
+                           {
+                               return k2 < k1;
+                           });
+        }
+
+        std::vector<unsigned> order;
+        order.reserve(keys->size());
+        for ( const auto& key : *keys )
+            order.push_back(key.index);
+
+        return order;
+    };
+}
+
+// Return the function sorting the given nodes by the values in the column
+// used by the given sort order and returning their indices in sorted order.
+//
+// The values are retrieved from the model by this function itself, which
+// must be called from the main thread, but the returned function doesn't use
+// the model and so can be executed in any thread.
+//
+// This can only be done if the model uses the default Compare() and all the
+// values are of the same type supported by it, otherwise an empty function is
+// returned.
+std::function<std::vector<unsigned>()>
+MakeKeySortFunction(const wxDataViewModel* model,
+                    const wxDataViewTreeNodes& nodes,
+                    const SortOrder& sortOrder)
+{
+    if ( nodes.empty() || !sortOrder.UsesColumn() || !model->UsesDefaultCompare() )
+        return {};
+
+    const wxDataViewItem& first = nodes[0]->GetItem();
+    if ( !model->HasValue(first, sortOrder.GetColumn()) )
+        return {};
+
+    wxVariant value;
+    model->GetValue(value, first, sortOrder.GetColumn());
+
+    const wxString type = value.GetType();
+    if ( type == wxS("string") )
+    {
+        return DoMakeKeySortFunction<wxString>(model, nodes, sortOrder, type,
+            [](const wxVariant& v) { return v.GetString(); });
+    }
+    else if ( type == wxS("long") )
+    {
+        return DoMakeKeySortFunction<long>(model, nodes, sortOrder, type,
+            [](const wxVariant& v) { return v.GetLong(); });
+    }
+    else if ( type == wxS("double") )
+    {
+        return DoMakeKeySortFunction<double>(model, nodes, sortOrder, type,
+            [](const wxVariant& v) { return v.GetDouble(); });
+    }
+#if wxUSE_DATETIME
+    else if ( type == wxS("datetime") )
+    {
+        return DoMakeKeySortFunction<wxLongLong_t>(model, nodes, sortOrder, type,
+            [](const wxVariant& v) { return v.GetDateTime().GetValue().GetValue(); });
+    }
+#endif // wxUSE_DATETIME
+    else if ( type == wxS("bool") )
+    {
+        return DoMakeKeySortFunction<bool>(model, nodes, sortOrder, type,
+            [](const wxVariant& v) { return v.GetBool(); });
+    }
+    else if ( type == wxS("wxDataViewIconText") )
+    {
+        return DoMakeKeySortFunction<wxString>(model, nodes, sortOrder, type,
+            [](const wxVariant& v)
+            {
+                wxDataViewIconText iconText;
+                iconText << v;
+                return iconText.GetText();
+            });
+    }
+
+    // Other types are compared using DoCompareValues(), which can be
+    // overridden, so we can't do it ourselves.
+    return {};
+}
+
 } // anonymous namespace
 
 void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
@@ -1857,6 +2225,8 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
     if (!m_branchData)
         m_branchData = new BranchNodeData;
 
+    window->OnTreeNodeAdded(node);
+
     const SortOrder sortOrder = window->GetSortOrder();
 
     // Flag indicating whether we should retain existing sorted list when
@@ -1937,6 +2307,50 @@ void wxDataViewTreeNode::InsertChild(wxDataViewMainWindow* window,
 }
 
 
+void wxDataViewTreeNode::AppendChildUnsorted(wxDataViewMainWindow* window,
+                                             wxDataViewTreeNode* node)
+{
+    if ( !m_branchData )
+        m_branchData = new BranchNodeData;
+
+    window->OnTreeNodeAdded(node);
+
+    m_branchData->sortOrder = SortOrder();
+    m_branchData->InsertChild(node, m_branchData->children.size());
+}
+
+void wxDataViewTreeNode::PutChildrenInModelOrder(const wxDataViewModel* model)
+{
+    if ( !m_branchData )
+        return;
+
+    wxDataViewItemArray modelChildren;
+    model->GetChildren(m_item, modelChildren);
+
+    std::unordered_map<void*, unsigned> positions;
+    positions.reserve(modelChildren.size());
+    for ( unsigned n = 0; n < modelChildren.size(); n++ )
+        positions[modelChildren[n].GetID()] = n;
+
+    // Put the nodes not found in the model, which shouldn't normally happen,
+    // at the end.
+    const auto getPosition = [&positions](const wxDataViewTreeNode* node)
+    {
+        const auto it = positions.find(node->GetItem().GetID());
+        return it == positions.end() ? static_cast<unsigned>(-1) : it->second;
+    };
+
+    wxDataViewTreeNodes& nodes = m_branchData->children;
+    std::stable_sort(nodes.begin(), nodes.end(),
+                     [&getPosition](const wxDataViewTreeNode* node1,
+                                    const wxDataViewTreeNode* node2)
+                     {
+                        return getPosition(node1) < getPosition(node2);
+                     });
+
+    m_branchData->InvalidateRowOffsets(0);
+}
+
 void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 {
     if (!m_branchData)
@@ -1956,11 +2370,11 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
         // using model-specific sort order, which can change at any time.
         if ( m_branchData->sortOrder != sortOrder || !sortOrder.UsesColumn() )
         {
-            std::sort(m_branchData->children.begin(),
-                      m_branchData->children.end(),
-                      wxGenericTreeModelNodeCmp(window, sortOrder));
-
-            m_branchData->sortOrder = sortOrder;
+            // Sorting a lot of items can take long enough to freeze the UI,
+            // so do it in background if possible: this node will remain in
+            // the old order until the sort completes.
+            if ( !window->StartBackgroundSort(this, sortOrder) )
+                SortChildren(window, sortOrder);
         }
 
         // There may be open child nodes that also need a resort.
@@ -1974,6 +2388,53 @@ void wxDataViewTreeNode::Resort(wxDataViewMainWindow* window)
 }
 
 
+void
+wxDataViewTreeNode::SortChildren(wxDataViewMainWindow* window,
+                                 const SortOrder& sortOrder)
+{
+    wxDataViewTreeNodes& nodes = m_branchData->children;
+
+    // When possible, avoid calling Compare() for each comparison and extract
+    // the sort keys only once instead, this is much faster.
+    const std::function<std::vector<unsigned>()>
+        sortFunc = MakeKeySortFunction(window->GetModel(), nodes, sortOrder);
+    if ( sortFunc )
+    {
+        SetChildrenOrder(sortFunc(), sortOrder);
+        return;
+    }
+
+    const wxGenericTreeModelNodeCmp cmp(window, sortOrder);
+
+    // Sorting many items can take a long time, so use several threads
+    // for it if the model allows us to do it.
+    if ( window->GetModel()->IsCompareThreadSafe() )
+        wxParallelSort(nodes.begin(), nodes.end(), cmp);
+    else
+        std::sort(nodes.begin(), nodes.end(), cmp);
+
+    m_branchData->sortOrder = sortOrder;
+    m_branchData->InvalidateRowOffsets(0);
+}
+
+void
+wxDataViewTreeNode::SetChildrenOrder(const std::vector<unsigned>& order,
+                                     const SortOrder& sortOrder)
+{
+    wxDataViewTreeNodes& nodes = m_branchData->children;
+    wxCHECK_RET( order.size() == nodes.size(), "wrong number of children" );
+
+    wxDataViewTreeNodes sorted;
+    sorted.reserve(nodes.size());
+    for ( const unsigned index : order )
+        sorted.push_back(nodes[index]);
+
+    nodes.swap(sorted);
+
+    m_branchData->sortOrder = sortOrder;
+    m_branchData->InvalidateRowOffsets(0);
+}
+
 void
 wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
                                         wxDataViewTreeNode* childNode)
@@ -2000,16 +2461,8 @@ wxDataViewTreeNode::PutChildInSortOrder(wxDataViewMainWindow* window,
 
     // First find the node in the current child list
     int hi = nodes.size();
-    int oldLocation = wxNOT_FOUND;
-    for ( int index = 0; index < hi; ++index )
-    {
-        if ( nodes[index] == childNode )
-        {
-            oldLocation = index;
-            break;
-        }
-    }
-    wxCHECK_RET( oldLocation >= 0, "not our child?" );
+    wxCHECK_RET( childNode->GetParent() == this, "not our child?" );
+    const int oldLocation = GetChildIndex(childNode);
 
     wxGenericTreeModelNodeCmp cmp(window, m_branchData->sortOrder);
 
@@ -2145,6 +2598,9 @@ wxDataViewMainWindow::wxDataViewMainWindow( wxDataViewCtrl *parent, wxWindowID i
     m_count = -1;
     m_underMouse = nullptr;
 
+    m_batchCount = 0;
+    m_batchResort = false;
+
     UpdateDisplay();
 }
 
@@ -3052,63 +3508,6 @@ void wxDataViewHeaderWindow::FinishEditing()
     win->FinishEditing();
 }
 
-//-----------------------------------------------------------------------------
-// Helper class for do operation on the tree node
-//-----------------------------------------------------------------------------
-
-namespace
-{
-
-class DoJob
-{
-public:
-    DoJob() { }
-    virtual ~DoJob() { }
-
-    // The return value control how the tree-walker tranverse the tree
-    enum
-    {
-        DONE,          // Job done, stop traversing and return
-        SKIP_SUBTREE,  // Ignore the current node's subtree and continue
-        CONTINUE       // Job not done, continue
-    };
-
-    virtual int operator() ( wxDataViewTreeNode * node ) = 0;
-};
-
-bool
-Walker(wxDataViewTreeNode * node, DoJob & func, WalkFlags flags = Walk_All)
-{
-    wxCHECK_MSG( node, false, "can't walk null node" );
-
-    switch( func( node ) )
-    {
-        case DoJob::DONE:
-            return true;
-        case DoJob::SKIP_SUBTREE:
-            return false;
-        case DoJob::CONTINUE:
-            break;
-    }
-
-    if ( node->HasChildren() && (flags != Walk_ExpandedOnly || node->IsOpen()) )
-    {
-        const wxDataViewTreeNodes& nodes = node->GetChildNodes();
-
-        for ( wxDataViewTreeNodes::const_iterator i = nodes.begin();
-              i != nodes.end();
-              ++i )
-        {
-            if ( Walker(*i, func, flags) )
-                return true;
-        }
-    }
-
-    return false;
-}
-
-} // anonymous namespace
-
 bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxDataViewItem & item)
 {
     if (IsVirtualList())
@@ -3119,6 +3518,10 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
     }
     else
     {
+        // The new item is inserted in the sorted position, so the pending
+        // sorts must be finished first.
+        CompleteBackgroundSorts();
+
         // specific position (row) is unclear, so clear whole height cache
         ClearRowHeightCache();
 
@@ -3153,7 +3556,17 @@ bool wxDataViewMainWindow::ItemAdded(const wxDataViewItem & parent, const wxData
         wxDataViewTreeNode *itemNode = new wxDataViewTreeNode(parentNode, item);
         itemNode->SetHasChildren(GetModel()->IsContainer(item));
 
-        if ( GetSortOrder().IsNone() )
+        if ( IsInBatch() )
+        {
+            // Just append the node for now, finding its correct position is
+            // relatively expensive and is done for all the children of this
+            // parent at once at the end of the batch.
+            parentNode->ChangeSubTreeCount(+1);
+            parentNode->AppendChildUnsorted(this, itemNode);
+
+            m_batchParents.insert(parent.GetID());
+        }
+        else if ( GetSortOrder().IsNone() )
         {
             // There's no sorting, so we need to select an insertion position
 
@@ -3237,6 +3650,10 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
     }
     else // general case
     {
+        // Deleting a child changes the indices of its siblings, so the
+        // results of the pending sorts couldn't be applied any more.
+        CompleteBackgroundSorts();
+
         const FindNodeResult findResult = FindNode(parent);
         wxDataViewTreeNode *parentNode = findResult.m_node;
 
@@ -3253,24 +3670,13 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
             return true;
 
         wxCHECK_MSG( parentNode->HasChildren(), false, "parent node doesn't have children?" );
-        const wxDataViewTreeNodes& parentsChildren = parentNode->GetChildNodes();
 
         // We can't use FindNode() to find 'item', because it was already
         // removed from the model by the time ItemDeleted() is called, so we
-        // have to do it manually. We keep track of its position as well for
-        // later use.
-        int itemPosInNode = 0;
-        wxDataViewTreeNode *itemNode = nullptr;
-        for ( wxDataViewTreeNodes::const_iterator i = parentsChildren.begin();
-              i != parentsChildren.end();
-              ++i, ++itemPosInNode )
-        {
-            if( (*i)->GetItem() == item )
-            {
-                itemNode = *i;
-                break;
-            }
-        }
+        // can't use GetParent() for it, but we can still look it up directly.
+        wxDataViewTreeNode *itemNode = GetTreeNodeByItem(item);
+        if ( itemNode && itemNode->GetParent() != parentNode )
+            itemNode = nullptr;
 
         // If the parent wasn't expanded, it's possible that we didn't have a
         // node corresponding to 'item' and so there's nothing left to do.
@@ -3284,6 +3690,8 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
             return true;
         }
 
+        const int itemPosInNode = parentNode->GetChildIndex(itemNode);
+
         if ( m_rowHeightCache )
             m_rowHeightCache->Remove(GetRowByItem(parent) + itemPosInNode);
 
@@ -3291,6 +3699,7 @@ bool wxDataViewMainWindow::ItemDeleted(const wxDataViewItem& parent,
         const int itemsDeleted = 1 + itemNode->GetSubTreeCount();
 
         parentNode->RemoveChild(itemPosInNode);
+        OnTreeNodeDeleted(itemNode);
         delete itemNode;
         parentNode->ChangeSubTreeCount(-itemsDeleted);
 
@@ -3351,7 +3760,12 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
 {
     if ( !IsVirtualList() )
     {
-        if ( m_rowHeightCache )
+        // The changed item is moved using binary search among its siblings,
+        // which must be in the current sort order for this.
+        CompleteBackgroundSorts();
+
+        // The entire cache is cleared at the end of the batch.
+        if ( m_rowHeightCache && !IsInBatch() )
             m_rowHeightCache->Remove(GetRowByItem(item));
 
         // Move this node to its new correct place after it was updated.
@@ -3367,7 +3781,17 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
         if ( !findResult.m_subtreeRealized )
             return true;
         wxCHECK_MSG( node, false, "invalid item" );
-        node->PutInSortOrder(this);
+
+        if ( !IsInBatch() )
+        {
+            node->PutInSortOrder(this);
+        }
+        else if ( !GetSortOrder().IsNone() && node->GetParent() )
+        {
+            // Resort all the changed children at once at the end of batch.
+            node->GetParent()->InvalidateSortOrder();
+            m_batchParents.insert(node->GetParent()->GetItem().GetID());
+        }
     }
 
     wxDataViewColumn* column;
@@ -3382,8 +3806,10 @@ bool wxDataViewMainWindow::DoItemChanged(const wxDataViewItem & item, int view_c
         GetOwner()->InvalidateColBestWidth(view_column);
     }
 
-    // Update the displayed value(s).
-    RefreshRow(GetRowByItem(item));
+    // Update the displayed value(s), unless we're going to refresh everything
+    // at the end of the batch anyhow.
+    if ( !IsInBatch() )
+        RefreshRow(GetRowByItem(item));
 
     // Send event
     wxDataViewEvent le(wxEVT_DATAVIEW_ITEM_VALUE_CHANGED, m_owner, column, item);
@@ -3424,6 +3850,181 @@ bool wxDataViewMainWindow::Cleared()
     return true;
 }
 
+void wxDataViewMainWindow::EndBatch()
+{
+    wxCHECK_RET( m_batchCount > 0, "EndBatch() without matching BeginBatch()" );
+
+    if ( --m_batchCount )
+        return;
+
+    if ( !IsVirtualList() && (m_batchResort || !m_batchParents.empty()) )
+    {
+        wxDataViewItemArray selected;
+        wxDataViewItem current;
+        SaveSelection(selected, current);
+
+        const SortOrder sortOrder = GetSortOrder();
+        for ( void* const id : m_batchParents )
+        {
+            wxDataViewTreeNode* const node = id ? GetTreeNodeByItem(wxDataViewItem(id))
+                                                : m_root;
+
+            // The node could have been deleted since then.
+            if ( !node )
+                continue;
+
+            if ( sortOrder.IsNone() )
+                node->PutChildrenInModelOrder(GetModel());
+            else if ( !m_batchResort )
+                node->Resort(this);
+        }
+
+        if ( m_batchResort )
+            m_root->Resort(this);
+
+        m_batchParents.clear();
+        m_batchResort = false;
+
+        RestoreSelection(selected, current);
+    }
+
+    ClearRowHeightCache();
+    UpdateDisplay();
+}
+
+void wxDataViewMainWindow::SaveSelection(wxDataViewItemArray& selected,
+                                         wxDataViewItem& current)
+{
+    wxSelectionStore::IterationState cookie;
+    for ( unsigned row = m_selection.GetFirstSelectedItem(cookie);
+          row != wxSelectionStore::NO_SELECTION;
+          row = m_selection.GetNextSelectedItem(cookie) )
+    {
+        selected.push_back(GetItemByRow(row));
+    }
+
+    current = HasCurrentRow() ? GetItemByRow(m_currentRow) : wxDataViewItem();
+}
+
+void wxDataViewMainWindow::RestoreSelection(const wxDataViewItemArray& selected,
+                                            const wxDataViewItem& current)
+{
+    if ( !selected.empty() )
+    {
+        ClearSelection();
+        for ( const auto& item : selected )
+        {
+            const int row = GetRowByItem(item);
+            if ( row != -1 )
+                m_selection.SelectItem(row);
+        }
+    }
+
+    if ( current.IsOk() )
+        m_currentRow = GetRowByItem(current);
+}
+
+bool wxDataViewMainWindow::StartBackgroundSort(wxDataViewTreeNode* node,
+                                               const SortOrder& sortOrder)
+{
+#if wxUSE_THREADS
+    if ( node->GetChildNodes().size() < BACKGROUND_SORT_MIN_ITEMS )
+        return false;
+
+    wxThreadPool* const pool = wxThreadPool::GetIfAvailable();
+    if ( !pool )
+        return false;
+
+    std::function<std::vector<unsigned>()>
+        sortFunc = MakeKeySortFunction(GetModel(), node->GetChildNodes(), sortOrder);
+    if ( !sortFunc )
+        return false;
+
+    // If we're already sorting this node, the result of this sort is not
+    // needed any more.
+    BackgroundSort& sort = m_backgroundSorts[node];
+    sort.cancel.Cancel();
+    sort.cancel = wxCancellationSource();
+    sort.sortOrder = sortOrder;
+
+    pool->SubmitThen
+          (
+            sortFunc,
+            [this, node, sortOrder](const std::vector<unsigned>& order)
+            {
+                ApplyBackgroundSort(node, sortOrder, order);
+            },
+            nullptr,
+            sort.cancel.GetToken()
+          );
+
+    return true;
+#else // !wxUSE_THREADS
+    wxUnusedVar(node);
+    wxUnusedVar(sortOrder);
+
+    return false;
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+void wxDataViewMainWindow::CompleteBackgroundSorts()
+{
+#if wxUSE_THREADS
+    if ( m_backgroundSorts.empty() )
+        return;
+
+    wxDataViewItemArray selected;
+    wxDataViewItem current;
+    SaveSelection(selected, current);
+
+    for ( auto& kv : m_backgroundSorts )
+    {
+        kv.second.cancel.Cancel();
+        kv.first->SortChildren(this, kv.second.sortOrder);
+    }
+
+    m_backgroundSorts.clear();
+
+    RestoreSelection(selected, current);
+
+    ClearRowHeightCache();
+#endif // wxUSE_THREADS
+}
+
+void wxDataViewMainWindow::CancelBackgroundSorts()
+{
+#if wxUSE_THREADS
+    for ( auto& kv : m_backgroundSorts )
+        kv.second.cancel.Cancel();
+
+    m_backgroundSorts.clear();
+#endif // wxUSE_THREADS
+}
+
+#if wxUSE_THREADS
+
+void wxDataViewMainWindow::ApplyBackgroundSort(wxDataViewTreeNode* node,
+                                               const SortOrder& sortOrder,
+                                               const std::vector<unsigned>& order)
+{
+    // As the sort would have been cancelled if the node had been deleted or
+    // modified in the meanwhile, it's safe to use it here.
+    m_backgroundSorts.erase(node);
+
+    wxDataViewItemArray selected;
+    wxDataViewItem current;
+    SaveSelection(selected, current);
+
+    node->SetChildrenOrder(order, sortOrder);
+
+    RestoreSelection(selected, current);
+
+    ClearRowHeightCache();
+    UpdateDisplay();
+}
+
+#endif // wxUSE_THREADS
+
 void wxDataViewMainWindow::UpdateDisplay()
 {
     m_dirty = true;
@@ -3871,74 +4472,27 @@ int wxDataViewMainWindow::QueryAndCacheLineHeight(unsigned int row, wxDataViewIt
     return height;
 }
 
-
-namespace
-{
-
-class RowToTreeNodeJob: public DoJob
-{
-public:
-    // Note that we initialize m_current to -1 because the first node passed to
-    // our operator() will be the root node, which doesn't appear in the window
-    // and so doesn't count as a real row.
-    explicit RowToTreeNodeJob(int row)
-        : m_row(row), m_current(-1), m_ret(nullptr)
-    {
-    }
-
-    virtual int operator() ( wxDataViewTreeNode * node ) override
-    {
-        if( m_current == m_row)
-        {
-            m_ret = node;
-            return DoJob::DONE;
-        }
-
-        if( node->GetSubTreeCount() + m_current < m_row )
-        {
-            m_current += node->GetSubTreeCount() + 1;
-            return  DoJob::SKIP_SUBTREE;
-        }
-        else
-        {
-            // If the current node has only leaf children, we can find the
-            // desired node directly. This can speed up finding the node
-            // in some cases, and will have a very good effect for list views.
-            if ( node->HasChildren() &&
-                 (int)node->GetChildNodes().size() == node->GetSubTreeCount() )
-            {
-                const int index = m_row - m_current - 1;
-                m_ret = node->GetChildNodes()[index];
-                return DoJob::DONE;
-            }
-
-            m_current++;
-
-            return DoJob::CONTINUE;
-        }
-    }
-
-    wxDataViewTreeNode * GetResult() const
-        { return m_ret; }
-
-private:
-    const int m_row;
-    int m_current;
-    wxDataViewTreeNode* m_ret;
-};
-
-} // anonymous namespace
-  //
 wxDataViewTreeNode * wxDataViewMainWindow::GetTreeNodeByRow(unsigned int row) const
 {
     wxASSERT( !IsVirtualList() );
 
-    if ( row == (unsigned)-1 )
+    if ( row >= static_cast<unsigned>(m_root->GetSubTreeCount()) )
         return nullptr;
 
-    RowToTreeNodeJob job(static_cast<int>(row));
-    Walker( m_root , job );
-    return job.GetResult();
+    // Descend into the subtree containing the row at each level, this is
+    // logarithmic in the number of children thanks to the row offsets
+    // maintained by the nodes.
+    int rowInSubtree = static_cast<int>(row);
+    wxDataViewTreeNode* node = m_root;
+    for ( ;; )
+    {
+        node = node->FindChildByRow(rowInSubtree);
+        if ( !rowInSubtree )
+            return node;
+
+        // Skip the row of this node itself.
+        rowInSubtree--;
+    }
 }
 
 wxDataViewItem wxDataViewMainWindow::GetItemByRow(unsigned int row) const
@@ -4168,6 +4722,12 @@ wxDataViewMainWindow::FindNode( const wxDataViewItem & item )
         return result;
     }
 
+    // Check if we already have a node for this item first, this is the
+    // common case and doesn't require walking the parent chain.
+    result.m_node = GetTreeNodeByItem(item);
+    if ( result.m_node )
+        return result;
+
     // Compose the parent-chain for the item we are looking for
     wxVector<wxDataViewItem> parentChain;
     wxDataViewItem it( item );
@@ -4338,60 +4898,6 @@ int wxDataViewMainWindow::RecalculateCount() const
     }
 }
 
-namespace
-{
-
-class ItemToRowJob : public DoJob
-{
-public:
-    // As with RowToTreeNodeJob above, we initialize m_current to -1 because
-    // the first node passed to our operator() is the root node which is not
-    // visible on screen and so we should return 0 for its first child node and
-    // not for the root itself.
-    ItemToRowJob(const wxDataViewItem& item, wxVector<wxDataViewItem>::reverse_iterator iter)
-        : m_item(item), m_iter(iter), m_current(-1)
-    {
-    }
-
-    // Maybe binary search will help to speed up this process
-    virtual int operator() ( wxDataViewTreeNode * node) override
-    {
-        if( node->GetItem() == m_item )
-        {
-            return DoJob::DONE;
-        }
-
-        // Is this node the next (grand)parent of the item we're looking for?
-        if( node->GetItem() == *m_iter )
-        {
-            // Search for the next (grand)parent now and skip this item itself.
-            ++m_iter;
-            ++m_current;
-            return DoJob::CONTINUE;
-        }
-        else
-        {
-            // Skip this node and all its currently visible children.
-            m_current += node->GetSubTreeCount() + 1;
-            return DoJob::SKIP_SUBTREE;
-        }
-
-    }
-
-    int GetResult() const
-        { return m_current; }
-
-private:
-    const wxDataViewItem m_item;
-    wxVector<wxDataViewItem>::reverse_iterator m_iter;
-
-    // The row corresponding to the last node seen in our operator().
-    int m_current;
-
-};
-
-} // anonymous namespace
-
 int
 wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
                                    WalkFlags flags) const
@@ -4409,25 +4915,24 @@ wxDataViewMainWindow::GetRowByItem(const wxDataViewItem & item,
         if( !item.IsOk() )
             return -1;
 
-        // Compose the parent-chain of the item we are looking for
-        wxVector<wxDataViewItem> parentChain;
-        wxDataViewItem it( item );
-        while( it.IsOk() )
-        {
-            parentChain.push_back(it);
-            it = model->GetParent(it);
-        }
+        const wxDataViewTreeNode* node = GetTreeNodeByItem(item);
+        if ( !node )
+            return -1;
 
-        // add an 'invalid' item to represent our 'invisible' root node
-        parentChain.push_back(wxDataViewItem());
+        // Sum the offsets of all the nodes from their parents, starting with
+        // -1 for the invisible root node.
+        int row = -1;
+        for ( const wxDataViewTreeNode* parent = node->GetParent();
+              parent;
+              node = parent, parent = parent->GetParent() )
+        {
+            if ( flags == Walk_ExpandedOnly && !parent->IsOpen() )
+                return -1;
 
-        // the parent chain was created by adding the deepest parent first.
-        // so if we want to start at the root node, we have to iterate backwards through the vector
-        ItemToRowJob job( item, parentChain.rbegin() );
-        if ( !Walker( m_root, job, flags ) )
-            return -1;
+            row += parent->GetChildRowOffset(node);
+        }
 
-        return job.GetResult();
+        return row;
     }
 }
 
@@ -4474,11 +4979,49 @@ void wxDataViewMainWindow::BuildTree(wxDataViewModel * model)
 
 void wxDataViewMainWindow::DestroyTree()
 {
+    CancelBackgroundSorts();
+
     if (!IsVirtualList())
     {
         wxDELETE(m_root);
         m_count = 0;
     }
+
+    m_itemToNode.clear();
+}
+
+wxDataViewTreeNode *
+wxDataViewMainWindow::GetTreeNodeByItem(const wxDataViewItem& item) const
+{
+    const auto it = m_itemToNode.find(item.GetID());
+    return it == m_itemToNode.end() ? nullptr : it->second;
+}
+
+void wxDataViewMainWindow::OnTreeNodeAdded(wxDataViewTreeNode* node)
+{
+    m_itemToNode[node->GetItem().GetID()] = node;
+}
+
+void wxDataViewMainWindow::OnTreeNodeDeleted(wxDataViewTreeNode* node)
+{
+    const auto it = m_itemToNode.find(node->GetItem().GetID());
+    if ( it != m_itemToNode.end() && it->second == node )
+        m_itemToNode.erase(it);
+
+#if wxUSE_THREADS
+    const auto itSort = m_backgroundSorts.find(node);
+    if ( itSort != m_backgroundSorts.end() )
+    {
+        itSort->second.cancel.Cancel();
+        m_backgroundSorts.erase(itSort);
+    }
+#endif // wxUSE_THREADS
+
+    if ( node->HasChildren() )
+    {
+        for ( wxDataViewTreeNode* const child : node->GetChildNodes() )
+            OnTreeNodeDeleted(child);
+    }
 }
 
 wxDataViewColumn*
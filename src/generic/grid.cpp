@@ -26,6 +26,7 @@
 #ifndef WX_PRECOMP
     #include "wx/utils.h"
     #include "wx/dcclient.h"
+    #include "wx/dcmemory.h"
     #include "wx/settings.h"
     #include "wx/log.h"
     #include "wx/textctrl.h"
@@ -45,6 +46,7 @@
 #include "wx/tokenzr.h"
 #include "wx/renderer.h"
 #include "wx/headerctrl.h"
+#include "wx/numformatter.h"
 #include "wx/scopeguard.h"
 
 #if wxUSE_CLIPBOARD
@@ -61,6 +63,8 @@ const char wxGridNameStr[] = "grid";
 // Required for wxIs... functions
 #include <ctype.h>
 
+#include <bitset>
+
 // ----------------------------------------------------------------------------
 // globals
 // ----------------------------------------------------------------------------
@@ -1306,6 +1310,197 @@ void wxGridRowOrColAttrData::UpdateAttrRowsOrCols( size_t pos, int numRowsOrCols
     }
 }
 
+// ----------------------------------------------------------------------------
+// wxGridBlockAttrData
+// ----------------------------------------------------------------------------
+
+wxGridBlockAttrData::~wxGridBlockAttrData()
+{
+    for ( const auto& entry : m_entries )
+        wxSafeDecRef(entry.attr);
+}
+
+void
+wxGridBlockAttrData::SetAttr(wxGridCellAttr *attr,
+                             const wxGridBlockCoords& block)
+{
+    // Remove the blocks completely hidden by the new one, notice that, as
+    // usual, this works even if the new attribute is the same as the old one
+    // because it must have been IncRef()'d by the caller in this case.
+    bool overlaps = false;
+    for ( auto it = m_entries.begin(); it != m_entries.end(); )
+    {
+        if ( block.Contains(it->block) )
+        {
+            wxSafeDecRef(it->attr);
+            it = m_entries.erase(it);
+            continue;
+        }
+
+        if ( block.Intersects(it->block) )
+            overlaps = true;
+
+        ++it;
+    }
+
+    // Resetting the attribute only needs to be remembered if it affects any
+    // of the remaining blocks.
+    if ( attr || overlaps )
+        m_entries.push_back({block, attr});
+
+    m_indexValid = false;
+}
+
+void wxGridBlockAttrData::UpdateIndex() const
+{
+    if ( m_indexValid )
+        return;
+
+    m_indexRows.clear();
+    m_indexEntries.clear();
+
+    for ( const auto& entry : m_entries )
+    {
+        m_indexRows.push_back(entry.block.GetTopRow());
+        m_indexRows.push_back(entry.block.GetBottomRow() + 1);
+    }
+
+    std::sort(m_indexRows.begin(), m_indexRows.end());
+    m_indexRows.erase(std::unique(m_indexRows.begin(), m_indexRows.end()),
+                      m_indexRows.end());
+
+    if ( !m_indexRows.empty() )
+        m_indexEntries.resize(m_indexRows.size() - 1);
+
+    for ( size_t n = 0; n < m_entries.size(); n++ )
+    {
+        const wxGridBlockCoords& block = m_entries[n].block;
+
+        const auto first = std::lower_bound(m_indexRows.begin(),
+                                            m_indexRows.end(),
+                                            block.GetTopRow());
+        const auto last = std::lower_bound(first,
+                                           m_indexRows.end(),
+                                           block.GetBottomRow() + 1);
+
+        for ( auto it = first; it != last; ++it )
+            m_indexEntries[it - m_indexRows.begin()].push_back(n);
+    }
+
+    m_indexValid = true;
+}
+
+wxGridCellAttr *wxGridBlockAttrData::GetAttr(int row, int col) const
+{
+    if ( m_entries.empty() )
+        return nullptr;
+
+    UpdateIndex();
+
+    // Find the range of rows containing this one.
+    const auto it = std::upper_bound(m_indexRows.begin(),
+                                     m_indexRows.end(),
+                                     row);
+    if ( it == m_indexRows.begin() || it == m_indexRows.end() )
+        return nullptr;
+
+    // And check the blocks covering it, starting from the most recent one.
+    const std::vector<size_t>& indices = m_indexEntries[it - m_indexRows.begin() - 1];
+    for ( auto n = indices.rbegin(); n != indices.rend(); ++n )
+    {
+        const Entry& entry = m_entries[*n];
+        if ( entry.block.GetLeftCol() <= col && col <= entry.block.GetRightCol() )
+        {
+            wxSafeIncRef(entry.attr);
+            return entry.attr;
+        }
+    }
+
+    return nullptr;
+}
+
+void
+wxGridBlockAttrData::UpdateAttrRowsOrCols(int pos, int numRowsOrCols, bool rows)
+{
+    if ( m_entries.empty() )
+        return;
+
+    std::vector<Entry> newEntries;
+    newEntries.reserve(m_entries.size());
+
+    for ( const auto& entry : m_entries )
+    {
+        const wxGridBlockCoords& block = entry.block;
+        const int first = rows ? block.GetTopRow() : block.GetLeftCol();
+        const int last = rows ? block.GetBottomRow() : block.GetRightCol();
+
+        // Append the part of the block between the given rows or columns.
+        const auto addBlock = [&newEntries, &entry, rows](int newFirst,
+                                                          int newLast)
+        {
+            wxGridBlockCoords newBlock = entry.block;
+            if ( rows )
+            {
+                newBlock.SetTopRow(newFirst);
+                newBlock.SetBottomRow(newLast);
+            }
+            else
+            {
+                newBlock.SetLeftCol(newFirst);
+                newBlock.SetRightCol(newLast);
+            }
+
+            newEntries.push_back({newBlock, entry.attr});
+        };
+
+        if ( last < pos )
+        {
+            // This block is not affected at all.
+            newEntries.push_back(entry);
+        }
+        else if ( numRowsOrCols > 0 )
+        {
+            if ( first >= pos )
+            {
+                addBlock(first + numRowsOrCols, last + numRowsOrCols);
+            }
+            else
+            {
+                // The new rows or columns don't have any attributes, so split
+                // the block in two parts sharing the same attribute.
+                addBlock(first, pos - 1);
+                addBlock(pos + numRowsOrCols, last + numRowsOrCols);
+                wxSafeIncRef(entry.attr);
+            }
+        }
+        else // rows or columns deleted
+        {
+            const int posEnd = pos - numRowsOrCols;
+
+            const int newFirst = first < pos ? first : wxMax(pos, first + numRowsOrCols);
+            const int newLast = last >= posEnd ? last + numRowsOrCols : pos - 1;
+
+            if ( newFirst <= newLast )
+                addBlock(newFirst, newLast);
+            else
+                wxSafeDecRef(entry.attr);
+        }
+    }
+
+    m_entries.swap(newEntries);
+    m_indexValid = false;
+}
+
+void wxGridBlockAttrData::UpdateAttrRows( size_t pos, int numRows )
+{
+    UpdateAttrRowsOrCols(static_cast<int>(pos), numRows, true);
+}
+
+void wxGridBlockAttrData::UpdateAttrCols( size_t pos, int numCols )
+{
+    UpdateAttrRowsOrCols(static_cast<int>(pos), numCols, false);
+}
+
 // ----------------------------------------------------------------------------
 // wxGridCellAttrProvider
 // ----------------------------------------------------------------------------
@@ -1334,62 +1529,50 @@ wxGridCellAttr *wxGridCellAttrProvider::GetAttr(int row, int col,
         switch (kind)
         {
             case (wxGridCellAttr::Any):
-                // Get cached merge attributes.
-                // Currently not used as no cache implemented as not mutable
-                // attr = m_data->m_mergeAttr.GetAttr(row, col);
-                if (!attr)
                 {
-                    // Basically implement old version.
-                    // Also check merge cache, so we don't have to re-merge every time..
-                    wxGridCellAttr *attrcell = m_data->m_cellAttrs.GetAttr(row, col);
-                    wxGridCellAttr *attrrow = m_data->m_rowAttrs.GetAttr(row);
-                    wxGridCellAttr *attrcol = m_data->m_colAttrs.GetAttr(col);
+                    // Get all the attributes applying to this cell, in the
+                    // order of their precedence.
+                    wxGridCellAttr* const attrs[] =
+                    {
+                        m_data->m_cellAttrs.GetAttr(row, col),
+                        m_data->m_blockAttrs.GetAttr(row, col),
+                        m_data->m_colAttrs.GetAttr(col),
+                        m_data->m_rowAttrs.GetAttr(row),
+                    };
+
+                    // If there is only one of them (possibly used for several
+                    // kinds), just return it, otherwise merge all of them.
+                    bool needsMerge = false;
+                    for ( wxGridCellAttr* const a : attrs )
+                    {
+                        if ( !a )
+                            continue;
 
-                    if ((attrcell != attrrow) && (attrrow != attrcol) && (attrcell != attrcol))
+                        if ( !attr )
+                            attr = a;
+                        else if ( a != attr )
+                            needsMerge = true;
+                    }
+
+                    if ( needsMerge )
                     {
-                        // Two or more are non null
                         attr = new wxGridCellAttr;
                         attr->SetKind(wxGridCellAttr::Merged);
 
-                        // Order is important..
-                        if (attrcell)
-                        {
-                            attr->MergeWith(attrcell);
-                            attrcell->DecRef();
-                        }
-                        if (attrcol)
+                        for ( wxGridCellAttr* const a : attrs )
                         {
-                            attr->MergeWith(attrcol);
-                            attrcol->DecRef();
+                            if ( a )
+                                attr->MergeWith(a);
                         }
-                        if (attrrow)
-                        {
-                            attr->MergeWith(attrrow);
-                            attrrow->DecRef();
-                        }
-
-                        // store merge attr if cache implemented
-                        //attr->IncRef();
-                        //m_data->m_mergeAttr.SetAttr(attr, row, col);
                     }
-                    else
+                    else if ( attr )
                     {
-                        // one or none is non null return it or null.
-                        if (attrrow)
-                            attr = attrrow;
-                        if (attrcol)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcol;
-                        }
-                        if (attrcell)
-                        {
-                            if (attr)
-                                attr->DecRef();
-                            attr = attrcell;
-                        }
+                        // Keep the single reference we return.
+                        attr->IncRef();
                     }
+
+                    for ( wxGridCellAttr* const a : attrs )
+                        wxSafeDecRef(a);
                 }
                 break;
 
@@ -1425,6 +1608,15 @@ void wxGridCellAttrProvider::SetAttr(wxGridCellAttr *attr,
     m_data->m_cellAttrs.SetAttr(attr, row, col);
 }
 
+void wxGridCellAttrProvider::SetBlockAttr(wxGridCellAttr *attr,
+                                          const wxGridBlockCoords& block)
+{
+    if ( !m_data )
+        InitData();
+
+    m_data->m_blockAttrs.SetAttr(attr, block.Canonicalize());
+}
+
 void wxGridCellAttrProvider::SetRowAttr(wxGridCellAttr *attr, int row)
 {
     if ( !m_data )
@@ -1446,6 +1638,7 @@ void wxGridCellAttrProvider::UpdateAttrRows( size_t pos, int numRows )
     if ( m_data )
     {
         m_data->m_cellAttrs.UpdateAttrRows( pos, numRows );
+        m_data->m_blockAttrs.UpdateAttrRows( pos, numRows );
 
         m_data->m_rowAttrs.UpdateAttrRowsOrCols( pos, numRows );
     }
@@ -1456,6 +1649,7 @@ void wxGridCellAttrProvider::UpdateAttrCols( size_t pos, int numCols )
     if ( m_data )
     {
         m_data->m_cellAttrs.UpdateAttrCols( pos, numCols );
+        m_data->m_blockAttrs.UpdateAttrCols( pos, numCols );
 
         m_data->m_colAttrs.UpdateAttrRowsOrCols( pos, numCols );
     }
@@ -1767,6 +1961,23 @@ void wxGridTableBase::SetColAttr(wxGridCellAttr *attr, int col)
     }
 }
 
+void wxGridTableBase::SetBlockAttr(wxGridCellAttr *attr,
+                                   const wxGridBlockCoords& block)
+{
+    if ( m_attrProvider )
+    {
+        if ( attr )
+            attr->SetKind(wxGridCellAttr::Cell);
+        m_attrProvider->SetBlockAttr(attr, block);
+    }
+    else
+    {
+        // as we take ownership of the pointer and don't store it, we must
+        // free it now
+        wxSafeDecRef(attr);
+    }
+}
+
 bool wxGridTableBase::InsertRows( size_t WXUNUSED(pos),
                                   size_t WXUNUSED(numRows) )
 {
@@ -2169,9 +2380,950 @@ bool wxGridStringTable::DeleteCols( size_t pos, size_t numCols )
             colData.erase( first, first + numCols );
         }
 
-        m_numCols -= numCols;
+        m_numCols -= numCols;
+    }
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_DELETED,
+                                pos,
+                                numCols );
+    }
+
+    return true;
+}
+
+wxString wxGridStringTable::GetRowLabelValue( int row )
+{
+    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetRowLabelValue( row );
+    }
+    else
+    {
+        return m_rowLabels[row];
+    }
+}
+
+wxString wxGridStringTable::GetColLabelValue( int col )
+{
+    if ( col > (int)(m_colLabels.GetCount()) - 1 )
+    {
+        // using default label
+        //
+        return wxGridTableBase::GetColLabelValue( col );
+    }
+    else
+    {
+        return m_colLabels[col];
+    }
+}
+
+void wxGridStringTable::SetRowLabelValue( int row, const wxString& value )
+{
+    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
+    {
+        int n = m_rowLabels.GetCount();
+        int i;
+
+        for ( i = n; i <= row; i++ )
+        {
+            m_rowLabels.Add( wxGridTableBase::GetRowLabelValue(i) );
+        }
+    }
+
+    m_rowLabels[row] = value;
+}
+
+void wxGridStringTable::SetColLabelValue( int col, const wxString& value )
+{
+    if ( col > (int)(m_colLabels.GetCount()) - 1 )
+    {
+        int n = m_colLabels.GetCount();
+        int i;
+
+        for ( i = n; i <= col; i++ )
+        {
+            m_colLabels.Add( wxGridTableBase::GetColLabelValue(i) );
+        }
+    }
+
+    m_colLabels[col] = value;
+}
+
+void wxGridStringTable::SetCornerLabelValue( const wxString& value )
+{
+    m_cornerLabel = value;
+}
+
+wxString wxGridStringTable::GetCornerLabelValue() const
+{
+    return m_cornerLabel;
+}
+
+//////////////////////////////////////////////////////////////////////
+//
+// A grid table storing typed values column by column.
+//
+
+namespace
+{
+
+// Helpers for converting the values stored in wxGridColumnarTable columns to
+// and from strings.
+
+wxString ColumnValueToString(wxLongLong_t value)
+{
+    return wxString::Format("%" wxLongLongFmtSpec "d", value);
+}
+
+wxString ColumnValueToString(double value)
+{
+    // Use enough digits to preserve all the digits of a number entered by
+    // the user, but not so many as to show the rounding errors.
+    return wxNumberFormatter::Format("%.15g", value);
+}
+
+wxString ColumnValueToString(bool value)
+{
+    return value ? wxString("1") : wxString("0");
+}
+
+bool ColumnValueFromString(const wxString& s, wxLongLong_t* value)
+{
+    return wxNumberFormatter::FromString(s, value);
+}
+
+bool ColumnValueFromString(const wxString& s, double* value)
+{
+    return wxNumberFormatter::FromString(s, value);
+}
+
+bool ColumnValueFromString(const wxString& s, bool* value)
+{
+    *value = s == "1" || wxGridCellBoolEditor::IsTrueValue(s);
+
+    return true;
+}
+
+} // anonymous namespace
+
+// Base class for all columns.
+class wxGridColumnarTable::Column
+{
+public:
+    explicit Column(wxGridColumnType type)
+        : m_type(type)
+    {
+    }
+
+    virtual ~Column() = default;
+
+    wxGridColumnType GetType() const { return m_type; }
+
+    virtual bool HasValue(size_t row) const = 0;
+
+    virtual void Reserve(size_t numRows) = 0;
+    virtual void InsertRows(size_t pos, size_t numRows) = 0;
+    virtual void DeleteRows(size_t pos, size_t numRows) = 0;
+
+    virtual void ClearValue(size_t row) = 0;
+    virtual void ClearAll() = 0;
+
+    // Return the string representation of the value, must only be called
+    // for the cells having a value.
+    virtual wxString GetValue(size_t row) const = 0;
+
+    // Set the value from its string representation, return false if it
+    // couldn't be parsed.
+    virtual bool SetValue(size_t row, const wxString& s) = 0;
+
+    // Explicitly set label or empty to use the default one.
+    wxString m_label;
+
+private:
+    const wxGridColumnType m_type;
+};
+
+// Column storing the values of type T in chunks of fixed size, which are only
+// allocated when a value is stored in one of their cells and freed when all
+// of them become empty again, so that the empty parts of the column only take
+// a single pointer for all the rows of the chunk.
+template <typename T>
+class wxGridColumnarTable::ChunkedColumn : public Column
+{
+public:
+    ChunkedColumn(wxGridColumnType type, size_t numRows)
+        : Column(type),
+          m_chunks(GetChunksCount(numRows)),
+          m_numRows(numRows)
+    {
+    }
+
+    // Must only be called for the cells having a value.
+    T Get(size_t row) const
+    {
+        return m_chunks[row / CHUNK_SIZE]->values[row % CHUNK_SIZE];
+    }
+
+    void Set(size_t row, T value)
+    {
+        std::unique_ptr<Chunk>& chunk = m_chunks[row / CHUNK_SIZE];
+        if ( !chunk )
+            chunk.reset(new Chunk);
+
+        chunk->values[row % CHUNK_SIZE] = value;
+        chunk->hasValue.set(row % CHUNK_SIZE);
+    }
+
+    virtual bool HasValue(size_t row) const override
+    {
+        const Chunk* const chunk = m_chunks[row / CHUNK_SIZE].get();
+
+        return chunk && chunk->hasValue.test(row % CHUNK_SIZE);
+    }
+
+    virtual void Reserve(size_t numRows) override
+    {
+        m_chunks.reserve(GetChunksCount(numRows));
+    }
+
+    virtual void InsertRows(size_t pos, size_t numRows) override
+    {
+        if ( !numRows )
+            return;
+
+        const size_t oldNumRows = m_numRows;
+        Resize(oldNumRows + numRows);
+
+        // Move the values after the insertion point, starting from the end.
+        // Notice that nothing needs to be done when appending rows, which is
+        // the most common case.
+        for ( size_t row = oldNumRows; row > pos; )
+        {
+            row--;
+            MoveValue(row, row + numRows);
+        }
+    }
+
+    virtual void DeleteRows(size_t pos, size_t numRows) override
+    {
+        if ( !numRows )
+            return;
+
+        for ( size_t row = pos; row < pos + numRows; row++ )
+            ClearValue(row);
+
+        for ( size_t row = pos + numRows; row < m_numRows; row++ )
+            MoveValue(row, row - numRows);
+
+        Resize(m_numRows - numRows);
+    }
+
+    virtual void ClearValue(size_t row) override
+    {
+        if ( HasValue(row) )
+        {
+            DoClearValue(row);
+            Erase(row);
+        }
+    }
+
+    virtual void ClearAll() override
+    {
+        for ( auto& chunk : m_chunks )
+            chunk.reset();
+
+        DoClearAll();
+    }
+
+private:
+    // Called before the value in the given cell is discarded.
+    virtual void DoClearValue(size_t WXUNUSED(row)) { }
+
+    // Called after all the cells were made empty.
+    virtual void DoClearAll() { }
+
+    static constexpr size_t CHUNK_SIZE = 1024;
+
+    struct Chunk
+    {
+        std::bitset<CHUNK_SIZE> hasValue;
+
+        // Only the values for which hasValue bit is set are initialized.
+        T values[CHUNK_SIZE];
+    };
+
+    static size_t GetChunksCount(size_t numRows)
+    {
+        return (numRows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    }
+
+    // Change the number of rows, the cells being removed must be empty.
+    void Resize(size_t numRows)
+    {
+        m_chunks.resize(GetChunksCount(numRows));
+        m_numRows = numRows;
+    }
+
+    // Make the cell empty without calling DoClearValue().
+    void Erase(size_t row)
+    {
+        std::unique_ptr<Chunk>& chunk = m_chunks[row / CHUNK_SIZE];
+        if ( !chunk )
+            return;
+
+        chunk->hasValue.reset(row % CHUNK_SIZE);
+        if ( chunk->hasValue.none() )
+            chunk.reset();
+    }
+
+    // Move the value from one cell to another one, leaving the source empty.
+    void MoveValue(size_t from, size_t to)
+    {
+        if ( HasValue(from) )
+        {
+            Set(to, Get(from));
+            Erase(from);
+        }
+        else
+        {
+            Erase(to);
+        }
+    }
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+
+    size_t m_numRows;
+};
+
+// Column storing the values of the given type directly.
+template <typename T>
+class wxGridColumnarTable::ValueColumn : public ChunkedColumn<T>
+{
+public:
+    ValueColumn(wxGridColumnType type, size_t numRows)
+        : ChunkedColumn<T>(type, numRows)
+    {
+    }
+
+    virtual wxString GetValue(size_t row) const override
+    {
+        return ColumnValueToString(this->Get(row));
+    }
+
+    virtual bool SetValue(size_t row, const wxString& s) override
+    {
+        T value;
+        if ( !ColumnValueFromString(s, &value) )
+            return false;
+
+        this->Set(row, value);
+
+        return true;
+    }
+};
+
+// Column storing the strings using dictionary encoding: each distinct string
+// is stored only once and the cells only store its index in the dictionary.
+//
+// This is very efficient for the typical columns containing only a limited
+// number of distinct values, and not worse than storing the strings directly
+// for the columns containing mostly unique strings.
+class wxGridColumnarTable::StringColumn : public ChunkedColumn<wxUint32>
+{
+public:
+    explicit StringColumn(size_t numRows)
+        : ChunkedColumn(wxGRID_COLUMN_STRING, numRows)
+    {
+    }
+
+    virtual wxString GetValue(size_t row) const override
+    {
+        return m_entries[Get(row)]->first;
+    }
+
+    virtual bool SetValue(size_t row, const wxString& s) override
+    {
+        // Add the new string before releasing the old one to avoid removing
+        // it from the dictionary if it's the same.
+        const Index index = Intern(s);
+
+        if ( HasValue(row) )
+            Release(Get(row));
+
+        Set(row, index);
+
+        return true;
+    }
+
+private:
+    // The cells store the indices of the strings in m_entries.
+    using Index = wxUint32;
+
+    // The dictionary maps the strings to their indices and reference counts.
+    struct Entry
+    {
+        Index index;
+        Index refCount;
+    };
+
+    using Dictionary = std::unordered_map<wxString, Entry>;
+
+    Index Intern(const wxString& s)
+    {
+        const auto it = m_dictionary.find(s);
+        if ( it != m_dictionary.end() )
+        {
+            it->second.refCount++;
+            return it->second.index;
+        }
+
+        // Reuse the indices of the strings which are not used any more, if
+        // any, to avoid growing m_entries indefinitely.
+        Index index;
+        if ( m_unusedIndices.empty() )
+        {
+            index = static_cast<Index>(m_entries.size());
+            m_entries.push_back(Dictionary::iterator());
+        }
+        else
+        {
+            index = m_unusedIndices.back();
+            m_unusedIndices.pop_back();
+        }
+
+        m_entries[index] = m_dictionary.emplace(s, Entry{index, 1}).first;
+
+        return index;
+    }
+
+    void Release(Index index)
+    {
+        const auto it = m_entries[index];
+        if ( --it->second.refCount == 0 )
+        {
+            m_dictionary.erase(it);
+            m_unusedIndices.push_back(index);
+        }
+    }
+
+    virtual void DoClearValue(size_t row) override
+    {
+        Release(Get(row));
+    }
+
+    virtual void DoClearAll() override
+    {
+        m_dictionary.clear();
+        m_entries.clear();
+        m_unusedIndices.clear();
+    }
+
+    Dictionary m_dictionary;
+
+    // Dictionary elements indexed by the string index.
+    std::vector<Dictionary::iterator> m_entries;
+
+    std::vector<Index> m_unusedIndices;
+};
+
+wxIMPLEMENT_DYNAMIC_CLASS(wxGridColumnarTable, wxGridTableBase);
+
+wxGridColumnarTable::wxGridColumnarTable()
+    : wxGridTableBase()
+{
+    m_numRows = 0;
+}
+
+wxGridColumnarTable::wxGridColumnarTable( int numRows )
+    : wxGridTableBase()
+{
+    wxASSERT_MSG( numRows >= 0, "invalid number of rows" );
+
+    m_numRows = numRows;
+}
+
+wxGridColumnarTable::~wxGridColumnarTable()
+{
+}
+
+void wxGridColumnarTable::DoInsertColumns( size_t pos,
+                                           size_t numCols,
+                                           wxGridColumnType type )
+{
+    // Notice that only the pointers to the existing columns need to be moved
+    // here, their data is not affected at all.
+    std::vector<std::unique_ptr<Column>> columns(numCols);
+    for ( auto& column : columns )
+    {
+        switch ( type )
+        {
+            case wxGRID_COLUMN_STRING:
+                column.reset(new StringColumn(m_numRows));
+                break;
+
+            case wxGRID_COLUMN_INT:
+                column.reset(new ValueColumn<wxLongLong_t>(type, m_numRows));
+                break;
+
+            case wxGRID_COLUMN_DOUBLE:
+                column.reset(new ValueColumn<double>(type, m_numRows));
+                break;
+
+            case wxGRID_COLUMN_BOOL:
+                column.reset(new ValueColumn<bool>(type, m_numRows));
+                break;
+        }
+    }
+
+    m_columns.insert(m_columns.begin() + pos,
+                     std::make_move_iterator(columns.begin()),
+                     std::make_move_iterator(columns.end()));
+}
+
+void wxGridColumnarTable::AppendColumn( wxGridColumnType type,
+                                        const wxString& label )
+{
+    InsertColumn(m_columns.size(), type, label);
+}
+
+bool wxGridColumnarTable::InsertColumn( size_t pos,
+                                        wxGridColumnType type,
+                                        const wxString& label )
+{
+    wxCHECK_MSG( pos <= m_columns.size(), false,
+                 "invalid column index in wxGridColumnarTable" );
+
+    DoInsertColumns(pos, 1, type);
+    m_columns[pos]->m_label = label;
+
+    if ( GetView() )
+    {
+        if ( pos == m_columns.size() - 1 )
+        {
+            GetView()->ProcessTableMessage( this,
+                                    wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                    1 );
+        }
+        else
+        {
+            GetView()->ProcessTableMessage( this,
+                                    wxGRIDTABLE_NOTIFY_COLS_INSERTED,
+                                    pos,
+                                    1 );
+        }
+    }
+
+    return true;
+}
+
+wxGridColumnType wxGridColumnarTable::GetColumnType( int col ) const
+{
+    wxCHECK_MSG( col >= 0 && col < wxSsize(m_columns), wxGRID_COLUMN_STRING,
+                 "invalid column index in wxGridColumnarTable" );
+
+    return m_columns[col]->GetType();
+}
+
+void wxGridColumnarTable::ReserveRows( size_t numRows )
+{
+    for ( auto& column : m_columns )
+        column->Reserve(numRows);
+}
+
+wxGridColumnarTable::Column*
+wxGridColumnarTable::GetColumnForCell( int row, int col ) const
+{
+    wxCHECK_MSG( (row >= 0 && static_cast<size_t>(row) < m_numRows) &&
+                 (col >= 0 && col < wxSsize(m_columns)),
+                 nullptr,
+                 "invalid row or column index in wxGridColumnarTable" );
+
+    return m_columns[col].get();
+}
+
+void wxGridColumnarTable::ClearCell( int row, int col )
+{
+    Column* const column = GetColumnForCell(row, col);
+    if ( column )
+        column->ClearValue(row);
+}
+
+bool wxGridColumnarTable::IsEmptyCell( int row, int col )
+{
+    const Column* const column = GetColumnForCell(row, col);
+
+    return !column || !column->HasValue(row);
+}
+
+wxString wxGridColumnarTable::GetValue( int row, int col )
+{
+    const Column* const column = GetColumnForCell(row, col);
+    if ( !column || !column->HasValue(row) )
+        return wxString();
+
+    return column->GetValue(row);
+}
+
+void wxGridColumnarTable::SetValue( int row, int col, const wxString& value )
+{
+    Column* const column = GetColumnForCell(row, col);
+    if ( !column )
+        return;
+
+    // Empty strings are represented by empty cells in all columns and so are
+    // the values which can't be represented in the column type.
+    if ( value.empty() || !column->SetValue(row, value) )
+        column->ClearValue(row);
+}
+
+wxString wxGridColumnarTable::GetTypeName( int WXUNUSED(row), int col )
+{
+    switch ( GetColumnType(col) )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_INT:
+            return wxGRID_VALUE_NUMBER;
+
+        case wxGRID_COLUMN_DOUBLE:
+            return wxGRID_VALUE_FLOAT;
+
+        case wxGRID_COLUMN_BOOL:
+            return wxGRID_VALUE_BOOL;
+    }
+
+    return wxGRID_VALUE_STRING;
+}
+
+bool wxGridColumnarTable::CanGetValueAs( int row, int col,
+                                         const wxString& typeName )
+{
+    if ( typeName == wxGRID_VALUE_STRING )
+        return true;
+
+    // Empty cells can only be retrieved as (empty) strings, this ensures that
+    // the renderers show them as empty instead of showing 0 or false.
+    if ( IsEmptyCell(row, col) )
+        return false;
+
+    switch ( GetColumnType(col) )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_INT:
+            if ( typeName == wxGRID_VALUE_NUMBER )
+            {
+                // We can't return the values not fitting into long from
+                // GetValueAsLong(), they have to be retrieved as strings.
+                const wxLongLong_t value = GetValueAsInt64(row, col);
+                return value >= LONG_MIN && value <= LONG_MAX;
+            }
+
+            return typeName == wxGRID_VALUE_FLOAT;
+
+        case wxGRID_COLUMN_DOUBLE:
+            return typeName == wxGRID_VALUE_FLOAT;
+
+        case wxGRID_COLUMN_BOOL:
+            return typeName == wxGRID_VALUE_BOOL;
+    }
+
+    return false;
+}
+
+bool wxGridColumnarTable::CanSetValueAs( int WXUNUSED(row), int col,
+                                         const wxString& typeName )
+{
+    return typeName == wxGRID_VALUE_STRING ||
+            typeName == GetTypeName(0, col);
+}
+
+wxLongLong_t wxGridColumnarTable::GetValueAsInt64( int row, int col )
+{
+    const Column* const column = GetColumnForCell(row, col);
+    if ( !column || !column->HasValue(row) )
+        return 0;
+
+    switch ( column->GetType() )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_INT:
+            return static_cast<const ValueColumn<wxLongLong_t>*>(column)->Get(row);
+
+        case wxGRID_COLUMN_DOUBLE:
+            return static_cast<wxLongLong_t>(GetValueAsDouble(row, col));
+
+        case wxGRID_COLUMN_BOOL:
+            return GetValueAsBool(row, col);
+    }
+
+    return 0;
+}
+
+void wxGridColumnarTable::SetValueAsInt64( int row, int col, wxLongLong_t value )
+{
+    Column* const column = GetColumnForCell(row, col);
+    if ( !column )
+        return;
+
+    switch ( column->GetType() )
+    {
+        case wxGRID_COLUMN_STRING:
+            column->SetValue(row, ColumnValueToString(value));
+            break;
+
+        case wxGRID_COLUMN_INT:
+            static_cast<ValueColumn<wxLongLong_t>*>(column)->Set(row, value);
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            SetValueAsDouble(row, col, static_cast<double>(value));
+            break;
+
+        case wxGRID_COLUMN_BOOL:
+            SetValueAsBool(row, col, value != 0);
+            break;
+    }
+}
+
+long wxGridColumnarTable::GetValueAsLong( int row, int col )
+{
+    return static_cast<long>(GetValueAsInt64(row, col));
+}
+
+void wxGridColumnarTable::SetValueAsLong( int row, int col, long value )
+{
+    SetValueAsInt64(row, col, value);
+}
+
+double wxGridColumnarTable::GetValueAsDouble( int row, int col )
+{
+    const Column* const column = GetColumnForCell(row, col);
+    if ( !column || !column->HasValue(row) )
+        return 0.0;
+
+    switch ( column->GetType() )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_INT:
+            return static_cast<double>(GetValueAsInt64(row, col));
+
+        case wxGRID_COLUMN_DOUBLE:
+            return static_cast<const ValueColumn<double>*>(column)->Get(row);
+
+        case wxGRID_COLUMN_BOOL:
+            return GetValueAsBool(row, col) ? 1.0 : 0.0;
+    }
+
+    return 0.0;
+}
+
+void wxGridColumnarTable::SetValueAsDouble( int row, int col, double value )
+{
+    Column* const column = GetColumnForCell(row, col);
+    if ( !column )
+        return;
+
+    switch ( column->GetType() )
+    {
+        case wxGRID_COLUMN_STRING:
+            column->SetValue(row, ColumnValueToString(value));
+            break;
+
+        case wxGRID_COLUMN_INT:
+            SetValueAsInt64(row, col, static_cast<wxLongLong_t>(value));
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            static_cast<ValueColumn<double>*>(column)->Set(row, value);
+            break;
+
+        case wxGRID_COLUMN_BOOL:
+            SetValueAsBool(row, col, value != 0.0);
+            break;
+    }
+}
+
+bool wxGridColumnarTable::GetValueAsBool( int row, int col )
+{
+    const Column* const column = GetColumnForCell(row, col);
+    if ( !column || !column->HasValue(row) )
+        return false;
+
+    switch ( column->GetType() )
+    {
+        case wxGRID_COLUMN_STRING:
+            break;
+
+        case wxGRID_COLUMN_INT:
+            return GetValueAsInt64(row, col) != 0;
+
+        case wxGRID_COLUMN_DOUBLE:
+            return GetValueAsDouble(row, col) != 0.0;
+
+        case wxGRID_COLUMN_BOOL:
+            return static_cast<const ValueColumn<bool>*>(column)->Get(row);
+    }
+
+    return false;
+}
+
+void wxGridColumnarTable::SetValueAsBool( int row, int col, bool value )
+{
+    Column* const column = GetColumnForCell(row, col);
+    if ( !column )
+        return;
+
+    switch ( column->GetType() )
+    {
+        case wxGRID_COLUMN_STRING:
+            column->SetValue(row, ColumnValueToString(value));
+            break;
+
+        case wxGRID_COLUMN_INT:
+            static_cast<ValueColumn<wxLongLong_t>*>(column)->Set(row, value);
+            break;
+
+        case wxGRID_COLUMN_DOUBLE:
+            static_cast<ValueColumn<double>*>(column)->Set(row, value);
+            break;
+
+        case wxGRID_COLUMN_BOOL:
+            static_cast<ValueColumn<bool>*>(column)->Set(row, value);
+            break;
+    }
+}
+
+void wxGridColumnarTable::Clear()
+{
+    for ( auto& column : m_columns )
+        column->ClearAll();
+}
+
+bool wxGridColumnarTable::InsertRows( size_t pos, size_t numRows )
+{
+    if ( pos >= m_numRows )
+    {
+        return AppendRows( numRows );
+    }
+
+    for ( auto& column : m_columns )
+        column->InsertRows(pos, numRows);
+
+    m_numRows += numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_INSERTED,
+                                pos,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::AppendRows( size_t numRows )
+{
+    for ( auto& column : m_columns )
+        column->InsertRows(m_numRows, numRows);
+
+    m_numRows += numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_APPENDED,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::DeleteRows( size_t pos, size_t numRows )
+{
+    wxCHECK_MSG( pos < m_numRows, false,
+                 "invalid row index in wxGridColumnarTable::DeleteRows()" );
+
+    if ( numRows > m_numRows - pos )
+    {
+        numRows = m_numRows - pos;
+    }
+
+    for ( auto& column : m_columns )
+        column->DeleteRows(pos, numRows);
+
+    m_numRows -= numRows;
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_ROWS_DELETED,
+                                pos,
+                                numRows );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::InsertCols( size_t pos, size_t numCols )
+{
+    if ( pos >= m_columns.size() )
+    {
+        return AppendCols( numCols );
+    }
+
+    DoInsertColumns(pos, numCols, wxGRID_COLUMN_STRING);
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_INSERTED,
+                                pos,
+                                numCols );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::AppendCols( size_t numCols )
+{
+    DoInsertColumns(m_columns.size(), numCols, wxGRID_COLUMN_STRING);
+
+    if ( GetView() )
+    {
+        GetView()->ProcessTableMessage( this,
+                                wxGRIDTABLE_NOTIFY_COLS_APPENDED,
+                                numCols );
+    }
+
+    return true;
+}
+
+bool wxGridColumnarTable::DeleteCols( size_t pos, size_t numCols )
+{
+    wxCHECK_MSG( pos < m_columns.size(), false,
+                 "invalid column index in wxGridColumnarTable::DeleteCols()" );
+
+    if ( numCols > m_columns.size() - pos )
+    {
+        numCols = m_columns.size() - pos;
     }
 
+    const auto first = m_columns.begin() + pos;
+    m_columns.erase(first, first + numCols);
+
     if ( GetView() )
     {
         GetView()->ProcessTableMessage( this,
@@ -2183,72 +3335,49 @@ bool wxGridStringTable::DeleteCols( size_t pos, size_t numCols )
     return true;
 }
 
-wxString wxGridStringTable::GetRowLabelValue( int row )
+wxString wxGridColumnarTable::GetRowLabelValue( int row )
 {
-    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
-    {
-        // using default label
-        //
-        return wxGridTableBase::GetRowLabelValue( row );
-    }
-    else
-    {
+    if ( row >= 0 && row < wxSsize(m_rowLabels) )
         return m_rowLabels[row];
-    }
+
+    return wxGridTableBase::GetRowLabelValue( row );
 }
 
-wxString wxGridStringTable::GetColLabelValue( int col )
+wxString wxGridColumnarTable::GetColLabelValue( int col )
 {
-    if ( col > (int)(m_colLabels.GetCount()) - 1 )
-    {
-        // using default label
-        //
-        return wxGridTableBase::GetColLabelValue( col );
-    }
-    else
-    {
-        return m_colLabels[col];
-    }
+    if ( col >= 0 && col < wxSsize(m_columns) &&
+            !m_columns[col]->m_label.empty() )
+        return m_columns[col]->m_label;
+
+    return wxGridTableBase::GetColLabelValue( col );
 }
 
-void wxGridStringTable::SetRowLabelValue( int row, const wxString& value )
+void wxGridColumnarTable::SetRowLabelValue( int row, const wxString& value )
 {
-    if ( row > (int)(m_rowLabels.GetCount()) - 1 )
-    {
-        int n = m_rowLabels.GetCount();
-        int i;
+    wxCHECK_RET( row >= 0, "invalid row index in wxGridColumnarTable" );
 
-        for ( i = n; i <= row; i++ )
-        {
-            m_rowLabels.Add( wxGridTableBase::GetRowLabelValue(i) );
-        }
+    for ( int i = m_rowLabels.size(); i <= row; i++ )
+    {
+        m_rowLabels.Add( wxGridTableBase::GetRowLabelValue(i) );
     }
 
     m_rowLabels[row] = value;
 }
 
-void wxGridStringTable::SetColLabelValue( int col, const wxString& value )
+void wxGridColumnarTable::SetColLabelValue( int col, const wxString& value )
 {
-    if ( col > (int)(m_colLabels.GetCount()) - 1 )
-    {
-        int n = m_colLabels.GetCount();
-        int i;
-
-        for ( i = n; i <= col; i++ )
-        {
-            m_colLabels.Add( wxGridTableBase::GetColLabelValue(i) );
-        }
-    }
+    wxCHECK_RET( col >= 0 && col < wxSsize(m_columns),
+                 "invalid column index in wxGridColumnarTable" );
 
-    m_colLabels[col] = value;
+    m_columns[col]->m_label = value;
 }
 
-void wxGridStringTable::SetCornerLabelValue( const wxString& value )
+void wxGridColumnarTable::SetCornerLabelValue( const wxString& value )
 {
     m_cornerLabel = value;
 }
 
-wxString wxGridStringTable::GetCornerLabelValue() const
+wxString wxGridColumnarTable::GetCornerLabelValue() const
 {
     return m_cornerLabel;
 }
@@ -2402,18 +3531,125 @@ void wxGridWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
     wxRegion reg = GetUpdateRegion();
 
     wxGridCellCoordsVector dirtyCells = m_owner->CalcCellsExposed( reg , this );
-    m_owner->DrawGridCellArea( dc, dirtyCells );
 
-    m_owner->DrawGridSpace( dc, this );
+    // The attributes of the same cells are used many times below.
+    m_owner->StartCachingAttrs( dirtyCells );
+
+    if ( m_owner->IsRenderCacheEnabled() )
+    {
+        PaintUsingRenderCache( dc, reg );
+
+        m_owner->DrawOverlaySelection( dc, this );
+    }
+    else
+    {
+        ResetRenderCache();
+
+        m_owner->DrawGridCellArea( dc, dirtyCells );
 
-    m_owner->DrawAllGridWindowLines( dc, reg, this );
+        m_owner->DrawGridSpace( dc, this );
 
-    m_owner->DrawOverlaySelection( dc, this );
+        m_owner->DrawAllGridWindowLines( dc, reg, this );
 
-    if ( m_type != wxGridWindow::wxGridWindowNormal )
-        m_owner->DrawFrozenBorder( dc, this );
+        m_owner->DrawOverlaySelection( dc, this );
+
+        if ( m_type != wxGridWindow::wxGridWindowNormal )
+            m_owner->DrawFrozenBorder( dc, this );
+    }
 
     m_owner->DrawHighlight( dc, dirtyCells );
+
+    m_owner->StopCachingAttrs();
+}
+
+void wxGridWindow::PaintUsingRenderCache(wxDC& dc, const wxRegion& region)
+{
+    const wxSize size = GetClientSize();
+    if ( size.x <= 0 || size.y <= 0 )
+        return;
+
+    const wxPoint
+        origin = m_owner->CalcGridWindowUnscrolledPosition(wxPoint(0, 0), this);
+
+    if ( !m_renderCache.IsOk() || m_renderCache.GetLogicalSize() != size )
+    {
+        m_renderCache.CreateWithLogicalSize(size, GetContentScaleFactor());
+        m_renderCacheValid.Clear();
+    }
+    else if ( origin != m_renderCacheOrigin )
+    {
+        // The window was scrolled, move the part of the cached contents
+        // which remains visible.
+        const wxPoint delta = m_renderCacheOrigin - origin;
+
+        wxBitmap scrolled;
+        scrolled.CreateWithLogicalSize(size, GetContentScaleFactor());
+        {
+            wxMemoryDC dcDst(scrolled);
+            wxMemoryDC dcSrc(m_renderCache);
+            dcDst.Blit(delta, size, &dcSrc, wxPoint(0, 0));
+        }
+
+        m_renderCache = scrolled;
+
+        m_renderCacheValid.Offset(delta);
+        m_renderCacheValid.Intersect(wxRect(size));
+    }
+
+    m_renderCacheOrigin = origin;
+
+    // Render the parts of the update region not already in the cache.
+    wxRegion regionToRender(region);
+    regionToRender.Subtract(m_renderCacheValid);
+    if ( !regionToRender.IsEmpty() )
+    {
+        wxMemoryDC dcCache(m_renderCache);
+        dcCache.SetDeviceClippingRegion(regionToRender);
+        m_owner->PrepareDCFor(dcCache, this);
+
+        const wxGridCellCoordsVector
+            cells = m_owner->CalcCellsExposed(regionToRender, this);
+        m_owner->DrawGridCellArea(dcCache, cells);
+
+        m_owner->DrawGridSpace(dcCache, this);
+
+        m_owner->DrawAllGridWindowLines(dcCache, regionToRender, this);
+
+        if ( m_type != wxGridWindow::wxGridWindowNormal )
+            m_owner->DrawFrozenBorder(dcCache, this);
+
+        m_renderCacheValid.Union(regionToRender);
+    }
+
+    // And copy the cached contents to the window, the paint DC is already
+    // clipped to the update region.
+    dc.DrawBitmap(m_renderCache,
+                  dc.DeviceToLogicalX(0),
+                  dc.DeviceToLogicalY(0));
+}
+
+void wxGridWindow::Refresh(bool eraseBackground, const wxRect *rect)
+{
+    InvalidateRenderCache(rect);
+
+    wxGridSubwindow::Refresh(eraseBackground, rect);
+}
+
+void wxGridWindow::InvalidateRenderCache(const wxRect *rect)
+{
+    if ( m_renderCacheValid.IsEmpty() )
+        return;
+
+    if ( rect )
+        m_renderCacheValid.Subtract(*rect);
+    else
+        m_renderCacheValid.Clear();
+}
+
+void wxGridWindow::ResetRenderCache()
+{
+    m_renderCache = wxBitmap();
+    m_renderCacheValid.Clear();
 }
 
 void wxGrid::Render( wxDC& dc,
@@ -3108,9 +4344,9 @@ wxGrid::SetTable(wxGridTableBase *table,
 
         // kill row and column size arrays
         m_colWidths.Empty();
-        m_colRights.Empty();
+        m_colRights.clear();
         m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        m_rowBottoms.clear();
     }
 
     if (table)
@@ -3260,6 +4496,13 @@ void wxGrid::Init()
 
     m_batchCount = 0;
 
+    m_autoSizeMode = wxGRID_AUTOSIZE_ALL;
+    m_autoSizeSampleSize = 1000;
+    m_autoSizePercentile = 100;
+    m_autoSizeExtents = nullptr;
+
+    m_useRenderCache = false;
+
     m_extraWidth =
     m_extraHeight = 0;
 
@@ -3286,35 +4529,23 @@ void wxGrid::Init()
 void wxGrid::InitRowHeights()
 {
     m_rowHeights.Empty();
-    m_rowBottoms.Empty();
 
     m_rowHeights.Alloc( m_numRows );
-    m_rowBottoms.Alloc( m_numRows );
 
     m_rowHeights.Add( m_defaultRowHeight, m_numRows );
 
-    for ( int i = 0; i < m_numRows; i++ )
-    {
-        int rowBottom = ( GetRowPos( i ) + 1 ) * m_defaultRowHeight;
-        m_rowBottoms.Add( rowBottom );
-    }
+    m_rowBottoms.Assign( m_numRows, m_defaultRowHeight );
 }
 
 void wxGrid::InitColWidths()
 {
     m_colWidths.Empty();
-    m_colRights.Empty();
 
     m_colWidths.Alloc( m_numCols );
-    m_colRights.Alloc( m_numCols );
 
     m_colWidths.Add( m_defaultColWidth, m_numCols );
 
-    for ( int i = 0; i < m_numCols; i++ )
-    {
-        int colRight = ( GetColPos( i ) + 1 ) * m_defaultColWidth;
-        m_colRights.Add( colRight );
-    }
+    m_colRights.Assign( m_numCols, m_defaultColWidth );
 }
 
 int wxGrid::GetColWidth(int col) const
@@ -3328,16 +4559,16 @@ int wxGrid::GetColWidth(int col) const
 
 int wxGrid::GetColLeft(int col) const
 {
-    if ( m_colRights.IsEmpty() )
+    if ( m_colRights.empty() )
         return GetColPos( col ) * m_defaultColWidth;
 
-    return m_colRights[col] - GetColWidth(col);
+    return m_colRights.GetStart(GetColPos( col ));
 }
 
 int wxGrid::GetColRight(int col) const
 {
-    return m_colRights.IsEmpty() ? (GetColPos( col ) + 1) * m_defaultColWidth
-                                 : m_colRights[col];
+    return m_colRights.empty() ? (GetColPos( col ) + 1) * m_defaultColWidth
+                               : m_colRights.GetEnd(GetColPos( col ));
 }
 
 int wxGrid::GetRowHeight(int row) const
@@ -3352,16 +4583,16 @@ int wxGrid::GetRowHeight(int row) const
 
 int wxGrid::GetRowTop(int row) const
 {
-    if ( m_rowBottoms.IsEmpty() )
+    if ( m_rowBottoms.empty() )
         return GetRowPos( row ) * m_defaultRowHeight;
 
-    return m_rowBottoms[row] - GetRowHeight(row);
+    return m_rowBottoms.GetStart(GetRowPos( row ));
 }
 
 int wxGrid::GetRowBottom(int row) const
 {
-    return m_rowBottoms.IsEmpty() ? (GetRowPos( row ) + 1) * m_defaultRowHeight
-                                  : m_rowBottoms[row];
+    return m_rowBottoms.empty() ? (GetRowPos( row ) + 1) * m_defaultRowHeight
+                                : m_rowBottoms.GetEnd(GetRowPos( row ));
 }
 
 void wxGrid::CalcDimensions()
@@ -3531,21 +4762,10 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
 
             if ( !m_rowHeights.IsEmpty() )
             {
+                // The new rows are inserted at the same position as their
+                // index, even if the rows are reordered.
                 m_rowHeights.Insert( m_defaultRowHeight, pos, numRows );
-                m_rowBottoms.Insert( 0, pos, numRows );
-
-                int bottom = 0;
-                if ( pos > 0 )
-                    bottom = m_rowBottoms[GetRowAt( pos - 1 )];
-
-                int rowPos;
-                for ( rowPos = pos; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
-
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
+                m_rowBottoms.Insert( pos, numRows, m_defaultRowHeight );
             }
 
             UpdateCurrentCellOnRedim();
@@ -3586,20 +4806,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.Add( m_defaultRowHeight, numRows );
-                m_rowBottoms.Add( 0, numRows );
-
-                int bottom = 0;
-                if ( oldNumRows > 0 )
-                    bottom = m_rowBottoms[oldNumRows - 1];
-
-                int rowPos;
-                for ( rowPos = oldNumRows; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
-
-                    bottom += GetRowHeight(i);
-                    m_rowBottoms[i] = bottom;
-                }
+                m_rowBottoms.Insert( oldNumRows, numRows, m_defaultRowHeight );
             }
 
             UpdateCurrentCellOnRedim();
@@ -3639,17 +4846,14 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_rowHeights.IsEmpty() )
             {
                 m_rowHeights.RemoveAt( pos, numRows );
-                m_rowBottoms.RemoveAt( pos, numRows );
-
-                int h = 0;
-                int rowPos;
-                for ( rowPos = 0; rowPos < m_numRows; rowPos++ )
-                {
-                    i = GetRowAt( rowPos );
 
-                    h += GetRowHeight(i);
-                    m_rowBottoms[i] = h;
-                }
+                // If the rows are not reordered, the deleted rows are at the
+                // same positions as their indices, otherwise just recompute
+                // everything.
+                if ( m_rowAt.IsEmpty() )
+                    m_rowBottoms.Remove( pos, numRows );
+                else
+                    m_rowBottoms.Assign( m_rowHeights, m_rowAt );
             }
 
             UpdateCurrentCellOnRedim();
@@ -3710,21 +4914,10 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
 
             if ( !m_colWidths.IsEmpty() )
             {
+                // As with the rows, the new columns positions are the same as
+                // their indices.
                 m_colWidths.Insert( m_defaultColWidth, pos, numCols );
-                m_colRights.Insert( 0, pos, numCols );
-
-                int right = 0;
-                if ( pos > 0 )
-                    right = m_colRights[GetColAt( pos - 1 )];
-
-                int colPos;
-                for ( colPos = pos; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    right += GetColWidth(i);
-                    m_colRights[i] = right;
-                }
+                m_colRights.Insert( pos, numCols, m_defaultColWidth );
             }
 
             // See comment for wxGRIDTABLE_NOTIFY_COLS_APPENDED case explaining
@@ -3770,20 +4963,7 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.Add( m_defaultColWidth, numCols );
-                m_colRights.Add( 0, numCols );
-
-                int right = 0;
-                if ( oldNumCols > 0 )
-                    right = m_colRights[GetColAt( oldNumCols - 1 )];
-
-                int colPos;
-                for ( colPos = oldNumCols; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
-
-                    right += GetColWidth(i);
-                    m_colRights[i] = right;
-                }
+                m_colRights.Insert( oldNumCols, numCols, m_defaultColWidth );
             }
 
             // Notice that this must be called after updating m_colWidths above
@@ -3829,17 +5009,11 @@ bool wxGrid::Redimension( const wxGridTableMessage& msg )
             if ( !m_colWidths.IsEmpty() )
             {
                 m_colWidths.RemoveAt( pos, numCols );
-                m_colRights.RemoveAt( pos, numCols );
-
-                int w = 0;
-                int colPos;
-                for ( colPos = 0; colPos < m_numCols; colPos++ )
-                {
-                    i = GetColAt( colPos );
 
-                    w += GetColWidth(i);
-                    m_colRights[i] = w;
-                }
+                if ( m_colAt.IsEmpty() )
+                    m_colRights.Remove( pos, numCols );
+                else
+                    m_colRights.Assign( m_colWidths, m_colAt );
             }
 
             // See comment for wxGRIDTABLE_NOTIFY_COLS_APPENDED case explaining
@@ -5458,20 +6632,7 @@ void wxGrid::RefreshAfterRowPosChange()
     // unless we calculate them dynamically because all rows heights are the
     // same and it's easy to do
     if ( !m_rowHeights.empty() )
-    {
-        int rowBottom = 0;
-        for ( int rowPos = 0; rowPos < m_numRows; rowPos++ )
-        {
-            int rowID = GetRowAt( rowPos );
-
-            // Ignore the currently hidden rows.
-            const int height = m_rowHeights[rowID];
-            if ( height > 0 )
-                rowBottom += height;
-
-            m_rowBottoms[rowID] = rowBottom;
-        }
-    }
+        m_rowBottoms.Assign( m_rowHeights, m_rowAt );
 
     // and make the changes visible
     RefreshArea(wxGA_Cells | wxGA_RowLabels);
@@ -5559,20 +6720,7 @@ void wxGrid::RefreshAfterColPosChange()
     // unless we calculate them dynamically because all columns widths are the
     // same and it's easy to do
     if ( !m_colWidths.empty() )
-    {
-        int colRight = 0;
-        for ( int colPos = 0; colPos < m_numCols; colPos++ )
-        {
-            int colID = GetColAt( colPos );
-
-            // Ignore the currently hidden columns.
-            const int width = m_colWidths[colID];
-            if ( width > 0 )
-                colRight += width;
-
-            m_colRights[colID] = colRight;
-        }
-    }
+        m_colRights.Assign( m_colWidths, m_colAt );
 
     int areas = wxGA_Cells;
 
@@ -5983,6 +7131,36 @@ void wxGrid::Refresh(bool eraseb, const wxRect* rect)
     // EndBatch() will do all this on the last nested one anyway.
     if ( ShouldRefresh() )
     {
+        // Refreshing this window refreshes the grid windows too, but without
+        // calling their Refresh(), so invalidate their render cache manually.
+        if ( m_useRenderCache )
+        {
+            wxGridWindow* const gridWindows[] =
+            {
+                m_gridWin,
+                m_frozenColGridWin,
+                m_frozenRowGridWin,
+                m_frozenCornerGridWin
+            };
+
+            for ( wxGridWindow* const gridWindow : gridWindows )
+            {
+                if ( !gridWindow )
+                    continue;
+
+                if ( rect )
+                {
+                    wxRect rectWin(*rect);
+                    rectWin.Offset(-gridWindow->GetPosition());
+                    gridWindow->InvalidateRenderCache(&rectWin);
+                }
+                else
+                {
+                    gridWindow->InvalidateRenderCache();
+                }
+            }
+        }
+
         wxScrolledCanvas::Refresh(eraseb, rect);
 
         // Notice that this function expects the rectangle to be relative
@@ -6113,34 +7291,206 @@ void wxGrid::RefreshRect(wxRect* rect)
         const bool refreshColLabels = GetColLabelSize() > 0 && rect->x >= -1 && rect->width > 0;
         const bool refreshRowLabels = GetRowLabelSize() > 0 && rect->y >= -1 && rect->height > 0;
 
-        rect->Offset(GetRowLabelSize(), GetColLabelSize());
-        rect->Inflate(3); // +2 to fix refresh problems with wxQt under Kubuntu
+        rect->Offset(GetRowLabelSize(), GetColLabelSize());
+        rect->Inflate(3); // +2 to fix refresh problems with wxQt under Kubuntu
+
+        // Refresh the cell(s) area
+        if ( refreshCells )
+        {
+            Refresh(false, rect);
+        }
+
+        // Refresh the corresponding col label(s)
+        if ( refreshColLabels )
+        {
+            const wxRect r(rect->x, 0, rect->width, GetColLabelSize() + 2);
+
+            Refresh(false, &r);
+        }
+
+        // Refresh the corresponding row label(s)
+        if ( refreshRowLabels )
+        {
+            const wxRect r(0, rect->y, GetRowLabelSize() + 2, rect->height);
+
+            Refresh(false, &r);
+        }
+    }
+    else
+    {
+        Refresh();
+    }
+}
+
+void wxGrid::RefreshCells(const wxGridCellCoordsVector& cells)
+{
+    // EndBatch() will refresh everything anyhow.
+    if ( !ShouldRefresh() )
+        return;
+
+    // Refresh the cells a bit later, to give the caller a chance to mark more
+    // cells as dirty, and refresh all of them at once then.
+    const bool wasEmpty = m_dirtyCells.empty();
+
+    m_dirtyCells.insert(m_dirtyCells.end(), cells.begin(), cells.end());
+
+    if ( wasEmpty && !m_dirtyCells.empty() )
+        CallAfter(&wxGrid::RefreshDirtyCells);
+}
+
+bool wxGrid::CellMayOverflow(int row, int col) const
+{
+    if ( !GetCellFitMode(row, col).IsOverflow() )
+        return false;
+
+    // Columns positions don't correspond to their indices, don't bother
+    // finding the neighbouring columns in this case.
+    if ( !m_colAt.empty() )
+        return true;
+
+    // The cell contents can only overflow into the empty cells, so check if
+    // we have any of them around.
+    if ( !m_table )
+        return true;
+
+    return (col > 0 && m_table->IsEmptyCell(row, col - 1)) ||
+           (col < m_numCols - 1 && m_table->IsEmptyCell(row, col + 1));
+}
+
+void wxGrid::RefreshDirtyCells()
+{
+    wxGridCellCoordsVector cells;
+    cells.swap(m_dirtyCells);
+
+    if ( !ShouldRefresh() )
+        return;
+
+    // Sort the cells by rows to find the adjacent ones below.
+    std::sort(cells.begin(), cells.end(),
+              [](const wxGridCellCoords& c1, const wxGridCellCoords& c2)
+              {
+                return c1.GetRow() < c2.GetRow() ||
+                        (c1.GetRow() == c2.GetRow() && c1.GetCol() < c2.GetCol());
+              });
+    cells.erase(std::unique(cells.begin(), cells.end()), cells.end());
+
+    struct DirtyRect
+    {
+        wxGridWindow* gridWindow;
+        wxRect rect;
+    };
+    std::vector<DirtyRect> dirtyRects;
+
+    for ( const auto& cell : cells )
+    {
+        const int row = cell.GetRow(),
+                  col = cell.GetCol();
+
+        // The grid could have been changed since the cell was marked as dirty.
+        if ( row < 0 || row >= m_numRows || col < 0 || col >= m_numCols )
+            continue;
+
+        wxGridWindow* const gridWindow = CellToGridWindow(row, col);
+
+        wxRect rect = CellToRect(row, col);
+        rect.Inflate(1);
+        CalcGridWindowScrolledPosition(rect.x, rect.y, &rect.x, &rect.y,
+                                       gridWindow);
+
+        const wxSize size = gridWindow->GetClientSize();
+        if ( CellMayOverflow(row, col) )
+        {
+            // Refresh the entire row, as in SetCellValue().
+            rect.x = 0;
+            rect.width = size.x;
+        }
+
+        if ( !rect.Intersects(wxRect(size)) )
+            continue;
+
+        // Merge the rectangles of the adjacent cells in the same row.
+        if ( !dirtyRects.empty() )
+        {
+            DirtyRect& last = dirtyRects.back();
+            if ( last.gridWindow == gridWindow &&
+                    last.rect.y == rect.y &&
+                        last.rect.height == rect.height &&
+                            last.rect.GetRight() + 1 >= rect.x )
+            {
+                last.rect.Union(rect);
+                continue;
+            }
+        }
+
+        dirtyRects.push_back({gridWindow, rect});
+    }
+
+    // Refreshing too many small rectangles is slower than refreshing a bigger
+    // one containing all of them, so limit their number for each window.
+    static const size_t MAX_DIRTY_RECTS = 64;
+
+    wxGridWindow* const gridWindows[] =
+    {
+        m_gridWin,
+        m_frozenColGridWin,
+        m_frozenRowGridWin,
+        m_frozenCornerGridWin
+    };
+
+    for ( wxGridWindow* const gridWindow : gridWindows )
+    {
+        if ( !gridWindow )
+            continue;
 
-        // Refresh the cell(s) area
-        if ( refreshCells )
+        size_t count = 0;
+        wxRect boundingRect;
+        for ( const auto& dirty : dirtyRects )
         {
-            Refresh(false, rect);
+            if ( dirty.gridWindow == gridWindow )
+            {
+                boundingRect.Union(dirty.rect);
+                count++;
+            }
         }
 
-        // Refresh the corresponding col label(s)
-        if ( refreshColLabels )
+        if ( count > MAX_DIRTY_RECTS )
         {
-            const wxRect r(rect->x, 0, rect->width, GetColLabelSize() + 2);
-
-            Refresh(false, &r);
+            gridWindow->Refresh(false, &boundingRect);
+            continue;
         }
 
-        // Refresh the corresponding row label(s)
-        if ( refreshRowLabels )
+        for ( const auto& dirty : dirtyRects )
         {
-            const wxRect r(0, rect->y, GetRowLabelSize() + 2, rect->height);
-
-            Refresh(false, &r);
+            if ( dirty.gridWindow == gridWindow )
+                gridWindow->Refresh(false, &dirty.rect);
         }
     }
-    else
+}
+
+void wxGrid::EnableRenderCache(bool enable)
+{
+    if ( enable == m_useRenderCache )
+        return;
+
+    m_useRenderCache = enable;
+
+    // The cache will be created when the window is repainted the next time,
+    // but destroy it immediately if it's not needed any longer.
+    if ( !enable )
     {
-        Refresh();
+        wxGridWindow* const gridWindows[] =
+        {
+            m_gridWin,
+            m_frozenColGridWin,
+            m_frozenRowGridWin,
+            m_frozenCornerGridWin
+        };
+
+        for ( wxGridWindow* const gridWindow : gridWindows )
+        {
+            if ( gridWindow )
+                gridWindow->ResetRenderCache();
+        }
     }
 }
 
@@ -6207,7 +7557,6 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
     // inside InitPixelFields() above).
     if ( !m_rowHeights.empty() )
     {
-        int total = 0;
         for ( unsigned i = 0; i < m_rowHeights.size(); ++i )
         {
             int height = m_rowHeights[i];
@@ -6216,12 +7565,10 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
             if ( height <= 0 )
                 continue;
 
-            height = event.ScaleY(height);
-            total += height;
-
-            m_rowHeights[i] = height;
-            m_rowBottoms[i] = total;
+            m_rowHeights[i] = event.ScaleY(height);
         }
+
+        m_rowBottoms.Assign( m_rowHeights, m_rowAt );
     }
 
     // Similarly for columns, except that here we need to update the native
@@ -6231,7 +7578,6 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
         colHeader = m_useNativeHeader ? GetGridColHeader() : nullptr;
     if ( !m_colWidths.empty() )
     {
-        int total = 0;
         for ( unsigned i = 0; i < m_colWidths.size(); ++i )
         {
             int width = m_colWidths[i];
@@ -6239,15 +7585,13 @@ void wxGrid::OnDPIChanged(wxDPIChangedEvent& event)
             if ( width <= 0 )
                 continue;
 
-            width = event.ScaleX(width);
-            total += width;
-
-            m_colWidths[i] = width;
-            m_colRights[i] = total;
+            m_colWidths[i] = event.ScaleX(width);
 
             if ( colHeader )
                 colHeader->UpdateColumn(i);
         }
+
+        m_colRights.Assign( m_colWidths, m_colAt );
     }
     else if ( colHeader )
     {
@@ -8329,9 +9673,8 @@ wxGridCellCoords wxGrid::XYToCell(int x, int y, wxGridWindow *gridWindow) const
 }
 
 // compute row or column from some (unscrolled) coordinate value, using either
-// m_defaultRowHeight/m_defaultColWidth or binary search on array of
-// m_rowBottoms/m_colRights to do it quickly in O(log n) time.
-// NOTE: This may not work correctly for reordered columns.
+// m_defaultRowHeight/m_defaultColWidth or m_rowBottoms/m_colRights to do it
+// quickly in O(log n) time.
 int wxGrid::PosToLinePos(int coord,
                          bool clipToMinMax,
                          const wxGridOperations& oper,
@@ -8350,7 +9693,7 @@ int wxGrid::PosToLinePos(int coord,
 
     // check for the simplest case: if we have no explicit line sizes
     // configured, then we already know the line this position falls in
-    const wxArrayInt& lineEnds = oper.GetLineEnds(this);
+    const wxGridLineEnds& lineEnds = oper.GetLineEnds(this);
     if ( lineEnds.empty() )
     {
         if ( maxPos < (numLines + minPos) )
@@ -8359,45 +9702,18 @@ int wxGrid::PosToLinePos(int coord,
         return clipToMinMax ? numLines + minPos - 1 : -1;
     }
 
-    // binary search is quite efficient and we can't really make any assumptions
-    // on where to start here since row and columns could be of size 0 if they are
-    // hidden. While this could be made more efficient, some profiling will be
-    // necessary to determine if it really is a performance bottleneck
     maxPos = numLines + minPos - 1;
 
-    // check if the position is beyond the last column
-    const int lineAtMaxPos = oper.GetLineAt(this, maxPos);
-    if ( coord >= lineEnds[lineAtMaxPos] )
+    // check if the position is beyond the last line of this window
+    if ( coord >= lineEnds.GetEnd(maxPos) )
         return clipToMinMax ? maxPos : wxNOT_FOUND;
 
     // or before the first one
-    const int lineAt0 = oper.GetLineAt(this, minPos);
-    if ( coord < oper.GetLineStartPos(this, lineAt0) )
+    if ( coord < lineEnds.GetStart(minPos) )
         return clipToMinMax ? minPos : wxNOT_FOUND;
-    else if ( coord < lineEnds[lineAt0] )
-        return minPos;
-
-    // finally do perform the binary search
-    while ( minPos < maxPos )
-    {
-        wxCHECK_MSG( lineEnds[oper.GetLineAt(this, minPos)] <= coord &&
-                        coord < lineEnds[oper.GetLineAt(this, maxPos)],
-                     -1,
-                     "wxGrid: internal error in PosToLinePos()" );
-
-        if ( coord >= lineEnds[oper.GetLineAt(this, maxPos - 1)] )
-            return maxPos;
-        else
-            maxPos--;
-
-        const int median = minPos + (maxPos - minPos + 1) / 2;
-        if ( coord < lineEnds[oper.GetLineAt(this, median)] )
-            maxPos = median;
-        else
-            minPos = median;
-    }
 
-    return maxPos;
+    // otherwise just find the line containing it
+    return static_cast<int>(lineEnds.FindLine(coord));
 }
 
 int
@@ -9927,6 +11243,53 @@ void wxGrid::ClearAttrCache()
         // to invalidate the cache  before calling wxSafeDecRef!
         wxSafeDecRef(oldAttr);
     }
+
+    // Keep using the painting cache, if we're painting, but forget all the
+    // attributes stored in it, for the same reason as above.
+    for ( auto& attr : m_paintAttrs )
+    {
+        wxGridCellAttr *oldAttr = attr;
+        attr = nullptr;
+        wxSafeDecRef(oldAttr);
+    }
+}
+
+void wxGrid::StartCachingAttrs(const wxGridCellCoordsVector& cells)
+{
+    if ( cells.empty() )
+        return;
+
+    int top = m_numRows,
+        left = m_numCols,
+        bottom = -1,
+        right = -1;
+    for ( const auto& cell : cells )
+    {
+        top = wxMin(top, cell.GetRow());
+        left = wxMin(left, cell.GetCol());
+        bottom = wxMax(bottom, cell.GetRow());
+        right = wxMax(right, cell.GetCol());
+    }
+
+    // Don't use the cache if the cells are sparse, as may happen if the
+    // columns are reordered, because it would need too much memory then.
+    const size_t
+        area = static_cast<size_t>(bottom - top + 1)*(right - left + 1);
+    if ( area > 4*cells.size() )
+        return;
+
+    m_paintAttrsBlock = wxGridBlockCoords(top, left, bottom, right);
+    m_paintAttrs.assign(area, nullptr);
+}
+
+void wxGrid::StopCachingAttrs()
+{
+    std::vector<wxGridCellAttr*> attrs;
+    attrs.swap(m_paintAttrs);
+    m_paintAttrsBlock = wxGridBlockCoords();
+
+    for ( auto attr : attrs )
+        wxSafeDecRef(attr);
 }
 
 void wxGrid::RefreshAttr(int row, int col)
@@ -9975,6 +11338,22 @@ bool wxGrid::LookupAttr(int row, int col, wxGridCellAttr **attr) const
 
 wxGridCellAttr *wxGrid::GetCellAttr(int row, int col) const
 {
+    // Check the painting cache first, if we're using it.
+    wxGridCellAttr **paintAttr = nullptr;
+    if ( !m_paintAttrs.empty() &&
+            m_paintAttrsBlock.Contains(wxGridCellCoords(row, col)) )
+    {
+        const int
+            width = m_paintAttrsBlock.GetRightCol() - m_paintAttrsBlock.GetLeftCol() + 1;
+        paintAttr = &m_paintAttrs[(row - m_paintAttrsBlock.GetTopRow())*width
+                                    + col - m_paintAttrsBlock.GetLeftCol()];
+        if ( *paintAttr )
+        {
+            (*paintAttr)->IncRef();
+            return *paintAttr;
+        }
+    }
+
     wxGridCellAttr *attr = nullptr;
     // Additional test to avoid looking at the cache e.g. for
     // wxNoCellCoords, as this will confuse memory management.
@@ -9998,6 +11377,12 @@ wxGridCellAttr *wxGrid::GetCellAttr(int row, int col) const
         attr->IncRef();
     }
 
+    if ( paintAttr )
+    {
+        attr->IncRef();
+        *paintAttr = attr;
+    }
+
     return attr;
 }
 
@@ -10088,6 +11473,19 @@ void wxGrid::SetAttr(int row, int col, wxGridCellAttr *attr)
     }
 }
 
+void wxGrid::SetBlockAttr(const wxGridBlockCoords& block, wxGridCellAttr *attr)
+{
+    if ( CanHaveAttributes() )
+    {
+        m_table->SetBlockAttr(attr, block);
+        ClearAttrCache();
+    }
+    else
+    {
+        wxSafeDecRef(attr);
+    }
+}
+
 void wxGrid::SetRowAttr(int row, wxGridCellAttr *attr)
 {
     if ( CanHaveAttributes() )
@@ -10355,7 +11753,7 @@ void wxGrid::SetDefaultRowSize( int height, bool resizeExistingRows )
         // arrays (which also allows us to take advantage of
         // some speed optimisations)
         m_rowHeights.Empty();
-        m_rowBottoms.Empty();
+        m_rowBottoms.clear();
         CalcDimensions();
     }
 }
@@ -10456,11 +11854,7 @@ void wxGrid::DoSetRowSize( int row, int height )
     if ( !diff )
         return;
 
-
-    for ( int rowPos = GetRowPos(row); rowPos < m_numRows; rowPos++ )
-    {
-        m_rowBottoms[GetRowAt(rowPos)] += diff;
-    }
+    m_rowBottoms.Add(GetRowPos(row), diff);
 
     InvalidateBestSize();
 
@@ -10524,7 +11918,7 @@ void wxGrid::SetDefaultColSize( int width, bool resizeExistingCols )
         // arrays (which also allows us to take advantage of
         // some speed optimisations)
         m_colWidths.Empty();
-        m_colRights.Empty();
+        m_colRights.clear();
 
         CalcDimensions();
     }
@@ -10605,10 +11999,7 @@ void wxGrid::DoSetColSize( int col, int width )
     }
     //else: will be refreshed when the header is redrawn
 
-    for ( int colPos = GetColPos(col); colPos < m_numCols; colPos++ )
-    {
-        m_colRights[GetColAt(colPos)] += diff;
-    }
+    m_colRights.Add(GetColPos(col), diff);
 
     InvalidateBestSize();
 
@@ -10737,6 +12128,100 @@ void wxGrid::SetNativeHeaderColOrder()
 // auto sizing
 // ----------------------------------------------------------------------------
 
+wxSize
+wxGridTextExtentCache::GetMultiLineTextExtent(wxReadOnlyDC& dc,
+                                              const wxFont& font,
+                                              const wxString& text)
+{
+    FontExtents* fontExtents = nullptr;
+    for ( auto& fe : m_fonts )
+    {
+        if ( fe.font == font )
+        {
+            fontExtents = &fe;
+            break;
+        }
+    }
+
+    if ( !fontExtents )
+    {
+        m_fonts.emplace_back(font);
+        fontExtents = &m_fonts.back();
+    }
+
+    const auto it = fontExtents->extents.find(text);
+    if ( it != fontExtents->extents.end() )
+        return it->second;
+
+    dc.SetFont(font);
+    const wxSize size = dc.GetMultiLineTextExtent(text);
+
+    if ( fontExtents->extents.size() < MAX_STRINGS_PER_FONT )
+        fontExtents->extents.emplace(text, size);
+
+    return size;
+}
+
+namespace
+{
+
+// Creates the text extent cache used by wxGrid during its lifetime, unless
+// it already exists, i.e. auto-sizing is already in progress.
+class wxGridAutoSizeCacheCreator
+{
+public:
+    explicit wxGridAutoSizeCacheCreator(wxGridTextExtentCache*& cache)
+        : m_cache(cache),
+          m_owned(cache == nullptr)
+    {
+        if ( m_owned )
+            m_cache = new wxGridTextExtentCache();
+    }
+
+    ~wxGridAutoSizeCacheCreator()
+    {
+        if ( m_owned )
+        {
+            delete m_cache;
+            m_cache = nullptr;
+        }
+    }
+
+private:
+    wxGridTextExtentCache*& m_cache;
+    const bool m_owned;
+
+    wxDECLARE_NO_COPY_CLASS(wxGridAutoSizeCacheCreator);
+};
+
+} // anonymous namespace
+
+void wxGrid::SetAutoSizeMode(wxGridAutoSizeMode mode, int sampleSize)
+{
+    wxCHECK_RET( sampleSize > 0, "sample size must be positive" );
+
+    m_autoSizeMode = mode;
+    m_autoSizeSampleSize = sampleSize;
+}
+
+void wxGrid::SetAutoSizePercentile(int percentile)
+{
+    wxCHECK_RET( percentile > 0 && percentile <= 100, "invalid percentile" );
+
+    m_autoSizePercentile = percentile;
+}
+
+wxSize wxGrid::GetCellTextExtent(wxReadOnlyDC& dc,
+                                 const wxFont& font,
+                                 const wxString& text) const
+{
+    if ( m_autoSizeExtents )
+        return m_autoSizeExtents->GetMultiLineTextExtent(dc, font, text);
+
+    dc.SetFont(font);
+    return dc.GetMultiLineTextExtent(text);
+}
+
 void
 wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
 {
@@ -10760,6 +12245,8 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
     // wxGridCellRenderer that we call below.
     wxClientDC dc(m_gridWin);
 
+    wxGridAutoSizeCacheCreator cacheCreator(m_autoSizeExtents);
+
     AcceptCellEditControlIfShown();
 
     // initialize both of them just to avoid compiler warnings even if only
@@ -10785,90 +12272,164 @@ wxGrid::AutoSizeColOrRow(int colOrRow, bool setAsMin, wxGridDirection direction)
     wxGridCellAttrPtr attr;
     wxGridCellRendererPtr renderer;
 
-    wxCoord extent, extentMax = 0;
-    int max = column ? m_numRows : m_numCols;
-    for ( int rowOrCol = 0; rowOrCol < max; rowOrCol++ )
+    // Determine the ranges of positions of the cells to measure, together
+    // with the number of cells to measure in each of them: if it is less than
+    // the size of the range, the cells in it are sampled uniformly.
+    struct PosRange
     {
-        if ( column )
-        {
-            if ( !IsRowShown(rowOrCol) )
-                continue;
+        int begin, end, count;
+    };
+    std::vector<PosRange> ranges;
 
-            row = rowOrCol;
-            col = colOrRow;
-        }
-        else
+    const int max = column ? m_numRows : m_numCols;
+    if ( m_autoSizeMode == wxGRID_AUTOSIZE_VISIBLE )
+    {
+        // The frozen cells are always visible.
+        const int numFrozen = column ? m_numFrozenRows : m_numFrozenCols;
+        if ( numFrozen )
+            ranges.push_back({0, numFrozen, numFrozen});
+
+        int w, h;
+        m_gridWin->GetClientSize(&w, &h);
+        if ( w > 0 && h > 0 )
         {
-            if ( !IsColShown(rowOrCol) )
-                continue;
+            int x1, y1, x2, y2;
+            CalcGridWindowUnscrolledPosition(0, 0, &x1, &y1, m_gridWin);
+            CalcGridWindowUnscrolledPosition(w - 1, h - 1, &x2, &y2, m_gridWin);
 
-            row = colOrRow;
-            col = rowOrCol;
+            const int first = column ? YToPos(y1, m_gridWin)
+                                     : XToPos(x1, m_gridWin);
+            const int last = column ? YToPos(y2, m_gridWin)
+                                    : XToPos(x2, m_gridWin);
+            if ( first != wxNOT_FOUND && last >= first )
+                ranges.push_back({first, last + 1, last - first + 1});
         }
+    }
 
-        // we need to account for the cells spanning multiple columns/rows:
-        // while they may need a lot of space, they don't need all of it in
-        // this column/row
-        int numRows, numCols;
-        const CellSpan span = GetCellSize(row, col, &numRows, &numCols);
-        if ( span == CellSpan_Inside )
-        {
-            // we need to get the size of the main cell, not of a cell hidden
-            // by it
-            row += numRows;
-            col += numCols;
+    // Also use sampling if the window is not visible yet.
+    if ( ranges.empty() )
+    {
+        const int count = m_autoSizeMode == wxGRID_AUTOSIZE_ALL
+                            ? max
+                            : wxMin(max, m_autoSizeSampleSize);
+        ranges.push_back({0, max, count});
+    }
 
-            // get the size of the main cell too
-            GetCellSize(row, col, &numRows, &numCols);
-        }
+    // The extents of all the cells are only needed if we don't just use the
+    // maximal one.
+    std::vector<wxCoord> extents;
+
+    wxCoord extent, extentMax = 0;
+    bool done = false;
+    for ( const auto& range : ranges )
+    {
+        if ( done )
+            break;
 
-        // get cell ( main cell if CellSpan_Inside ) renderer best size
-        if ( !canReuseAttr || !attr )
+        for ( int n = 0; n < range.count; n++ )
         {
-            attr = GetCellAttrPtr(row, col);
-            renderer = attr->GetRendererPtr(this, row, col);
+            int pos = range.begin;
+            if ( range.count == range.end - range.begin )
+                pos += n;
+            else
+                pos += static_cast<int>(static_cast<long long>(n)
+                                        * (range.end - range.begin)
+                                        / range.count);
 
-            if ( canReuseAttr )
+            if ( column )
             {
-                // Try to get the best width for the entire column at once, if
-                // it's supported by the renderer.
-                extent = renderer->GetMaxBestSize(*this, *attr, dc).x;
+                row = GetRowAt(pos);
+                if ( !IsRowShown(row) )
+                    continue;
 
-                if ( extent != wxDefaultCoord )
-                {
-                    extentMax = extent;
+                col = colOrRow;
+            }
+            else
+            {
+                col = GetColAt(pos);
+                if ( !IsColShown(col) )
+                    continue;
 
-                    // No need to check all the values.
-                    break;
-                }
+                row = colOrRow;
             }
-        }
 
-        if ( renderer )
-        {
-            extent = column
-                        ? renderer->GetBestWidth(*this, *attr, dc, row, col,
-                                                 GetRowHeight(row))
-                        : renderer->GetBestHeight(*this, *attr, dc, row, col,
-                                                  GetColWidth(col));
+            // we need to account for the cells spanning multiple columns/rows:
+            // while they may need a lot of space, they don't need all of it in
+            // this column/row
+            int numRows, numCols;
+            const CellSpan span = GetCellSize(row, col, &numRows, &numCols);
+            if ( span == CellSpan_Inside )
+            {
+                // we need to get the size of the main cell, not of a cell
+                // hidden by it
+                row += numRows;
+                col += numCols;
+
+                // get the size of the main cell too
+                GetCellSize(row, col, &numRows, &numCols);
+            }
 
-            if ( span != CellSpan_None )
+            // get cell ( main cell if CellSpan_Inside ) renderer best size
+            if ( !canReuseAttr || !attr )
             {
-                // we spread the size of a spanning cell over all the cells it
-                // covers evenly -- this is probably not ideal but we can't
-                // really do much better here
-                //
-                // notice that numCols and numRows are never 0 as they
-                // correspond to the size of the main cell of the span and not
-                // of the cell inside it
-                extent /= column ? numCols : numRows;
+                attr = GetCellAttrPtr(row, col);
+                renderer = attr->GetRendererPtr(this, row, col);
+
+                if ( canReuseAttr )
+                {
+                    // Try to get the best width for the entire column at once,
+                    // if it's supported by the renderer.
+                    extent = renderer->GetMaxBestSize(*this, *attr, dc).x;
+
+                    if ( extent != wxDefaultCoord )
+                    {
+                        extentMax = extent;
+                        extents.clear();
+
+                        // No need to check all the values.
+                        done = true;
+                        break;
+                    }
+                }
             }
 
-            if ( extent > extentMax )
-                extentMax = extent;
+            if ( renderer )
+            {
+                extent = column
+                            ? renderer->GetBestWidth(*this, *attr, dc, row, col,
+                                                     GetRowHeight(row))
+                            : renderer->GetBestHeight(*this, *attr, dc, row, col,
+                                                      GetColWidth(col));
+
+                if ( span != CellSpan_None )
+                {
+                    // we spread the size of a spanning cell over all the cells
+                    // it covers evenly -- this is probably not ideal but we
+                    // can't really do much better here
+                    //
+                    // notice that numCols and numRows are never 0 as they
+                    // correspond to the size of the main cell of the span and
+                    // not of the cell inside it
+                    extent /= column ? numCols : numRows;
+                }
+
+                if ( m_autoSizePercentile < 100 )
+                    extents.push_back(extent);
+                else if ( extent > extentMax )
+                    extentMax = extent;
+            }
         }
     }
 
+    if ( !extents.empty() )
+    {
+        // Use the extent at the given percentile, ignoring the outliers.
+        const auto nth = extents.begin() +
+                            (extents.size() - 1)*m_autoSizePercentile/100;
+        std::nth_element(extents.begin(), nth, extents.end());
+        extentMax = *nth;
+    }
+
     // now also compare with the column label extent
     wxCoord extentLabel;
     dc.SetFont( GetLabelFont() );
@@ -11046,6 +12607,7 @@ wxCoord wxGrid::CalcColOrRowLabelAreaMinSize(wxGridDirection direction)
 void wxGrid::AutoSizeColumns(bool setAsMin)
 {
     wxGridUpdateLocker locker(this);
+    wxGridAutoSizeCacheCreator cacheCreator(m_autoSizeExtents);
 
     for ( int col = 0; col < m_numCols; col++ )
         AutoSizeColumn(col, setAsMin);
@@ -11054,6 +12616,7 @@ void wxGrid::AutoSizeColumns(bool setAsMin)
 void wxGrid::AutoSizeRows(bool setAsMin)
 {
     wxGridUpdateLocker locker(this);
+    wxGridAutoSizeCacheCreator cacheCreator(m_autoSizeExtents);
 
     for ( int row = 0; row < m_numRows; row++ )
         AutoSizeRow(row, setAsMin);
@@ -11110,8 +12673,7 @@ wxSize wxGrid::DoGetBestSize() const
     }
     else
     {
-        for ( int col = 0; col < m_numCols; col++ )
-            size.x += GetColWidth(col);
+        size.x += m_colRights.GetTotal();
     }
 
     if ( m_rowHeights.empty() )
@@ -11120,8 +12682,7 @@ wxSize wxGrid::DoGetBestSize() const
     }
     else
     {
-        for ( int row = 0; row < m_numRows; row++ )
-            size.y += GetRowHeight(row);
+        size.y += m_rowBottoms.GetTotal();
     }
 
     return size + GetWindowBorderSize();
@@ -11152,7 +12713,11 @@ void wxGrid::SetCellValue( int row, int col, const wxString& s )
     if ( m_table )
     {
         m_table->SetValue( row, col, s );
-        if ( ShouldRefresh() )
+        if ( ShouldRefresh() && !CellMayOverflow(row, col) )
+        {
+            RefreshBlock(row, col, row, col);
+        }
+        else if ( ShouldRefresh() )
         {
             wxRect rect( CellToRect( row, col ) );
             CalcScrolledPosition(0, rect.y, nullptr, &rect.y);
@@ -11969,6 +13534,146 @@ int wxGridSizesInfo::GetSize(unsigned pos) const
     return it->second;
 }
 
+// ----------------------------------------------------------------------------
+// wxGridLineEnds
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Return the value of the lowest bit set in the given number.
+inline size_t LowestBit(size_t n)
+{
+    return n & (~n + 1);
+}
+
+} // anonymous namespace
+
+void wxGridLineEnds::Assign(size_t count, int size)
+{
+    m_tree.assign(count, size);
+    MakeTree();
+}
+
+void wxGridLineEnds::Assign(const wxArrayInt& sizes, const wxArrayInt& lineAt)
+{
+    m_tree.resize(sizes.size());
+    for ( size_t pos = 0; pos < m_tree.size(); pos++ )
+    {
+        // Hidden lines have negative sizes but don't take any space.
+        const int size = sizes[lineAt.empty() ? pos : lineAt[pos]];
+        m_tree[pos] = size > 0 ? size : 0;
+    }
+
+    MakeTree();
+}
+
+void wxGridLineEnds::MakeTree()
+{
+    // Add each element to its parent: as the parents always come after their
+    // children, this computes the sums for the entire tree in a single pass.
+    const size_t count = m_tree.size();
+    for ( size_t i = 1; i <= count; i++ )
+    {
+        const size_t parent = i + LowestBit(i);
+        if ( parent <= count )
+            m_tree[parent - 1] += m_tree[i - 1];
+    }
+}
+
+void wxGridLineEnds::MakeSizes()
+{
+    // Just undo what MakeTree() does, in the reverse order.
+    const size_t count = m_tree.size();
+    for ( size_t i = count; i > 0; i-- )
+    {
+        const size_t parent = i + LowestBit(i);
+        if ( parent <= count )
+            m_tree[parent - 1] -= m_tree[i - 1];
+    }
+}
+
+int wxGridLineEnds::GetSum(size_t count) const
+{
+    wxASSERT_MSG( count <= m_tree.size(), "invalid number of lines" );
+
+    int sum = 0;
+    for ( size_t i = count; i > 0; i -= LowestBit(i) )
+        sum += m_tree[i - 1];
+
+    return sum;
+}
+
+void wxGridLineEnds::Add(size_t pos, int diff)
+{
+    wxCHECK_RET( pos < m_tree.size(), "invalid line position" );
+
+    for ( size_t i = pos + 1; i <= m_tree.size(); i += LowestBit(i) )
+        m_tree[i - 1] += diff;
+}
+
+size_t wxGridLineEnds::FindLine(int coord) const
+{
+    // Find the greatest number of lines whose total size doesn't exceed the
+    // given coordinate by descending the tree from its root, this number is
+    // also the position of the line containing the coordinate.
+    size_t step = 1;
+    while ( step <= m_tree.size() / 2 )
+        step *= 2;
+
+    size_t count = 0;
+    int sum = 0;
+    for ( ; step; step /= 2 )
+    {
+        const size_t next = count + step;
+        if ( next <= m_tree.size() && sum + m_tree[next - 1] <= coord )
+        {
+            count = next;
+            sum += m_tree[next - 1];
+        }
+    }
+
+    return count;
+}
+
+void wxGridLineEnds::Insert(size_t pos, size_t count, int size)
+{
+    wxCHECK_RET( pos <= m_tree.size(), "invalid line position" );
+
+    if ( pos == m_tree.size() )
+    {
+        // Appending is simple as we only need to compute the new elements.
+        for ( size_t n = 0; n < count; n++ )
+        {
+            const size_t i = m_tree.size() + 1;
+            m_tree.push_back(size + GetSum(i - 1) - GetSum(i - LowestBit(i)));
+        }
+
+        return;
+    }
+
+    MakeSizes();
+    m_tree.insert(m_tree.begin() + pos, count, size);
+    MakeTree();
+}
+
+void wxGridLineEnds::Remove(size_t pos, size_t count)
+{
+    wxCHECK_RET( pos + count <= m_tree.size(), "invalid line position" );
+
+    if ( pos + count == m_tree.size() )
+    {
+        // Removing the last elements doesn't affect the remaining ones.
+        m_tree.resize(pos);
+        return;
+    }
+
+    MakeSizes();
+    const auto first = m_tree.begin() + pos;
+    m_tree.erase(first, first + count);
+    MakeTree();
+}
+
 // ----------------------------------------------------------------------------
 // drop target
 // ----------------------------------------------------------------------------
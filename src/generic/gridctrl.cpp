@@ -214,7 +214,7 @@ wxSize wxGridCellDateRenderer::GetBestSize(wxGrid& grid,
                                            wxDC& dc,
                                            int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 wxSize wxGridCellDateRenderer::GetMaxBestSize(wxGrid& WXUNUSED(grid),
@@ -353,7 +353,7 @@ wxSize wxGridCellEnumRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 // ----------------------------------------------------------------------------
@@ -608,12 +608,20 @@ wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGridCellAttr& attr,
     return dc.GetMultiLineTextExtent(text);
 }
 
+wxSize wxGridCellStringRenderer::DoGetBestSize(const wxGrid& grid,
+                                               const wxGridCellAttr& attr,
+                                               wxReadOnlyDC& dc,
+                                               const wxString& text)
+{
+    return grid.GetCellTextExtent(dc, attr.GetFont(), text);
+}
+
 wxSize wxGridCellStringRenderer::GetBestSize(wxGrid& grid,
                                              wxGridCellAttr& attr,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, grid.GetCellValue(row, col));
+    return DoGetBestSize(grid, attr, dc, grid.GetCellValue(row, col));
 }
 
 void wxGridCellStringRenderer::Draw(wxGrid& grid,
@@ -760,7 +768,7 @@ wxSize wxGridCellNumberRenderer::GetBestSize(wxGrid& grid,
                                              wxDC& dc,
                                              int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 wxSize wxGridCellNumberRenderer::GetMaxBestSize(wxGrid& WXUNUSED(grid),
@@ -889,7 +897,7 @@ wxSize wxGridCellFloatRenderer::GetBestSize(wxGrid& grid,
                                             wxDC& dc,
                                             int row, int col)
 {
-    return DoGetBestSize(attr, dc, GetString(grid, row, col));
+    return DoGetBestSize(grid, attr, dc, GetString(grid, row, col));
 }
 
 void wxGridCellFloatRenderer::SetParameters(const wxString& params)
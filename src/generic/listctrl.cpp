@@ -91,53 +91,6 @@ static const int HEADER_IMAGE_MARGIN_IN_REPORT_MODE = 2;
 // space after a checkbox
 static const int MARGIN_AROUND_CHECKBOX = 5;
 
-// ----------------------------------------------------------------------------
-// wxListItemData
-// ----------------------------------------------------------------------------
-
-wxListItemData::wxListItemData(wxListItemData&& other)
-              : m_image(other.m_image),
-                m_data(other.m_data),
-                m_owner(other.m_owner),
-                m_text(std::move(other.m_text))
-{
-    // Take ownership of the pointers from the other object and reset them.
-    std::swap(m_attr, other.m_attr);
-    std::swap(m_rect, other.m_rect);
-}
-
-wxListItemData& wxListItemData::operator=(wxListItemData&& other)
-{
-    m_image = other.m_image;
-    m_data = other.m_data;
-    m_owner = other.m_owner;
-    m_text = std::move(other.m_text);
-
-    // Swap them to let our pointers be deleted by the other object if necessary.
-    std::swap(m_attr, other.m_attr);
-    std::swap(m_rect, other.m_rect);
-
-    return *this;
-}
-
-wxListItemData::~wxListItemData()
-{
-    // in the virtual list control the attributes are managed by the main
-    // program, so don't delete them
-    if ( !m_owner->IsVirtual() )
-        delete m_attr;
-
-    delete m_rect;
-}
-
-wxListItemData::wxListItemData(wxListMainWindow *owner)
-{
-    m_owner = owner;
-
-    if ( !owner->InReportView() )
-        m_rect = new wxRect;
-}
-
 // Check if the item is visible
 bool wxGenericListCtrl::IsVisible(long item) const
 {
@@ -155,110 +108,6 @@ bool wxGenericListCtrl::IsVisible(long item) const
     return visible;
 }
 
-void wxListItemData::SetItem( const wxListItem &info )
-{
-    if ( info.m_mask & wxLIST_MASK_TEXT )
-        SetText(info.m_text);
-    if ( info.m_mask & wxLIST_MASK_IMAGE )
-        m_image = info.m_image;
-    if ( info.m_mask & wxLIST_MASK_DATA )
-        m_data = info.m_data;
-
-    if ( info.HasAttributes() )
-    {
-        if ( m_attr )
-            m_attr->AssignFrom(*info.GetAttributes());
-        else
-            m_attr = new wxItemAttr(*info.GetAttributes());
-    }
-
-    if ( m_rect )
-    {
-        m_rect->x =
-        m_rect->y =
-        m_rect->height = 0;
-        m_rect->width = info.m_width;
-    }
-}
-
-void wxListItemData::SetPosition( int x, int y )
-{
-    wxCHECK_RET( m_rect, wxT("unexpected SetPosition() call") );
-
-    m_rect->x = x;
-    m_rect->y = y;
-}
-
-void wxListItemData::SetSize( int width, int height )
-{
-    wxCHECK_RET( m_rect, wxT("unexpected SetSize() call") );
-
-    if ( width != -1 )
-        m_rect->width = width;
-    if ( height != -1 )
-        m_rect->height = height;
-}
-
-bool wxListItemData::IsHit( int x, int y ) const
-{
-    wxCHECK_MSG( m_rect, false, wxT("can't be called in this mode") );
-
-    return wxRect(GetX(), GetY(), GetWidth(), GetHeight()).Contains(x, y);
-}
-
-int wxListItemData::GetX() const
-{
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
-
-    return m_rect->x;
-}
-
-int wxListItemData::GetY() const
-{
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
-
-    return m_rect->y;
-}
-
-int wxListItemData::GetWidth() const
-{
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
-
-    return m_rect->width;
-}
-
-int wxListItemData::GetHeight() const
-{
-    wxCHECK_MSG( m_rect, 0, wxT("can't be called in this mode") );
-
-    return m_rect->height;
-}
-
-void wxListItemData::GetItem( wxListItem &info ) const
-{
-    long mask = info.m_mask;
-    if ( !mask )
-        // by default, get everything for backwards compatibility
-        mask = -1;
-
-    if ( mask & wxLIST_MASK_TEXT )
-        info.m_text = m_text;
-    if ( mask & wxLIST_MASK_IMAGE )
-        info.m_image = m_image;
-    if ( mask & wxLIST_MASK_DATA )
-        info.m_data = m_data;
-
-    if ( m_attr )
-    {
-        if ( m_attr->HasTextColour() )
-            info.SetTextColour(m_attr->GetTextColour());
-        if ( m_attr->HasBackgroundColour() )
-            info.SetBackgroundColour(m_attr->GetBackgroundColour());
-        if ( m_attr->HasFont() )
-            info.SetFont(m_attr->GetFont());
-    }
-}
-
 //-----------------------------------------------------------------------------
 //  wxListHeaderData
 //-----------------------------------------------------------------------------
@@ -417,14 +266,56 @@ wxListLineData::wxListLineData( wxListMainWindow *owner )
     m_highlighted = false;
     m_checked = false;
 
+    m_data = 0;
+    m_attr = nullptr;
+
     InitItems( GetMode() == wxLC_REPORT ? m_owner->GetColumnCount() : 1 );
 }
 
-void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
+wxListLineData::wxListLineData(wxListLineData&& other)
+              : m_gi(std::move(other.m_gi)),
+                m_highlighted(other.m_highlighted),
+                m_checked(other.m_checked),
+                m_owner(other.m_owner),
+                m_subitems(std::move(other.m_subitems)),
+                m_texts(std::move(other.m_texts)),
+                m_data(other.m_data),
+                m_attr(other.m_attr),
+                m_extra(std::move(other.m_extra))
+{
+    // Take ownership of the attributes from the other object.
+    other.m_attr = nullptr;
+}
+
+wxListLineData& wxListLineData::operator=(wxListLineData&& other)
 {
-    wxCHECK_RET( !m_items.empty(), wxT("no subitems at all??") );
+    m_gi = std::move(other.m_gi);
+    m_highlighted = other.m_highlighted;
+    m_checked = other.m_checked;
+    m_owner = other.m_owner;
+    m_subitems = std::move(other.m_subitems);
+    m_texts = std::move(other.m_texts);
+    m_data = other.m_data;
+    m_extra = std::move(other.m_extra);
 
-    wxListItemData* const item = &m_items[0];
+    // Swap them to let our attributes be deleted by the other object if
+    // necessary.
+    std::swap(m_attr, other.m_attr);
+
+    return *this;
+}
+
+wxListLineData::~wxListLineData()
+{
+    // in the virtual list control the attributes are managed by the main
+    // program, so don't delete them
+    if ( !IsVirtual() )
+        delete m_attr;
+}
+
+void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
+{
+    wxCHECK_RET( !m_subitems.empty(), wxT("no subitems at all??") );
 
     wxString s;
     wxCoord lw, lh;
@@ -435,7 +326,7 @@ void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
         case wxLC_SMALL_ICON:
             m_gi->m_rectAll.width = spacing;
 
-            s = item->GetText();
+            s = GetText(0);
 
             if ( s.empty() )
             {
@@ -457,10 +348,10 @@ void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
                 m_gi->m_rectLabel.height = lh;
             }
 
-            if (item->HasImage())
+            if (HasImage())
             {
                 int w, h;
-                m_owner->GetImageSize( item->GetImage(), w, h );
+                m_owner->GetImageSize( GetImage(), w, h );
                 m_gi->m_rectIcon.width = w + 8;
                 m_gi->m_rectIcon.height = h + 8;
 
@@ -470,7 +361,7 @@ void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
                     m_gi->m_rectAll.height = m_gi->m_rectIcon.height + lh + 4;
             }
 
-            if ( item->HasText() )
+            if ( HasText() )
             {
                 m_gi->m_rectHighlight.width = m_gi->m_rectLabel.width;
                 m_gi->m_rectHighlight.height = m_gi->m_rectLabel.height;
@@ -483,7 +374,7 @@ void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
             break;
 
         case wxLC_LIST:
-            s = item->GetTextForMeasuring();
+            s = GetTextForMeasuring();
 
             dc->GetTextExtent( s, &lw, &lh );
             lw += EXTRA_WIDTH;
@@ -495,10 +386,10 @@ void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
             m_gi->m_rectAll.width = lw;
             m_gi->m_rectAll.height = lh;
 
-            if (item->HasImage())
+            if (HasImage())
             {
                 int w, h;
-                m_owner->GetImageSize( item->GetImage(), w, h );
+                m_owner->GetImageSize( GetImage(), w, h );
                 m_gi->m_rectIcon.width = w;
                 m_gi->m_rectIcon.height = h;
 
@@ -523,9 +414,7 @@ void wxListLineData::CalculateSize( wxReadOnlyDC *dc, int spacing )
 
 void wxListLineData::SetPosition( int x, int y, int WXUNUSED(spacing) )
 {
-    wxCHECK_RET( !m_items.empty(), wxT("no subitems at all??") );
-
-    wxListItemData* const item = &m_items[0];
+    wxCHECK_RET( !m_subitems.empty(), wxT("no subitems at all??") );
 
     switch ( GetMode() )
     {
@@ -534,14 +423,14 @@ void wxListLineData::SetPosition( int x, int y, int WXUNUSED(spacing) )
             m_gi->m_rectAll.x = x;
             m_gi->m_rectAll.y = y;
 
-            if ( item->HasImage() )
+            if ( HasImage() )
             {
                 m_gi->m_rectIcon.x = m_gi->m_rectAll.x + 4 +
                     (m_gi->m_rectAll.width - m_gi->m_rectIcon.width) / 2;
                 m_gi->m_rectIcon.y = m_gi->m_rectAll.y + 4;
             }
 
-            if ( item->HasText() )
+            if ( HasText() )
             {
                 m_gi->m_rectLabel.x = m_gi->m_rectAll.x + (EXTRA_WIDTH/2) +
                     (m_gi->m_rectAll.width - m_gi->m_rectLabel.width) / 2;
@@ -565,7 +454,7 @@ void wxListLineData::SetPosition( int x, int y, int WXUNUSED(spacing) )
             m_gi->m_rectHighlight.y = m_gi->m_rectAll.y;
             m_gi->m_rectLabel.y = m_gi->m_rectAll.y + 2;
 
-            if (item->HasImage())
+            if (HasImage())
             {
                 m_gi->m_rectIcon.x = m_gi->m_rectAll.x + 2;
                 m_gi->m_rectIcon.y = m_gi->m_rectAll.y + 2;
@@ -589,48 +478,205 @@ void wxListLineData::SetPosition( int x, int y, int WXUNUSED(spacing) )
 
 void wxListLineData::InitItems( int num )
 {
-    for (int i = 0; i < num; i++)
-        m_items.emplace_back( m_owner );
+    m_subitems.resize(num, SubItem{0, -1});
+}
+
+void wxListLineData::InsertSubItem(size_t index)
+{
+    wxCHECK_RET( index <= m_subitems.size(), wxT("invalid subitem index") );
+
+    m_subitems.insert(m_subitems.begin() + index,
+                      SubItem{wxUint32(GetTextStart(index)), -1});
+
+    if ( !index )
+    {
+        // the data of the old first subitem now belongs to the second one
+        if ( m_data || m_attr || m_extra )
+        {
+            if ( !m_extra )
+                m_extra.reset(new std::vector<SubItemExtra>);
+
+            m_extra->emplace(m_extra->begin());
+
+            SubItemExtra& extra = m_extra->front();
+            extra.data = m_data;
+            extra.attr.reset(m_attr);
+
+            m_data = 0;
+            m_attr = nullptr;
+        }
+    }
+    else if ( m_extra && index - 1 < m_extra->size() )
+    {
+        m_extra->emplace(m_extra->begin() + index - 1);
+    }
+}
+
+void wxListLineData::DeleteSubItem(size_t index)
+{
+    wxCHECK_RET( index < m_subitems.size(), wxT("invalid subitem index") );
+
+    SetText(index, wxString());
+    m_subitems.erase(m_subitems.begin() + index);
+
+    if ( !index )
+    {
+        // the data of the second subitem now belongs to the first one
+        delete m_attr;
+        m_attr = nullptr;
+        m_data = 0;
+
+        if ( m_extra && !m_extra->empty() )
+        {
+            SubItemExtra& extra = m_extra->front();
+            m_data = extra.data;
+            m_attr = extra.attr.release();
+
+            m_extra->erase(m_extra->begin());
+        }
+    }
+    else if ( m_extra && index - 1 < m_extra->size() )
+    {
+        m_extra->erase(m_extra->begin() + index - 1);
+    }
+}
+
+wxListLineData::SubItemExtra& wxListLineData::GetExtra(int index)
+{
+    wxASSERT_MSG( index > 0, wxT("first subitem data is stored directly") );
+
+    if ( !m_extra )
+        m_extra.reset(new std::vector<SubItemExtra>);
+
+    if ( m_extra->size() < static_cast<size_t>(index) )
+        m_extra->resize(index);
+
+    return (*m_extra)[index - 1];
+}
+
+wxItemAttr *wxListLineData::GetSubItemAttr(int index) const
+{
+    if ( !index )
+        return m_attr;
+
+    if ( !m_extra || m_extra->size() < static_cast<size_t>(index) )
+        return nullptr;
+
+    return (*m_extra)[index - 1].attr.get();
 }
 
 void wxListLineData::SetItem( int index, const wxListItem &info )
 {
-    m_items.at(index).SetItem( info );
+    // check the index in the same way as std::vector::at() would do
+    m_subitems.at(index);
+
+    if ( info.m_mask & wxLIST_MASK_TEXT )
+        SetText(index, info.m_text);
+    if ( info.m_mask & wxLIST_MASK_IMAGE )
+        SetImage(index, info.m_image);
+    if ( info.m_mask & wxLIST_MASK_DATA )
+    {
+        if ( index )
+            GetExtra(index).data = info.m_data;
+        else
+            m_data = info.m_data;
+    }
+
+    if ( info.HasAttributes() )
+    {
+        wxItemAttr* const attr = GetSubItemAttr(index);
+        if ( attr )
+            attr->AssignFrom(*info.GetAttributes());
+        else if ( index )
+            GetExtra(index).attr.reset(new wxItemAttr(*info.GetAttributes()));
+        else
+            m_attr = new wxItemAttr(*info.GetAttributes());
+    }
 }
 
 void wxListLineData::GetItem( int index, wxListItem &info ) const
 {
-    m_items.at(index).GetItem( info );
+    const SubItem& subitem = m_subitems.at(index);
+
+    long mask = info.m_mask;
+    if ( !mask )
+        // by default, get everything for backwards compatibility
+        mask = -1;
+
+    if ( mask & wxLIST_MASK_TEXT )
+        info.m_text = GetText(index);
+    if ( mask & wxLIST_MASK_IMAGE )
+        info.m_image = subitem.image;
+    if ( mask & wxLIST_MASK_DATA )
+    {
+        if ( !index )
+            info.m_data = m_data;
+        else if ( m_extra && m_extra->size() >= static_cast<size_t>(index) )
+            info.m_data = (*m_extra)[index - 1].data;
+        else
+            info.m_data = 0;
+    }
+
+    const wxItemAttr* const attr = GetSubItemAttr(index);
+    if ( attr )
+    {
+        if ( attr->HasTextColour() )
+            info.SetTextColour(attr->GetTextColour());
+        if ( attr->HasBackgroundColour() )
+            info.SetBackgroundColour(attr->GetBackgroundColour());
+        if ( attr->HasFont() )
+            info.SetFont(attr->GetFont());
+    }
+}
+
+bool wxListLineData::HasText(int index) const
+{
+    return m_subitems.at(index).textEnd > GetTextStart(index);
 }
 
 wxString wxListLineData::GetText(int index) const
 {
-    return m_items.at(index).GetText();
+    const size_t end = m_subitems.at(index).textEnd;
+    const size_t start = GetTextStart(index);
+
+    return wxString::FromUTF8Unchecked(m_texts.data() + start, end - start);
 }
 
 void wxListLineData::SetText( int index, const wxString& s )
 {
-    m_items.at(index).SetText(s);
+    const size_t end = m_subitems.at(index).textEnd;
+    const size_t start = GetTextStart(index);
+
+    const wxScopedCharBuffer utf8 = s.utf8_str();
+    const size_t len = utf8.length();
+    if ( !len && end == start )
+        return;
+
+    m_texts.replace(start, end - start, utf8.data(), len);
+
+    // shift the ends of this and all the following subitems texts
+    const wxUint32 newEnd = wxUint32(start + len);
+    const wxUint32 oldEnd = wxUint32(end);
+    for ( size_t n = index; n < m_subitems.size(); n++ )
+        m_subitems[n].textEnd = m_subitems[n].textEnd - oldEnd + newEnd;
 }
 
 void wxListLineData::SetImage( int index, int image )
 {
-    m_items.at(index).SetImage(image);
+    m_subitems.at(index).image = image;
 }
 
 int wxListLineData::GetImage( int index ) const
 {
-    return m_items.at(index).GetImage();
-}
-
-wxItemAttr *wxListLineData::GetAttr() const
-{
-    return m_items.at(0).GetAttr();
+    return m_subitems.at(index).image;
 }
 
 void wxListLineData::SetAttr(wxItemAttr *attr)
 {
-    m_items.at(0).SetAttr(attr);
+    // this is only used in virtual mode, where we don't own the attributes
+    wxASSERT_MSG( IsVirtual(), wxT("unexpected call to SetAttr()") );
+
+    m_attr = attr;
 }
 
 void wxListLineData::ApplyAttributes(wxDC *dc,
@@ -713,26 +759,25 @@ void wxListLineData::ApplyAttributes(wxDC *dc,
 
 void wxListLineData::Draw(wxDC *dc, bool current)
 {
-    wxCHECK_RET( !m_items.empty(), wxT("no subitems at all??") );
+    wxCHECK_RET( !m_subitems.empty(), wxT("no subitems at all??") );
 
     ApplyAttributes(dc, m_gi->m_rectHighlight, IsHighlighted(), current);
 
-    wxListItemData* const item = &m_items[0];
-    if (item->HasImage())
+    if (HasImage())
     {
         // centre the image inside our rectangle, this looks nicer when items
         // ae aligned in a row
         const wxRect& rectIcon = m_gi->m_rectIcon;
 
-        m_owner->DrawImage(item->GetImage(), dc, rectIcon.x, rectIcon.y);
+        m_owner->DrawImage(GetImage(), dc, rectIcon.x, rectIcon.y);
     }
 
-    if (item->HasText())
+    if (HasText())
     {
         const wxRect& rectLabel = m_gi->m_rectLabel;
 
         wxDCClipper clipper(*dc, rectLabel);
-        dc->DrawText(item->GetText(), rectLabel.x, rectLabel.y);
+        dc->DrawText(GetText(0), rectLabel.x, rectLabel.y);
     }
 }
 
@@ -769,8 +814,8 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
         x += cbSize.GetWidth() + (2 * MARGIN_AROUND_CHECKBOX);
     }
 
-    size_t col = 0;
-    for ( const auto& item : m_items )
+    const size_t count = m_subitems.size();
+    for ( size_t col = 0; col < count; col++ )
     {
         int width = m_owner->GetColumnWidth(col);
         if (col == 0 && m_owner->HasCheckBoxes())
@@ -782,11 +827,12 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
         const int wText = width;
         wxDCClipper clipper(*dc, xOld, rect.y, wText, rect.height);
 
-        if ( item.HasImage() )
+        const int image = m_subitems[col].image;
+        if ( image != -1 )
         {
             int ix, iy;
-            m_owner->GetImageSize( item.GetImage(), ix, iy );
-            m_owner->DrawImage( item.GetImage(), dc, xOld, yMid - iy/2 );
+            m_owner->GetImageSize( image, ix, iy );
+            m_owner->DrawImage( image, dc, xOld, yMid - iy/2 );
 
             ix += IMAGE_MARGIN_IN_REPORT_MODE;
 
@@ -794,10 +840,8 @@ void wxListLineData::DrawInReportMode( wxDC *dc,
             width -= ix;
         }
 
-        if ( item.HasText() )
-            DrawTextFormatted(dc, item.GetText(), col, xOld, yMid, width);
-
-        ++col;
+        if ( HasText(col) )
+            DrawTextFormatted(dc, GetText(col), col, xOld, yMid, width);
     }
 }
 
@@ -899,6 +943,68 @@ void wxListLineData::ReverseHighlight( void )
     Highlight(!IsHighlighted());
 }
 
+//-----------------------------------------------------------------------------
+//  wxListVirtualCache
+//-----------------------------------------------------------------------------
+
+wxListVirtualCache::Line* wxListVirtualCache::GetLine(size_t line)
+{
+    const auto it = m_pages.find(line / PAGE_SIZE);
+    if ( it == m_pages.end() )
+        return nullptr;
+
+    Page& page = it->second;
+    page.lastUsed = ++m_lastUsed;
+
+    const size_t n = line % PAGE_SIZE;
+    return n < page.lines.size() ? &page.lines[n] : nullptr;
+}
+
+void wxListVirtualCache::AddPage(size_t page, Lines&& lines)
+{
+    m_fetching.erase(page);
+
+    if ( m_pages.size() >= MAX_PAGES && !HasPage(page) )
+    {
+        auto lru = m_pages.begin();
+        for ( auto it = m_pages.begin(); it != m_pages.end(); ++it )
+        {
+            if ( it->second.lastUsed < lru->second.lastUsed )
+                lru = it;
+        }
+
+        m_pages.erase(lru);
+    }
+
+    Page& p = m_pages[page];
+    p.lines = std::move(lines);
+    p.lastUsed = ++m_lastUsed;
+}
+
+void wxListVirtualCache::Invalidate()
+{
+    m_pages.clear();
+    m_fetching.clear();
+    m_generation++;
+}
+
+void wxListVirtualCache::Invalidate(size_t lineFrom, size_t lineTo)
+{
+    const size_t pageFrom = lineFrom / PAGE_SIZE,
+                 pageTo = lineTo / PAGE_SIZE;
+    for ( auto it = m_pages.begin(); it != m_pages.end(); )
+    {
+        if ( it->first >= pageFrom && it->first <= pageTo )
+            it = m_pages.erase(it);
+        else
+            ++it;
+    }
+
+    // The pages being fetched may contain the old data too.
+    m_fetching.clear();
+    m_generation++;
+}
+
 //-----------------------------------------------------------------------------
 //  wxListHeaderWindow
 //-----------------------------------------------------------------------------
@@ -1600,6 +1706,8 @@ wxListMainWindow::wxListMainWindow( wxWindow *parent,
 
 wxListMainWindow::~wxListMainWindow()
 {
+    EnableVirtualCache(false, false);
+
     if ( m_textctrlWrapper )
         m_textctrlWrapper->EndEdit(wxListTextCtrlWrapper::End_Destroy);
 
@@ -1625,6 +1733,24 @@ void wxListMainWindow::CacheLineData(size_t line)
 
     wxListLineData *ld = GetDummyLine();
 
+    if ( m_virtualCache )
+    {
+        wxListVirtualCache::Line& data = GetVirtualCacheLine(line);
+
+        for ( size_t col = 0; col < data.texts.size(); col++ )
+        {
+            ld->SetText(col, data.texts[col]);
+            ld->SetImage(col, data.images[col]);
+        }
+
+        if ( HasCheckBoxes() )
+            ld->Check(data.checked);
+
+        ld->SetAttr(data.hasAttr ? &data.attr : nullptr);
+
+        return;
+    }
+
     size_t countCol = GetColumnCount();
     for ( size_t col = 0; col < countCol; col++ )
     {
@@ -1640,6 +1766,197 @@ void wxListMainWindow::CacheLineData(size_t line)
     ld->SetAttr(listctrl->OnGetItemAttr(line));
 }
 
+wxListVirtualCache::Line& wxListMainWindow::GetVirtualCacheLine(size_t line)
+{
+    const size_t numColumns = GetColumnCount();
+    if ( !m_virtualCache->HasLayout(numColumns, HasCheckBoxes()) )
+    {
+        // The cached items don't have the right number of fields any more,
+        // recreate the cache.
+        EnableVirtualCache(true, m_virtualCache->ShouldPrefetch());
+    }
+
+    wxListVirtualCache::Line* data = m_virtualCache->GetLine(line);
+    if ( !data )
+    {
+        const size_t page = line / wxListVirtualCache::PAGE_SIZE;
+        const size_t lineFrom = page * wxListVirtualCache::PAGE_SIZE;
+
+        wxListVirtualCache::Lines lines;
+        FetchVirtualLines(GetListCtrl(),
+                          lineFrom,
+                          wxMin(size_t(wxListVirtualCache::PAGE_SIZE),
+                                GetItemCount() - lineFrom),
+                          numColumns,
+                          HasCheckBoxes(),
+                          true /* with attributes */,
+                          lines);
+
+        m_virtualCache->AddPage(page, std::move(lines));
+
+        data = m_virtualCache->GetLine(line);
+    }
+
+    return *data;
+}
+
+/* static */
+void wxListMainWindow::FetchVirtualLines(const wxGenericListCtrl* listctrl,
+                                         size_t lineFrom,
+                                         size_t count,
+                                         size_t numColumns,
+                                         bool hasCheckBoxes,
+                                         bool withAttrs,
+                                         wxListVirtualCache::Lines& lines)
+{
+    lines.resize(count);
+    for ( size_t n = 0; n < count; n++ )
+    {
+        const long item = lineFrom + n;
+        wxListVirtualCache::Line& data = lines[n];
+
+        data.texts.reserve(numColumns);
+        data.images.reserve(numColumns);
+        for ( size_t col = 0; col < numColumns; col++ )
+        {
+            data.texts.push_back(listctrl->OnGetItemText(item, col));
+            data.images.push_back(listctrl->OnGetItemColumnImage(item, col));
+        }
+
+        if ( hasCheckBoxes )
+            data.checked = listctrl->OnGetItemIsChecked(item);
+
+        if ( withAttrs )
+        {
+            const wxItemAttr* const attr = listctrl->OnGetItemAttr(item);
+            if ( attr )
+            {
+                // Copy the attributes as the pointer returned by
+                // OnGetItemAttr() is not guaranteed to remain valid.
+                data.attr = *attr;
+                data.hasAttr = true;
+            }
+        }
+    }
+}
+
+void
+wxListMainWindow::FetchVirtualAttrs(size_t lineFrom,
+                                    wxListVirtualCache::Lines& lines)
+{
+    const wxGenericListCtrl* const listctrl = GetListCtrl();
+    for ( size_t n = 0; n < lines.size(); n++ )
+    {
+        const wxItemAttr* const attr = listctrl->OnGetItemAttr(lineFrom + n);
+        if ( attr )
+        {
+            lines[n].attr = *attr;
+            lines[n].hasAttr = true;
+        }
+    }
+}
+
+void wxListMainWindow::PrefetchVirtualCache(size_t lineFrom, size_t lineTo)
+{
+#if wxUSE_THREADS
+    if ( !m_virtualCache || !m_virtualCache->ShouldPrefetch() )
+        return;
+
+    wxThreadPool* const pool = wxThreadPool::GetIfAvailable();
+    if ( !pool )
+        return;
+
+    // Prefetch the pages just after and before the visible ones, as they're
+    // going to be needed when scrolling.
+    const size_t count = GetItemCount();
+    const size_t pageAfter = lineTo / wxListVirtualCache::PAGE_SIZE + 1;
+    const size_t pageBefore = lineFrom / wxListVirtualCache::PAGE_SIZE - 1;
+
+    const size_t pages[] = { pageAfter, pageBefore };
+    for ( const size_t page : pages )
+    {
+        // Notice that this also skips pageBefore if it wrapped around.
+        const size_t first = page * wxListVirtualCache::PAGE_SIZE;
+        if ( first >= count ||
+                m_virtualCache->HasPage(page) ||
+                    m_virtualCache->IsFetching(page) )
+            continue;
+
+        m_virtualCache->SetFetching(page);
+
+        const wxGenericListCtrl* const listctrl = GetListCtrl();
+        const size_t num = wxMin(size_t(wxListVirtualCache::PAGE_SIZE),
+                                 count - first);
+        const size_t numColumns = GetColumnCount();
+        const bool hasCheckBoxes = HasCheckBoxes();
+        const unsigned generation = m_virtualCache->GetGeneration();
+        const wxCancellationToken token = m_virtualCache->m_cancel.GetToken();
+        const std::shared_ptr<wxMutex> mutex = m_virtualCache->m_fetchMutex;
+
+        pool->SubmitThen
+              (
+                [=]()
+                {
+                    wxListVirtualCache::Lines lines;
+
+                    wxMutexLocker lock(*mutex);
+                    if ( !token.IsCancelled() )
+                    {
+                        FetchVirtualLines(listctrl, first, num, numColumns,
+                                          hasCheckBoxes, false, lines);
+                    }
+
+                    return lines;
+                },
+                [this, page, first, generation](wxListVirtualCache::Lines lines)
+                {
+                    // Don't use the fetched items if they could have changed.
+                    if ( !m_virtualCache ||
+                            m_virtualCache->GetGeneration() != generation )
+                        return;
+
+                    FetchVirtualAttrs(first, lines);
+                    m_virtualCache->AddPage(page, std::move(lines));
+                },
+                nullptr,
+                token
+              );
+    }
+#else // !wxUSE_THREADS
+    wxUnusedVar(lineFrom);
+    wxUnusedVar(lineTo);
+#endif // wxUSE_THREADS/!wxUSE_THREADS
+}
+
+void wxListMainWindow::EnableVirtualCache(bool enable, bool prefetch)
+{
+    if ( m_virtualCache )
+    {
+#if wxUSE_THREADS
+        // Ensure that the background tasks don't use the old cache any more.
+        wxMutexLocker lock(*m_virtualCache->m_fetchMutex);
+        m_virtualCache->m_cancel.Cancel();
+#endif // wxUSE_THREADS
+    }
+
+    m_virtualCache.reset(enable ? new wxListVirtualCache(prefetch,
+                                                         GetColumnCount(),
+                                                         HasCheckBoxes())
+                                : nullptr);
+}
+
+void wxListMainWindow::InvalidateVirtualCache()
+{
+    if ( m_virtualCache )
+        m_virtualCache->Invalidate();
+}
+
+void wxListMainWindow::InvalidateVirtualCache(size_t lineFrom, size_t lineTo)
+{
+    if ( m_virtualCache )
+        m_virtualCache->Invalidate(lineFrom, lineTo);
+}
+
 wxListLineData *wxListMainWindow::GetDummyLine() const
 {
     wxASSERT_MSG( !IsEmpty(), wxT("invalid line index") );
@@ -1651,7 +1968,7 @@ wxListLineData *wxListMainWindow::GetDummyLine() const
     // control changed as it would have the incorrect number of fields
     // otherwise
     if ( !m_lines.empty() &&
-            m_lines[0].m_items.size() != (size_t)GetColumnCount() )
+            m_lines[0].GetSubItemCount() != (size_t)GetColumnCount() )
     {
         self->m_lines.clear();
     }
@@ -1726,13 +2043,12 @@ wxRect wxListMainWindow::GetLineLabelRect(size_t line) const
 
     int image_x = 0;
     wxListLineData *data = GetLine(line);
-    if ( !data->m_items.empty() )
+    if ( data->GetSubItemCount() )
     {
-        wxListItemData *item = &data->m_items[0];
-        if ( item->HasImage() )
+        if ( data->HasImage() )
         {
             int ix, iy;
-            GetImageSize( item->GetImage(), ix, iy );
+            GetImageSize( data->GetImage(), ix, iy );
             image_x = 3 + ix + IMAGE_MARGIN_IN_REPORT_MODE;
         }
     }
@@ -2063,6 +2379,8 @@ void wxListMainWindow::OnPaint( wxPaintEvent &WXUNUSED(event) )
             evCache.m_item.m_itemId =
             evCache.m_itemIndex = visibleTo;
             GetParent()->GetEventHandler()->ProcessEvent( evCache );
+
+            PrefetchVirtualCache(visibleFrom, visibleTo);
         }
 
         for ( size_t line = visibleFrom; line <= visibleEnd; line++ )
@@ -3393,7 +3711,7 @@ public:
         wxListLineData *line = m_listmain->GetLine( row );
 
         wxListItem item;
-        line->m_items.at(GetColumn()).GetItem(item);
+        line->GetItem(GetColumn(), item);
 
         UpdateWithWidth(m_listmain->GetItemWidthWithImage(&item));
     }
@@ -3749,6 +4067,8 @@ void wxListMainWindow::SetItemCount(long count)
     m_selStore.SetItemCount(count);
     m_countVirt = count;
 
+    InvalidateVirtualCache();
+
     ResetVisibleLinesRange();
 
     // scrollbars must be reset
@@ -3937,6 +4257,11 @@ void wxListMainWindow::CheckItem(long item, bool state)
 
     SendNotify(item, state ? wxEVT_LIST_ITEM_CHECKED
         : wxEVT_LIST_ITEM_UNCHECKED);
+
+    // The state of the item in a virtual control is presumably updated by
+    // the event handler.
+    if ( IsVirtual() )
+        InvalidateVirtualCache(item, item);
 }
 
 bool wxListMainWindow::IsItemChecked(long item) const
@@ -3949,6 +4274,11 @@ bool wxListMainWindow::IsItemChecked(long item) const
         wxListLineData* line = GetLine((size_t)item);
         return line->IsChecked();
     }
+    else if ( m_virtualCache )
+    {
+        wxListMainWindow* const self = wxConstCast(this, wxListMainWindow);
+        return self->GetVirtualCacheLine(item).checked;
+    }
     else
     {
         wxGenericListCtrl* listctrl = GetListCtrl();
@@ -4277,15 +4607,15 @@ void wxListMainWindow::DeleteItem( long lindex )
         wxListLineData * const line = GetLine(index);
         wxListItem      item;
 
-        size_t i = 0;
-        for ( const auto& it : line->m_items )
+        const size_t count = line->GetSubItemCount();
+        for ( size_t i = 0; i < count; i++ )
         {
-            it.GetItem(item);
+            line->GetItem(i, item);
 
             int itemWidth;
             itemWidth = GetItemWidthWithImage(&item);
 
-            wxColWidthInfo& widthInfo = m_aColWidths.at(i++);
+            wxColWidthInfo& widthInfo = m_aColWidths.at(i);
             if ( itemWidth >= widthInfo.nMaxWidth )
                 widthInfo.bNeedsUpdate = true;
         }
@@ -4345,10 +4675,10 @@ void wxListMainWindow::DeleteColumn( int col )
             //  6. Call DeleteColumn().
             // So we need to check for this as otherwise we would simply crash
             // if this happens.
-            if ( line.m_items.size() <= static_cast<unsigned>(col) )
+            if ( line.GetSubItemCount() <= static_cast<unsigned>(col) )
                 continue;
 
-            line.m_items.erase(line.m_items.begin() + col);
+            line.DeleteSubItem(col);
         }
     }
 
@@ -4630,11 +4960,8 @@ long wxListMainWindow::InsertColumn( long col, const wxListItem &item )
             // update all the items
             for ( auto& line : m_lines )
             {
-                auto& items = line.m_items;
-                if ( insert )
-                    items.emplace(items.begin() + col, this);
-                else
-                    items.emplace_back(this);
+                line.InsertSubItem(insert ? static_cast<size_t>(col)
+                                          : line.GetSubItemCount());
             }
         }
 
@@ -5788,14 +6115,28 @@ void wxGenericListCtrl::SetItemCount(long count)
 
 void wxGenericListCtrl::RefreshItem(long item)
 {
+    m_mainWin->InvalidateVirtualCache(item, item);
     m_mainWin->RefreshLine(item);
 }
 
 void wxGenericListCtrl::RefreshItems(long itemFrom, long itemTo)
 {
+    m_mainWin->InvalidateVirtualCache(itemFrom, itemTo);
     m_mainWin->RefreshLines(itemFrom, itemTo);
 }
 
+void wxGenericListCtrl::EnableVirtualCache(bool enable, bool prefetch)
+{
+    wxCHECK_RET( IsVirtual(), wxT("this is for virtual controls only") );
+
+    m_mainWin->EnableVirtualCache(enable, prefetch);
+}
+
+void wxGenericListCtrl::InvalidateVirtualCache()
+{
+    m_mainWin->InvalidateVirtualCache();
+}
+
 void wxGenericListCtrl::EnableBellOnNoMatch( bool on )
 {
     m_mainWin->EnableBellOnNoMatch(on);
@@ -5816,7 +6157,12 @@ void wxGenericListCtrl::Refresh(bool eraseBackground, const wxRect *rect)
             m_headerWin->Refresh(eraseBackground);
 
         if (m_mainWin)
+        {
+            // Refreshing the entire control is often used to show the
+            // updated items of a virtual control, so don't use the cache.
+            m_mainWin->InvalidateVirtualCache();
             m_mainWin->Refresh(eraseBackground);
+        }
     }
     else
     {
@@ -40,6 +40,8 @@
 
 #include "wx/generic/private/drawbitmap.h"
 
+#include <vector>
+
 #ifdef __WXMAC__
     #include "wx/osx/private.h"
 #endif
@@ -66,6 +68,9 @@ static const int MARGIN_BETWEEN_STATE_AND_IMAGE = 2;
 // the margin between the item image and the item text
 static const int MARGIN_BETWEEN_IMAGE_AND_TEXT = 4;
 
+// the margin above the first item
+static const int MARGIN_ABOVE_ITEMS = 2;
+
 // -----------------------------------------------------------------------------
 // private classes
 // -----------------------------------------------------------------------------
@@ -145,6 +150,9 @@ public:
         m_data = nullptr;
         m_widthText =
         m_heightText = -1;
+        m_subtreeHeight = -1;
+        m_index = 0;
+        m_hasChildrenIndex = false;
     }
 
     wxGenericTreeItem( wxGenericTreeItem *parent,
@@ -193,12 +201,6 @@ public:
         ResetTextSize();
     }
 
-    int GetX() const { return m_x; }
-    int GetY() const { return m_y; }
-
-    void SetX(int x) { m_x = x; }
-    void SetY(int y) { m_y = y; }
-
     int GetHeight() const { return m_height; }
     int GetWidth() const { return m_width; }
 
@@ -247,6 +249,9 @@ public:
     void Insert(wxGenericTreeItem *child, size_t index)
         { m_children.Insert(child, index); }
 
+    // return the index of this item in its parent children array
+    size_t GetIndexInParent() const;
+
     // calculate and cache the item size using either the provided DC (which is
     // supposed to have wxGenericTreeCtrl::m_normalFont selected into it!) or a
     // wxClientDC on the control window
@@ -254,20 +259,51 @@ public:
         { DoCalculateSize(control, dc, true /* dc uses normal font */); }
     void CalculateSize(wxGenericTreeCtrl *control);
 
-    void GetSize( int &x, int &y, const wxGenericTreeCtrl* );
-
     void ResetSize() { m_width = 0; }
     void ResetTextSize() { m_width = 0; m_widthText = -1; }
     void RecursiveResetSize();
     void RecursiveResetTextSize();
-
-        // return the item at given position (or nullptr if no item), onButton is
-        // true if the point belongs to the item's button, otherwise it lies
-        // on the item's label
-    wxGenericTreeItem *HitTest( const wxPoint& point,
-                                const wxGenericTreeCtrl *,
-                                int &flags,
-                                int level );
+    void RecursiveResetHeights();
+
+        // return the wxTREE_HITTEST_XXX flags for the given point which must
+        // be inside the row of this item, which is at the given position
+    int HitTest( const wxPoint& point,
+                 const wxPoint& pos,
+                 const wxGenericTreeCtrl *theCtrl ) const;
+
+    // the cached height of this item together with all its visible
+    // descendants or -1 if it's not known
+    int GetSubtreeHeight() const { return m_subtreeHeight; }
+    void SetSubtreeHeight(int height) { m_subtreeHeight = height; }
+
+    // the children index is a Fenwick tree of the subtree heights of all
+    // children, allowing to find the offset of the given child from the
+    // parent, or the child at the given offset, in logarithmic time; it is
+    // built by wxGenericTreeCtrl on demand and must be reset when the
+    // children change in any way other than their heights
+    bool HasChildrenIndex() const { return m_hasChildrenIndex; }
+    void ResetChildrenIndex()
+    {
+        m_childrenHeights.clear();
+        m_hasChildrenIndex = false;
+    }
+    void BuildChildrenIndex(const std::vector<int>& heights);
+
+    // total height of the first n children subtrees
+    int GetChildrenOffset(size_t n) const;
+    int GetChildrenHeight() const
+        { return GetChildrenOffset(m_childrenHeights.size()); }
+
+    // find the child containing the given offset, which is updated to become
+    // relative to this child, return its index or the number of children if
+    // the offset is beyond the last child
+    size_t FindChildAtOffset(int& offset) const;
+
+    // update the index after changing the height of the child with the given
+    // index or after adding or removing the last child
+    void AdjustChildHeight(size_t n, int delta);
+    void AppendChildHeight(int height);
+    void RemoveLastChildHeight();
 
     void Expand() { m_isCollapsed = false; }
     void Collapse() { m_isCollapsed = true; }
@@ -339,12 +375,15 @@ private:
 
     wxItemAttr     *m_attr;         // attributes???
 
+    std::vector<int>    m_childrenHeights; // index of children heights
+    int                 m_subtreeHeight; // -1 if not computed yet
+    unsigned int        m_index;        // in the parent children array,
+                                        // valid if the parent has index
+
     // tree ctrl images for the normal, selected, expanded and
     // expanded+selected states
     int                 m_images[wxTreeItemIcon_Max];
 
-    wxCoord             m_x;            // (virtual) offset from top
-    wxCoord             m_y;            // (virtual) offset from left
     int                 m_width;        // width of this item
     int                 m_height;       // height of this item
 
@@ -355,6 +394,7 @@ private:
                                           // children but has a [+] button
     unsigned int        m_isBold      :1; // render the label in bold font
     unsigned int        m_ownsAttr    :1; // delete attribute when done
+    unsigned int        m_hasChildrenIndex :1;
 
     wxDECLARE_NO_COPY_CLASS(wxGenericTreeItem);
 };
@@ -619,12 +659,15 @@ wxGenericTreeItem::wxGenericTreeItem(wxGenericTreeItem *parent,
 
     m_data = data;
     m_state = wxTREE_ITEMSTATE_NONE;
-    m_x = m_y = 0;
+
+    m_subtreeHeight = -1;
+    m_index = 0;
 
     m_isCollapsed = true;
     m_hasHilight = false;
     m_hasPlus = false;
     m_isBold = false;
+    m_hasChildrenIndex = false;
 
     m_parent = parent;
 
@@ -682,126 +725,183 @@ size_t wxGenericTreeItem::GetChildrenCount(bool recursively) const
     return total;
 }
 
-void wxGenericTreeItem::GetSize( int &x, int &y,
-                                 const wxGenericTreeCtrl *theButton )
+size_t wxGenericTreeItem::GetIndexInParent() const
+{
+    wxCHECK_MSG( m_parent, 0, "root item doesn't have any index" );
+
+    if ( m_parent->HasChildrenIndex() )
+        return m_index;
+
+    wxGenericTreeItem * const self = const_cast<wxGenericTreeItem*>(this);
+    const int index = m_parent->m_children.Index(self);
+    wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
+
+    return index;
+}
+
+void wxGenericTreeItem::BuildChildrenIndex(const std::vector<int>& heights)
 {
-    int bottomY=m_y+theButton->GetLineHeight(this);
-    if ( y < bottomY )
-        y = bottomY;
-    int width = m_x +  m_width;
-    if ( x < width )
-        x = width;
+    const size_t count = m_children.GetCount();
+    wxASSERT( heights.size() == count );
 
-    if (IsExpanded())
+    // Build the Fenwick tree in linear time: each node contains the sum of
+    // its own element and of all the nodes for which it is the parent.
+    m_childrenHeights = heights;
+    for ( size_t n = 1; n <= count; n++ )
     {
-        size_t count = m_children.GetCount();
-        for ( size_t n = 0; n < count; ++n )
-        {
-            m_children[n]->GetSize( x, y, theButton );
-        }
+        m_children[n - 1]->m_index = n - 1;
+
+        const size_t parent = n + (n & (0 - n));
+        if ( parent <= count )
+            m_childrenHeights[parent - 1] += m_childrenHeights[n - 1];
     }
+
+    m_hasChildrenIndex = true;
+}
+
+int wxGenericTreeItem::GetChildrenOffset(size_t n) const
+{
+    wxASSERT( m_hasChildrenIndex );
+
+    int offset = 0;
+    for ( ; n > 0; n -= n & (0 - n) )
+        offset += m_childrenHeights[n - 1];
+
+    return offset;
 }
 
-wxGenericTreeItem *wxGenericTreeItem::HitTest(const wxPoint& point,
-                                              const wxGenericTreeCtrl *theCtrl,
-                                              int &flags,
-                                              int level)
+size_t wxGenericTreeItem::FindChildAtOffset(int& offset) const
 {
-    // for a hidden root node, don't evaluate it, but do evaluate children
-    if ( !(level == 0 && theCtrl->HasFlag(wxTR_HIDE_ROOT)) )
+    wxASSERT( m_hasChildrenIndex );
+
+    const size_t count = m_childrenHeights.size();
+
+    size_t step = 1;
+    while ( step <= count / 2 )
+        step *= 2;
+
+    // Find the greatest number of children whose total height doesn't exceed
+    // the offset: the next child is then the one containing it.
+    size_t n = 0;
+    for ( ; step; step /= 2 )
     {
-        // evaluate the item
-        int h = theCtrl->GetLineHeight(this);
-        if ((point.y > m_y) && (point.y < m_y + h))
+        if ( n + step <= count && m_childrenHeights[n + step - 1] <= offset )
         {
-            int y_mid = m_y + h/2;
-            if (point.y < y_mid )
-                flags |= wxTREE_HITTEST_ONITEMUPPERPART;
-            else
-                flags |= wxTREE_HITTEST_ONITEMLOWERPART;
+            n += step;
+            offset -= m_childrenHeights[n - 1];
+        }
+    }
 
-            int xCross = m_x - theCtrl->FromDIP(theCtrl->GetSpacing());
-#ifdef __WXMAC__
-            // according to the drawing code the triangels are drawn
-            // at -4 , -4  from the position up to +10/+10 max
-            const int triangleStart = theCtrl->FromDIP(4);
-            const int triangleEnd = theCtrl->FromDIP(10);
-            if ((point.x > xCross - triangleStart) && (point.x < xCross + triangleEnd) &&
-                (point.y > y_mid - triangleStart) && (point.y < y_mid + triangleEnd) &&
-                HasPlus() && theCtrl->HasButtons() )
-#else
-            // 5 is the size of the plus sign
-            const int plusSize = 1 + theCtrl->FromDIP(5);
-            if ((point.x > xCross - plusSize) && (point.x < xCross + plusSize) &&
-                (point.y > y_mid - plusSize) && (point.y < y_mid + plusSize) &&
-                HasPlus() && theCtrl->HasButtons() )
-#endif
-            {
-                flags |= wxTREE_HITTEST_ONITEMBUTTON;
-                return this;
-            }
+    return n;
+}
 
-            if ((point.x >= m_x) && (point.x <= m_x+m_width))
-            {
-                int image_w = -1;
+void wxGenericTreeItem::AdjustChildHeight(size_t n, int delta)
+{
+    wxASSERT( m_hasChildrenIndex );
 
-                // assuming every image (normal and selected) has the same size!
-                if ( (GetImage() != NO_IMAGE) && theCtrl->HasImages() )
-                {
-                    image_w = theCtrl->GetImageLogicalSize(theCtrl).x;
-                }
+    const size_t count = m_childrenHeights.size();
+    for ( n++; n <= count; n += n & (0 - n) )
+        m_childrenHeights[n - 1] += delta;
+}
 
-                int state_w = -1;
+void wxGenericTreeItem::AppendChildHeight(int height)
+{
+    wxASSERT( m_hasChildrenIndex );
+    wxASSERT( m_childrenHeights.size() + 1 == m_children.GetCount() );
 
-                if ( (GetState() != wxTREE_ITEMSTATE_NONE) &&
-                        theCtrl->m_imagesState.HasImages() )
-                {
-                    int state_h;
-                    theCtrl->m_imagesState.GetImageLogicalSize(theCtrl, GetState(),
-                                                       state_w, state_h);
-                }
+    // The new node covers the range ending with it whose length is given by
+    // its lowest bit, so it's the sum of the nodes covering the same range.
+    const size_t n = m_children.GetCount();
+    for ( size_t step = 1; step < (n & (0 - n)); step *= 2 )
+        height += m_childrenHeights[n - step - 1];
 
-                if ((state_w != -1) && (point.x <= m_x + state_w + 1))
-                    flags |= wxTREE_HITTEST_ONITEMSTATEICON;
-                else if ((image_w != -1) &&
-                         (point.x <= m_x +
-                            (state_w != -1 ? state_w +
-                                                MARGIN_BETWEEN_STATE_AND_IMAGE
-                                           : 0)
-                                            + image_w + 1))
-                    flags |= wxTREE_HITTEST_ONITEMICON;
-                else
-                    flags |= wxTREE_HITTEST_ONITEMLABEL;
+    m_childrenHeights.push_back(height);
+    m_children.Last()->m_index = n - 1;
+}
 
-                return this;
-            }
+void wxGenericTreeItem::RemoveLastChildHeight()
+{
+    wxASSERT( m_hasChildrenIndex );
 
-            if (point.x < m_x)
-                flags |= wxTREE_HITTEST_ONITEMINDENT;
-            if (point.x > m_x+m_width)
-                flags |= wxTREE_HITTEST_ONITEMRIGHT;
+    // Removing the last node doesn't affect any of the preceding ones.
+    m_childrenHeights.pop_back();
+}
 
-            return this;
-        }
+int wxGenericTreeItem::HitTest(const wxPoint& point,
+                               const wxPoint& pos,
+                               const wxGenericTreeCtrl *theCtrl) const
+{
+    int flags;
 
-        // if children are expanded, fall through to evaluate them
-        if (m_isCollapsed)
-            return nullptr;
+    const int h = theCtrl->GetLineHeight(const_cast<wxGenericTreeItem*>(this));
+    int y_mid = pos.y + h/2;
+    if (point.y < y_mid )
+        flags = wxTREE_HITTEST_ONITEMUPPERPART;
+    else
+        flags = wxTREE_HITTEST_ONITEMLOWERPART;
+
+    int xCross = pos.x - theCtrl->FromDIP(theCtrl->GetSpacing());
+#ifdef __WXMAC__
+    // according to the drawing code the triangels are drawn
+    // at -4 , -4  from the position up to +10/+10 max
+    const int triangleStart = theCtrl->FromDIP(4);
+    const int triangleEnd = theCtrl->FromDIP(10);
+    if ((point.x > xCross - triangleStart) && (point.x < xCross + triangleEnd) &&
+        (point.y > y_mid - triangleStart) && (point.y < y_mid + triangleEnd) &&
+        HasPlus() && theCtrl->HasButtons() )
+#else
+    // 5 is the size of the plus sign
+    const int plusSize = 1 + theCtrl->FromDIP(5);
+    if ((point.x > xCross - plusSize) && (point.x < xCross + plusSize) &&
+        (point.y > y_mid - plusSize) && (point.y < y_mid + plusSize) &&
+        HasPlus() && theCtrl->HasButtons() )
+#endif
+    {
+        flags |= wxTREE_HITTEST_ONITEMBUTTON;
+        return flags;
     }
 
-    // evaluate children
-    size_t count = m_children.GetCount();
-    for ( size_t n = 0; n < count; n++ )
+    if ((point.x >= pos.x) && (point.x <= pos.x+m_width))
     {
-        wxGenericTreeItem *res = m_children[n]->HitTest( point,
-                                                         theCtrl,
-                                                         flags,
-                                                         level + 1 );
-        if ( res != nullptr )
-            return res;
+        int image_w = -1;
+
+        // assuming every image (normal and selected) has the same size!
+        if ( (GetImage() != NO_IMAGE) && theCtrl->HasImages() )
+        {
+            image_w = theCtrl->GetImageLogicalSize(theCtrl).x;
+        }
+
+        int state_w = -1;
+
+        if ( (GetState() != wxTREE_ITEMSTATE_NONE) &&
+                theCtrl->m_imagesState.HasImages() )
+        {
+            int state_h;
+            theCtrl->m_imagesState.GetImageLogicalSize(theCtrl, GetState(),
+                                               state_w, state_h);
+        }
+
+        if ((state_w != -1) && (point.x <= pos.x + state_w + 1))
+            flags |= wxTREE_HITTEST_ONITEMSTATEICON;
+        else if ((image_w != -1) &&
+                 (point.x <= pos.x +
+                    (state_w != -1 ? state_w +
+                                        MARGIN_BETWEEN_STATE_AND_IMAGE
+                                   : 0)
+                                    + image_w + 1))
+            flags |= wxTREE_HITTEST_ONITEMICON;
+        else
+            flags |= wxTREE_HITTEST_ONITEMLABEL;
+
+        return flags;
     }
 
-    return nullptr;
+    if (point.x < pos.x)
+        flags |= wxTREE_HITTEST_ONITEMINDENT;
+    if (point.x > pos.x+m_width)
+        flags |= wxTREE_HITTEST_ONITEMRIGHT;
+
+    return flags;
 }
 
 int wxGenericTreeItem::GetCurrentImage() const
@@ -907,14 +1007,23 @@ wxGenericTreeItem::DoCalculateSize(wxGenericTreeCtrl* control,
     m_height += control->FromDIP(2); // See CalculateLineHeight().
 
     if (m_height > control->m_lineHeight)
+    {
         control->m_lineHeight = m_height;
 
+        // The positions of all items depend on the line height, unless they
+        // all use their own heights.
+        if ( !control->HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+            control->InvalidateLayout();
+    }
+
     m_width = state_w + image_w + m_widthText + 2;
 }
 
 void wxGenericTreeItem::RecursiveResetSize()
 {
     m_width = 0;
+    m_subtreeHeight = -1;
+    ResetChildrenIndex();
 
     const size_t count = m_children.Count();
     for (size_t i = 0; i < count; i++ )
@@ -925,12 +1034,24 @@ void wxGenericTreeItem::RecursiveResetTextSize()
 {
     m_width = 0;
     m_widthText = -1;
+    m_subtreeHeight = -1;
+    ResetChildrenIndex();
 
     const size_t count = m_children.Count();
     for (size_t i = 0; i < count; i++ )
         m_children[i]->RecursiveResetTextSize();
 }
 
+void wxGenericTreeItem::RecursiveResetHeights()
+{
+    m_subtreeHeight = -1;
+    ResetChildrenIndex();
+
+    const size_t count = m_children.Count();
+    for (size_t i = 0; i < count; i++ )
+        m_children[i]->RecursiveResetHeights();
+}
+
 // -----------------------------------------------------------------------------
 // wxGenericTreeCtrl implementation
 // -----------------------------------------------------------------------------
@@ -963,6 +1084,7 @@ void wxGenericTreeCtrl::Init()
     m_dirty = false;
 
     m_lineHeight = 10;
+    m_itemsWidth = 0;
     m_indent = 0;
     m_spacing = 0;
 
@@ -1112,7 +1234,14 @@ void wxGenericTreeCtrl::SetWindowStyleFlag(long styles)
         // if we will hide the root, make sure children are visible
         m_anchor->SetHasPlus();
         m_anchor->Expand();
-        CalculatePositions();
+    }
+
+    // the items heights depend on these styles
+    if ( m_anchor &&
+            ((m_windowStyle ^ styles) &
+                (wxTR_HIDE_ROOT | wxTR_HAS_VARIABLE_ROW_HEIGHT)) )
+    {
+        m_anchor->RecursiveResetHeights();
     }
 
     // right now, just sets the styles.  Eventually, we may
@@ -1189,6 +1318,7 @@ wxGenericTreeCtrl::SetItemText(const wxTreeItemId& item, const wxString& text)
     wxGenericTreeItem *pItem = (wxGenericTreeItem*) item.m_pItem;
     pItem->SetText(text);
     pItem->CalculateSize(this);
+    UpdateRowHeight(pItem);
     RefreshLine(pItem);
 }
 
@@ -1201,6 +1331,7 @@ void wxGenericTreeCtrl::SetItemImage(const wxTreeItemId& item,
     wxGenericTreeItem *pItem = (wxGenericTreeItem*) item.m_pItem;
     pItem->SetImage(image, which);
     pItem->CalculateSize(this);
+    UpdateRowHeight(pItem);
     RefreshLine(pItem);
 }
 
@@ -1222,6 +1353,7 @@ void wxGenericTreeCtrl::DoSetItemState(const wxTreeItemId& item, int state)
     wxGenericTreeItem *pItem = (wxGenericTreeItem*) item.m_pItem;
     pItem->SetState(state);
     pItem->CalculateSize(this);
+    UpdateRowHeight(pItem);
     RefreshLine(pItem);
 }
 
@@ -1247,6 +1379,7 @@ void wxGenericTreeCtrl::SetItemBold(const wxTreeItemId& item, bool bold)
         // recalculate the item size as bold and non bold fonts have different
         // widths
         pItem->CalculateSize(this);
+        UpdateRowHeight(pItem);
         RefreshLine(pItem);
     }
 }
@@ -1299,6 +1432,7 @@ wxGenericTreeCtrl::SetItemFont(const wxTreeItemId& item, const wxFont& font)
     pItem->Attr().SetFont(font);
     pItem->ResetTextSize();
     pItem->CalculateSize(this);
+    UpdateRowHeight(pItem);
     RefreshLine(pItem);
 }
 
@@ -1314,6 +1448,7 @@ bool wxGenericTreeCtrl::SetFont( const wxFont &font )
 
     if (m_anchor)
         m_anchor->RecursiveResetTextSize();
+    m_itemsWidth = 0;
 
     return true;
 }
@@ -1456,10 +1591,7 @@ wxTreeItemId wxGenericTreeCtrl::GetNextSibling(const wxTreeItemId& item) const
     }
 
     wxArrayGenericTreeItems& siblings = parent->GetChildren();
-    int index = siblings.Index(i);
-    wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
-
-    size_t n = (size_t)(index + 1);
+    size_t n = i->GetIndexInParent() + 1;
     return n == siblings.GetCount() ? wxTreeItemId()
                                     : wxTreeItemId(siblings[n]);
 }
@@ -1477,11 +1609,10 @@ wxTreeItemId wxGenericTreeCtrl::GetPrevSibling(const wxTreeItemId& item) const
     }
 
     wxArrayGenericTreeItems& siblings = parent->GetChildren();
-    int index = siblings.Index(i);
-    wxASSERT( index != wxNOT_FOUND ); // I'm not a child of my parent?
+    size_t index = i->GetIndexInParent();
 
     return index == 0 ? wxTreeItemId()
-                      : wxTreeItemId(siblings[(size_t)(index - 1)]);
+                      : wxTreeItemId(siblings[index - 1]);
 }
 
 // Only for internal use right now, but should probably be public
@@ -1672,8 +1803,10 @@ wxTreeItemId wxGenericTreeCtrl::DoInsertItem(const wxTreeItemId& parentId,
         data->m_pItem = item;
     }
 
-    parent->Insert( item, previous == (size_t)-1 ? parent->GetChildren().size()
-                                                 : previous );
+    const size_t index = previous == (size_t)-1 ? parent->GetChildren().size()
+                                                : previous;
+    parent->Insert( item, index );
+    UpdateLayoutAfterInsert( item, index );
 
     InvalidateBestSize();
     return item;
@@ -1701,7 +1834,6 @@ wxTreeItemId wxGenericTreeCtrl::AddRoot(const wxString& text,
         // into children
         m_anchor->SetHasPlus();
         m_anchor->Expand();
-        CalculatePositions();
     }
 
     if (!HasFlag(wxTR_MULTIPLE))
@@ -1784,6 +1916,10 @@ void wxGenericTreeCtrl::DeleteChildren(const wxTreeItemId& itemId)
     wxGenericTreeItem *item = (wxGenericTreeItem*) itemId.m_pItem;
     ChildrenClosing(item);
     item->DeleteChildren(this);
+    item->ResetChildrenIndex();
+    if ( ShowsChildren(item) )
+        UpdateSubtreeHeight(item);
+    m_itemsWidth = 0; // the widest item could have been among the children
     InvalidateBestSize();
 }
 
@@ -1803,11 +1939,12 @@ void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
 
     // if the selected item will be deleted, select the parent ...
     wxGenericTreeItem *to_be_selected = parent;
+    size_t pos = 0;
     if (parent)
     {
         // .. unless there is a next sibling like wxMSW does it
-        int pos = parent->GetChildren().Index( item );
-        if ((int)(parent->GetChildren().GetCount()) > pos+1)
+        pos = item->GetIndexInParent();
+        if (parent->GetChildren().GetCount() > pos+1)
             to_be_selected = parent->GetChildren().Item( pos+1 );
     }
 
@@ -1843,7 +1980,25 @@ void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
     // remove the item from the tree
     if ( parent )
     {
-        parent->GetChildren().Remove( item );  // remove by value
+        wxArrayGenericTreeItems& siblings = parent->GetChildren();
+        siblings.RemoveAt( pos );
+
+        if ( parent->HasChildrenIndex() )
+        {
+            if ( pos == siblings.GetCount() )
+                parent->RemoveLastChildHeight();
+            else
+                parent->ResetChildrenIndex();
+        }
+
+        if ( ShowsChildren(parent) )
+        {
+            const int height = item->GetSubtreeHeight();
+            if ( height != -1 )
+                AdjustSubtreeHeight(parent, -height);
+            else
+                InvalidateSubtreeHeight(parent);
+        }
     }
     else // deleting the root
     {
@@ -1851,6 +2006,9 @@ void wxGenericTreeCtrl::Delete(const wxTreeItemId& itemId)
         m_anchor = nullptr;
     }
 
+    // the widest item could have been among the deleted ones
+    m_itemsWidth = 0;
+
     // and delete all of its children and the item itself now
     item->DeleteChildren(this);
     SendDeleteEvent(item);
@@ -1894,10 +2052,9 @@ void wxGenericTreeCtrl::Expand(const wxTreeItemId& itemId)
     }
 
     item->Expand();
+    UpdateSubtreeHeight(item);
     if ( !IsFrozen() )
     {
-        CalculatePositions();
-
         RefreshSubtree(item);
     }
     else // frozen
@@ -1936,6 +2093,10 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
 
     ChildrenClosing(item);
     item->Collapse();
+    UpdateSubtreeHeight(item);
+
+    // the widest item could have been among the children
+    m_itemsWidth = 0;
 
 #if 0  // TODO why should items be collapsed recursively?
     wxArrayGenericTreeItems& children = item->GetChildren();
@@ -1946,8 +2107,6 @@ void wxGenericTreeCtrl::Collapse(const wxTreeItemId& itemId)
     }
 #endif
 
-    CalculatePositions();
-
     RefreshSubtree(item);
 
     event.SetEventType(wxEVT_TREE_ITEM_COLLAPSED);
@@ -2128,8 +2287,9 @@ wxGenericTreeCtrl::SelectItemRange(wxGenericTreeItem *item1,
 
     // item2 is not necessary after item1
     // choice first' and 'last' between item1 and item2
-    wxGenericTreeItem *first= (item1->GetY()<item2->GetY()) ? item1 : item2;
-    wxGenericTreeItem *last = (item1->GetY()<item2->GetY()) ? item2 : item1;
+    const bool firstIs1 = GetItemY(item1) < GetItemY(item2);
+    wxGenericTreeItem *first= firstIs1 ? item1 : item2;
+    wxGenericTreeItem *last = firstIs1 ? item2 : item1;
 
     bool select = m_current->IsSelected();
 
@@ -2332,7 +2492,10 @@ void wxGenericTreeCtrl::ScrollTo(const wxTreeItemId &item)
 
     wxGenericTreeItem *gitem = (wxGenericTreeItem*) item.m_pItem;
 
-    int itemY = gitem->GetY();
+    // measure the item before using its position, which may depend on it
+    gitem->CalculateSize(this);
+
+    int itemY = GetItemY(gitem);
 
     int start_x = 0;
     int start_y = 0;
@@ -2391,6 +2554,8 @@ void wxGenericTreeCtrl::SortChildren(const wxTreeItemId& itemId)
         s_treeBeingSorted = this;
         children.Sort(tree_ctrl_compare_func);
         s_treeBeingSorted = nullptr;
+
+        item->ResetChildrenIndex();
     }
     //else: don't make the tree dirty as nothing changed
 }
@@ -2458,6 +2623,7 @@ void wxGenericTreeCtrl::UpdateAfterImageListChange()
 
     if (m_anchor)
         m_anchor->RecursiveResetSize();
+    m_itemsWidth = 0;
 
     // Don't do this if we're in the process of deleting the tree control.
     if (HasImages())
@@ -2506,8 +2672,14 @@ void wxGenericTreeCtrl::AdjustMyScrollbars()
 {
     if (m_anchor)
     {
-        int x = 0, y = 0;
-        m_anchor->GetSize( x, y, this );
+        // m_itemsWidth is reset when the items are removed from view, so
+        // compute it for the currently shown items to avoid losing the
+        // horizontal scroll position until they are painted again.
+        if ( !m_itemsWidth )
+            UpdateShownItemsWidth();
+
+        int x = m_itemsWidth;
+        int y = MARGIN_ABOVE_ITEMS + GetSubtreeHeight(m_anchor);
         y += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         x += PIXELS_PER_UNIT+2; // one more scrollbar unit + 2 pixels
         int x_pos = GetScrollPos( wxHORIZONTAL );
@@ -2522,15 +2694,43 @@ void wxGenericTreeCtrl::AdjustMyScrollbars()
     }
 }
 
+void wxGenericTreeCtrl::UpdateShownItemsWidth()
+{
+    int yTop;
+    CalcUnscrolledPosition(0, 0, nullptr, &yTop);
+    const int yBottom = yTop + GetClientSize().y;
+
+    int y;
+    for ( wxGenericTreeItem *item = FindItemAtY(wxMax(yTop, MARGIN_ABOVE_ITEMS), &y);
+          item && y < yBottom;
+          item = GetNextShown(item) )
+    {
+        item->CalculateSize(this);
+
+        const int width = GetItemX(item) + item->GetWidth();
+        if ( width > m_itemsWidth )
+            m_itemsWidth = width;
+
+        y += GetLineHeight(item);
+    }
+}
+
 int wxGenericTreeCtrl::GetLineHeight(wxGenericTreeItem *item) const
 {
     if (GetWindowStyleFlag() & wxTR_HAS_VARIABLE_ROW_HEIGHT)
+    {
+        // items are measured lazily, so do it now if not done yet
+        item->CalculateSize(wxConstCast(this, wxGenericTreeCtrl));
         return item->GetHeight();
+    }
     else
         return m_lineHeight;
 }
 
-void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
+void
+wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item,
+                             wxDC& dc,
+                             const wxPoint& pos)
 {
     item->SetFont(this, dc);
     item->CalculateSize(this, dc);
@@ -2604,7 +2804,7 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
         int x, w, h;
         x=0;
         GetVirtualSize(&w, &h);
-        wxRect rect( x, item->GetY()+offset, w, total_h-offset);
+        wxRect rect( x, pos.y+offset, w, total_h-offset);
         if (!item->IsSelected())
         {
             dc.DrawRectangle(rect);
@@ -2629,8 +2829,8 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
             // If it's selected, and there's an state image or normal image,
             // then we should take care to leave the area under the image
             // painted in the background colour.
-            wxRect rect( item->GetX() + state_w + image_w - 2,
-                         item->GetY() + offset,
+            wxRect rect( pos.x + state_w + image_w - 2,
+                         pos.y + offset,
                          item->GetWidth() - state_w - image_w + 2,
                          total_h - offset );
             rect.x -= 1;
@@ -2649,8 +2849,8 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
         // except for custom item backgrounds, works for both kinds of theme.
         else if (drawItemBackground)
         {
-            wxRect rect( item->GetX() + state_w + image_w - 2,
-                         item->GetY() + offset,
+            wxRect rect( pos.x + state_w + image_w - 2,
+                         pos.y + offset,
                          item->GetWidth() - state_w - image_w + 2,
                          total_h - offset );
             if ( hasBgColour )
@@ -2675,31 +2875,31 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
 
     if ( state != wxTREE_ITEMSTATE_NONE )
     {
-        wxDCClipper clip(dc, item->GetX(), item->GetY(), state_w, total_h);
+        wxDCClipper clip(dc, pos.x, pos.y, state_w, total_h);
 
         wxDrawImageBitmap(this, m_imagesState, state,
                           dc,
-                          item->GetX(),
-                          item->GetY() +
+                          pos.x,
+                          pos.y +
                           (total_h > state_h ? (total_h-state_h)/2 : 0));
     }
 
     if ( image != NO_IMAGE )
     {
-        wxDCClipper clip(dc, item->GetX() + state_w, item->GetY(),
+        wxDCClipper clip(dc, pos.x + state_w, pos.y,
                              image_w, total_h);
         wxDrawImageBitmap(this, image,
                           dc,
-                          item->GetX() + state_w,
-                          item->GetY() +
+                          pos.x + state_w,
+                          pos.y +
                           (total_h > image_h ? (total_h-image_h)/2 : 0));
     }
 
     dc.SetBackgroundMode(wxBRUSHSTYLE_TRANSPARENT);
     int extraH = (total_h > text_h) ? (total_h - text_h)/2 : 0;
     dc.DrawText( item->GetText(),
-                 (wxCoord)(state_w + image_w + item->GetX()),
-                 (wxCoord)(item->GetY() + extraH));
+                 (wxCoord)(state_w + image_w + pos.x),
+                 (wxCoord)(pos.y + extraH));
 
     // restore normal font
     dc.SetFont( m_normalFont );
@@ -2715,20 +2915,20 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
                 dc.SetBrush(*wxTRANSPARENT_BRUSH);
                 int w = item->GetWidth() + 2;
                 int h = total_h + 2;
-                dc.DrawRectangle( item->GetX() - 1, item->GetY() - 1, w, h);
+                dc.DrawRectangle( pos.x - 1, pos.y - 1, w, h);
                 break;
             }
             case AboveEffect:
             {
-                int x = item->GetX(),
-                    y = item->GetY();
+                int x = pos.x,
+                    y = pos.y;
                 dc.DrawLine( x, y, x + item->GetWidth(), y);
                 break;
             }
             case BelowEffect:
             {
-                int x = item->GetX(),
-                    y = item->GetY();
+                int x = pos.x,
+                    y = pos.y;
                 y += total_h - 1;
                 dc.DrawLine( x, y, x + item->GetWidth(), y);
                 break;
@@ -2740,52 +2940,17 @@ void wxGenericTreeCtrl::PaintItem(wxGenericTreeItem *item, wxDC& dc)
 }
 
 void
-wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
-                              wxDC &dc,
-                              int level,
-                              int &y)
+wxGenericTreeCtrl::PaintRow(wxGenericTreeItem *item, wxDC &dc, int y)
 {
     int indent = FromDIP(m_indent);
     int spacing = FromDIP(m_spacing);
 
-    int x = level*indent;
-    if (!HasFlag(wxTR_HIDE_ROOT))
-    {
-        x += indent;
-    }
-    else if (level == 0)
-    {
-        // always expand hidden root
-        int origY = y;
-        wxArrayGenericTreeItems& children = item->GetChildren();
-        int count = children.GetCount();
-        if (count > 0)
-        {
-            int n = 0, oldY;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, 1, y);
-            } while (++n < count);
-
-            if ( !HasFlag(wxTR_NO_LINES) && HasFlag(wxTR_LINES_AT_ROOT)
-                    && count > 0 )
-            {
-                // draw line down to last child
-                origY += GetLineHeight(children[0])>>1;
-                oldY += GetLineHeight(children[n-1])>>1;
-                dc.DrawLine(3, origY, 3, oldY);
-            }
-        }
-        return;
-    }
-
-    item->SetX(x+spacing);
-    item->SetY(y);
+    int x = GetItemX(item) - spacing;
 
     int h = GetLineHeight(item);
     int y_top = y;
     int y_mid = y_top + (h>>1);
-    y += h;
+    int y_bottom = y_top + h;
 
     int exposed_x = dc.LogicalToDeviceX(0);
     int exposed_y = dc.LogicalToDeviceY(y_top);
@@ -2826,13 +2991,19 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         dc.SetPen(*pen);
 
         // draw
-        PaintItem(item, dc);
+        const wxPoint pos(x + spacing, y_top);
+        PaintItem(item, dc, pos);
+
+        // Remember the width of the widest item seen so far for the
+        // scrollbars, see OnInternalIdle().
+        if ( pos.x + item->GetWidth() > m_itemsWidth )
+            m_itemsWidth = pos.x + item->GetWidth();
 
         if (HasFlag(wxTR_ROW_LINES))
         {
             dc.SetPen(wxSystemSettings::GetColour(wxSYS_COLOUR_GRAYTEXT));
             dc.DrawLine(0, y_top, 10000, y_top);
-            dc.DrawLine(0, y, 10000, y);
+            dc.DrawLine(0, y_bottom, 10000, y_bottom);
         }
 
         // restore DC objects
@@ -2894,46 +3065,52 @@ wxGenericTreeCtrl::PaintLevel(wxGenericTreeItem *item,
         }
     }
 
-    if (item->IsExpanded())
+}
+
+void
+wxGenericTreeCtrl::PaintChildrenLine(wxGenericTreeItem *item, wxDC &dc)
+{
+    if ( !ShowsChildren(item) || !item->HasChildren() )
+        return;
+
+    wxArrayGenericTreeItems& children = item->GetChildren();
+
+    // the line goes down to the middle of the last child
+    wxGenericTreeItem * const last = children.Last();
+    int y_last = GetItemY(last) + (GetLineHeight(last)>>1);
+
+    if ( item == m_anchor && HasFlag(wxTR_HIDE_ROOT) )
     {
-        wxArrayGenericTreeItems& children = item->GetChildren();
-        int count = children.GetCount();
-        if (count > 0)
+        if ( HasFlag(wxTR_LINES_AT_ROOT) )
         {
-            int n = 0, oldY;
-            ++level;
-            do {
-                oldY = y;
-                PaintLevel(children[n], dc, level, y);
-            } while (++n < count);
-
-            if (!HasFlag(wxTR_NO_LINES) && count > 0)
-            {
-                // draw line down to last child
-                oldY += GetLineHeight(children[n-1])>>1;
-                if (HasButtons())
-                    y_mid += 5;
-
-                // Only draw the portion of the line that is visible, in case
-                // it is huge
-                wxCoord xOrigin=0, yOrigin=0, width, height;
-                dc.GetDeviceOrigin(&xOrigin, &yOrigin);
-                yOrigin = abs(yOrigin);
-                GetClientSize(&width, &height);
-
-                // Move end points to the beginning/end of the view?
-                if (y_mid < yOrigin)
-                    y_mid = yOrigin;
-                if (oldY > yOrigin + height)
-                    oldY = yOrigin + height;
-
-                // after the adjustments if y_mid is larger than oldY then the
-                // line isn't visible at all so don't draw anything
-                if (y_mid < oldY)
-                    dc.DrawLine(x, y_mid, x, oldY);
-            }
+            wxGenericTreeItem * const first = children[0];
+            int y_first = GetItemY(first) + (GetLineHeight(first)>>1);
+            dc.DrawLine(3, y_first, 3, y_last);
         }
+
+        return;
     }
+
+    int x = GetItemX(item) - FromDIP(m_spacing);
+    int y_mid = GetItemY(item) + (GetLineHeight(item)>>1);
+    if (HasButtons())
+        y_mid += 5;
+
+    // Only draw the portion of the line that is visible, in case
+    // it is huge
+    const int yOrigin = CalcUnscrolledPosition(wxPoint(0, 0)).y;
+    const int height = GetClientSize().y;
+
+    // Move end points to the beginning/end of the view?
+    if (y_mid < yOrigin)
+        y_mid = yOrigin;
+    if (y_last > yOrigin + height)
+        y_last = yOrigin + height;
+
+    // after the adjustments if y_mid is larger than y_last then the
+    // line isn't visible at all so don't draw anything
+    if (y_mid < y_last)
+        dc.DrawLine(x, y_mid, x, y_last);
 }
 
 void wxGenericTreeCtrl::DrawDropEffect(wxGenericTreeItem *item)
@@ -2978,7 +3155,8 @@ void wxGenericTreeCtrl::DrawBorder(const wxTreeItemId &item)
         m_dndEffectItem = nullptr;
     }
 
-    wxRect rect( i->GetX()-1, i->GetY()-1, i->GetWidth()+2, GetLineHeight(i)+2 );
+    i->CalculateSize(this);
+    wxRect rect( GetItemX(i)-1, GetItemY(i)-1, i->GetWidth()+2, GetLineHeight(i)+2 );
     CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
     RefreshRect( rect );
 }
@@ -3003,7 +3181,8 @@ void wxGenericTreeCtrl::DrawLine(const wxTreeItemId &item, bool below)
         m_dndEffectItem = nullptr;
     }
 
-    wxRect rect( i->GetX()-1, i->GetY()-1, i->GetWidth()+2, GetLineHeight(i)+2 );
+    i->CalculateSize(this);
+    wxRect rect( GetItemX(i)-1, GetItemY(i)-1, i->GetWidth()+2, GetLineHeight(i)+2 );
     CalcScrolledPosition( rect.x, rect.y, &rect.x, &rect.y );
     RefreshRect( rect );
 }
@@ -3031,8 +3210,67 @@ void wxGenericTreeCtrl::OnPaint( wxPaintEvent &WXUNUSED(event) )
     dc.SetFont( m_normalFont );
     dc.SetPen( m_dottedPen );
 
-    int y = 2;
-    PaintLevel( m_anchor, dc, 0, y );
+    // only the items intersecting the update region need to be painted
+    wxRect rectUpdate = GetUpdateClientRect();
+    rectUpdate.SetPosition(CalcUnscrolledPosition(rectUpdate.GetPosition()));
+
+    // Items are measured lazily, so do it for all the items which are going
+    // to be painted before painting any of them, as this can change the line
+    // height and hence the items positions.
+    wxGenericTreeItem *first;
+    int yFirst = 0;
+    for ( ;; )
+    {
+        const int lineHeight = m_lineHeight;
+
+        first = FindItemAtY(wxMax(rectUpdate.y, MARGIN_ABOVE_ITEMS), &yFirst);
+
+        int y = yFirst;
+        for ( wxGenericTreeItem *item = first;
+              item && y <= rectUpdate.GetBottom();
+              item = GetNextShown(item) )
+        {
+            item->CalculateSize(this, dc);
+            y += GetLineHeight(item);
+        }
+
+        if ( m_lineHeight == lineHeight )
+            break;
+    }
+
+    if ( !first )
+        return;
+
+    // The lines from the parent items to their children must be drawn after
+    // painting the children, for all the parents of the first painted item
+    // and all painted items which have any children.
+    std::vector<wxGenericTreeItem *> parents;
+    for ( wxGenericTreeItem *parent = first->GetParent();
+          parent;
+          parent = parent->GetParent() )
+    {
+        parents.push_back(parent);
+    }
+
+    int y = yFirst;
+    for ( wxGenericTreeItem *item = first;
+          item && y <= rectUpdate.GetBottom();
+          item = GetNextShown(item) )
+    {
+        PaintRow(item, dc, y);
+        y += GetLineHeight(item);
+
+        if ( item->HasChildren() && item->IsExpanded() )
+            parents.push_back(item);
+    }
+
+    if ( !HasFlag(wxTR_NO_LINES) )
+    {
+        dc.SetPen( m_dottedPen );
+
+        for ( size_t n = 0; n < parents.size(); n++ )
+            PaintChildrenLine(parents[n], dc);
+    }
 }
 
 void wxGenericTreeCtrl::OnSetFocus( wxFocusEvent &event )
@@ -3446,8 +3684,7 @@ wxGenericTreeCtrl::DoTreeHitTest(const wxPoint& point, int& flags) const
         return wxTreeItemId();
     }
 
-    wxGenericTreeItem *hit =  m_anchor->HitTest(CalcUnscrolledPosition(point),
-                                                this, flags, 0);
+    wxGenericTreeItem *hit = HitTestItem(CalcUnscrolledPosition(point), flags);
     if (hit == nullptr)
     {
         flags = wxTREE_HITTEST_NOWHERE;
@@ -3466,6 +3703,10 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
 
     wxGenericTreeItem *i = (wxGenericTreeItem*) item.m_pItem;
 
+    // items are measured lazily, so we may need to do it now, notice that this
+    // must be done before computing the position as it can change the height
+    i->CalculateSize(wxConstCast(this, wxGenericTreeCtrl));
+
     if ( textOnly )
     {
         int image_w = 0;
@@ -3486,7 +3727,7 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
                 state_w += MARGIN_BETWEEN_IMAGE_AND_TEXT;
         }
 
-        rect.x = i->GetX() + state_w + image_w;
+        rect.x = GetItemX(i) + state_w + image_w;
         rect.width = i->GetWidth() - state_w - image_w;
 
     }
@@ -3496,7 +3737,7 @@ bool wxGenericTreeCtrl::GetBoundingRect(const wxTreeItemId& item,
         rect.width = GetClientSize().x;
     }
 
-    rect.y = i->GetY();
+    rect.y = GetItemY(i);
     rect.height = GetLineHeight(i);
 
     // we have to return the logical coordinates, not physical ones
@@ -3583,7 +3824,7 @@ void wxGenericTreeCtrl::OnMouse( wxMouseEvent &event )
 
     // Is the mouse over a tree item button?
     int flags = 0;
-    wxGenericTreeItem *thisItem = m_anchor->HitTest(pt, this, flags, 0);
+    wxGenericTreeItem *thisItem = HitTestItem(pt, flags);
     wxGenericTreeItem *underMouse = thisItem;
 #if wxUSE_TOOLTIPS
     bool underMouseChanged = (underMouse != m_underMouse) ;
@@ -3668,7 +3909,7 @@ void wxGenericTreeCtrl::OnMouse( wxMouseEvent &event )
 
 
     flags = 0;
-    wxGenericTreeItem *item = m_anchor->HitTest(pt, this, flags, 0);
+    wxGenericTreeItem *item = HitTestItem(pt, flags);
 
     if ( event.Dragging() && !m_isDragging )
     {
@@ -3981,62 +4222,280 @@ void wxGenericTreeCtrl::OnInternalIdle()
     // actually redraw the tree when everything is over
     if (m_dirty)
         DoDirtyProcessing();
+    else if (m_anchor && m_itemsWidth > GetVirtualSize().x)
+        AdjustMyScrollbars(); // some newly painted items are wider
 }
 
-void
-wxGenericTreeCtrl::CalculateLevel(wxGenericTreeItem *item,
-                                  wxReadOnlyDC &dc,
-                                  int level,
-                                  int &y )
+bool wxGenericTreeCtrl::ShowsChildren(const wxGenericTreeItem *item) const
 {
-    int indent = FromDIP(m_indent);
-    int spacing = FromDIP(m_spacing);
+    // hidden root children are always shown, even if it's not expanded
+    return item->IsExpanded() || (item == m_anchor && HasFlag(wxTR_HIDE_ROOT));
+}
 
-    int x = level*indent;
-    if (!HasFlag(wxTR_HIDE_ROOT))
+int wxGenericTreeCtrl::GetRowHeight(wxGenericTreeItem *item) const
+{
+    if ( item == m_anchor && HasFlag(wxTR_HIDE_ROOT) )
+        return 0;
+
+    return GetLineHeight(item);
+}
+
+int wxGenericTreeCtrl::GetSubtreeHeight(wxGenericTreeItem *item) const
+{
+    int height = item->GetSubtreeHeight();
+    if ( height == -1 )
     {
-        x += indent;
+        height = GetRowHeight(item);
+        if ( ShowsChildren(item) )
+        {
+            UpdateChildrenIndex(item);
+            height += item->GetChildrenHeight();
+        }
+
+        item->SetSubtreeHeight(height);
     }
-    else if (level == 0)
+
+    return height;
+}
+
+void wxGenericTreeCtrl::UpdateChildrenIndex(wxGenericTreeItem *item) const
+{
+    if ( item->HasChildrenIndex() )
+        return;
+
+    wxArrayGenericTreeItems& children = item->GetChildren();
+    const size_t count = children.GetCount();
+
+    std::vector<int> heights(count);
+    for ( size_t n = 0; n < count; n++ )
+        heights[n] = GetSubtreeHeight(children[n]);
+
+    item->BuildChildrenIndex(heights);
+}
+
+void wxGenericTreeCtrl::AdjustSubtreeHeight(wxGenericTreeItem *item, int delta)
+{
+    for ( ;; )
     {
-        // a hidden root is not evaluated, but its
-        // children are always calculated
-        goto Recurse;
+        const int height = item->GetSubtreeHeight();
+        if ( height != -1 )
+            item->SetSubtreeHeight(height + delta);
+
+        wxGenericTreeItem * const parent = item->GetParent();
+        if ( !parent )
+            break;
+
+        if ( parent->HasChildrenIndex() )
+        {
+            if ( height != -1 )
+                parent->AdjustChildHeight(item->GetIndexInParent(), delta);
+            else
+                parent->ResetChildrenIndex();
+        }
+
+        // the items above a collapsed one are not affected
+        if ( !ShowsChildren(parent) )
+            break;
+
+        item = parent;
     }
+}
 
-    item->CalculateSize(this, dc);
+void wxGenericTreeCtrl::InvalidateSubtreeHeight(wxGenericTreeItem *item)
+{
+    for ( ;; )
+    {
+        item->SetSubtreeHeight(-1);
 
-    // set its position
-    item->SetX( x+spacing );
-    item->SetY( y );
-    y += GetLineHeight(item);
+        wxGenericTreeItem * const parent = item->GetParent();
+        if ( !parent )
+            break;
 
-    if ( !item->IsExpanded() )
+        parent->ResetChildrenIndex();
+
+        if ( !ShowsChildren(parent) )
+            break;
+
+        item = parent;
+    }
+}
+
+void wxGenericTreeCtrl::UpdateSubtreeHeight(wxGenericTreeItem *item)
+{
+    const int heightOld = item->GetSubtreeHeight();
+    if ( heightOld == -1 )
     {
-        // we don't need to calculate collapsed branches
+        // we can't compute the change in height, so just let it, and the
+        // heights of all the parents, be recomputed when needed
+        InvalidateSubtreeHeight(item);
         return;
     }
 
-  Recurse:
-    wxArrayGenericTreeItems& children = item->GetChildren();
-    size_t n, count = children.GetCount();
-    ++level;
-    for (n = 0; n < count; ++n )
-        CalculateLevel( children[n], dc, level, y );  // recurse
+    item->SetSubtreeHeight(-1);
+    const int heightNew = GetSubtreeHeight(item);
+    item->SetSubtreeHeight(heightOld);
+
+    AdjustSubtreeHeight(item, heightNew - heightOld);
 }
 
-void wxGenericTreeCtrl::CalculatePositions()
+void wxGenericTreeCtrl::UpdateRowHeight(wxGenericTreeItem *item)
 {
-    if ( !m_anchor )
+    // only the items using their own height need to be updated
+    if ( HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+        UpdateSubtreeHeight(item);
+}
+
+void wxGenericTreeCtrl::UpdateLayoutAfterInsert(wxGenericTreeItem *item,
+                                                size_t index)
+{
+    wxGenericTreeItem * const parent = item->GetParent();
+
+    if ( HasFlag(wxTR_HAS_VARIABLE_ROW_HEIGHT) )
+    {
+        // don't measure the new item right now, it will be done later if it
+        // is shown
+        parent->ResetChildrenIndex();
+        if ( ShowsChildren(parent) )
+            InvalidateSubtreeHeight(parent);
         return;
+    }
 
-    wxInfoDC dc(this);
-    PrepareDC( dc );
+    const int height = GetSubtreeHeight(item);
 
-    dc.SetFont( m_normalFont );
+    if ( parent->HasChildrenIndex() )
+    {
+        // appending items, which is by far the most common case, can be done
+        // without rebuilding the index
+        if ( index == parent->GetChildren().GetCount() - 1 )
+            parent->AppendChildHeight(height);
+        else
+            parent->ResetChildrenIndex();
+    }
+
+    if ( ShowsChildren(parent) )
+        AdjustSubtreeHeight(parent, height);
+}
+
+void wxGenericTreeCtrl::InvalidateLayout()
+{
+    if ( m_anchor )
+        m_anchor->RecursiveResetHeights();
+
+    m_itemsWidth = 0;
+
+    m_dirty = true;
+}
+
+int wxGenericTreeCtrl::GetItemX(wxGenericTreeItem *item) const
+{
+    int level = 0;
+    for ( wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          parent = parent->GetParent() )
+    {
+        level++;
+    }
+
+    int indent = FromDIP(m_indent);
+
+    int x = level*indent;
+    if (!HasFlag(wxTR_HIDE_ROOT))
+        x += indent;
+
+    return x + FromDIP(m_spacing);
+}
+
+int wxGenericTreeCtrl::GetItemY(wxGenericTreeItem *item) const
+{
+    int y = MARGIN_ABOVE_ITEMS;
+    for ( wxGenericTreeItem *parent = item->GetParent();
+          parent;
+          parent = parent->GetParent() )
+    {
+        UpdateChildrenIndex(parent);
+
+        y += GetRowHeight(parent) +
+                parent->GetChildrenOffset(item->GetIndexInParent());
+
+        item = parent;
+    }
+
+    return y;
+}
+
+wxGenericTreeItem *wxGenericTreeCtrl::FindItemAtY(int y, int *top) const
+{
+    if ( !m_anchor )
+        return nullptr;
+
+    int offset = y - MARGIN_ABOVE_ITEMS;
+    if ( offset < 0 || offset >= GetSubtreeHeight(m_anchor) )
+        return nullptr;
+
+    // descend into the tree, finding the child containing the offset at each
+    // level, until we find the item whose own row contains it
+    wxGenericTreeItem *item = m_anchor;
+    for ( ;; )
+    {
+        const int height = GetRowHeight(item);
+        if ( offset < height )
+            break;
+
+        offset -= height;
+
+        if ( !ShowsChildren(item) )
+            return nullptr;
+
+        UpdateChildrenIndex(item);
+
+        const size_t n = item->FindChildAtOffset(offset);
+        if ( n == item->GetChildren().GetCount() )
+            return nullptr;
+
+        item = item->GetChildren()[n];
+    }
+
+    if ( top )
+        *top = y - offset;
+
+    return item;
+}
+
+wxGenericTreeItem *wxGenericTreeCtrl::GetNextShown(wxGenericTreeItem *item) const
+{
+    if ( ShowsChildren(item) && item->HasChildren() )
+        return item->GetChildren()[0];
+
+    for ( ;; )
+    {
+        wxGenericTreeItem * const parent = item->GetParent();
+        if ( !parent )
+            return nullptr;
+
+        const size_t n = item->GetIndexInParent() + 1;
+        if ( n < parent->GetChildren().GetCount() )
+            return parent->GetChildren()[n];
 
-    int y = 2;
-    CalculateLevel( m_anchor, dc, 0, y ); // start recursion
+        item = parent;
+    }
+}
+
+wxGenericTreeItem *
+wxGenericTreeCtrl::HitTestItem(const wxPoint& point, int& flags) const
+{
+    int top;
+    wxGenericTreeItem * const item = FindItemAtY(point.y, &top);
+
+    // notice that the points on the item boundary are not inside it
+    if ( !item || point.y == top )
+        return nullptr;
+
+    // we need to know the item width to determine the flags
+    item->CalculateSize(wxConstCast(this, wxGenericTreeCtrl));
+
+    flags |= item->HitTest(point, wxPoint(GetItemX(item), top), this);
+
+    return item;
 }
 
 void wxGenericTreeCtrl::Refresh(bool eraseBackground, const wxRect *rect)
@@ -4053,7 +4512,7 @@ void wxGenericTreeCtrl::RefreshSubtree(wxGenericTreeItem *item)
     wxSize client = GetClientSize();
 
     wxRect rect;
-    CalcScrolledPosition(0, item->GetY(), nullptr, &rect.y);
+    CalcScrolledPosition(0, GetItemY(item), nullptr, &rect.y);
     rect.width = client.x;
     rect.height = client.y;
 
@@ -4068,7 +4527,7 @@ void wxGenericTreeCtrl::RefreshLine( wxGenericTreeItem *item )
         return;
 
     wxRect rect;
-    CalcScrolledPosition(0, item->GetY(), nullptr, &rect.y);
+    CalcScrolledPosition(0, GetItemY(item), nullptr, &rect.y);
     rect.width = GetClientSize().x;
     rect.height = GetLineHeight(item); //dc.GetCharHeight() + 6;
 
@@ -4144,10 +4603,11 @@ void wxGenericTreeCtrl::OnGetToolTip( wxTreeEvent &event )
 {
 #if wxUSE_TOOLTIPS
     wxTreeItemId itemId = event.GetItem();
-    const wxGenericTreeItem* const pItem = (wxGenericTreeItem*)itemId.m_pItem;
+    wxGenericTreeItem* const pItem = (wxGenericTreeItem*)itemId.m_pItem;
+    pItem->CalculateSize(this);
 
     // Check if the item fits into the client area:
-    if ( pItem->GetX() + pItem->GetWidth() > GetClientSize().x )
+    if ( GetItemX(pItem) + pItem->GetWidth() > GetClientSize().x )
     {
         // If it doesn't, show its full text in the tooltip.
         event.SetLabel(pItem->GetText());
@@ -4192,18 +4652,12 @@ void wxGenericTreeCtrl::DoDirtyProcessing()
 
     m_dirty = false;
 
-    CalculatePositions();
     Refresh();
     AdjustMyScrollbars();
 }
 
 wxSize wxGenericTreeCtrl::DoGetBestSize() const
 {
-    // make sure all positions are calculated as normally this only done during
-    // idle time but we need them for base class DoGetBestSize() to return the
-    // correct result
-    wxConstCast(this, wxGenericTreeCtrl)->CalculatePositions();
-
     wxSize size = wxTreeCtrlBase::DoGetBestSize();
 
     // there seems to be an implicit extra border around the items, although
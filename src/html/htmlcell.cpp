@@ -24,8 +24,12 @@
 #include "wx/html/htmlcell.h"
 #include "wx/html/htmlwin.h"
 
+#include <limits.h>
 #include <stdlib.h>
 
+#include <algorithm>
+#include <vector>
+
 //-----------------------------------------------------------------------------
 // Helper classes
 //-----------------------------------------------------------------------------
@@ -658,6 +662,366 @@ wxString wxHtmlWordCell::GetDescription() const
 
 wxIMPLEMENT_ABSTRACT_CLASS(wxHtmlContainerCell, wxHtmlCell);
 
+// Lazy layout support data.
+struct wxHtmlContainerCell::LayoutData
+{
+    // Only used by the container for which lazy layout is enabled.
+    bool lazy = false;
+    LayoutRange viewport = { 0, 0 };
+
+    // Sizes of the container for the last few widths it was laid out at.
+    struct Size
+    {
+        int w, width, height, maxTotalWidth;
+    };
+
+    static const int MAX_SIZES = 4;
+    Size sizes[MAX_SIZES];
+    int numSizes = 0,
+        nextSize = 0;
+
+    // All children before this one, if it's non-null, are laid out exactly.
+    wxHtmlCell *firstPending = nullptr;
+
+    // Statistics of the container contents used for estimating its size
+    // before laying it out.
+    bool hasStats = false;
+    int contentWidth = 0,       // Total width of all terminal cells.
+        maxCellWidth = 0,       // Width of the widest terminal cell.
+        maxLineWidth = 0,       // Width of the longest run of terminal cells.
+        lineHeight = 0,         // Average height of the terminal cells.
+        lines = 0,              // Number of containers with terminal cells.
+        fixedHeight = 0;        // Sum of the vertical indents.
+
+    void Reset()
+    {
+        numSizes =
+        nextSize = 0;
+        firstPending = nullptr;
+        hasStats = false;
+    }
+
+    const Size* FindSize(int w) const
+    {
+        for ( int n = 0; n < numSizes; n++ )
+        {
+            if ( sizes[n].w == w )
+                return &sizes[n];
+        }
+
+        return nullptr;
+    }
+
+    void AddSize(const Size& size)
+    {
+        if ( FindSize(size.w) )
+            return;
+
+        sizes[nextSize] = size;
+        nextSize = (nextSize + 1) % MAX_SIZES;
+        if ( numSizes < MAX_SIZES )
+            numSizes++;
+    }
+
+    void ComputeStats(const wxHtmlContainerCell& cont)
+    {
+        contentWidth =
+        maxCellWidth =
+        maxLineWidth =
+        lines =
+        fixedHeight = 0;
+
+        int totalHeight = 0,
+            numCells = 0;
+        AddStats(cont, totalHeight, numCells);
+
+        lineHeight = numCells ? totalHeight / numCells : 0;
+        hasStats = true;
+    }
+
+private:
+    void AddStats(const wxHtmlContainerCell& cont, int& totalHeight, int& numCells)
+    {
+        // Indents in percents are ignored, this is just an estimate anyhow.
+        if ( cont.m_IndentTop > 0 )
+            fixedHeight += cont.m_IndentTop;
+        if ( cont.m_IndentBottom > 0 )
+            fixedHeight += cont.m_IndentBottom;
+
+        int lineWidth = 0;
+        bool hasCells = false;
+        for ( const wxHtmlCell *cell = cont.m_Cells; cell; cell = cell->GetNext() )
+        {
+            if ( cell->IsTerminalCell() )
+            {
+                const int width = cell->GetWidth();
+                contentWidth += width;
+                lineWidth += width;
+                if ( width > maxCellWidth )
+                    maxCellWidth = width;
+
+                if ( !cell->IsFormattingCell() )
+                {
+                    totalHeight += cell->GetHeight();
+                    numCells++;
+                    hasCells = true;
+                }
+            }
+            else // Nested container starts a new line.
+            {
+                if ( lineWidth > maxLineWidth )
+                    maxLineWidth = lineWidth;
+                lineWidth = 0;
+
+                AddStats(*static_cast<const wxHtmlContainerCell*>(cell),
+                         totalHeight, numCells);
+            }
+        }
+
+        if ( lineWidth > maxLineWidth )
+            maxLineWidth = lineWidth;
+
+        if ( hasCells )
+            lines++;
+    }
+};
+
+namespace
+{
+
+// Return the cell as container if it can be laid out lazily, i.e. if it's a
+// plain container and not a table or another kind of container with its own
+// layout logic, or null otherwise.
+wxHtmlContainerCell* AsLazyContainer(wxHtmlCell* cell)
+{
+    if ( cell->IsTerminalCell() )
+        return nullptr;
+
+    wxHtmlContainerCell* const cont = static_cast<wxHtmlContainerCell*>(cell);
+    return cont->CanLayoutChildrenLazily() ? cont : nullptr;
+}
+
+} // anonymous namespace
+
+// Index of the children of a container allowing to find the ones intersecting
+// the given vertical range without iterating over all of them.
+//
+// Children are usually, but not always, ordered by their vertical positions
+// and may overlap, so instead of their positions we store the maximal bottom
+// coordinate of all the children up to the given one and the minimal top
+// coordinate of all the children starting from it, which are both monotonic
+// and allow using binary search.
+struct wxHtmlContainerCell::ChildrenIndex
+{
+    // Containers with fewer children don't use the index.
+    static const size_t MIN_CHILDREN = 32;
+
+    // Children of the selection endpoints, if any, see FindSelectionCells().
+    struct SelectionCells
+    {
+        size_t indices[2];
+        size_t count = 0;
+    };
+
+    explicit ChildrenIndex(const wxHtmlContainerCell& cont)
+    {
+        for ( wxHtmlCell *cell = cont.m_Cells; cell; cell = cell->GetNext() )
+        {
+            const int bottom = cell->GetPosY() + cell->GetHeight();
+            maxBottom.push_back(cells.empty() ? bottom
+                                              : wxMax(maxBottom.back(), bottom));
+
+            if ( cell->NeedsDrawInvisible() )
+                stateCells.push_back(cells.size());
+
+            cells.push_back(cell);
+        }
+
+        minTop.resize(cells.size());
+        for ( size_t n = cells.size(); n > 0; n-- )
+        {
+            const int top = cells[n - 1]->GetPosY();
+            minTop[n - 1] = n == cells.size() ? top : wxMin(minTop[n], top);
+        }
+    }
+
+    // Return the index of the first child which may extend below y.
+    size_t FindFirst(int y) const
+    {
+        return std::upper_bound(maxBottom.begin(), maxBottom.end(), y)
+                - maxBottom.begin();
+    }
+
+    // Return the index after the last child which may start at or above y.
+    size_t FindEnd(int y) const
+    {
+        return std::upper_bound(minTop.begin(), minTop.end(), y)
+                - minTop.begin();
+    }
+
+    // Return the index of the given child or cells.size() if not found.
+    size_t FindCell(const wxHtmlCell *cell) const
+    {
+        const int top = cell->GetPosY();
+        const size_t end = FindEnd(top);
+        for ( size_t n = FindFirst(top - 1); n < end; n++ )
+        {
+            if ( cells[n] == cell )
+                return n;
+        }
+
+        // Not found where it should be, fall back to linear search.
+        return std::find(cells.begin(), cells.end(), cell) - cells.begin();
+    }
+
+    // Find the children which are or contain the selection endpoints: their
+    // DrawInvisible() must be called even if they don't change the rendering
+    // state themselves, as they update the selection state.
+    SelectionCells
+    FindSelectionCells(const wxHtmlContainerCell& cont,
+                       const wxHtmlSelection *sel) const
+    {
+        SelectionCells selCells;
+        if ( !sel )
+            return selCells;
+
+        const wxHtmlCell* const endpoints[] = { sel->GetFromCell(),
+                                                sel->GetToCell() };
+        for ( const wxHtmlCell *cell : endpoints )
+        {
+            while ( cell && cell->GetParent() != &cont )
+                cell = cell->GetParent();
+
+            if ( !cell )
+                continue;
+
+            const size_t n = FindCell(cell);
+            if ( n == cells.size() )
+                continue;
+
+            if ( selCells.count == 1 && selCells.indices[0] >= n )
+            {
+                if ( selCells.indices[0] == n )
+                    continue;
+
+                selCells.indices[1] = selCells.indices[0];
+                selCells.indices[0] = n;
+            }
+            else
+            {
+                selCells.indices[selCells.count] = n;
+            }
+
+            selCells.count++;
+        }
+
+        return selCells;
+    }
+
+    // Call the given function, in order, for all the children in [from, to)
+    // range which are either state cells or selection cells.
+    template <typename F>
+    void ForEachStateCell(size_t from, size_t to,
+                          const SelectionCells& selCells,
+                          F func) const
+    {
+        auto it = std::lower_bound(stateCells.begin(), stateCells.end(), from);
+        size_t sel = 0;
+        while ( sel < selCells.count && selCells.indices[sel] < from )
+            sel++;
+
+        for ( ;; )
+        {
+            size_t n = to;
+            if ( it != stateCells.end() && *it < n )
+                n = *it;
+            if ( sel < selCells.count && selCells.indices[sel] < n )
+                n = selCells.indices[sel];
+
+            if ( n == to )
+                break;
+
+            func(cells[n]);
+
+            if ( it != stateCells.end() && *it == n )
+                ++it;
+            if ( sel < selCells.count && selCells.indices[sel] == n )
+                sel++;
+        }
+    }
+
+    std::vector<wxHtmlCell*> cells;
+    std::vector<int> maxBottom,
+                     minTop;
+
+    // Indices of the children which DrawInvisible() may have an effect.
+    std::vector<size_t> stateCells;
+};
+
+const wxHtmlContainerCell::ChildrenIndex*
+wxHtmlContainerCell::GetChildrenIndex() const
+{
+    if ( !m_childrenIndex )
+    {
+        // Only plain containers position their children in PlaceChildren(),
+        // which invalidates the index, so we can't use it for the others.
+        if ( !CanLayoutChildrenLazily() )
+            return nullptr;
+
+        size_t count = 0;
+        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        {
+            if ( ++count == ChildrenIndex::MIN_CHILDREN )
+                break;
+        }
+
+        if ( count < ChildrenIndex::MIN_CHILDREN )
+            return nullptr;
+
+        m_childrenIndex = new ChildrenIndex(*this);
+    }
+
+    return m_childrenIndex;
+}
+
+void wxHtmlContainerCell::InvalidateChildrenIndex()
+{
+    wxDELETE(m_childrenIndex);
+}
+
+void wxHtmlContainerCell::OnChildrenChanged()
+{
+    m_LastLayout = -1;
+    if ( m_layoutData )
+        m_layoutData->Reset();
+
+    // Whether DrawInvisible() needs to be called for the parent containers
+    // depends on their children, so reset it for all of them.
+    for ( wxHtmlContainerCell *cont = this; cont; cont = cont->GetParent() )
+    {
+        cont->m_needsDrawInvisible = -1;
+        cont->InvalidateChildrenIndex();
+    }
+}
+
+bool wxHtmlContainerCell::NeedsDrawInvisible() const
+{
+    if ( m_needsDrawInvisible == -1 )
+    {
+        m_needsDrawInvisible = 0;
+        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        {
+            if ( cell->NeedsDrawInvisible() )
+            {
+                m_needsDrawInvisible = 1;
+                break;
+            }
+        }
+    }
+
+    return m_needsDrawInvisible == 1;
+}
+
 void wxHtmlContainerCell::InitParent(wxHtmlContainerCell *parent)
 {
     m_Parent = parent;
@@ -678,6 +1042,9 @@ wxHtmlContainerCell::wxHtmlContainerCell(const wxHtmlTag& tag,
 
 wxHtmlContainerCell::~wxHtmlContainerCell()
 {
+    delete m_layoutData;
+    delete m_childrenIndex;
+
     wxHtmlCell *cell = m_Cells;
     while ( cell )
     {
@@ -734,25 +1101,217 @@ wxHtmlContainerCell::AdjustPagebreak(int *pagebreak, int pageHeight) const
     bool rt = false;
     int pbrk = *pagebreak - m_PosY;
 
-    for ( wxHtmlCell *c = GetFirstChild(); c; c = c->GetNext() )
+    // only the children intersecting the current page may need to adjust the
+    // page break, so don't check all the others, as this function is called
+    // for every page and there can be a lot of them
+    const auto adjust = [&](const wxHtmlCell *c)
     {
+        const int top = c->GetPosY();
+        if ( top > pbrk || top + c->GetHeight() <= pbrk - pageHeight )
+            return;
+
         if (c->AdjustPagebreak(&pbrk, pageHeight))
             rt = true;
+    };
+
+    if ( const ChildrenIndex* const index = GetChildrenIndex() )
+    {
+        // the page break can only move up, so the children after the range
+        // intersecting the initial page can't intersect it later either,
+        // while the ones before it wouldn't be checked after it moves anyhow
+        const size_t end = index->FindEnd(pbrk);
+        for ( size_t n = index->FindFirst(pbrk - pageHeight); n < end; n++ )
+            adjust(index->cells[n]);
     }
+    else
+    {
+        for ( wxHtmlCell *c = GetFirstChild(); c; c = c->GetNext() )
+            adjust(c);
+    }
+
     if (rt)
         *pagebreak = pbrk + m_PosY;
     return rt;
 }
 
 
-void wxHtmlContainerCell::Layout(int w)
+wxHtmlContainerCell::LayoutData& wxHtmlContainerCell::GetLayoutData()
 {
-    wxHtmlCell::Layout(w);
+    if ( !m_layoutData )
+        m_layoutData = new LayoutData;
 
-    if (m_LastLayout == w)
+    return *m_layoutData;
+}
+
+void wxHtmlContainerCell::EnableLazyLayout(bool enable)
+{
+    if ( enable == IsLazyLayoutEnabled() )
         return;
-    m_LastLayout = w;
 
+    GetLayoutData().lazy = enable;
+    m_LastLayout = -1;
+}
+
+bool wxHtmlContainerCell::IsLazyLayoutEnabled() const
+{
+    return m_layoutData && m_layoutData->lazy;
+}
+
+bool wxHtmlContainerCell::SetLayoutViewport(int top, int bottom)
+{
+    wxCHECK_MSG( IsLazyLayoutEnabled(), false, "lazy layout must be enabled" );
+
+    m_layoutData->viewport.top = top;
+    m_layoutData->viewport.bottom = bottom;
+
+    if ( !HasPendingLayout() )
+        return false;
+
+    return Relayout(&m_layoutData->viewport);
+}
+
+bool wxHtmlContainerCell::HasPendingLayout() const
+{
+    return m_LastLayout != -1 && m_layoutState != Layout_Exact;
+}
+
+bool wxHtmlContainerCell::LayoutPending(int maxCells)
+{
+    if ( !HasPendingLayout() )
+        return false;
+
+    const int width = m_Width,
+              height = m_Height;
+
+    DoLayoutPending(maxCells);
+
+    return m_Width != width || m_Height != height;
+}
+
+void wxHtmlContainerCell::DoLayoutPending(int& maxCells)
+{
+    const int childrenWidth = GetChildrenWidth(m_LastLayout);
+    // This range doesn't intersect any cell.
+    const LayoutRange rangeNone = { INT_MAX, INT_MIN };
+
+    LayoutData& data = GetLayoutData();
+    wxHtmlCell *cell = data.firstPending ? data.firstPending : m_Cells;
+    wxHtmlCell *firstPending = nullptr;
+
+    bool changed = false;
+    for ( ; cell && maxCells > 0; cell = cell->GetNext() )
+    {
+        wxHtmlContainerCell* const cont = AsLazyContainer(cell);
+        if ( !cont || cont->m_layoutState == Layout_Exact )
+            continue;
+
+        const int x = cont->GetPosX(),
+                  y = cont->GetPosY(),
+                  width = cont->GetWidth(),
+                  height = cont->GetHeight();
+
+        if ( cont->m_layoutState == Layout_Estimated )
+        {
+            // Don't lay out the nested containers at once, they will be laid
+            // out during the next calls if necessary.
+            cont->DoLayout(childrenWidth, &rangeNone);
+            maxCells--;
+        }
+        else
+        {
+            cont->DoLayoutPending(maxCells);
+        }
+
+        cont->SetPos(x, y);
+
+        if ( cont->GetWidth() != width || cont->GetHeight() != height )
+            changed = true;
+
+        if ( !firstPending && cont->m_layoutState != Layout_Exact )
+            firstPending = cell;
+    }
+
+    data.firstPending = firstPending ? firstPending : cell;
+
+    if ( changed )
+        PlaceChildren(m_LastLayout);
+
+    UpdateLayoutState();
+}
+
+bool wxHtmlContainerCell::EnsureLaidOut(const wxHtmlCell *cell)
+{
+    wxCHECK_MSG( cell, false, "null cell" );
+
+    const int width = m_Width,
+              height = m_Height;
+
+    const wxHtmlContainerCell *estimatedLast = nullptr;
+    while ( HasPendingLayout() )
+    {
+        // Find the outermost ancestor of the cell which hasn't been laid out
+        // yet: its own position is exact, as its parent was laid out.
+        const wxHtmlContainerCell *estimated = nullptr;
+        for ( const wxHtmlContainerCell *parent = cell->GetParent();
+              parent && parent != this;
+              parent = parent->GetParent() )
+        {
+            if ( parent->m_layoutState == Layout_Estimated )
+                estimated = parent;
+        }
+
+        // Also stop if we failed to lay it out, e.g. because it's empty.
+        if ( !estimated || estimated == estimatedLast )
+            break;
+        estimatedLast = estimated;
+
+        const int y = estimated->GetAbsPos(this).y;
+        const LayoutRange range = { y, y };
+        Relayout(&range);
+    }
+
+    return m_Width != width || m_Height != height;
+}
+
+bool wxHtmlContainerCell::Relayout(const LayoutRange *range)
+{
+    const int x = m_PosX,
+              y = m_PosY,
+              width = m_Width,
+              height = m_Height;
+
+    DoLayout(m_LastLayout, range);
+
+    SetPos(x, y);
+
+    return m_Width != width || m_Height != height;
+}
+
+void wxHtmlContainerCell::UpdateLayoutState()
+{
+    m_layoutState = Layout_Exact;
+
+    wxHtmlCell *cell = m_layoutData && m_layoutData->firstPending
+                            ? m_layoutData->firstPending
+                            : m_Cells;
+    for ( ; cell; cell = cell->GetNext() )
+    {
+        const wxHtmlContainerCell* const cont = AsLazyContainer(cell);
+        if ( cont && cont->m_layoutState != Layout_Exact )
+        {
+            m_layoutState = Layout_Partial;
+            return;
+        }
+    }
+
+    // Remember the size of the container to avoid having to estimate it when
+    // it's laid out with the same width again.
+    if ( m_layoutData )
+        m_layoutData->AddSize({m_LastLayout, m_Width, m_Height, m_MaxTotalWidth});
+}
+
+int wxHtmlContainerCell::GetAdjustedWidth(int w) const
+{
     // VS: Any attempt to layout with negative or zero width leads to hell,
     // but we can't ignore such attempts completely, since it sometimes
     // happen (e.g. when trying how small a table can be), so use at least one
@@ -760,46 +1319,166 @@ void wxHtmlContainerCell::Layout(int w)
     if (w < 1)
         w = 1;
 
-    wxHtmlCell *nextCell;
-    long xpos = 0, ypos = m_IndentTop;
-    int xdelta = 0, ybasicpos = 0;
-    int s_width, s_indent;
-    int ysizeup = 0, ysizedown = 0;
-    int MaxLineWidth = 0;
-    int curLineWidth = 0;
-    m_MaxTotalWidth = 0;
+    if (m_WidthFloatUnits == wxHTML_UNITS_PERCENT)
+    {
+        if (m_WidthFloat < 0) return (100 + m_WidthFloat) * w / 100;
+        else return m_WidthFloat * w / 100;
+    }
+    else
+    {
+        if (m_WidthFloat < 0) return w + m_WidthFloat;
+        else return m_WidthFloat;
+    }
+}
 
+int wxHtmlContainerCell::GetChildrenWidth(int w) const
+{
+    const int width = GetAdjustedWidth(w);
+    int l = (m_IndentLeft < 0) ? (-m_IndentLeft * width / 100) : m_IndentLeft;
+    int r = (m_IndentRight < 0) ? (-m_IndentRight * width / 100) : m_IndentRight;
+    return width - (l + r);
+}
 
-    /*
+void wxHtmlContainerCell::EstimateLayout(int w)
+{
+    wxHtmlCell::Layout(w);
 
-    WIDTH ADJUSTING :
+    // Nothing to do if we already know our size for this width.
+    if (m_LastLayout == w)
+        return;
+    m_LastLayout = w;
+    m_layoutState = Layout_Estimated;
 
-    */
+    LayoutData& data = GetLayoutData();
+    if ( const LayoutData::Size* const size = data.FindSize(w) )
+    {
+        m_Width = size->width;
+        m_Height = size->height;
+        m_MaxTotalWidth = size->maxTotalWidth;
+        return;
+    }
 
-    if (m_WidthFloatUnits == wxHTML_UNITS_PERCENT)
+    if ( !data.hasStats )
+        data.ComputeStats(*this);
+
+    // Assume that all terminal cells have the same height and use as many
+    // lines as needed to fit them, but at least one line per paragraph.
+    m_Width = GetAdjustedWidth(w);
+
+    const int childrenWidth = wxMax(GetChildrenWidth(w), 1);
+    const int indents = m_Width - childrenWidth;
+
+    int lines = (data.contentWidth + childrenWidth - 1) / childrenWidth;
+    if ( lines < data.lines )
+        lines = data.lines;
+
+    m_Height = data.fixedHeight + lines * data.lineHeight;
+    if ( m_Height < m_MinHeight )
+        m_Height = m_MinHeight;
+
+    m_MaxTotalWidth = data.maxLineWidth + indents;
+    if ( m_Width < data.maxCellWidth + indents )
+        m_Width = data.maxCellWidth + indents;
+}
+
+void wxHtmlContainerCell::Layout(int w)
+{
+    DoLayout(w, IsLazyLayoutEnabled() ? &m_layoutData->viewport : nullptr);
+}
+
+void wxHtmlContainerCell::DoLayout(int w, const LayoutRange *range)
+{
+    wxHtmlCell::Layout(w);
+
+    if (m_LastLayout == w && m_layoutState == Layout_Exact)
+        return;
+
+    // If the children are already positioned for this width, we only need to
+    // lay out the ones intersecting the range and not laid out yet.
+    if (m_LastLayout != w || m_layoutState == Layout_Estimated || !range)
     {
-        if (m_WidthFloat < 0) m_Width = (100 + m_WidthFloat) * w / 100;
-        else m_Width = m_WidthFloat * w / 100;
+        m_LastLayout = w;
+        if ( m_layoutData )
+            m_layoutData->firstPending = nullptr;
+
+        if (m_Cells)
+        {
+            const int childrenWidth = GetChildrenWidth(w);
+            for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
+            {
+                wxHtmlContainerCell* const cont = range ? AsLazyContainer(cell)
+                                                        : nullptr;
+                if (cont)
+                    cont->EstimateLayout(childrenWidth);
+                else
+                    cell->Layout(childrenWidth);
+            }
+        }
+
+        PlaceChildren(w);
+    }
+
+    if (range)
+    {
+        // Laying out the children may move the other ones in or out of the
+        // range, so continue until we stabilize.
+        while (LayoutChildrenInRange(*range))
+            PlaceChildren(w);
+
+        UpdateLayoutState();
     }
     else
     {
-        if (m_WidthFloat < 0) m_Width = w + m_WidthFloat;
-        else m_Width = m_WidthFloat;
+        m_layoutState = Layout_Exact;
+        if ( m_layoutData )
+            m_layoutData->AddSize({w, m_Width, m_Height, m_MaxTotalWidth});
     }
+}
 
-    if (m_Cells)
+bool wxHtmlContainerCell::LayoutChildrenInRange(const LayoutRange& range)
+{
+    const int childrenWidth = GetChildrenWidth(m_LastLayout);
+
+    bool changed = false;
+    for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
     {
-        int l = (m_IndentLeft < 0) ? (-m_IndentLeft * m_Width / 100) : m_IndentLeft;
-        int r = (m_IndentRight < 0) ? (-m_IndentRight * m_Width / 100) : m_IndentRight;
-        for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
-            cell->Layout(m_Width - (l + r));
+        wxHtmlContainerCell* const cont = AsLazyContainer(cell);
+        if ( !cont || cont->m_layoutState == Layout_Exact )
+            continue;
+
+        const int x = cont->GetPosX(),
+                  y = cont->GetPosY(),
+                  width = cont->GetWidth(),
+                  height = cont->GetHeight();
+
+        if ( y > range.bottom || y + height <= range.top )
+            continue;
+
+        const LayoutRange rangeChild = { range.top - y, range.bottom - y };
+        cont->DoLayout(childrenWidth, &rangeChild);
+        cont->SetPos(x, y);
+
+        if ( cont->GetWidth() != width || cont->GetHeight() != height )
+            changed = true;
     }
 
-    /*
+    return changed;
+}
+
+void wxHtmlContainerCell::PlaceChildren(int w)
+{
+    wxHtmlCell *nextCell;
+    long xpos = 0, ypos = m_IndentTop;
+    int xdelta = 0, ybasicpos = 0;
+    int s_width, s_indent;
+    int ysizeup = 0, ysizedown = 0;
+    int MaxLineWidth = 0;
+    int curLineWidth = 0;
+    m_MaxTotalWidth = 0;
 
-    LAYOUT :
+    InvalidateChildrenIndex();
 
-    */
+    m_Width = GetAdjustedWidth(w);
 
     // adjust indentation:
     s_indent = (m_IndentLeft < 0) ? (-m_IndentLeft * m_Width / 100) : m_IndentLeft;
@@ -1116,30 +1795,59 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
         dc.DrawLines(2, &poly[1], x, y - 1); // between 1 and 2
         dc.DrawLines(2, &poly[4], x, y - 1); // between 4 and 5
     }
-    if (m_Cells)
+    // draw the given child if it's visible or just update the rendering
+    // state if it's not:
+    const auto drawCell = [&](wxHtmlCell *cell)
     {
-        // draw container's contents:
-        for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
+        // optimize drawing: don't render off-screen content nor the
+        // containers which haven't been laid out yet:
+        const wxHtmlContainerCell* const cont = AsLazyContainer(cell);
+        if ((ylocal + cell->GetPosY() <= view_y2) &&
+            (ylocal + cell->GetPosY() + cell->GetHeight() > view_y1) &&
+            !(cont && cont->m_layoutState == Layout_Estimated))
         {
-
-            // optimize drawing: don't render off-screen content:
-            if ((ylocal + cell->GetPosY() <= view_y2) &&
-                (ylocal + cell->GetPosY() + cell->GetHeight() > view_y1))
-            {
-                // the cell is visible, draw it:
-                UpdateRenderingStatePre(info, cell);
-                cell->Draw(dc,
-                           xlocal, ylocal, view_y1, view_y2,
-                           info);
-                UpdateRenderingStatePost(info, cell);
-            }
-            else
-            {
-                // the cell is off-screen, proceed with font+color+etc.
-                // changes only:
-                cell->DrawInvisible(dc, xlocal, ylocal, info);
-            }
+            // the cell is visible, draw it:
+            UpdateRenderingStatePre(info, cell);
+            cell->Draw(dc,
+                       xlocal, ylocal, view_y1, view_y2,
+                       info);
+            UpdateRenderingStatePost(info, cell);
         }
+        else
+        {
+            // the cell is off-screen, proceed with font+color+etc.
+            // changes only:
+            cell->DrawInvisible(dc, xlocal, ylocal, info);
+        }
+    };
+
+    if ( const ChildrenIndex* const index = GetChildrenIndex() )
+    {
+        // only the children in [first, end) range may be visible, for all
+        // the others we only need to call DrawInvisible() if it does
+        // anything, which is the case for only a few of them
+        const size_t first = index->FindFirst(view_y1 - ylocal);
+        const size_t end = wxMax(first, index->FindEnd(view_y2 - ylocal));
+
+        const ChildrenIndex::SelectionCells
+            selCells = index->FindSelectionCells(*this, info.GetSelection());
+        const auto drawInvisible = [&](wxHtmlCell *cell)
+        {
+            cell->DrawInvisible(dc, xlocal, ylocal, info);
+        };
+
+        index->ForEachStateCell(0, first, selCells, drawInvisible);
+
+        for ( size_t n = first; n < end; n++ )
+            drawCell(index->cells[n]);
+
+        index->ForEachStateCell(end, index->cells.size(), selCells, drawInvisible);
+    }
+    else
+    {
+        // draw container's contents:
+        for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
+            drawCell(cell);
     }
 }
 
@@ -1148,14 +1856,24 @@ void wxHtmlContainerCell::Draw(wxDC& dc, int x, int y, int view_y1, int view_y2,
 void wxHtmlContainerCell::DrawInvisible(wxDC& dc, int x, int y,
                                         wxHtmlRenderingInfo& info)
 {
-    if (m_Cells)
+    const auto drawInvisible = [&](wxHtmlCell *cell)
+    {
+        UpdateRenderingStatePre(info, cell);
+        cell->DrawInvisible(dc, x + m_PosX, y + m_PosY, info);
+        UpdateRenderingStatePost(info, cell);
+    };
+
+    if ( const ChildrenIndex* const index = GetChildrenIndex() )
+    {
+        // skip the children for which nothing would be done anyhow
+        index->ForEachStateCell(0, index->cells.size(),
+                                index->FindSelectionCells(*this, info.GetSelection()),
+                                drawInvisible);
+    }
+    else
     {
         for (wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext())
-        {
-            UpdateRenderingStatePre(info, cell);
-            cell->DrawInvisible(dc, x + m_PosX, y + m_PosY, info);
-            UpdateRenderingStatePost(info, cell);
-        }
+            drawInvisible(cell);
     }
 }
 
@@ -1189,7 +1907,7 @@ void wxHtmlContainerCell::InsertCell(wxHtmlCell *f)
         if (m_LastCell) while (m_LastCell->GetNext()) m_LastCell = m_LastCell->GetNext();
     }
     f->SetParent(this);
-    m_LastLayout = -1;
+    OnChildrenChanged();
 }
 
 
@@ -1227,6 +1945,8 @@ void wxHtmlContainerCell::Detach(wxHtmlCell *cell)
 
     cell->SetParent(nullptr);
     cell->SetNext(nullptr);
+
+    OnChildrenChanged();
 }
 
 
@@ -1291,9 +2011,13 @@ const wxHtmlCell* wxHtmlContainerCell::Find(int condition, const void* param) co
 wxHtmlCell *wxHtmlContainerCell::FindCellByPos(wxCoord x, wxCoord y,
                                                unsigned flags) const
 {
+    // if we have the index, only check the children which may contain or
+    // follow the given position, as all the previous ones end above it
+    const ChildrenIndex* const index = GetChildrenIndex();
+
     if ( flags & wxHTML_FIND_EXACT )
     {
-        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        const auto findExact = [=](const wxHtmlCell *cell) -> const wxHtmlCell*
         {
             int cx = cell->GetPosX(),
                 cy = cell->GetPosY();
@@ -1301,42 +2025,112 @@ wxHtmlCell *wxHtmlContainerCell::FindCellByPos(wxCoord x, wxCoord y,
             if ( (cx <= x) && (cx + cell->GetWidth() > x) &&
                  (cy <= y) && (cy + cell->GetHeight() > y) )
             {
-                return cell->FindCellByPos(x - cx, y - cy, flags);
+                return cell;
             }
+
+            return nullptr;
+        };
+
+        const wxHtmlCell *found = nullptr;
+        if ( index )
+        {
+            const size_t end = index->FindEnd(y);
+            for ( size_t n = index->FindFirst(y); n < end && !found; n++ )
+                found = findExact(index->cells[n]);
+        }
+        else
+        {
+            for ( const wxHtmlCell *cell = m_Cells; cell && !found; cell = cell->GetNext() )
+                found = findExact(cell);
+        }
+
+        if ( found )
+        {
+            return found->FindCellByPos(x - found->GetPosX(),
+                                        y - found->GetPosY(), flags);
         }
     }
     else if ( flags & wxHTML_FIND_NEAREST_AFTER )
     {
-        wxHtmlCell *c;
-        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        const auto findAfter = [=](const wxHtmlCell *cell) -> wxHtmlCell*
         {
             if ( cell->IsFormattingCell() )
-                continue;
+                return nullptr;
             int cellY = cell->GetPosY();
             if (!( y < cellY || (y < cellY + cell->GetHeight() &&
                                  x < cell->GetPosX() + cell->GetWidth()) ))
-                continue;
+                return nullptr;
 
-            c = cell->FindCellByPos(x - cell->GetPosX(), y - cellY, flags);
-            if (c) return c;
+            return cell->FindCellByPos(x - cell->GetPosX(), y - cellY, flags);
+        };
+
+        wxHtmlCell *c;
+        if ( index )
+        {
+            for ( size_t n = index->FindFirst(y); n < index->cells.size(); n++ )
+            {
+                c = findAfter(index->cells[n]);
+                if (c) return c;
+            }
+        }
+        else
+        {
+            for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+            {
+                c = findAfter(cell);
+                if (c) return c;
+            }
         }
     }
     else if ( flags & wxHTML_FIND_NEAREST_BEFORE )
     {
-        wxHtmlCell *c2, *c = nullptr;
-        for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+        const auto isBefore = [=](const wxHtmlCell *cell)
         {
-            if ( cell->IsFormattingCell() )
-                continue;
             int cellY = cell->GetPosY();
-            if (!( cellY + cell->GetHeight() <= y ||
-                   (y >= cellY && x >= cell->GetPosX()) ))
-                break;
-            c2 = cell->FindCellByPos(x - cell->GetPosX(), y - cellY, flags);
-            if (c2)
-                c = c2;
+            return cellY + cell->GetHeight() <= y ||
+                    (y >= cellY && x >= cell->GetPosX());
+        };
+
+        if ( index )
+        {
+            // find the first child which is not before the position, all
+            // the children before FindFirst(y) are, and then return the
+            // result for the last child before it which has any
+            size_t end = index->FindFirst(y);
+            for ( ; end < index->cells.size(); end++ )
+            {
+                const wxHtmlCell* const cell = index->cells[end];
+                if ( !cell->IsFormattingCell() && !isBefore(cell) )
+                    break;
+            }
+
+            for ( size_t n = end; n > 0; n-- )
+            {
+                const wxHtmlCell* const cell = index->cells[n - 1];
+                if ( cell->IsFormattingCell() )
+                    continue;
+
+                wxHtmlCell* const c = cell->FindCellByPos(x - cell->GetPosX(),
+                                                          y - cell->GetPosY(),
+                                                          flags);
+                if (c) return c;
+            }
+        }
+        else
+        {
+            wxHtmlCell *c2, *c = nullptr;
+            for ( const wxHtmlCell *cell = m_Cells; cell; cell = cell->GetNext() )
+            {
+                if ( cell->IsFormattingCell() )
+                    continue;
+                if ( !isBefore(cell) )
+                    break;
+                c2 = cell->FindCellByPos(x - cell->GetPosX(), y - cell->GetPosY(), flags);
+                if (c2)
+                    c = c2;
+            }
+            if (c) return c;
         }
-        if (c) return c;
     }
 
     return nullptr;
@@ -41,9 +41,14 @@ class wxHtmlTextPiece
 public:
     wxHtmlTextPiece() {}
     wxHtmlTextPiece(const wxString::const_iterator& start,
-                    const wxString::const_iterator& end)
-        : m_start(start), m_end(end) {}
+                    const wxString::const_iterator& end,
+                    bool hasEntities)
+        : m_start(start), m_end(end), m_hasEntities(hasEntities) {}
     wxString::const_iterator m_start, m_end;
+
+    // False if the text doesn't contain any '&' and so doesn't need to be
+    // processed by wxHtmlEntitiesParser.
+    bool m_hasEntities = true;
 };
 
 // NB: this is an empty class and not typedef because of forward declaration
@@ -148,6 +153,10 @@ void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
     wxString::const_iterator i = begin_pos;
     wxString::const_iterator textBeginning = begin_pos;
 
+    // Check for the entities while looking for the tags to avoid having to
+    // look for them in every text piece later.
+    bool textHasEntities = false;
+
     // If the tag contains CDATA text, we include the text between beginning
     // and ending tag verbosely. Setting i=end_pos will skip to the very
     // end of this function where text piece is added, bypassing any child
@@ -155,6 +164,9 @@ void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
     if (cur != nullptr && wxIsCDATAElement(cur->GetName()))
     {
         i = end_pos;
+
+        // We don't check CDATA text for entities, so always process it.
+        textHasEntities = true;
     }
 
     while (i < end_pos)
@@ -166,7 +178,12 @@ void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
         {
             // add text to m_TextPieces:
             if (i > textBeginning)
-                m_TextPieces->push_back(wxHtmlTextPiece(textBeginning, i));
+            {
+                m_TextPieces->push_back(wxHtmlTextPiece(textBeginning, i,
+                                                        textHasEntities));
+            }
+
+            textHasEntities = false;
 
             // if it is a comment, skip it:
             if ( SkipCommentTag(i, m_Source->end()) )
@@ -220,12 +237,20 @@ void wxHtmlParser::CreateDOMSubTree(wxHtmlTag *cur,
                 textBeginning = i < end_pos ? i+1 : i;
             }
         }
-        else ++i;
+        else
+        {
+            if (c == wxT('&'))
+                textHasEntities = true;
+            ++i;
+        }
     }
 
     // add remaining text to m_TextPieces:
     if (end_pos > textBeginning)
-        m_TextPieces->push_back(wxHtmlTextPiece(textBeginning, end_pos));
+    {
+        m_TextPieces->push_back(wxHtmlTextPiece(textBeginning, end_pos,
+                                                textHasEntities));
+    }
 }
 
 void wxHtmlParser::DestroyDOMTree()
@@ -274,10 +299,13 @@ void wxHtmlParser::DoParsing(const wxString::const_iterator& begin_pos_,
              pieces[m_CurTextPiece].m_start < m_CurTag->GetBeginIter()))
         {
             // Add text:
-            AddText(GetEntitiesParser()->Parse(
-                       wxString(pieces[m_CurTextPiece].m_start,
-                                pieces[m_CurTextPiece].m_end)));
-            begin_pos = pieces[m_CurTextPiece].m_end;
+            const wxHtmlTextPiece& piece = pieces[m_CurTextPiece];
+            const wxString text(piece.m_start, piece.m_end);
+            if (piece.m_hasEntities)
+                AddText(GetEntitiesParser()->Parse(text));
+            else
+                AddText(text);
+            begin_pos = piece.m_end;
             m_CurTextPiece++;
         }
         else if (m_CurTag)
@@ -21,11 +21,238 @@
 #include "wx/html/htmlpars.h"
 #include "wx/html/styleparams.h"
 
+#include "wx/hashmap.h"
 #include "wx/vector.h"
 
 #include <stdio.h> // for vsscanf
 #include <stdarg.h>
 
+#include <unordered_map>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// wxHtmlTagParam
+//-----------------------------------------------------------------------------
+
+bool wxHtmlTagParam::IsNamed(const wxString& name) const
+{
+    if ( m_flags & Value_Owned )
+        return m_name.IsSameAs(name, false);
+
+    // Compare the name in place to avoid creating a string just for this.
+    wxString::const_iterator i = m_nameBegin;
+    for ( wxString::const_iterator j = name.begin(); j != name.end(); ++i, ++j )
+    {
+        if ( i == m_nameEnd || wxTolower(*i) != wxTolower(*j) )
+            return false;
+    }
+
+    return i == m_nameEnd;
+}
+
+wxString wxHtmlTagParam::GetName() const
+{
+    if ( m_flags & Value_Owned )
+        return m_name;
+
+    return wxString(m_nameBegin, m_nameEnd);
+}
+
+wxString wxHtmlTagParam::GetValue(const wxHtmlEntitiesParser *entParser) const
+{
+    if ( m_flags & Value_Owned )
+        return m_value;
+
+    wxString value(m_valueBegin, m_valueEnd);
+
+    if ( m_flags & Value_Upper )
+    {
+        // VS: backward compatibility, no real reason,
+        //     but wxHTML code relies on this... :(
+        value.MakeUpper();
+    }
+
+    if ( (m_flags & Value_HasEntities) && entParser )
+        value = entParser->Parse(value);
+
+    return value;
+}
+
+namespace
+{
+
+inline bool IsHtmlWhite(wxChar c)
+{
+    return c == wxT(' ') || c == wxT('\r') || c == wxT('\n') || c == wxT('\t');
+}
+
+// Parses the tag starting at pos, which must point to '<', and ending at or
+// before end: fills in its name, in upper case, and its parameters and returns
+// the position just after the tag.
+//
+// If firstGt is non-null, it's set to the position of the first '>' after
+// pos, even if it's inside a quoted value, or to end if there is none.
+wxString::const_iterator
+ParseStartTag(const wxString::const_iterator& pos,
+              const wxString::const_iterator& end,
+              wxString& name,
+              wxHtmlTagParams& params,
+              wxString::const_iterator *firstGt)
+{
+    if ( firstGt )
+        *firstGt = end;
+
+    wxChar c wxDUMMY_INITIALIZE(0);
+
+    wxString::const_iterator i(pos+1);
+
+    // find tag's name and convert it to uppercase:
+    while ((i < end) &&
+           ((c = *(i++)) != wxT(' ') && c != wxT('\r') &&
+             c != wxT('\n') && c != wxT('\t') &&
+             c != wxT('>') && c != wxT('/')))
+    {
+        if ((c >= wxT('a')) && (c <= wxT('z')))
+            c -= (wxT('a') - wxT('A'));
+        name << c;
+    }
+
+    if ( c == wxT('>') && firstGt )
+    {
+        *firstGt = i - 1;
+        firstGt = nullptr;
+    }
+
+    // if the tag has parameters, read them, remembering where their names and
+    // values are in the source: the values are only converted to strings if
+    // they're requested later.
+    if (*(i-1) != wxT('>'))
+    {
+        wxHtmlTagParam param;
+        wxChar quote;
+        enum
+        {
+            ST_BEFORE_NAME = 1,
+            ST_NAME,
+            ST_BEFORE_EQ,
+            ST_BEFORE_VALUE,
+            ST_VALUE
+        } state;
+
+        // Add the parameter with the name ending at the given position and
+        // without any value.
+        const auto addWithoutValue = [&params, &param]()
+        {
+            param.m_valueBegin =
+            param.m_valueEnd = param.m_nameEnd;
+            param.m_flags = 0;
+            params.push_back(param);
+        };
+
+        quote = 0;
+        state = ST_BEFORE_NAME;
+        while (i < end)
+        {
+            c = *(i++);
+
+            if ( c == wxT('>') && firstGt )
+            {
+                *firstGt = i - 1;
+                firstGt = nullptr;
+            }
+
+            if (c == wxT('>') && !(state == ST_VALUE && quote != 0))
+            {
+                if (state == ST_NAME)
+                {
+                    param.m_nameEnd = i - 1;
+                    addWithoutValue();
+                }
+                else if (state == ST_BEFORE_EQ)
+                {
+                    addWithoutValue();
+                }
+                else if (state == ST_VALUE && quote == 0)
+                {
+                    // Notice that the value is not converted to upper case in
+                    // this case, for compatibility.
+                    param.m_valueEnd = i - 1;
+                    param.m_flags &= ~wxHtmlTagParam::Value_Upper;
+                    params.push_back(param);
+                }
+                break;
+            }
+            switch (state)
+            {
+                case ST_BEFORE_NAME:
+                    if (!IsHtmlWhite(c))
+                    {
+                        param.m_nameBegin = i - 1;
+                        state = ST_NAME;
+                    }
+                    break;
+                case ST_NAME:
+                    if (IsHtmlWhite(c))
+                    {
+                        param.m_nameEnd = i - 1;
+                        state = ST_BEFORE_EQ;
+                    }
+                    else if (c == wxT('='))
+                    {
+                        param.m_nameEnd = i - 1;
+                        state = ST_BEFORE_VALUE;
+                    }
+                    break;
+                case ST_BEFORE_EQ:
+                    if (c == wxT('='))
+                        state = ST_BEFORE_VALUE;
+                    else if (!IsHtmlWhite(c))
+                    {
+                        addWithoutValue();
+                        param.m_nameBegin = i - 1;
+                        state = ST_NAME;
+                    }
+                    break;
+                case ST_BEFORE_VALUE:
+                    if (!IsHtmlWhite(c))
+                    {
+                        if (c == wxT('"') || c == wxT('\''))
+                        {
+                            quote = c;
+                            param.m_valueBegin = i;
+                            param.m_flags = 0;
+                        }
+                        else
+                        {
+                            quote = 0;
+                            param.m_valueBegin = i - 1;
+                            param.m_flags = wxHtmlTagParam::Value_Upper;
+                            if (c == wxT('&'))
+                                param.m_flags |= wxHtmlTagParam::Value_HasEntities;
+                        }
+                        state = ST_VALUE;
+                    }
+                    break;
+                case ST_VALUE:
+                    if ((quote != 0 && c == quote) ||
+                        (quote == 0 && IsHtmlWhite(c)))
+                    {
+                        param.m_valueEnd = i - 1;
+                        params.push_back(param);
+                        state = ST_BEFORE_NAME;
+                    }
+                    else if (c == wxT('&'))
+                        param.m_flags |= wxHtmlTagParam::Value_HasEntities;
+                    break;
+            }
+        }
+    }
+
+    return i;
+}
+
+} // anonymous namespace
+
 //-----------------------------------------------------------------------------
 // wxHtmlTagsCache
 //-----------------------------------------------------------------------------
@@ -50,8 +277,13 @@ struct wxHtmlCacheItem
     // end2 is '>' or both are
     wxString::const_iterator End1, End2;
 
-    // name of this tag
-    wxChar *Name;
+    // The name and parameters of the starting tag and the position after its
+    // end: they're found when creating the cache, so that wxHtmlTag doesn't
+    // need to parse the tag again, and are moved to it when it's created.
+    bool HasData = false;
+    wxString Name;
+    wxHtmlTagParams Params;
+    wxString::const_iterator Begin;
 };
 
 // NB: this is an empty class and not typedef because of forward declaration
@@ -78,6 +310,16 @@ wxHtmlTagsCache::wxHtmlTagsCache(const wxString& source)
 
     wxChar tagBuffer[256];
 
+    // The names of the tags are mapped to their indices in this hash map and,
+    // for each name, we keep the indices of the starting tags without the
+    // matching ending tag, allowing to find the match for the ending tag
+    // immediately instead of searching for it among all the preceding tags.
+    std::unordered_map<wxString, size_t, wxStringHash, wxStringEqual> nameIndices;
+    std::vector< std::vector<int> > unmatchedTags;
+
+    // Reused for looking up the names to avoid allocating memory every time.
+    wxString name;
+
     const wxString::const_iterator end = source.end();
     for ( wxString::const_iterator pos = source.begin(); pos < end; ++pos )
     {
@@ -104,8 +346,20 @@ wxHtmlTagsCache::wxHtmlTagsCache(const wxString& source)
         }
         tagBuffer[i] = wxT('\0');
 
-        while (pos < end && *pos != wxT('>'))
-            ++pos;
+        const bool isEndingTag = (stpos+1) < end && *(stpos+1) == wxT('/');
+
+        wxHtmlCacheItem item;
+        if ( isEndingTag )
+        {
+            while (pos < end && *pos != wxT('>'))
+                ++pos;
+        }
+        else
+        {
+            // Parse the entire tag now, this also finds its end.
+            item.Begin = ParseStartTag(stpos, end, item.Name, item.Params, &pos);
+            item.HasData = true;
+        }
 
         if ( pos == end )
         {
@@ -118,30 +372,38 @@ wxHtmlTagsCache::wxHtmlTagsCache(const wxString& source)
         }
 
         // We have a valid tag, add it to the cache.
-        size_t tg = Cache().size();
-        Cache().push_back(wxHtmlCacheItem());
-        Cache()[tg].Key = stpos;
-        Cache()[tg].Name = new wxChar[i+1];
-        memcpy(Cache()[tg].Name, tagBuffer, (i+1)*sizeof(wxChar));
+        const int tg = Cache().size();
+        item.Key = stpos;
 
-        if ((stpos+1) < end && *(stpos+1) == wxT('/')) // ending tag:
+        if ( isEndingTag )
         {
-            Cache()[tg].type = wxHtmlCacheItem::Type_EndingTag;
-            // find matching begin tag:
-            for (i = tg; i >= 0; i--)
+            item.type = wxHtmlCacheItem::Type_EndingTag;
+            Cache().push_back(std::move(item));
+
+            // find matching begin tag, which is necessarily the last one with
+            // this name without the ending tag:
+            name.assign(tagBuffer + 1);
+            const auto it = nameIndices.find(name);
+            if ( it != nameIndices.end() && !unmatchedTags[it->second].empty() )
             {
-                if ((Cache()[i].type == wxHtmlCacheItem::Type_NoMatchingEndingTag) && (wxStrcmp(Cache()[i].Name, tagBuffer+1) == 0))
-                {
-                    Cache()[i].type = wxHtmlCacheItem::Type_Normal;
-                    Cache()[i].End1 = stpos;
-                    Cache()[i].End2 = pos + 1;
-                    break;
-                }
+                wxHtmlCacheItem& match = Cache()[unmatchedTags[it->second].back()];
+                unmatchedTags[it->second].pop_back();
+
+                match.type = wxHtmlCacheItem::Type_Normal;
+                match.End1 = stpos;
+                match.End2 = pos + 1;
             }
         }
         else
         {
-            Cache()[tg].type = wxHtmlCacheItem::Type_NoMatchingEndingTag;
+            item.type = wxHtmlCacheItem::Type_NoMatchingEndingTag;
+            Cache().push_back(std::move(item));
+
+            name.assign(tagBuffer);
+            const auto it = nameIndices.emplace(name, unmatchedTags.size()).first;
+            if ( it->second == unmatchedTags.size() )
+                unmatchedTags.emplace_back();
+            unmatchedTags[it->second].push_back(tg);
 
             if (wxIsCDATAElement(tagBuffer))
             {
@@ -210,13 +472,6 @@ wxHtmlTagsCache::wxHtmlTagsCache(const wxString& source)
             }
         }
     }
-
-    // ok, we're done, now we'll free .Name members of cache - we don't need it anymore:
-    for ( wxHtmlTagsCacheData::iterator i = Cache().begin();
-          i != Cache().end(); ++i )
-    {
-        wxDELETEA(i->Name);
-    }
 }
 
 wxHtmlTagsCache::~wxHtmlTagsCache()
@@ -224,19 +479,10 @@ wxHtmlTagsCache::~wxHtmlTagsCache()
     delete m_Cache;
 }
 
-void wxHtmlTagsCache::QueryTag(const wxString::const_iterator& at,
-                               const wxString::const_iterator& inputEnd,
-                               wxString::const_iterator *end1,
-                               wxString::const_iterator *end2,
-                               bool *hasEnding)
+bool wxHtmlTagsCache::LocateTag(const wxString::const_iterator& at)
 {
     if (Cache().empty())
-    {
-        *end1 =
-        *end2 = inputEnd;
-        *hasEnding = true;
-        return;
-    }
+        return false;
 
     if (Cache()[m_CachePos].Key != at)
     {
@@ -251,18 +497,32 @@ void wxHtmlTagsCache::QueryTag(const wxString::const_iterator& at,
                     m_CachePos = 0;
                 else
                     m_CachePos = Cache().size() - 1;
-                // something is very wrong with HTML, give up by returning an
-                // impossibly large value which is going to be ignored by the
-                // caller
-                *end1 =
-                *end2 = inputEnd;
-                *hasEnding = true;
-                return;
+                return false;
             }
         }
         while (Cache()[m_CachePos].Key != at);
     }
 
+    return true;
+}
+
+void wxHtmlTagsCache::QueryTag(const wxString::const_iterator& at,
+                               const wxString::const_iterator& inputEnd,
+                               wxString::const_iterator *end1,
+                               wxString::const_iterator *end2,
+                               bool *hasEnding)
+{
+    if ( !LocateTag(at) )
+    {
+        // something is very wrong with HTML, give up by returning an
+        // impossibly large value which is going to be ignored by the
+        // caller
+        *end1 =
+        *end2 = inputEnd;
+        *hasEnding = true;
+        return;
+    }
+
     switch ( Cache()[m_CachePos].type )
     {
         case wxHtmlCacheItem::Type_Normal:
@@ -285,6 +545,31 @@ void wxHtmlTagsCache::QueryTag(const wxString::const_iterator& at,
     }
 }
 
+bool wxHtmlTagsCache::TakeTagData(const wxString::const_iterator& at,
+                                  const wxString::const_iterator& inputEnd,
+                                  wxString *name,
+                                  wxHtmlTagParams *params,
+                                  wxString::const_iterator *begin)
+{
+    if ( !LocateTag(at) )
+        return false;
+
+    wxHtmlCacheItem& item = Cache()[m_CachePos];
+
+    // If the tag extends beyond the end of the input, it must be parsed again
+    // as the parameters after the input end must be ignored.
+    if ( !item.HasData || item.Begin > inputEnd )
+        return false;
+
+    name->swap(item.Name);
+    params->swap(item.Params);
+    *begin = item.Begin;
+
+    item.HasData = false;
+
+    return true;
+}
+
 
 
 
@@ -316,135 +601,14 @@ wxHtmlTag::wxHtmlTag(wxHtmlTag *parent,
     else
         m_Prev = nullptr;
 
-    /* Find parameters and their values: */
-
-    wxChar c wxDUMMY_INITIALIZE(0);
-
-    // fill-in name, params and begin pos:
-    wxString::const_iterator i(pos+1);
+    m_entParser = entParser;
 
-    // find tag's name and convert it to uppercase:
-    while ((i < end_pos) &&
-           ((c = *(i++)) != wxT(' ') && c != wxT('\r') &&
-             c != wxT('\n') && c != wxT('\t') &&
-             c != wxT('>') && c != wxT('/')))
-    {
-        if ((c >= wxT('a')) && (c <= wxT('z')))
-            c -= (wxT('a') - wxT('A'));
-        m_Name << c;
-    }
+    /* Find name, parameters and their values: */
 
-    // if the tag has parameters, read them and "normalize" them,
-    // i.e. convert to uppercase, replace whitespaces by spaces and
-    // remove whitespaces around '=':
-    if (*(i-1) != wxT('>'))
-    {
-        #define IS_WHITE(c) (c == wxT(' ') || c == wxT('\r') || \
-                             c == wxT('\n') || c == wxT('\t'))
-        wxString pname, pvalue;
-        wxChar quote;
-        enum
-        {
-            ST_BEFORE_NAME = 1,
-            ST_NAME,
-            ST_BEFORE_EQ,
-            ST_BEFORE_VALUE,
-            ST_VALUE
-        } state;
+    // The tag has been normally already parsed when creating the cache.
+    if ( !cache->TakeTagData(pos, end_pos, &m_Name, &m_Params, &m_Begin) )
+        m_Begin = ParseStartTag(pos, end_pos, m_Name, m_Params, nullptr);
 
-        quote = 0;
-        state = ST_BEFORE_NAME;
-        while (i < end_pos)
-        {
-            c = *(i++);
-
-            if (c == wxT('>') && !(state == ST_VALUE && quote != 0))
-            {
-                if (state == ST_BEFORE_EQ || state == ST_NAME)
-                {
-                    m_ParamNames.Add(pname);
-                    m_ParamValues.Add(wxGetEmptyString());
-                }
-                else if (state == ST_VALUE && quote == 0)
-                {
-                    m_ParamNames.Add(pname);
-                    if (entParser)
-                        m_ParamValues.Add(entParser->Parse(pvalue));
-                    else
-                        m_ParamValues.Add(pvalue);
-                }
-                break;
-            }
-            switch (state)
-            {
-                case ST_BEFORE_NAME:
-                    if (!IS_WHITE(c))
-                    {
-                        pname = c;
-                        state = ST_NAME;
-                    }
-                    break;
-                case ST_NAME:
-                    if (IS_WHITE(c))
-                        state = ST_BEFORE_EQ;
-                    else if (c == wxT('='))
-                        state = ST_BEFORE_VALUE;
-                    else
-                        pname << c;
-                    break;
-                case ST_BEFORE_EQ:
-                    if (c == wxT('='))
-                        state = ST_BEFORE_VALUE;
-                    else if (!IS_WHITE(c))
-                    {
-                        m_ParamNames.Add(pname);
-                        m_ParamValues.Add(wxGetEmptyString());
-                        pname = c;
-                        state = ST_NAME;
-                    }
-                    break;
-                case ST_BEFORE_VALUE:
-                    if (!IS_WHITE(c))
-                    {
-                        if (c == wxT('"') || c == wxT('\''))
-                        {
-                            quote = c;
-                            pvalue.clear();
-                        }
-                        else
-                        {
-                            quote = 0;
-                            pvalue = c;
-                        }
-                        state = ST_VALUE;
-                    }
-                    break;
-                case ST_VALUE:
-                    if ((quote != 0 && c == quote) ||
-                        (quote == 0 && IS_WHITE(c)))
-                    {
-                        m_ParamNames.Add(pname);
-                        if (quote == 0)
-                        {
-                            // VS: backward compatibility, no real reason,
-                            //     but wxHTML code relies on this... :(
-                            pvalue.MakeUpper();
-                        }
-                        if (entParser)
-                            m_ParamValues.Add(entParser->Parse(pvalue));
-                        else
-                            m_ParamValues.Add(pvalue);
-                        state = ST_BEFORE_NAME;
-                    }
-                    else
-                        pvalue << c;
-                    break;
-            }
-        }
-
-        #undef IS_WHITE
-    }
-    m_Begin = i;
     cache->QueryTag(pos, source->end(), &m_End1, &m_End2, &m_hasEnding);
     if (m_End1 > end_pos) m_End1 = end_pos;
     if (m_End2 > end_pos) m_End2 = end_pos;
@@ -452,6 +616,10 @@ wxHtmlTag::wxHtmlTag(wxHtmlTag *parent,
     // Try to parse any style parameters that can be handled simply by
     // converting them to the equivalent HTML 3 attributes: this is a far cry
     // from perfect but better than nothing.
+    static const wxString styleParam(wxS("STYLE"));
+    if ( !HasParam(styleParam) )
+        return;
+
     static const struct EquivAttr
     {
         const char *style;
@@ -474,8 +642,8 @@ wxHtmlTag::wxHtmlTag(wxHtmlTag *parent,
         const EquivAttr& ea = equivAttrs[n];
         if ( styleParams.HasParam(ea.style) && !HasParam(ea.attr) )
         {
-            m_ParamNames.Add(ea.attr);
-            m_ParamValues.Add(styleParams.GetParam(ea.style));
+            m_Params.push_back(wxHtmlTagParam(ea.attr,
+                                              styleParams.GetParam(ea.style)));
         }
     }
 }
@@ -492,36 +660,48 @@ wxHtmlTag::~wxHtmlTag()
     }
 }
 
+int wxHtmlTag::FindParam(const wxString& par) const
+{
+    const size_t count = m_Params.size();
+    for ( size_t n = 0; n < count; n++ )
+    {
+        if ( m_Params[n].IsNamed(par) )
+            return n;
+    }
+
+    return wxNOT_FOUND;
+}
+
 bool wxHtmlTag::HasParam(const wxString& par) const
 {
-    return (m_ParamNames.Index(par, false) != wxNOT_FOUND);
+    return FindParam(par) != wxNOT_FOUND;
 }
 
 wxString wxHtmlTag::GetParam(const wxString& par, bool with_quotes) const
 {
-    int index = m_ParamNames.Index(par, false);
+    int index = FindParam(par);
     if (index == wxNOT_FOUND)
         return wxGetEmptyString();
     if (with_quotes)
     {
         // VS: backward compatibility, seems to be never used by wxHTML...
         wxString s;
-        s << wxT('"') << m_ParamValues[index] << wxT('"');
+        s << wxT('"') << m_Params[index].GetValue(m_entParser) << wxT('"');
         return s;
     }
     else
-        return m_ParamValues[index];
+        return m_Params[index].GetValue(m_entParser);
 }
 
 bool wxHtmlTag::GetParamAsString(const wxString& par, wxString *str) const
 {
     wxCHECK_MSG( str, false, wxT("null output string argument") );
 
-    int index = m_ParamNames.Index(par, false);
+    int index = FindParam(par);
     if (index == wxNOT_FOUND)
         return false;
 
-    *str = m_ParamValues[index];
+    *str = m_Params[index].GetValue(m_entParser);
 
     return true;
 }
@@ -642,15 +822,17 @@ wxString wxHtmlTag::GetAllParams() const
     // VS: this function is for backward compatibility only,
     //     never used by wxHTML
     wxString s;
-    size_t cnt = m_ParamNames.GetCount();
+    size_t cnt = m_Params.size();
     for (size_t i = 0; i < cnt; i++)
     {
-        s << m_ParamNames[i];
+        const wxString value = m_Params[i].GetValue(m_entParser);
+
+        s << m_Params[i].GetName();
         s << wxT('=');
-        if (m_ParamValues[i].Find(wxT('"')) != wxNOT_FOUND)
-            s << wxT('\'') << m_ParamValues[i] << wxT('\'');
+        if (value.Find(wxT('"')) != wxNOT_FOUND)
+            s << wxT('\'') << value << wxT('\'');
         else
-            s << wxT('"') << m_ParamValues[i] << wxT('"');
+            s << wxT('"') << value << wxT('"');
     }
     return s;
 }
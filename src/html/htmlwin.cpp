@@ -12,6 +12,7 @@
 #if wxUSE_HTML && wxUSE_STREAMS
 
 #ifndef WX_PRECOMP
+    #include "wx/app.h"
     #include "wx/list.h"
     #include "wx/log.h"
     #include "wx/intl.h"
@@ -350,6 +351,7 @@ void wxHtmlWindow::Init()
     m_lastDoubleClick = 0;
 #endif // wxUSE_CLIPBOARD
     m_tmpSelFromCell = nullptr;
+    m_lazyLayout = false;
 }
 
 bool wxHtmlWindow::Create(wxWindow *parent, wxWindowID id,
@@ -539,6 +541,7 @@ bool wxHtmlWindow::DoSetPage(const wxString& source)
 
     m_Cell->SetIndent(m_Borders, wxHTML_INDENT_ALL, wxHTML_UNITS_PIXELS);
     m_Cell->SetAlignHor(wxHTML_ALIGN_CENTER);
+    m_Cell->EnableLazyLayout(m_lazyLayout);
     CreateLayout();
     if (m_tmpCanDrawLocks == 0)
         Refresh();
@@ -735,6 +738,10 @@ bool wxHtmlWindow::ScrollToAnchor(const wxString& anchor)
         if ( !c )
             c = c_save;
 
+        // With lazy layout, the cell position may be not known yet.
+        if ( m_lazyLayout && m_Cell->EnsureLaidOut(c) )
+            SetVirtualSize(m_Cell->GetWidth(), m_Cell->GetHeight());
+
         int y;
 
         for (y = 0; c != nullptr; c = c->GetParent()) y += c->GetPosY();
@@ -770,6 +777,9 @@ void wxHtmlWindow::CreateLayout()
     if (!m_Cell)
         return;
 
+    if ( m_lazyLayout )
+        UpdateLayoutViewport();
+
     if ( HasFlag(wxHW_SCROLLBAR_NEVER) )
     {
         m_Cell->Layout(GetClientSize().GetWidth());
@@ -797,6 +807,75 @@ void wxHtmlWindow::CreateLayout()
     }
 }
 
+void wxHtmlWindow::EnableLazyLayout(bool enable)
+{
+    if ( enable == m_lazyLayout )
+        return;
+
+    m_lazyLayout = enable;
+
+    if ( m_Cell )
+    {
+        m_Cell->EnableLazyLayout(enable);
+        CreateLayout();
+        Refresh();
+    }
+}
+
+bool wxHtmlWindow::UpdateLayoutViewport()
+{
+    int x, y;
+    GetViewStart(&x, &y);
+
+    // Lay out one more page above and below the visible one to avoid having
+    // to do it when scrolling by a small amount.
+    const int top = y * wxHTML_SCROLL_STEP;
+    const int height = GetClientSize().y;
+
+    return m_Cell->SetLayoutViewport(top - height, top + 2*height);
+}
+
+void wxHtmlWindow::DoLayoutPending()
+{
+    int x, y;
+    GetViewStart(&x, &y);
+    const int top = y * wxHTML_SCROLL_STEP;
+
+    // Laying out the cells above the visible part of the page moves it, so
+    // remember the position of the first visible cell to keep it in place.
+    const wxHtmlCell* const
+        cellTop = m_Cell->FindCellByPos(0, top, wxHTML_FIND_NEAREST_AFTER);
+    const int cellTopY = cellTop ? cellTop->GetAbsPos().y : 0;
+
+    const int width = m_Cell->GetWidth(),
+              height = m_Cell->GetHeight();
+
+    // Don't block the UI for too long, we'll continue during the next idle
+    // time if necessary.
+    const wxMilliClock_t start = wxGetLocalTimeMillis();
+    while ( m_Cell->HasPendingLayout() &&
+                wxGetLocalTimeMillis() - start < 20 )
+        m_Cell->LayoutPending(100);
+
+    if ( m_Cell->GetWidth() != width || m_Cell->GetHeight() != height )
+    {
+        SetVirtualSize(m_Cell->GetWidth(), m_Cell->GetHeight());
+
+        if ( cellTop )
+        {
+            const int delta = cellTop->GetAbsPos().y - cellTopY;
+            if ( delta )
+            {
+                Scroll(-1, (top + delta + wxHTML_SCROLL_STEP / 2)
+                                / wxHTML_SCROLL_STEP);
+            }
+        }
+    }
+
+    if ( m_Cell->HasPendingLayout() )
+        wxWakeUpIdle();
+}
+
 #if wxUSE_CONFIG
 void wxHtmlWindow::ReadCustomization(wxConfigBase *cfg, wxString path)
 {
@@ -1181,6 +1260,10 @@ void wxHtmlWindow::OnPaint(wxPaintEvent& WXUNUSED(event))
     dc->SetBackgroundMode(wxBRUSHSTYLE_TRANSPARENT);
     dc->SetLayoutDirection(GetLayoutDirection());
 
+    // With lazy layout, the newly visible part may need to be laid out.
+    if ( m_lazyLayout && UpdateLayoutViewport() )
+        SetVirtualSize(m_Cell->GetWidth(), m_Cell->GetHeight());
+
     wxHtmlRenderingInfo rinfo;
     wxDefaultHtmlRenderingStyle rstyle(this);
     rinfo.SetSelection(m_selection);
@@ -1449,6 +1532,9 @@ void wxHtmlWindow::OnInternalIdle()
 {
     wxWindow::OnInternalIdle();
 
+    if ( m_lazyLayout && m_Cell && m_Cell->HasPendingLayout() )
+        DoLayoutPending();
+
     if (m_Cell != nullptr && DidMouseMove())
     {
 #ifdef DEBUG_HTML_SELECTION
@@ -368,14 +368,33 @@ void wxHtmlPrintout::OnPreparePrinting()
         printAreaH -= int(m_FooterHeight + m_MarginSpace * ppmm_v);
 
     m_Renderer.SetSize(printAreaW, printAreaH);
-    m_Renderer.SetHtmlText(m_Document, m_BasePath, m_BasePathIsDir);
+
+    // Parsing, laying out and paginating a long document takes time, so reuse
+    // the results of doing it the last time if this printout is being printed
+    // again with the same page size and resolution.
+    const LayoutParams params =
+    {
+        GetDC()->GetClassInfo(),
+        printAreaW, printAreaH,
+        ppiPrinterY, ppiScreenY
+    };
+
+    if ( !m_layoutDone || !(params == m_layoutParams) )
+    {
+        m_Renderer.SetHtmlText(m_Document, m_BasePath, m_BasePathIsDir);
+        m_PageBreaks.clear();
+
+        m_layoutParams = params;
+        m_layoutDone = true;
+    }
 
     if ( CheckFit(wxSize(printAreaW, printAreaH),
                   wxSize(m_Renderer.GetTotalWidth(),
                          m_Renderer.GetTotalHeight())) || IsPreview() )
     {
-        // do paginate the document
-        CountPages();
+        // do paginate the document, unless it had been already done
+        if ( m_PageBreaks.empty() )
+            CountPages();
     }
     //else: if we don't call CountPages() m_PageBreaks remains empty and our
     //      GetPageInfo() will return 0 as max page and so nothing will be
@@ -428,6 +447,8 @@ void wxHtmlPrintout::SetHtmlText(const wxString& html, const wxString &basepath,
     m_Document = html;
     m_BasePath = basepath;
     m_BasePathIsDir = isdir;
+
+    m_layoutDone = false;
 }
 
 void wxHtmlPrintout::SetHtmlFile(const wxString& htmlfile)
@@ -608,6 +629,8 @@ void wxHtmlPrintout::SetFonts(const wxString& normal_face, const wxString& fixed
 {
     m_Renderer.SetFonts(normal_face, fixed_face, sizes);
     m_RendererHdr.SetFonts(normal_face, fixed_face, sizes);
+
+    m_layoutDone = false;
 }
 
 void wxHtmlPrintout::SetStandardFonts(int size,
@@ -616,6 +639,8 @@ void wxHtmlPrintout::SetStandardFonts(int size,
 {
     m_Renderer.SetStandardFonts(size, normal_face, fixed_face);
     m_RendererHdr.SetStandardFonts(size, normal_face, fixed_face);
+
+    m_layoutDone = false;
 }
 
 
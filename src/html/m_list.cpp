@@ -20,6 +20,7 @@
 #include "wx/html/m_templ.h"
 
 #include "wx/html/htmlcell.h"
+#include "wx/html/private/htmlcell.h"
 
 FORCE_LINK_ME(m_list)
 
@@ -237,7 +238,7 @@ TAG_HANDLER_BEGIN(OLULLI, "OL,UL,LI")
         // List Item:
         if (m_List && tag.GetName() == wxT("LI"))
         {
-            c = m_WParser->SetContainer(new wxHtmlContainerCell(m_List));
+            c = m_WParser->SetContainer(new wxHtmlPlainContainerCell(m_List));
             c->SetAlignVer(wxHTML_ALIGN_TOP);
 
             wxHtmlContainerCell *mark = c;
@@ -20,6 +20,7 @@
 #include "wx/html/m_templ.h"
 
 #include "wx/html/htmlcell.h"
+#include "wx/html/private/htmlcell.h"
 
 FORCE_LINK_ME(m_tables)
 
@@ -779,7 +780,7 @@ TAG_HANDLER_BEGIN(TABLE, "TABLE,TR,TD,TH")
             // new cell
             else
             {
-                c = m_WParser->SetContainer(new wxHtmlContainerCell(m_Table));
+                c = m_WParser->SetContainer(new wxHtmlPlainContainerCell(m_Table));
                 m_Table->AddCell(c, tag);
 
                 m_WParser->OpenContainer();
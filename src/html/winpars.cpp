@@ -26,6 +26,7 @@
 #include "wx/uri.h"
 
 #include "wx/private/hyperlink.h"
+#include "wx/html/private/htmlcell.h"
 
 //-----------------------------------------------------------------------------
 // wxHtmlWinParser
@@ -469,7 +470,7 @@ void wxHtmlWinParser::AddPreBlock(const wxString& text)
 
 wxHtmlContainerCell* wxHtmlWinParser::OpenContainer()
 {
-    m_Container = new wxHtmlContainerCell(m_Container);
+    m_Container = new wxHtmlPlainContainerCell(m_Container);
     m_Container->SetAlignHor(m_Align);
     m_posColumn = 0;
     m_tmpLastWasSpace = true;
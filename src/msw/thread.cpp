@@ -181,7 +181,9 @@ private:
     wxDECLARE_NO_COPY_CLASS(wxMutexInternal);
 };
 
-// all mutexes are recursive under Win32 so we don't use mutexType
+// all mutexes are recursive under Win32 so we don't use mutexType, except for
+// checking for deadlocks with non-recursive ones, and wxMUTEX_ADAPTIVE is the
+// same as wxMUTEX_DEFAULT here
 wxMutexInternal::wxMutexInternal(wxMutexType mutexType)
 {
     // create a nameless (hence intra process and always private) mutex
@@ -223,7 +225,7 @@ wxMutexError wxMutexInternal::TryLock()
 
 wxMutexError wxMutexInternal::LockTimeout(DWORD milliseconds)
 {
-    if (m_type == wxMUTEX_DEFAULT)
+    if (m_type != wxMUTEX_RECURSIVE)
     {
         // Don't allow recursive
         if (m_owningThread != 0)
@@ -258,7 +260,7 @@ wxMutexError wxMutexInternal::LockTimeout(DWORD milliseconds)
             return wxMUTEX_MISC_ERROR;
     }
 
-    if (m_type == wxMUTEX_DEFAULT)
+    if (m_type != wxMUTEX_RECURSIVE)
     {
         // required for checking recursiveness
         m_owningThread = wxThread::GetCurrentId();
@@ -282,6 +284,67 @@ wxMutexError wxMutexInternal::Unlock()
     return wxMUTEX_NO_ERROR;
 }
 
+// ----------------------------------------------------------------------------
+// wxSharedMutex
+// ----------------------------------------------------------------------------
+
+// a trivial wrapper around Win32 slim reader/writer lock
+class wxSharedMutexInternal
+{
+public:
+    wxSharedMutexInternal() { ::InitializeSRWLock(&m_lock); }
+
+    // SRW locks don't need to be destroyed
+    ~wxSharedMutexInternal() = default;
+
+    bool IsOk() const { return true; }
+
+    wxMutexError Lock()
+    {
+        ::AcquireSRWLockExclusive(&m_lock);
+
+        return wxMUTEX_NO_ERROR;
+    }
+
+    wxMutexError TryLock()
+    {
+        return ::TryAcquireSRWLockExclusive(&m_lock) ? wxMUTEX_NO_ERROR
+                                                     : wxMUTEX_BUSY;
+    }
+
+    wxMutexError Unlock()
+    {
+        ::ReleaseSRWLockExclusive(&m_lock);
+
+        return wxMUTEX_NO_ERROR;
+    }
+
+    wxMutexError LockShared()
+    {
+        ::AcquireSRWLockShared(&m_lock);
+
+        return wxMUTEX_NO_ERROR;
+    }
+
+    wxMutexError TryLockShared()
+    {
+        return ::TryAcquireSRWLockShared(&m_lock) ? wxMUTEX_NO_ERROR
+                                                  : wxMUTEX_BUSY;
+    }
+
+    wxMutexError UnlockShared()
+    {
+        ::ReleaseSRWLockShared(&m_lock);
+
+        return wxMUTEX_NO_ERROR;
+    }
+
+private:
+    SRWLOCK m_lock;
+
+    wxDECLARE_NO_COPY_CLASS(wxSharedMutexInternal);
+};
+
 // --------------------------------------------------------------------------
 // wxSemaphore
 // --------------------------------------------------------------------------
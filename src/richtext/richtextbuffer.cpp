@@ -44,6 +44,9 @@
 #include "wx/listimpl.cpp"
 #include "wx/arrimpl.cpp"
 
+#include <algorithm>
+#include <vector>
+
 WX_DEFINE_LIST(wxRichTextObjectList)
 
 // Switch off if the platform doesn't like it for some reason
@@ -1367,6 +1370,7 @@ size_t wxRichTextCompositeObject::AppendChild(wxRichTextObject* child)
 {
     m_children.Append(child);
     child->SetParent(this);
+    OnChildrenChanged();
     return m_children.GetCount() - 1;
 }
 
@@ -1381,6 +1385,7 @@ bool wxRichTextCompositeObject::InsertChild(wxRichTextObject* child, wxRichTextO
     else
         m_children.Insert(child);
     child->SetParent(this);
+    OnChildrenChanged();
 
     return true;
 }
@@ -1393,6 +1398,7 @@ bool wxRichTextCompositeObject::RemoveChild(wxRichTextObject* child, bool delete
     {
         wxRichTextObject* obj = node->GetData();
         m_children.Erase(node);
+        OnChildrenChanged();
         if (deleteChild)
             delete obj;
 
@@ -1416,6 +1422,8 @@ bool wxRichTextCompositeObject::DeleteChildren()
         m_children.Erase(oldNode);
     }
 
+    OnChildrenChanged();
+
     return true;
 }
 
@@ -1442,6 +1450,8 @@ void wxRichTextCompositeObject::Copy(const wxRichTextCompositeObject& obj)
 
         node = node->GetNext();
     }
+
+    OnChildrenChanged();
 }
 
 /// Hit-testing: returns a flag indicating hit test details, plus
@@ -1657,6 +1667,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                         {
                             nextChild->Dereference();
                             m_children.Erase(node->GetNext());
+                            OnChildrenChanged();
                         }
                         else
                             node = node->GetNext();
@@ -1703,6 +1714,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                         {
                             nextChild->Dereference();
                             m_children.Erase(node->GetNext());
+                            OnChildrenChanged();
 
                             // Don't set node -- we'll see if we can merge again with the next
                             // child. UNLESS we split this or the next child, in which case we know we have to
@@ -1741,6 +1753,7 @@ bool wxRichTextCompositeObject::Defragment(wxRichTextDrawingContext& context, co
                 {
                     child->Dereference();
                     m_children.Erase(node);
+                    OnChildrenChanged();
                 }
                 node = next;
             }
@@ -1937,6 +1950,8 @@ wxRichTextParagraphLayoutBox::~wxRichTextParagraphLayoutBox()
         delete m_floatCollector;
         m_floatCollector = nullptr;
     }
+
+    InvalidatePositionIndex();
 }
 
 /// Initialize the object.
@@ -1952,6 +1967,11 @@ void wxRichTextParagraphLayoutBox::Init()
 
     m_partialParagraph = false;
     m_floatCollector = nullptr;
+
+    m_lazyLayoutLimit = -1;
+    m_pendingLayoutPosition = -1;
+    m_averageLineHeight = 0;
+    m_averageLineLength = 0;
 }
 
 void wxRichTextParagraphLayoutBox::Clear()
@@ -1962,6 +1982,7 @@ void wxRichTextParagraphLayoutBox::Clear()
         delete m_floatCollector;
     m_floatCollector = nullptr;
     m_partialParagraph = false;
+    m_pendingLayoutPosition = -1;
 }
 
 /// Copy
@@ -2033,6 +2054,100 @@ void wxRichTextParagraphLayoutBox::UpdateRanges()
     CalculateRange(start, end);
 }
 
+void wxRichTextParagraphLayoutBox::CalculateRange(long start, long& end)
+{
+    // The ranges of the paragraphs are going to change.
+    InvalidatePositionIndex();
+
+    wxRichTextCompositeObject::CalculateRange(start, end);
+}
+
+void wxRichTextParagraphLayoutBox::OnChildrenChanged()
+{
+    InvalidatePositionIndex();
+}
+
+// The paragraphs of a box with many of them are indexed to allow finding the
+// one containing the given position using binary search instead of iterating
+// over all of them.
+//
+// The index refers to the list nodes rather than to the paragraphs themselves
+// because the latter are sometimes replaced in place, e.g. when undoing the
+// changes. It is only valid as long as neither the children nor their ranges
+// change, which is ensured by destroying it when this happens.
+struct wxRichTextParagraphLayoutBox::PositionIndex
+{
+    // Don't bother indexing boxes with fewer paragraphs than this.
+    static const size_t MIN_PARAGRAPHS = 32;
+
+    // Return the node of the only paragraph which may contain the given
+    // position or null if there is none.
+    wxRichTextObjectList::compatibility_iterator FindNode(long pos) const
+    {
+        // Find the last paragraph starting at or before this position: as
+        // the ranges don't overlap, none of the previous ones can contain it.
+        std::vector<wxRichTextObjectList::compatibility_iterator>::const_iterator
+            it = std::upper_bound(nodes.begin(), nodes.end(), pos,
+                    [](long p, const wxRichTextObjectList::compatibility_iterator& node)
+                    {
+                        return p < node->GetData()->GetRange().GetStart();
+                    });
+        if (it == nodes.begin())
+            return wxRichTextObjectList::compatibility_iterator();
+
+        return *--it;
+    }
+
+    // Nodes of all the paragraph children, in order.
+    std::vector<wxRichTextObjectList::compatibility_iterator> nodes;
+
+    // False if the index can't be used because the ranges of the paragraphs
+    // were not ordered when it was built, as happens temporarily while the
+    // buffer is being modified.
+    bool usable = true;
+};
+
+const wxRichTextParagraphLayoutBox::PositionIndex*
+wxRichTextParagraphLayoutBox::GetPositionIndex() const
+{
+    if (!m_positionIndex)
+    {
+        if (m_children.GetCount() < PositionIndex::MIN_PARAGRAPHS)
+            return nullptr;
+
+        m_positionIndex = new PositionIndex;
+        m_positionIndex->nodes.reserve(m_children.GetCount());
+
+        long lastEnd = LONG_MIN;
+        for (wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
+             node;
+             node = node->GetNext())
+        {
+            const wxRichTextObject* const child = node->GetData();
+            if (!wxDynamicCast(child, wxRichTextParagraph))
+                continue;
+
+            const wxRichTextRange& range = child->GetRange();
+            if (range.GetStart() <= lastEnd || range.GetEnd() < range.GetStart())
+            {
+                m_positionIndex->usable = false;
+                m_positionIndex->nodes.clear();
+                break;
+            }
+
+            lastEnd = range.GetEnd();
+            m_positionIndex->nodes.push_back(node);
+        }
+    }
+
+    return m_positionIndex->usable ? m_positionIndex : nullptr;
+}
+
+void wxRichTextParagraphLayoutBox::InvalidatePositionIndex()
+{
+    wxDELETE(m_positionIndex);
+}
+
 // HitTest
 int wxRichTextParagraphLayoutBox::HitTest(wxReadOnlyDC& dc, wxRichTextDrawingContext& context, const wxPoint& pt, long& textPosition, wxRichTextObject** obj, wxRichTextObject** contextObj, int flags)
 {
@@ -2212,6 +2327,33 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
     // Get invalid range, rounding to paragraph start/end.
     wxRichTextRange invalidRange = GetInvalidRange(true);
 
+    // If some paragraphs were not laid out before, lay them out now too.
+    if (HasPendingLayout())
+    {
+        m_pendingLayoutPosition = -1;
+
+        wxRichTextRange pendingRange = wxRICHTEXT_NONE;
+        for (wxRichTextObjectList::compatibility_iterator n = m_children.GetFirst(); n; n = n->GetNext())
+        {
+            wxRichTextParagraph* child = wxDynamicCast(n->GetData(), wxRichTextParagraph);
+            if (child && child->IsShown() && child->GetLines().empty())
+            {
+                if (pendingRange == wxRICHTEXT_NONE)
+                    pendingRange.SetStart(child->GetRange().GetStart());
+                pendingRange.SetEnd(child->GetRange().GetEnd());
+            }
+        }
+
+        if (pendingRange != wxRICHTEXT_NONE)
+        {
+            if (invalidRange == wxRICHTEXT_NONE)
+                invalidRange = pendingRange;
+            else if (invalidRange != wxRICHTEXT_ALL)
+                invalidRange = wxRichTextRange(wxMin(pendingRange.GetStart(), invalidRange.GetStart()),
+                                               wxMax(pendingRange.GetEnd(), invalidRange.GetEnd()));
+        }
+    }
+
     if (invalidRange == wxRICHTEXT_NONE && !formatRect)
         return true;
 
@@ -2251,6 +2393,56 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
     // A way to force speedy rest-of-buffer layout (the 'else' below)
     bool forceQuickLayout = false;
 
+    // The total height, number of lines and length of the paragraphs laid
+    // out below, used for estimating the size of the deferred ones.
+    long laidOutHeight = 0;
+    long laidOutLines = 0;
+    long laidOutLength = 0;
+
+    // Lays out the paragraph unless lazy layout is used and it is below the
+    // limit, in which case only its height is estimated. Notice that at least
+    // one paragraph is always laid out to ensure that repeated calls to this
+    // function make progress.
+    const bool canDefer = m_lazyLayoutLimit != -1 && !hasVerticalAlignment && !formatRect;
+    bool laidOutAny = false;
+    auto layoutParagraph = [&](wxRichTextParagraph* para)
+    {
+        if (canDefer && laidOutAny && availableSpace.y > m_lazyLayoutLimit)
+        {
+            if (m_pendingLayoutPosition == -1)
+                m_pendingLayoutPosition = availableSpace.y;
+
+            int lineHeight = m_averageLineHeight;
+            int lineLength = m_averageLineLength;
+            if (laidOutLines)
+            {
+                lineHeight = laidOutHeight / laidOutLines;
+                lineLength = wxMax(laidOutLength / laidOutLines, 1L);
+            }
+            if (lineHeight <= 0)
+                lineHeight = dc.GetCharHeight();
+            if (lineLength <= 0)
+                lineLength = wxMax(availableSpace.width / wxMax(dc.GetCharWidth(), 1), 1);
+
+            const long numLines = (para->GetRange().GetLength() + lineLength - 1) / lineLength;
+
+            para->ClearLines();
+            para->SetPosition(availableSpace.GetPosition());
+            para->SetCachedSize(wxSize(availableSpace.width, lineHeight*wxMax(numLines, 1L)));
+            return;
+        }
+
+        // Lays out the object first with a given amount of space, and then if no width was specified in attr,
+        // lays out the object again using the minimum size
+        para->LayoutToBestSize(dc, context, GetBuffer(),
+                attr, para->GetAttributes(), availableSpace, rect, style&~wxRICHTEXT_LAYOUT_SPECIFIED_RECT);
+
+        laidOutAny = true;
+        laidOutHeight += para->GetCachedSize().y;
+        laidOutLines += para->GetLines().size();
+        laidOutLength += para->GetRange().GetLength();
+    };
+
     // First get the size of the paragraphs we won't be laying out
     wxRichTextObjectList::compatibility_iterator n = m_children.GetFirst();
     while (n && n != node)
@@ -2281,10 +2473,7 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
                         child->GetLines().empty() ||
                             !child->GetRange().IsOutside(invalidRange)) )
             {
-                // Lays out the object first with a given amount of space, and then if no width was specified in attr,
-                // lays out the object again using the minimum size
-                child->LayoutToBestSize(dc, context, GetBuffer(),
-                        attr, child->GetAttributes(), availableSpace, rect, style&~wxRICHTEXT_LAYOUT_SPECIFIED_RECT);
+                layoutParagraph(child);
 
                 // Layout must set the cached size
                 availableSpace.y += child->GetCachedSize().y;
@@ -2355,10 +2544,7 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
                         {
                             nodeChild->SetImpactedByFloatingObjects(-1);
 
-                            // Lays out the object first with a given amount of space, and then if no width was specified in attr,
-                            // lays out the object again using the minimum size
-                            nodeChild->LayoutToBestSize(dc, context, GetBuffer(),
-                                        attr, nodeChild->GetAttributes(), availableSpace, rect, style&~wxRICHTEXT_LAYOUT_SPECIFIED_RECT);
+                            layoutParagraph(nodeChild);
                         }
                         else
                         {
@@ -2487,6 +2673,12 @@ bool wxRichTextParagraphLayoutBox::Layout(wxReadOnlyDC& dc, wxRichTextDrawingCon
         }
     }
 
+    if (laidOutLines)
+    {
+        m_averageLineHeight = laidOutHeight / laidOutLines;
+        m_averageLineLength = wxMax(laidOutLength / laidOutLines, 1L);
+    }
+
     m_invalidRange = wxRICHTEXT_NONE;
 
     return true;
@@ -2574,6 +2766,15 @@ wxRichTextParagraph* wxRichTextParagraphLayoutBox::GetParagraphAtPosition(long p
     if (caretPosition)
         pos ++;
 
+    if (const PositionIndex* const index = GetPositionIndex())
+    {
+        wxRichTextObjectList::compatibility_iterator node = index->FindNode(pos);
+        if (node && node->GetData()->GetRange().Contains(pos))
+            return wxDynamicCast(node->GetData(), wxRichTextParagraph);
+
+        return nullptr;
+    }
+
     // First find the first paragraph whose starting position is within the range.
     wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
     while (node)
@@ -2604,7 +2805,9 @@ wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtPosition(long pos, bool c
         pos ++;
 
     // First find the first paragraph whose starting position is within the range.
-    wxRichTextObjectList::compatibility_iterator node = m_children.GetFirst();
+    const PositionIndex* const index = GetPositionIndex();
+    wxRichTextObjectList::compatibility_iterator node = index ? index->FindNode(pos)
+                                                              : m_children.GetFirst();
     while (node)
     {
         wxRichTextObject* obj = (wxRichTextObject*) node->GetData();
@@ -2635,6 +2838,10 @@ wxRichTextLine* wxRichTextParagraphLayoutBox::GetLineAtPosition(long pos, bool c
             }
         }
 
+        // If the index is used, no other paragraph can contain this position.
+        if (index)
+            break;
+
         node = node->GetNext();
     }
 
@@ -2878,6 +3085,49 @@ bool wxRichTextParagraphLayoutBox::InsertFragment(long position, wxRichTextParag
         wxRichTextAttr originalAttr = para->GetAttributes();
         wxRichTextProperties originalProperties = para->GetProperties();
 
+        // Special case: a single text object, e.g. a character being typed,
+        // inserted next to a text object with the same attributes. Insert the
+        // text directly into the existing object instead of splitting it and
+        // merging the pieces back together later, as this would copy the
+        // entire text of the object every time.
+        if (fragment.GetPartialParagraph() && fragment.GetChildCount() == 1)
+        {
+            wxRichTextParagraph* firstPara = wxDynamicCast(fragment.GetChild(0), wxRichTextParagraph);
+            wxRichTextPlainText* newText = nullptr;
+            if (firstPara && firstPara->GetChildCount() == 1)
+                newText = wxDynamicCast(firstPara->GetChild(0), wxRichTextPlainText);
+
+            if (newText && !newText->IsEmpty())
+            {
+                // Find the objects before and after the insertion point.
+                wxRichTextPlainText* textBefore = nullptr;
+                wxRichTextPlainText* textAfter = nullptr;
+                for (wxRichTextObjectList::compatibility_iterator childNode = para->GetChildren().GetFirst(); childNode; childNode = childNode->GetNext())
+                {
+                    wxRichTextObject* child = childNode->GetData();
+                    if (child->GetRange().Contains(position - 1))
+                        textBefore = wxDynamicCast(child, wxRichTextPlainText);
+                    if (child->GetRange().Contains(position))
+                    {
+                        textAfter = wxDynamicCast(child, wxRichTextPlainText);
+                        break;
+                    }
+                }
+
+                wxRichTextDrawingContext context(GetBuffer());
+                const auto canInsertInto = [newText, &context](wxRichTextPlainText* textObj)
+                {
+                    return textObj && !textObj->IsEmpty() &&
+                            textObj->CanMerge(newText, context) && newText->CanMerge(textObj, context);
+                };
+
+                if (canInsertInto(textBefore))
+                    return textBefore->InsertText(position, newText->GetText());
+                if (canInsertInto(textAfter))
+                    return textAfter->InsertText(position, newText->GetText());
+            }
+        }
+
         wxRichTextObjectList::compatibility_iterator node = m_children.Find(para);
 
         // Now split at this position, returning the object to insert the new
@@ -6777,13 +7027,79 @@ wxRichTextRange wxRichTextLine::GetAbsoluteRange() const
 
 wxIMPLEMENT_DYNAMIC_CLASS(wxRichTextPlainText, wxRichTextObject);
 
+// The text of wxRichTextPlainText is shared between the object and its copies,
+// such as the ones stored by the undo actions or created when copying the
+// fragments of the buffer, and only copied when one of them is modified.
+//
+// Notice that AllocExclusive() is not used for this, as it would copy the old
+// text only to overwrite it, see SetText() and DoReplaceText().
+class wxRichTextPlainTextData: public wxObjectRefData
+{
+public:
+    explicit wxRichTextPlainTextData(const wxString& text = wxString()) : m_text(text) {}
+
+    wxString    m_text;
+};
+
+#define M_TEXTDATA static_cast<wxRichTextPlainTextData*>(m_refData)
+
 wxRichTextPlainText::wxRichTextPlainText(const wxString& text, wxRichTextObject* parent, wxRichTextAttr* style):
     wxRichTextObject(parent)
 {
     if (style)
         SetAttributes(*style);
 
-    m_text = text;
+    m_refData = new wxRichTextPlainTextData(text);
+}
+
+const wxString& wxRichTextPlainText::GetText() const
+{
+    return M_TEXTDATA->m_text;
+}
+
+void wxRichTextPlainText::SetText(const wxString& text)
+{
+    if (m_refData->GetRefCount() > 1)
+    {
+        UnRef();
+        m_refData = new wxRichTextPlainTextData(text);
+    }
+    else
+        M_TEXTDATA->m_text = text;
+}
+
+void wxRichTextPlainText::DoReplaceText(size_t start, size_t len, const wxString& text)
+{
+    if (m_refData->GetRefCount() > 1)
+    {
+        const wxString& oldText = GetText();
+
+        wxString newText;
+        newText.reserve(oldText.length() - len + text.length());
+        newText.append(oldText, 0, start);
+        newText += text;
+        newText.append(oldText, start + len, wxString::npos);
+
+        UnRef();
+        m_refData = new wxRichTextPlainTextData;
+        M_TEXTDATA->m_text.swap(newText);
+    }
+    else
+        M_TEXTDATA->m_text.replace(start, len, text);
+}
+
+bool wxRichTextPlainText::InsertText(long pos, const wxString& text)
+{
+    long index = pos - GetRange().GetStart();
+
+    if (index < 0 || index > (long) GetText().length())
+        return false;
+
+    DoReplaceText(index, 0, text);
+
+    GetRange().SetEnd(GetRange().GetEnd() + text.length());
+
+    return true;
 }
 
 #define USE_KERNING_FIX 1
@@ -6828,10 +7144,10 @@ bool wxRichTextPlainText::Draw(wxDC& dc, wxRichTextDrawingContext& context, cons
     // In case of partial selection we need to preprocess stringWhole too.
     if (allSelected || noneSelected)
     {
-        const wxString* pWholeString = &m_text;
+        const wxString* pWholeString = &GetText();
         if (context.HasVirtualText(this))
         {
-            if (context.GetVirtualText(this, stringWhole) && stringWhole.length() == m_text.length())
+            if (context.GetVirtualText(this, stringWhole) && stringWhole.length() == GetText().length())
                 pWholeString = &stringWhole;
         }
 
@@ -6849,11 +7165,11 @@ bool wxRichTextPlainText::Draw(wxDC& dc, wxRichTextDrawingContext& context, cons
     }
     else
     {
-        stringWhole = m_text;
+        stringWhole = GetText();
         if (context.HasVirtualText(this))
         {
-            if (!context.GetVirtualText(this, stringWhole) || stringWhole.length() != m_text.length())
-                stringWhole = m_text;
+            if (!context.GetVirtualText(this, stringWhole) || stringWhole.length() != GetText().length())
+                stringWhole = GetText();
         }
 
         // Replace line break characters with spaces
@@ -7198,7 +7514,7 @@ void wxRichTextPlainText::Copy(const wxRichTextPlainText& obj)
 {
     wxRichTextObject::Copy(obj);
 
-    m_text = obj.m_text;
+    Ref(obj);
 }
 
 /// Get/set the object size for the given range. Returns false if the range
@@ -7261,10 +7577,10 @@ bool wxRichTextPlainText::GetRangeSize(const wxRichTextRange& range, wxSize& siz
     {
         // We don't need stringWhole. Only prepare stringChunk.
         wxString stringWhole;
-        const wxString* pWholeString = &m_text;
+        const wxString* pWholeString = &GetText();
         if (context.HasVirtualText(this))
         {
-            if (context.GetVirtualText(this, stringWhole) && stringWhole.length() == m_text.length())
+            if (context.GetVirtualText(this, stringWhole) && stringWhole.length() == GetText().length())
                 pWholeString = &stringWhole;
         }
 
@@ -7419,13 +7735,12 @@ wxRichTextObject* wxRichTextPlainText::DoSplit(long pos)
 {
     long index = pos - GetRange().GetStart();
 
-    if (index < 0 || index >= (int) m_text.length())
+    if (index < 0 || index >= (int) GetText().length())
         return nullptr;
 
-    wxString firstPart = m_text.Mid(0, index);
-    wxString secondPart = m_text.Mid(index);
+    wxString secondPart = GetText().substr(index);
 
-    m_text = firstPart;
+    DoReplaceText(index, secondPart.length(), wxString());
 
     wxRichTextPlainText* newObject = new wxRichTextPlainText(secondPart);
     newObject->SetAttributes(GetAttributes());
@@ -7440,7 +7755,7 @@ wxRichTextObject* wxRichTextPlainText::DoSplit(long pos)
 /// Calculate range
 void wxRichTextPlainText::CalculateRange(long start, long& end)
 {
-    end = start + m_text.length() - 1;
+    end = start + GetText().length() - 1;
     m_range.SetRange(start, end);
 }
 
@@ -7453,14 +7768,14 @@ bool wxRichTextPlainText::DeleteRange(const wxRichTextRange& range)
 
     if (r.GetStart() == GetRange().GetStart() && r.GetEnd() == GetRange().GetEnd())
     {
-        m_text.Empty();
+        SetText(wxString());
         return true;
     }
 
     long startIndex = r.GetStart() - GetRange().GetStart();
     long len = r.GetLength();
 
-    m_text = m_text.Mid(0, startIndex) + m_text.Mid(startIndex+len);
+    DoReplaceText(startIndex, len, wxString());
     return true;
 }
 
@@ -7474,7 +7789,7 @@ wxString wxRichTextPlainText::GetTextForRange(const wxRichTextRange& range) cons
     long startIndex = r.GetStart() - GetRange().GetStart();
     long len = r.GetLength();
 
-    return m_text.Mid(startIndex, len);
+    return GetText().Mid(startIndex, len);
 }
 
 /// Returns true if this object can merge itself with the given one.
@@ -7484,12 +7799,12 @@ bool wxRichTextPlainText::CanMerge(wxRichTextObject* object, wxRichTextDrawingCo
     if (!context.GetVirtualAttributesEnabled())
     {
         return object->GetClassInfo() == wxCLASSINFO(wxRichTextPlainText) &&
-            (m_text.empty() || (wxTextAttrEq(GetAttributes(), object->GetAttributes()) && m_properties == object->GetProperties()));
+            (GetText().empty() || (wxTextAttrEq(GetAttributes(), object->GetAttributes()) && m_properties == object->GetProperties()));
     }
     else
     {
         wxRichTextPlainText* otherObj = wxDynamicCast(object, wxRichTextPlainText);
-        if (!otherObj || m_text.empty())
+        if (!otherObj || GetText().empty())
             return false;
 
         if (!wxTextAttrEq(GetAttributes(), object->GetAttributes()) || !(m_properties == object->GetProperties()))
@@ -7522,7 +7837,7 @@ bool wxRichTextPlainText::Merge(wxRichTextObject* object, wxRichTextDrawingConte
 
     if (textObject)
     {
-        m_text += textObject->GetText();
+        DoReplaceText(GetText().length(), 0, textObject->GetText());
         wxRichTextApplyStyle(m_attributes, textObject->GetAttributes());
         return true;
     }
@@ -7535,7 +7850,7 @@ bool wxRichTextPlainText::CanSplit(wxRichTextDrawingContext& context) const
     // If this object has any virtual attributes at all, whether for the whole object
     // or individual ones, we should try splitting it by calling Split.
     // Must be more than one character in order to be able to split.
-    return m_text.length() > 1 && context.HasVirtualAttributes(const_cast<wxRichTextPlainText*>(this));
+    return GetText().length() > 1 && context.HasVirtualAttributes(const_cast<wxRichTextPlainText*>(this));
 }
 
 wxRichTextObject* wxRichTextPlainText::Split(wxRichTextDrawingContext& context)
@@ -7558,7 +7873,7 @@ wxRichTextObject* wxRichTextPlainText::Split(wxRichTextDrawingContext& context)
 
                 // We will gather up runs of text with the same virtual attributes
 
-                int len = m_text.length();
+                int len = GetText().length();
                 int i = 0;
 
                 // runStart and runEnd represent the accumulated run with a consistent attribute
@@ -7566,7 +7881,7 @@ wxRichTextObject* wxRichTextPlainText::Split(wxRichTextDrawingContext& context)
                 int runStart = -1;
                 int runEnd = -1;
                 wxRichTextAttr currentAttr;
-                wxString text = m_text;
+                wxString text = GetText();
                 wxRichTextPlainText* lastPlainText = this;
 
                 for (i = 0; i < (int) positions.GetCount(); i++)
@@ -7742,18 +8057,18 @@ wxRichTextObject* wxRichTextPlainText::Split(wxRichTextDrawingContext& context)
 void wxRichTextPlainText::Dump(wxTextOutputStream& stream)
 {
     wxRichTextObject::Dump(stream);
-    stream << m_text << wxT("\n");
+    stream << GetText() << wxT("\n");
 }
 
 /// Get the first position from pos that has a line break character.
 long wxRichTextPlainText::GetFirstLineBreakPosition(long pos)
 {
     int i;
-    int len = m_text.length();
+    int len = GetText().length();
     int startPos = pos - m_range.GetStart();
     for (i = startPos; i < len; i++)
     {
-        wxUniChar ch = m_text[i];
+        wxUniChar ch = GetText()[i];
         if (ch == wxRichTextLineBreakChar)
         {
             return i + m_range.GetStart();
@@ -374,6 +374,7 @@ void wxRichTextCtrl::Init()
     m_fullLayoutTime = 0;
     m_fullLayoutSavedPosition = 0;
     m_delayedLayoutThreshold = wxRICHTEXT_DEFAULT_DELAYED_LAYOUT_THRESHOLD;
+    m_lazyLayout = false;
     m_caretPositionForDefaultStyle = -2;
     m_focusObject = & m_buffer;
     m_scale = 1.0;
@@ -463,14 +464,17 @@ void wxRichTextCtrl::OnPaint(wxPaintEvent& WXUNUSED(event))
 
         wxRect availableSpace(GetUnscaledSize(GetClientSize()));
         wxRichTextDrawingContext context(& GetBuffer());
-        if (GetBuffer().IsDirty())
+        const int lazyLayoutLimit = GetLazyLayoutLimit();
+        if (GetBuffer().IsDirty() || NeedsPendingLayout(lazyLayoutLimit))
         {
             dc.SetUserScale(GetScale(), GetScale());
 
             GetBuffer().Defragment(context);
             GetBuffer().UpdateRanges();     // If items were deleted, ranges need recalculation
 
+            GetBuffer().SetLazyLayoutLimit(lazyLayoutLimit);
             DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT);
+            GetBuffer().SetLazyLayoutLimit(-1);
 
             GetBuffer().Invalidate(wxRICHTEXT_NONE);
 
@@ -1805,6 +1809,19 @@ bool wxRichTextCtrl::ScrollIntoView(long position, int keyCode)
     if (!m_verticalScrollbarEnabled)
         return false;
 
+    // When using lazy layout, the paragraph containing this position may not
+    // have been laid out yet, so continue laying out until it is.
+    while (GetBuffer().HasPendingLayout())
+    {
+        wxRichTextParagraph* para = GetFocusObject()->GetParagraphAtPosition(position, true);
+        if (!para || !para->GetLines().empty())
+            break;
+
+        const int pageHeight = GetUnscaledSize(GetClientSize()).y;
+        DoLayoutContent(false, GetBuffer().GetPendingLayoutPosition() +
+                                wxRICHTEXT_DEFAULT_LAZY_LAYOUT_PAGES*pageHeight);
+    }
+
     wxRichTextLine* line = GetVisibleLineForCaretPosition(position);
 
     if (!line)
@@ -2839,6 +2856,13 @@ void wxRichTextCtrl::ForceDelayedLayout()
         Refresh(false);
         Update();
     }
+
+    // Also finish lazy layout, if any.
+    if (GetBuffer().HasPendingLayout())
+    {
+        DoLayoutContent(false, -1);
+        Refresh(false);
+    }
 }
 
 /// Idle-time processing
@@ -2864,6 +2888,21 @@ void wxRichTextCtrl::OnIdle(wxIdleEvent& event)
         ShowPosition(m_fullLayoutSavedPosition);
         Refresh(false);
     }
+    else if (GetBuffer().HasPendingLayout() && !IsFrozen())
+    {
+        // Continue lazy layout by laying out a few more pages at a time.
+        const int pageHeight = GetUnscaledSize(GetClientSize()).y;
+        const int pendingPosition = GetBuffer().GetPendingLayoutPosition();
+
+        DoLayoutContent(false, m_lazyLayout ? pendingPosition + wxRICHTEXT_DEFAULT_LAZY_LAYOUT_PAGES*pageHeight : -1);
+
+        // Only refresh if the paragraphs which were not laid out were visible.
+        if (pendingPosition < GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))).y + pageHeight)
+            Refresh(false);
+
+        if (GetBuffer().HasPendingLayout())
+            event.RequestMore();
+    }
 
     const int imageProcessingInterval = wxRICHTEXT_DEFAULT_DELAYED_IMAGE_PROCESSING_INTERVAL;
 
@@ -4256,42 +4295,67 @@ bool wxRichTextCtrl::MoveCaret(long pos, bool showAtLineStart, wxRichTextParagra
 /// setting the caret position.
 bool wxRichTextCtrl::LayoutContent(bool onlyVisibleRect)
 {
-    if (GetBuffer().IsDirty() || onlyVisibleRect)
-    {
-        wxRect availableSpace(GetUnscaledSize(GetClientSize()));
-        if (availableSpace.width == 0)
-            availableSpace.width = 10;
-        if (availableSpace.height == 0)
-            availableSpace.height = 10;
+    const int lazyLayoutLimit = onlyVisibleRect ? -1 : GetLazyLayoutLimit();
 
-        int flags = wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT;
-        if (onlyVisibleRect)
-        {
-            flags |= wxRICHTEXT_LAYOUT_SPECIFIED_RECT;
-            availableSpace.SetPosition(GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))));
-        }
+    if (GetBuffer().IsDirty() || onlyVisibleRect || NeedsPendingLayout(lazyLayoutLimit))
+        DoLayoutContent(onlyVisibleRect, lazyLayoutLimit);
 
-        wxInfoDC dc(this);
+    return true;
+}
 
-        PrepareDC(dc);
-        dc.SetUserScale(GetScale(), GetScale());
+bool wxRichTextCtrl::NeedsPendingLayout(int lazyLayoutLimit) const
+{
+    // When using lazy layout, only lay out the paragraphs which were not laid
+    // out before when they get close to the visible area.
+    return GetBuffer().HasPendingLayout() &&
+            (lazyLayoutLimit == -1 || GetBuffer().GetPendingLayoutPosition() <= lazyLayoutLimit);
+}
 
-        wxRichTextDrawingContext context(& GetBuffer());
-        GetBuffer().Defragment(context);
-        GetBuffer().UpdateRanges();     // If items were deleted, ranges need recalculation
-        DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, flags);
-        GetBuffer().Invalidate(wxRICHTEXT_NONE);
+int wxRichTextCtrl::GetLazyLayoutLimit() const
+{
+    if (!m_lazyLayout)
+        return -1;
 
-        dc.SetUserScale(1.0, 1.0);
+    // Lay out everything up to one page below the visible area.
+    const int pageHeight = GetUnscaledSize(GetClientSize()).y;
+    return GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))).y + 2*pageHeight;
+}
 
-        if (!IsFrozen() && !onlyVisibleRect)
-            SetupScrollbars();
+void wxRichTextCtrl::DoLayoutContent(bool onlyVisibleRect, int lazyLayoutLimit)
+{
+    wxRect availableSpace(GetUnscaledSize(GetClientSize()));
+    if (availableSpace.width == 0)
+        availableSpace.width = 10;
+    if (availableSpace.height == 0)
+        availableSpace.height = 10;
 
-        if (GetDelayedImageLoading())
-            RequestDelayedImageProcessing();
+    int flags = wxRICHTEXT_FIXED_WIDTH|wxRICHTEXT_VARIABLE_HEIGHT;
+    if (onlyVisibleRect)
+    {
+        flags |= wxRICHTEXT_LAYOUT_SPECIFIED_RECT;
+        availableSpace.SetPosition(GetUnscaledPoint(GetLogicalPoint(wxPoint(0, 0))));
     }
 
-    return true;
+    wxInfoDC dc(this);
+
+    PrepareDC(dc);
+    dc.SetUserScale(GetScale(), GetScale());
+
+    wxRichTextDrawingContext context(& GetBuffer());
+    GetBuffer().Defragment(context);
+    GetBuffer().UpdateRanges();     // If items were deleted, ranges need recalculation
+    GetBuffer().SetLazyLayoutLimit(lazyLayoutLimit);
+    DoLayoutBuffer(GetBuffer(), dc, context, availableSpace, availableSpace, flags);
+    GetBuffer().SetLazyLayoutLimit(-1);
+    GetBuffer().Invalidate(wxRICHTEXT_NONE);
+
+    dc.SetUserScale(1.0, 1.0);
+
+    if (!IsFrozen() && !onlyVisibleRect)
+        SetupScrollbars();
+
+    if (GetDelayedImageLoading())
+        RequestDelayedImageProcessing();
 }
 
 void wxRichTextCtrl::DoLayoutBuffer(wxRichTextBuffer& buffer, wxReadOnlyDC& dc, wxRichTextDrawingContext& context, const wxRect& rect, const wxRect& parentRect, int flags)
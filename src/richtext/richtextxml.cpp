@@ -27,10 +27,12 @@
 #include "wx/sstream.h"
 #include "wx/txtstrm.h"
 #include "wx/mstream.h"
+#include "wx/stream.h"
 #include "wx/tokenzr.h"
 #include "wx/stopwatch.h"
 #include "wx/xml/xml.h"
 
+#include <string>
 #include <unordered_map>
 
 // Set to 1 for slower wxXmlDocument method, 0 for faster direct method.
@@ -56,6 +58,71 @@ namespace
 
 std::unordered_map<wxString, wxString> gs_nodeNameToClassMap;
 
+#if wxUSE_STREAMS
+
+// Imports the objects into the buffer as soon as they are parsed, so that only
+// the XML tree of the object being currently parsed needs to be kept in memory
+// instead of the tree for the entire document.
+class wxRichTextXMLParseHandler : public wxXmlParseHandler
+{
+public:
+    wxRichTextXMLParseHandler(wxRichTextXMLHandler& handler, wxRichTextBuffer* buffer)
+        : m_handler(handler),
+          m_buffer(buffer)
+    {
+    }
+
+    virtual bool OnElementEnd(wxXmlNode* node) override
+    {
+        wxXmlNode* const parent = node->GetParent();
+        if (IsRoot(parent))
+        {
+            // This is the stylesheet or the top level paragraph layout, whose
+            // objects have been already imported below, if any.
+            if (node->GetName() != wxT("richtext-version"))
+                m_handler.ImportXML(m_buffer, m_buffer, node);
+
+            return true;
+        }
+
+        if (IsRoot(parent->GetParent()) &&
+                parent->GetName() != wxT("stylesheet") &&
+                    node->GetName() != wxT("stylesheet"))
+        {
+            // This is an object inside the top level paragraph layout, e.g. a
+            // paragraph: import it directly into the buffer, as ImportXML()
+            // would do for the paragraph layout later otherwise.
+            wxRichTextObject* obj = m_handler.CreateObjectForXMLName(m_buffer, node->GetName());
+            if (!obj)
+                return false;
+
+            m_buffer->AppendChild(obj);
+            m_handler.ImportXML(m_buffer, obj, node);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Return true if this is the root "richtext" element.
+    static bool IsRoot(const wxXmlNode* node)
+    {
+        return node && node->GetType() == wxXML_ELEMENT_NODE &&
+                node->GetName() == wxT("richtext") &&
+                    node->GetParent() &&
+                        node->GetParent()->GetType() == wxXML_DOCUMENT_NODE;
+    }
+
+private:
+    wxRichTextXMLHandler& m_handler;
+    wxRichTextBuffer* const m_buffer;
+
+    wxDECLARE_NO_COPY_CLASS(wxRichTextXMLParseHandler);
+};
+
+#endif // wxUSE_STREAMS
+
 } // anonymous namespace
 
 void wxRichTextXMLHandler::Init()
@@ -73,42 +140,20 @@ bool wxRichTextXMLHandler::DoLoadFile(wxRichTextBuffer *buffer, wxInputStream& s
     buffer->ResetAndClearCommands();
     buffer->Clear();
 
-    wxXmlDocument* xmlDoc = new wxXmlDocument;
-    bool success = true;
+    // The objects are imported while parsing the document and removed from it
+    // immediately, so only the root element remains in it after loading.
+    wxRichTextXMLParseHandler parseHandler(*this, buffer);
+    wxXmlDocument xmlDoc;
 
-    if (!xmlDoc->Load(stream))
+    bool success = xmlDoc.Load(stream, parseHandler) &&
+                    wxRichTextXMLParseHandler::IsRoot(xmlDoc.GetRoot());
+    if (!success)
     {
+        // Don't keep the partially loaded contents.
         buffer->ResetAndClearCommands();
-        success = false;
-    }
-    else
-    {
-        if (xmlDoc->GetRoot() && xmlDoc->GetRoot()->GetType() == wxXML_ELEMENT_NODE && xmlDoc->GetRoot()->GetName() == wxT("richtext"))
-        {
-            wxXmlNode* child = xmlDoc->GetRoot()->GetChildren();
-            while (child)
-            {
-                if (child->GetType() == wxXML_ELEMENT_NODE)
-                {
-                    wxString name = child->GetName();
-                    if (name == wxT("richtext-version"))
-                    {
-                    }
-                    else
-                        ImportXML(buffer, buffer, child);
-                }
-
-                child = child->GetNext();
-            }
-        }
-        else
-        {
-            success = false;
-        }
+        buffer->Clear();
     }
 
-    delete xmlDoc;
-
     buffer->UpdateRanges();
 
     return success;
@@ -253,61 +298,68 @@ bool wxRichTextXMLHandler::DoSaveFile(wxRichTextBuffer *buffer, wxOutputStream&
 #else
     // !(wxRICHTEXT_HAVE_XMLDOCUMENT_OUTPUT && wxRICHTEXT_USE_XMLDOCUMENT_OUTPUT)
 
+    // Many short strings are written below, so accumulate them in a buffer
+    // instead of writing each of them to the stream separately.
+    wxBufferedOutputStream out(stream, 65536);
+
     wxString s ;
     s.Printf(wxT("<?xml version=\"%s\" encoding=\"%s\"?>\n"),
              version.c_str(), fileEncoding.c_str());
-    m_helper.OutputString(stream, s);
-    m_helper.OutputString(stream, wxT("<richtext version=\"1.0.0.0\" xmlns=\"http://www.wxwidgets.org\">"));
+    m_helper.OutputString(out, s);
+    m_helper.OutputString(out, wxT("<richtext version=\"1.0.0.0\" xmlns=\"http://www.wxwidgets.org\">"));
 
     int level = 1;
 
     if (buffer->GetStyleSheet() && (GetFlags() & wxRICHTEXT_HANDLER_INCLUDE_STYLESHEET))
     {
-        m_helper.OutputIndentation(stream, level);
+        m_helper.OutputIndentation(out, level);
         wxString nameAndDescr;
         if (!buffer->GetStyleSheet()->GetName().empty())
             nameAndDescr << wxT(" name=\"") << buffer->GetStyleSheet()->GetName() << wxT("\"");
         if (!buffer->GetStyleSheet()->GetDescription().empty())
             nameAndDescr << wxT(" description=\"") << buffer->GetStyleSheet()->GetDescription() << wxT("\"");
-        m_helper.OutputString(stream, wxString(wxT("<stylesheet")) + nameAndDescr + wxT(">"));
+        m_helper.OutputString(out, wxString(wxT("<stylesheet")) + nameAndDescr + wxT(">"));
 
         int i;
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetCharacterStyleCount(); i++)
         {
             wxRichTextCharacterStyleDefinition* def = buffer->GetStyleSheet()->GetCharacterStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(out, def, level + 1);
         }
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetParagraphStyleCount(); i++)
         {
             wxRichTextParagraphStyleDefinition* def = buffer->GetStyleSheet()->GetParagraphStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(out, def, level + 1);
         }
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetListStyleCount(); i++)
         {
             wxRichTextListStyleDefinition* def = buffer->GetStyleSheet()->GetListStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(out, def, level + 1);
         }
 
         for (i = 0; i < (int) buffer->GetStyleSheet()->GetBoxStyleCount(); i++)
         {
             wxRichTextBoxStyleDefinition* def = buffer->GetStyleSheet()->GetBoxStyle(i);
-            m_helper.ExportStyleDefinition(stream, def, level + 1);
+            m_helper.ExportStyleDefinition(out, def, level + 1);
         }
 
-        m_helper.WriteProperties(stream, buffer->GetStyleSheet()->GetProperties(), level);
+        m_helper.WriteProperties(out, buffer->GetStyleSheet()->GetProperties(), level);
 
-        m_helper.OutputIndentation(stream, level);
-        m_helper.OutputString(stream, wxT("</stylesheet>"));
+        m_helper.OutputIndentation(out, level);
+        m_helper.OutputString(out, wxT("</stylesheet>"));
     }
 
 
-    bool success = ExportXML(stream, *buffer, level);
+    bool success = ExportXML(out, *buffer, level);
+
+    m_helper.OutputString(out, wxT("\n</richtext>"));
+    m_helper.OutputString(out, wxT("\n"));
 
-    m_helper.OutputString(stream, wxT("\n</richtext>"));
-    m_helper.OutputString(stream, wxT("\n"));
+    if (!out.Close())
+        success = false;
 #endif
 
     return success;
@@ -1892,24 +1944,16 @@ void wxRichTextXMLHelper::OutputString(wxOutputStream& stream, const wxString& s
                                 wxMBConv *WXUNUSED(convMem), wxMBConv *convFile)
 {
     if (str.empty()) return;
-    if (convFile)
-    {
-        const wxWX2MBbuf buf(str.mb_str(*convFile));
-        stream.Write((const char*)buf, strlen((const char*)buf));
-    }
-    else
-    {
-        const wxWX2MBbuf buf(str.mb_str(wxConvUTF8));
-        stream.Write((const char*)buf, strlen((const char*)buf));
-    }
+
+    const wxWX2MBbuf buf(str.mb_str(convFile ? *convFile : wxConvUTF8));
+    stream.Write(buf.data(), buf.length());
 }
 
 void wxRichTextXMLHelper::OutputIndentation(wxOutputStream& stream, int indent)
 {
-    wxString str = wxT("\n");
-    for (int i = 0; i < indent; i++)
-        str << wxT(' ') << wxT(' ');
-    OutputString(stream, str, nullptr, nullptr);
+    // The indentation is always ASCII, so it doesn't need to be converted.
+    const std::string str = '\n' + std::string(2*indent, ' ');
+    stream.Write(str.data(), str.length());
 }
 
 // Same as above, but create entities first.
@@ -1917,53 +1961,44 @@ void wxRichTextXMLHelper::OutputIndentation(wxOutputStream& stream, int indent)
 void wxRichTextXMLHelper::OutputStringEnt(wxOutputStream& stream, const wxString& str,
                             wxMBConv *convMem, wxMBConv *convFile)
 {
-    size_t i, last, len;
-    wxChar c;
+    // Build the entire string first instead of outputting each fragment and
+    // entity separately: all of them are ASCII, so converting them together
+    // with the rest of the string gives the same result.
+    wxString out;
+    out.reserve(str.length());
 
-    len = str.Len();
-    last = 0;
-    for (i = 0; i < len; i++)
+    for (wxString::const_iterator i = str.begin(); i != str.end(); ++i)
     {
-        c = str.GetChar(i);
+        const wxChar c = *i;
 
         // Original code excluded "&amp;" but we _do_ want to convert
         // the ampersand beginning &amp; because otherwise when read in,
         // the original "&amp;" becomes "&".
 
-        if (c == wxT('<') || c == wxT('>') || c == wxT('"') ||
-            (c == wxT('&') /* && (str.Mid(i+1, 4) != wxT("amp;")) */ ))
-        {
-            OutputString(stream, str.Mid(last, i - last), convMem, convFile);
-            switch (c)
-            {
-            case wxT('<'):
-                OutputString(stream, wxT("&lt;"), nullptr, nullptr);
-                break;
-            case wxT('>'):
-                OutputString(stream, wxT("&gt;"), nullptr, nullptr);
-                break;
-            case wxT('&'):
-                OutputString(stream, wxT("&amp;"), nullptr, nullptr);
-                break;
-            case wxT('"'):
-                OutputString(stream, wxT("&quot;"), nullptr, nullptr);
-                break;
-            default: break;
-            }
-            last = i + 1;
-        }
-        else if (wxUChar(c) > 127)
-        {
-            OutputString(stream, str.Mid(last, i - last), convMem, convFile);
-
-            wxString s(wxT("&#"));
-            s << (int) c;
-            s << wxT(";");
-            OutputString(stream, s, nullptr, nullptr);
-            last = i + 1;
+        switch (c)
+        {
+        case wxT('<'):
+            out += wxT("&lt;");
+            break;
+        case wxT('>'):
+            out += wxT("&gt;");
+            break;
+        case wxT('&'):
+            out += wxT("&amp;");
+            break;
+        case wxT('"'):
+            out += wxT("&quot;");
+            break;
+        default:
+            if (wxUChar(c) > 127)
+                out << wxT("&#") << (int) c << wxT(';');
+            else
+                out += c;
+            break;
         }
     }
-    OutputString(stream, str.Mid(last, i - last), convMem, convFile);
+
+    OutputString(stream, out, convMem, convFile);
 }
 
 void wxRichTextXMLHelper::OutputString(wxOutputStream& stream, const wxString& str)
@@ -41,8 +41,11 @@
 #include "wx/graphics.h"
 #endif
 
+#include <algorithm>
 #include <memory>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "PlatWX.h"
 #include "wx/stc/stc.h"
@@ -95,6 +98,73 @@ namespace Scintilla
 
 inline wxWindow* GETWIN(WindowID id) { return (wxWindow*)id; }
 
+// Cache of the character positions of the text runs measured with the given
+// font by SurfaceImpl::MeasureWidths().
+//
+// Scintilla has its own cache of the measured line segments, but it is small
+// and doesn't help when scrolling through a long document, where the same
+// short runs, such as keywords, identifiers or indentation, are measured over
+// and over again in different lines.
+class MeasuredRunsCache
+{
+public:
+    MeasuredRunsCache() : m_scale(0) { }
+
+    // Copy the positions of the characters of the given run to the provided
+    // array and return true if the run is in the cache.
+    bool Get(const char* s, int len, double scale, XYPOSITION* positions)
+    {
+        // The results depend on the DC used for measuring, so forget all of
+        // them if it changes.
+        if ( scale != m_scale )
+        {
+            m_runs.clear();
+            m_scale = scale;
+            return false;
+        }
+
+        if ( len > MAX_RUN_LENGTH )
+            return false;
+
+        // Reuse the same string for the lookups to avoid allocating memory.
+        m_key.assign(s, len);
+
+        const auto it = m_runs.find(m_key);
+        if ( it == m_runs.end() )
+            return false;
+
+        std::copy(it->second.begin(), it->second.end(), positions);
+        return true;
+    }
+
+    void Add(const char* s, int len, const XYPOSITION* positions)
+    {
+        if ( len > MAX_RUN_LENGTH )
+            return;
+
+        // Don't bother with discarding the least recently used runs, just
+        // start from scratch when the cache becomes full.
+        if ( m_runs.size() >= MAX_RUNS )
+            m_runs.clear();
+
+        m_runs.emplace(std::string(s, len),
+                       std::vector<XYPOSITION>(positions, positions + len));
+    }
+
+private:
+    // The longest run cached, longer runs are unlikely to be repeated.
+    static const int MAX_RUN_LENGTH = 256;
+
+    // Maximal number of the cached runs.
+    static const size_t MAX_RUNS = 4096;
+
+    std::unordered_map<std::string, std::vector<XYPOSITION>> m_runs;
+    std::string m_key;
+    double m_scale;
+
+    wxDECLARE_NO_COPY_CLASS(MeasuredRunsCache);
+};
+
 // wxFont with ascent cached, a pointer to this type is stored in Font::fid.
 class wxFontWithAscent : public wxFont
 {
@@ -122,9 +192,12 @@ public:
     SurfaceData* GetSurfaceFontData() const { return m_surfaceFontData; }
     void SetSurfaceFontData(SurfaceData* data) { m_surfaceFontData=data; }
 
+    MeasuredRunsCache& GetMeasuredRunsCache() { return m_measuredRuns; }
+
 private:
     int m_ascent;
     SurfaceData* m_surfaceFontData;
+    MeasuredRunsCache m_measuredRuns;
 };
 
 void SetAscent(Font& f, int ascent)
@@ -663,6 +736,13 @@ void SurfaceImpl::DrawTextTransparent(PRectangle rc, Font &font, XYPOSITION ybas
 
 void SurfaceImpl::MeasureWidths(Font &font, const char *s, int len, XYPOSITION *positions) {
 
+    MeasuredRunsCache&
+        cache = wxFontWithAscent::FromFID(font.GetID())->GetMeasuredRunsCache();
+
+    const double scale = hdc->GetContentScaleFactor();
+    if (cache.Get(s, len, scale, positions))
+        return;
+
     wxString   str = stc2wx(s, len);
     wxArrayInt tpos;
 
@@ -670,32 +750,38 @@ void SurfaceImpl::MeasureWidths(Font &font, const char *s, int len, XYPOSITION *
 
     hdc->GetPartialTextExtents(str, tpos);
 
-    // Map the widths back to the UTF-8 input string
-    size_t utf8i = 0;
-    for (size_t wxi = 0; wxi < str.size(); ++wxi) {
-        wxUniChar c = str[wxi];
+    // Map the widths back to the UTF-8 input string: all bytes of a character
+    // get the position of its end. Use the UTF-8 lead bytes to find the length
+    // of each character instead of examining the converted string.
+    const size_t count = tpos.size();
+    size_t wxi = 0;
+    int utf8i = 0;
+    while (utf8i < len && wxi < count) {
+        const unsigned char lead = static_cast<unsigned char>(s[utf8i]);
+        const int bytes = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 1;
 
 #if SIZEOF_WCHAR_T == 2
         // For surrogate pairs, the position for the lead surrogate is garbage
         // and we need to use the position of the trail surrogate for all four bytes
-        if (c >= 0xD800 && c < 0xE000 && wxi + 1 < str.size()) {
+        if (bytes == 4 && wxi + 1 < count)
             ++wxi;
-            positions[utf8i++] = tpos[wxi];
-            positions[utf8i++] = tpos[wxi];
-            positions[utf8i++] = tpos[wxi];
-            positions[utf8i++] = tpos[wxi];
-            continue;
-        }
 #endif
 
-        positions[utf8i++] = tpos[wxi];
-        if (c >= 0x80)
-            positions[utf8i++] = tpos[wxi];
-        if (c >= 0x800)
-            positions[utf8i++] = tpos[wxi];
-        if (c >= 0x10000)
-            positions[utf8i++] = tpos[wxi];
+        const XYPOSITION pos = tpos[wxi++];
+        for (const int end = wxMin(utf8i + bytes, len); utf8i < end; ++utf8i)
+            positions[utf8i] = pos;
     }
+
+    // The conversion fails for invalid UTF-8, don't leave the positions
+    // uninitialized nor cache them in this case.
+    if (utf8i < len) {
+        const XYPOSITION last = utf8i ? positions[utf8i - 1] : 0;
+        for (; utf8i < len; ++utf8i)
+            positions[utf8i] = last;
+        return;
+    }
+
+    cache.Add(s, len, positions);
 }
 
 
@@ -79,6 +79,21 @@
     #endif
 #endif
 
+#ifdef __LINUX__
+    #include <linux/futex.h>
+    #include <sys/syscall.h>
+
+    #if defined(SYS_futex) && defined(FUTEX_WAIT_PRIVATE)
+        #define wxHAVE_FUTEX
+    #endif
+#endif
+
+// glibc provides adaptive mutexes spinning for a while before blocking, but we
+// need to be able to set the mutex type to use them, otherwise we emulate them.
+#if defined(__GLIBC__) && defined(__USE_GNU) && defined(HAVE_PTHREAD_MUTEXATTR_T)
+    #define wxHAVE_NATIVE_ADAPTIVE_MUTEX
+#endif
+
 #include <atomic>
 #include <exception>
 
@@ -172,6 +187,190 @@ static wxMutex *gs_mutexGui = nullptr;
 // so instead we maintain a global list of the structs below for the threads
 // we're interested in waiting on
 
+// ----------------------------------------------------------------------------
+// spinning helpers
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Tell the CPU that we're busy waiting.
+inline void CpuRelax()
+{
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#endif
+}
+
+// Return the number of iterations to spin for before blocking when waiting
+// for a lock which is going to be released soon.
+int GetSpinCount()
+{
+    // Spinning is useless when there is only a single CPU, as the thread
+    // holding the lock can't release it while we're spinning. Notice that we
+    // can't use wxThread::GetCPUCount() here as it may log.
+#if defined(_SC_NPROCESSORS_ONLN)
+    static const int s_spinCount = sysconf(_SC_NPROCESSORS_ONLN) > 1 ? 100 : 0;
+#else
+    static const int s_spinCount = 0;
+#endif
+
+    return s_spinCount;
+}
+
+} // anonymous namespace
+
+// ============================================================================
+// wxCriticalSection implementation
+// ============================================================================
+
+#if !defined(__CYGWIN__)
+
+// Under Linux we use futexes for waiting until the lock word changes, but
+// under the other systems we emulate them using a fixed number of condition
+// variables, with the lock words hashed to select the one to use.
+namespace
+{
+
+#ifdef wxHAVE_FUTEX
+
+inline void WaitOnAddress(std::atomic<int>* addr, int expected)
+{
+    syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAIT_PRIVATE,
+            expected, nullptr, nullptr, 0);
+}
+
+inline void WakeOneOnAddress(std::atomic<int>* addr)
+{
+    syscall(SYS_futex, reinterpret_cast<int*>(addr), FUTEX_WAKE_PRIVATE,
+            1, nullptr, nullptr, 0);
+}
+
+#else // !wxHAVE_FUTEX
+
+struct ParkingBucket
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+};
+
+// Use static initialization to avoid any problems with using the critical
+// sections during the static initialization or destruction.
+#define wxPARKING_BUCKET { PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER }
+
+ParkingBucket gs_parkingBuckets[] =
+{
+    wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET,
+    wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET,
+    wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET,
+    wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET, wxPARKING_BUCKET,
+};
+
+#undef wxPARKING_BUCKET
+
+ParkingBucket& GetParkingBucket(std::atomic<int>* addr)
+{
+    const wxUIntPtr n = reinterpret_cast<wxUIntPtr>(addr);
+
+    return gs_parkingBuckets[(n / sizeof(void*)) % WXSIZEOF(gs_parkingBuckets)];
+}
+
+void WaitOnAddress(std::atomic<int>* addr, int expected)
+{
+    ParkingBucket& bucket = GetParkingBucket(addr);
+
+    pthread_mutex_lock(&bucket.mutex);
+
+    // As WakeOneOnAddress() changes the value before locking the bucket, we
+    // can't miss the wake up if we check the value while holding the lock.
+    if ( addr->load(std::memory_order_relaxed) == expected )
+        pthread_cond_wait(&bucket.cond, &bucket.mutex);
+
+    pthread_mutex_unlock(&bucket.mutex);
+}
+
+void WakeOneOnAddress(std::atomic<int>* addr)
+{
+    ParkingBucket& bucket = GetParkingBucket(addr);
+
+    pthread_mutex_lock(&bucket.mutex);
+
+    // Other lock words can share the same bucket, so we have to wake up all
+    // the threads waiting on it, they will just go back to sleep if their
+    // lock word didn't change.
+    pthread_cond_broadcast(&bucket.cond);
+
+    pthread_mutex_unlock(&bucket.mutex);
+}
+
+#endif // wxHAVE_FUTEX/!wxHAVE_FUTEX
+
+} // anonymous namespace
+
+/* static */
+const void* wxCriticalSection::DoGetCurrentThreadTag()
+{
+    // The address of this variable is different for all threads.
+    static thread_local char s_threadTag;
+
+    return &s_threadTag;
+}
+
+bool wxCriticalSection::DoTryEnterContended()
+{
+    // The owner can only be equal to the current thread tag if we had stored
+    // it there, i.e. if we're re-entering the critical section we own.
+    if ( m_recursive &&
+            m_owner.load(std::memory_order_relaxed) == GetCurrentThreadTag() )
+    {
+        m_recursionCount++;
+        return true;
+    }
+
+    return false;
+}
+
+// This is the classic futex-based mutex algorithm, with the only difference
+// being that we spin for a while before blocking.
+void wxCriticalSection::DoEnterContended()
+{
+    if ( DoTryEnterContended() )
+        return;
+
+    for ( int n = GetSpinCount(); n > 0; n-- )
+    {
+        CpuRelax();
+
+        int unlocked = 0;
+        if ( m_state.load(std::memory_order_relaxed) == 0 &&
+                m_state.compare_exchange_weak(unlocked, 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed) )
+        {
+            SetOwner();
+            return;
+        }
+    }
+
+    // Mark the critical section as having waiters and wait until the thread
+    // owning it wakes us up. Notice that if we get it after changing the state
+    // to 2, we will call DoLeaveContended() when leaving it, even if there
+    // are no other waiters, but this is harmless.
+    while ( m_state.exchange(2, std::memory_order_acquire) != 0 )
+        WaitOnAddress(&m_state, 2);
+
+    SetOwner();
+}
+
+void wxCriticalSection::DoLeaveContended()
+{
+    m_state.store(0, std::memory_order_release);
+
+    WakeOneOnAddress(&m_state);
+}
+
+#endif // !__CYGWIN__
+
 // ============================================================================
 // wxMutex implementation
 // ============================================================================
@@ -255,6 +454,25 @@ wxMutexInternal::wxMutexInternal(wxMutexType mutexType)
 #endif // HAVE_PTHREAD_MUTEXATTR_T/...
             break;
 
+        case wxMUTEX_ADAPTIVE:
+            // use the native adaptive mutexes if possible, otherwise we spin
+            // ourselves in Lock()
+#ifdef wxHAVE_NATIVE_ADAPTIVE_MUTEX
+            {
+                pthread_mutexattr_t attr;
+                pthread_mutexattr_init(&attr);
+                pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+
+                err = pthread_mutex_init(&m_mutex, &attr);
+
+                pthread_mutexattr_destroy(&attr);
+            }
+            break;
+#else
+            err = pthread_mutex_init(&m_mutex, nullptr);
+            break;
+#endif
+
         default:
             wxFAIL_MSG( wxT("unknown mutex type") );
             wxFALLTHROUGH;
@@ -285,10 +503,47 @@ wxMutexInternal::~wxMutexInternal()
 
 wxMutexError wxMutexInternal::Lock()
 {
-    if ( m_type == wxMUTEX_DEFAULT && m_owningThread == wxThread::GetCurrentId() )
-           return wxMUTEX_DEAD_LOCK;
+    if ( m_type == wxMUTEX_RECURSIVE )
+        return HandleLockResult(pthread_mutex_lock(&m_mutex));
+
+    const wxThreadIdType self = wxThread::GetCurrentId();
+    if ( m_owningThread == self )
+        return wxMUTEX_DEAD_LOCK;
 
-    return HandleLockResult(pthread_mutex_lock(&m_mutex));
+    int err = EBUSY;
+
+#ifndef wxHAVE_NATIVE_ADAPTIVE_MUTEX
+    if ( m_type == wxMUTEX_ADAPTIVE )
+    {
+        // Emulate adaptive mutexes natively provided by glibc by trying to
+        // lock the mutex a few times before blocking on it.
+        for ( int n = GetSpinCount(); n > 0; n-- )
+        {
+            err = pthread_mutex_trylock(&m_mutex);
+            if ( err != EBUSY )
+                break;
+
+            CpuRelax();
+        }
+
+        if ( err == 0 )
+        {
+            m_owningThread = self;
+            return wxMUTEX_NO_ERROR;
+        }
+    }
+#endif // !wxHAVE_NATIVE_ADAPTIVE_MUTEX
+
+    // Handle the most common case of successful locking without any
+    // additional checks.
+    err = pthread_mutex_lock(&m_mutex);
+    if ( err == 0 )
+    {
+        m_owningThread = self;
+        return wxMUTEX_NO_ERROR;
+    }
+
+    return HandleLockResult(err);
 }
 
 wxMutexError wxMutexInternal::Lock(unsigned long ms)
@@ -361,7 +616,7 @@ wxMutexError wxMutexInternal::HandleLockResult(int err)
             return wxMUTEX_TIMEOUT;
 
         case 0:
-            if (m_type == wxMUTEX_DEFAULT)
+            if (m_type != wxMUTEX_RECURSIVE)
                 m_owningThread = wxThread::GetCurrentId();
             return wxMUTEX_NO_ERROR;
 
@@ -388,7 +643,7 @@ wxMutexError wxMutexInternal::TryLock()
             break;
 
         case 0:
-            if (m_type == wxMUTEX_DEFAULT)
+            if (m_type != wxMUTEX_RECURSIVE)
                 m_owningThread = wxThread::GetCurrentId();
             return wxMUTEX_NO_ERROR;
 
@@ -404,6 +659,9 @@ wxMutexError wxMutexInternal::Unlock()
     m_owningThread = 0;
 
     int err = pthread_mutex_unlock(&m_mutex);
+    if ( err == 0 )
+        return wxMUTEX_NO_ERROR;
+
     switch ( err )
     {
         case EPERM:
@@ -424,6 +682,128 @@ wxMutexError wxMutexInternal::Unlock()
     return wxMUTEX_MISC_ERROR;
 }
 
+// ===========================================================================
+// wxSharedMutex implementation
+// ===========================================================================
+
+// this is a simple wrapper around pthread_rwlock_t
+class wxSharedMutexInternal
+{
+public:
+    wxSharedMutexInternal();
+    ~wxSharedMutexInternal();
+
+    bool IsOk() const { return m_isOk; }
+
+    wxMutexError Lock()
+    {
+        return HandleResult(pthread_rwlock_wrlock(&m_rwlock),
+                            "pthread_rwlock_wrlock()");
+    }
+
+    wxMutexError TryLock()
+    {
+        return HandleResult(pthread_rwlock_trywrlock(&m_rwlock),
+                            "pthread_rwlock_trywrlock()");
+    }
+
+    wxMutexError LockShared()
+    {
+        return HandleResult(pthread_rwlock_rdlock(&m_rwlock),
+                            "pthread_rwlock_rdlock()");
+    }
+
+    wxMutexError TryLockShared()
+    {
+        return HandleResult(pthread_rwlock_tryrdlock(&m_rwlock),
+                            "pthread_rwlock_tryrdlock()");
+    }
+
+    wxMutexError Unlock()
+    {
+        return HandleResult(pthread_rwlock_unlock(&m_rwlock),
+                            "pthread_rwlock_unlock()");
+    }
+
+    // the same function is used for unlocking in both modes
+    wxMutexError UnlockShared() { return Unlock(); }
+
+private:
+    // convert the result of pthread_rwlock_xxx() call to wx return code,
+    // this is inline to make the success path as fast as possible
+    static wxMutexError HandleResult(int err, const char* func)
+    {
+        return err == 0 ? wxMUTEX_NO_ERROR : HandleError(err, func);
+    }
+
+    static wxMutexError HandleError(int err, const char* func);
+
+    pthread_rwlock_t m_rwlock;
+    bool m_isOk;
+
+    wxDECLARE_NO_COPY_CLASS(wxSharedMutexInternal);
+};
+
+wxSharedMutexInternal::wxSharedMutexInternal()
+{
+    int err;
+
+#if defined(__GLIBC__) && defined(__USE_GNU)
+    // By default glibc prefers readers, which can result in the writers
+    // starving if there are many of them, so prefer writers instead.
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+    pthread_rwlockattr_setkind_np(&attr,
+                                  PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+
+    err = pthread_rwlock_init(&m_rwlock, &attr);
+
+    pthread_rwlockattr_destroy(&attr);
+#else // !glibc
+    err = pthread_rwlock_init(&m_rwlock, nullptr);
+#endif // glibc/!glibc
+
+    m_isOk = err == 0;
+    if ( !m_isOk )
+    {
+        wxLogApiError( wxT("pthread_rwlock_init()"), err);
+    }
+}
+
+wxSharedMutexInternal::~wxSharedMutexInternal()
+{
+    if ( m_isOk )
+    {
+        int err = pthread_rwlock_destroy(&m_rwlock);
+        if ( err != 0 )
+        {
+            wxLogApiError( wxT("pthread_rwlock_destroy()"), err);
+        }
+    }
+}
+
+/* static */
+wxMutexError wxSharedMutexInternal::HandleError(int err, const char* func)
+{
+    switch ( err )
+    {
+        case EBUSY:
+            return wxMUTEX_BUSY;
+
+        case EDEADLK:
+            wxFAIL_MSG( wxT("shared mutex deadlock prevented") );
+            return wxMUTEX_DEAD_LOCK;
+
+        case EPERM:
+            return wxMUTEX_UNLOCKED;
+
+        default:
+            wxLogApiError(func, err);
+    }
+
+    return wxMUTEX_MISC_ERROR;
+}
+
 // ===========================================================================
 // wxCondition implementation
 // ===========================================================================
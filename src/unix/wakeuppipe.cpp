@@ -26,6 +26,10 @@
 
 #include <errno.h>
 
+#ifdef HAVE_SYS_EVENTFD_H
+    #include <sys/eventfd.h>
+#endif
+
 // ----------------------------------------------------------------------------
 // constants
 // ----------------------------------------------------------------------------
@@ -41,8 +45,11 @@
 // ----------------------------------------------------------------------------
 
 wxWakeUpPipe::wxWakeUpPipe()
+    : m_eventFD(wxPipe::INVALID_FD),
+      m_signalled(false)
 {
-    m_pipeIsEmpty = true;
+    if ( CreateEventFD() )
+        return;
 
     if ( !m_pipe.Create() )
     {
@@ -61,26 +68,70 @@ wxWakeUpPipe::wxWakeUpPipe()
                m_pipe[wxPipe::Read], m_pipe[wxPipe::Write]);
 }
 
+bool wxWakeUpPipe::CreateEventFD()
+{
+#ifdef HAVE_SYS_EVENTFD_H
+    m_eventFD = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if ( m_eventFD == -1 )
+    {
+        // This is not an error, eventfd() may be just not supported by the
+        // kernel, so just fall back to using the pipe.
+        m_eventFD = wxPipe::INVALID_FD;
+
+        wxLogTrace(TRACE_EVENTS, wxT("eventfd() failed, using wake up pipe"));
+
+        return false;
+    }
+
+    wxLogTrace(TRACE_EVENTS, wxT("Wake up eventfd %d created"), m_eventFD);
+
+    return true;
+#else // !HAVE_SYS_EVENTFD_H
+    return false;
+#endif // HAVE_SYS_EVENTFD_H/!HAVE_SYS_EVENTFD_H
+}
+
+wxWakeUpPipe::~wxWakeUpPipe()
+{
+    if ( m_eventFD != wxPipe::INVALID_FD )
+        close(m_eventFD);
+}
+
 // ----------------------------------------------------------------------------
 // wakeup handling
 // ----------------------------------------------------------------------------
 
 void wxWakeUpPipe::WakeUpNoLock()
 {
-    // No need to do anything if the pipe already contains something.
-    if ( !m_pipeIsEmpty )
-      return;
+    // No need to do anything if the pipe already contains something: this is
+    // the fast path taken when many wake up requests arrive before the main
+    // thread gets to process the first one, so it must not do any system
+    // calls.
+    if ( m_signalled.exchange(true, std::memory_order_acq_rel) )
+        return;
 
-    if ( write(m_pipe[wxPipe::Write], "s", 1) != 1 )
+    bool ok;
+#ifdef HAVE_SYS_EVENTFD_H
+    if ( m_eventFD != wxPipe::INVALID_FD )
     {
-        // don't use wxLog here, we can be in another thread and this could
-        // result in dead locks
-        perror("write(wake up pipe)");
+        const eventfd_t value = 1;
+        ok = write(m_eventFD, &value, sizeof(value)) == sizeof(value);
     }
     else
+#endif // HAVE_SYS_EVENTFD_H
+    {
+        ok = write(m_pipe[wxPipe::Write], "s", 1) == 1;
+    }
+
+    if ( !ok )
     {
-        // We just wrote to it, so it's not empty any more.
-        m_pipeIsEmpty = false;
+        // don't use wxLog here, we can be in another thread and this could
+        // result in dead locks
+        perror("write(wake up pipe)");
+
+        // We didn't manage to wake up the main thread, so allow the next
+        // call to try doing it again.
+        m_signalled.store(false, std::memory_order_release);
     }
 }
 
@@ -89,14 +140,19 @@ void wxWakeUpPipe::OnReadWaiting()
     // got wakeup from child thread, remove the data that provoked it from the
     // pipe
 
-    char buf[4];
+    // Notice that eventfd() requires reading exactly 8 bytes, while for the
+    // pipe we expect to read a single byte, but use a bigger buffer to detect
+    // unexpected writes to it.
+    wxUint64 buf[1];
+    const bool usingEventFD = m_eventFD != wxPipe::INVALID_FD;
     for ( ;; )
     {
-        const int size = read(GetReadFd(), buf, WXSIZEOF(buf));
+        const int size = read(GetReadFd(), buf, usingEventFD ? sizeof(buf) : 4);
 
         if ( size > 0 )
         {
-            wxASSERT_MSG( size == 1, "Too many writes to wake-up pipe?" );
+            wxASSERT_MSG( usingEventFD || size == 1,
+                          "Too many writes to wake-up pipe?" );
 
             break;
         }
@@ -121,5 +177,10 @@ void wxWakeUpPipe::OnReadWaiting()
 
     // The pipe is empty now, so future calls to WakeUp() would need to write
     // to it again.
-    m_pipeIsEmpty = true;
+    //
+    // Note that this must be done only after reading from the pipe: otherwise
+    // another thread could write to it between resetting the flag and reading
+    // and we would consume its data while leaving the flag set, and so never
+    // be woken up again.
+    m_signalled.store(false, std::memory_order_release);
 }
@@ -615,6 +615,7 @@ struct wxXmlParsingContext
           lastChild(nullptr),
           lastAsText(nullptr),
           doctype(nullptr),
+          handler(nullptr),
           removeWhiteOnlyNodes(false)
     {}
 
@@ -625,6 +626,7 @@ struct wxXmlParsingContext
     wxString   encoding;
     wxString   version;
     wxXmlDoctype *doctype;
+    wxXmlParseHandler *handler;         // notified about the parsed elements
     bool       removeWhiteOnlyNodes;
 };
 
@@ -667,10 +669,25 @@ static void EndElementHnd(void *userData, const char* WXUNUSED(name))
     // we're exiting the last children of ctx->node->GetParent() and going
     // back one level up, so current value of ctx->node points to the last
     // child of ctx->node->GetParent()
-    ctx->lastChild = ctx->node;
+    wxXmlNode * const node = ctx->node;
+    ctx->lastChild = node;
 
-    ctx->node = ctx->node->GetParent();
+    ctx->node = node->GetParent();
     ctx->lastAsText = nullptr;
+
+    if (ctx->handler && ctx->handler->OnElementEnd(node))
+    {
+        // The handler doesn't need this node any more, so remove it, making
+        // its previous sibling the last child of its parent again.
+        wxXmlNode *prev = nullptr;
+        for (wxXmlNode *n = ctx->node->GetChildren(); n != node; n = n->GetNext())
+            prev = n;
+
+        ctx->node->RemoveChild(node);
+        delete node;
+
+        ctx->lastChild = prev;
+    }
 }
 
 static void TextHnd(void *userData, const char *s, int len)
@@ -823,6 +840,18 @@ static int UnknownEncodingHnd(void * WXUNUSED(encodingHandlerData),
 
 bool wxXmlDocument::Load(wxInputStream& stream, int flags,
                          wxXmlParseError* err)
+{
+    return DoLoad(stream, nullptr, flags, err);
+}
+
+bool wxXmlDocument::Load(wxInputStream& stream, wxXmlParseHandler& handler,
+                         int flags, wxXmlParseError* err)
+{
+    return DoLoad(stream, &handler, flags, err);
+}
+
+bool wxXmlDocument::DoLoad(wxInputStream& stream, wxXmlParseHandler* handler,
+                           int flags, wxXmlParseError* err)
 {
     const size_t BUFSIZE = 16384;
     char buf[BUFSIZE];
@@ -833,6 +862,7 @@ bool wxXmlDocument::Load(wxInputStream& stream, int flags,
 
     ctx.encoding = wxS("UTF-8"); // default in absence of encoding=""
     ctx.doctype = &m_doctype;
+    ctx.handler = handler;
     ctx.removeWhiteOnlyNodes = (flags & wxXMLDOC_KEEP_WHITESPACE_NODES) == 0;
     ctx.parser = parser;
     ctx.node = root;
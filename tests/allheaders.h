@@ -60,6 +60,7 @@
 #include <wx/button.h>
 #include <wx/calctrl.h>
 #include <wx/caret.h>
+#include <wx/channel.h>
 #include <wx/chartype.h>
 #include <wx/checkbox.h>
 #include <wx/checkeddelete.h>
@@ -261,6 +262,7 @@
 #include <wx/palette.h>
 #include <wx/panel.h>
 #include <wx/paper.h>
+#include <wx/parallel.h>
 #include <wx/pen.h>
 #include <wx/peninfobase.h>
 #include <wx/persist.h>
@@ -356,9 +358,11 @@
 #include <wx/textdlg.h>
 #include <wx/textentry.h>
 #include <wx/textfile.h>
+#include <wx/textextentcache.h>
 #include <wx/textwrapper.h>
 #include <wx/tglbtn.h>
 #include <wx/thread.h>
+#include <wx/threadpool.h>
 #include <wx/timectrl.h>
 #include <wx/time.h>
 #include <wx/timer.h>
@@ -113,6 +113,27 @@ int wxCMPFUNC_CONV StringLenCompare(const wxString& first,
     return first.length() - second.length();
 }
 
+// Count the calls of the comparison functions below made from threads other
+// than the main one: this must never happen as these functions are not
+// required to be thread-safe.
+static int gs_nonMainThreadCompares = 0;
+
+int wxCMPFUNC_CONV StringReverseCompare(const wxString& first,
+                                        const wxString& second)
+{
+    if ( !wxThread::IsMain() )
+        gs_nonMainThreadCompares++;
+
+    return second.compare(first);
+}
+
+#if !wxUSE_STD_CONTAINERS
+int wxCMPFUNC_CONV StringReverseCompare2(wxString* first, wxString* second)
+{
+    return StringReverseCompare(*first, *second);
+}
+#endif // !wxUSE_STD_CONTAINERS
+
 #define DEFINE_COMPARE(name, T)                                               \
                                                                               \
 int wxCMPFUNC_CONV name ## CompareValues(T first, T second)                   \
@@ -382,6 +403,36 @@ TEST_CASE("wxArrayString::Vector", "[dynarray][vector]")
     }
 }
 
+TEST_CASE("wxArrayString::SortCompareFunction", "[dynarray]")
+{
+    // Use an array big enough to be sorted in parallel if the comparison
+    // function allowed it.
+    wxArrayString a;
+    for ( int n = 0; n < 100000; n++ )
+        a.push_back(wxString::Format("%05d", (n*7919) % 100000));
+
+    gs_nonMainThreadCompares = 0;
+
+    SECTION("CompareFunction")
+    {
+        a.Sort(StringReverseCompare);
+    }
+
+#if !wxUSE_STD_CONTAINERS
+    SECTION("CompareFunction2")
+    {
+        a.Sort(StringReverseCompare2);
+    }
+#endif // !wxUSE_STD_CONTAINERS
+
+    CHECK( gs_nonMainThreadCompares == 0 );
+
+    REQUIRE( a.size() == 100000 );
+    CHECK( a[0] == "99999" );
+    CHECK( a[50000] == "49999" );
+    CHECK( a[99999] == "00000" );
+}
+
 TEST_CASE("wxSortedArrayString", "[dynarray]")
 {
     wxSortedArrayString a;
@@ -0,0 +1,147 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/channel.cpp
+// Purpose:     Benchmarks comparing wxMessageQueue with lock-free channels
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/thread.h"
+
+#include "bench.h"
+
+#if wxUSE_THREADS
+
+#include "wx/channel.h"
+#include "wx/msgqueue.h"
+
+#include <thread>
+#include <vector>
+
+// Total number of messages sent in a single benchmark run.
+static const int NUM_MESSAGES = 100000;
+
+// Capacity of the channels used in the benchmarks.
+static const size_t CHANNEL_CAPACITY = 1024;
+
+// Size of the batches used in the batch benchmarks.
+static const size_t BATCH_SIZE = 64;
+
+namespace
+{
+
+// Adapters allowing to use the same benchmark code with all the queues.
+struct MessageQueueAdapter
+{
+    explicit MessageQueueAdapter(size_t WXUNUSED(capacity)) { }
+
+    void Push(int n) { queue.Post(n); }
+    void Pop(int& n) { queue.Receive(n); }
+
+    wxMessageQueue<int> queue;
+};
+
+template <typename Channel>
+struct ChannelAdapter
+{
+    explicit ChannelAdapter(size_t capacity) : channel(capacity) { }
+
+    void Push(int n) { channel.Push(n); }
+    void Pop(int& n) { channel.Pop(n); }
+
+    Channel channel;
+};
+
+// Send NUM_MESSAGES from the given number of producer threads to the main
+// thread and check that all of them were received.
+template <typename Queue>
+bool SendMessages(long numProducers)
+{
+    Queue queue(CHANNEL_CAPACITY);
+
+    const int perProducer = NUM_MESSAGES / numProducers;
+
+    std::vector<std::thread> threads;
+    for ( long i = 0; i < numProducers; i++ )
+    {
+        threads.emplace_back([&queue, perProducer]()
+            {
+                for ( int n = 1; n <= perProducer; n++ )
+                    queue.Push(n);
+            });
+    }
+
+    long long sum = 0;
+    for ( long i = 0; i < numProducers*perProducer; i++ )
+    {
+        int n;
+        queue.Pop(n);
+        sum += n;
+    }
+
+    for ( auto& t : threads )
+        t.join();
+
+    return sum == numProducers*(perProducer*(perProducer + 1LL)/2);
+}
+
+} // anonymous namespace
+
+// All the benchmarks below take the number of producer threads as numeric
+// parameter, with single producer by default.
+
+BENCHMARK_FUNC(MessageQueueSend)
+{
+    return SendMessages<MessageQueueAdapter>(Bench::GetNumericParameter());
+}
+
+BENCHMARK_FUNC(SPSCChannelSend)
+{
+    // This channel can't be used with more than one producer.
+    return SendMessages< ChannelAdapter< wxSPSCChannel<int> > >(1);
+}
+
+BENCHMARK_FUNC(MPMCChannelSend)
+{
+    return SendMessages< ChannelAdapter< wxMPMCChannel<int> > >
+           (
+                Bench::GetNumericParameter()
+           );
+}
+
+// Same as SPSCChannelSend, but send and receive the messages in batches.
+BENCHMARK_FUNC(SPSCChannelSendBatch)
+{
+    wxSPSCChannel<int> channel(CHANNEL_CAPACITY);
+
+    std::thread producer([&channel]()
+        {
+            int batch[BATCH_SIZE];
+            for ( int n = 0; n < NUM_MESSAGES; )
+            {
+                size_t count = 0;
+                while ( count < BATCH_SIZE && n < NUM_MESSAGES )
+                    batch[count++] = ++n;
+
+                channel.PushBatch(batch, count);
+            }
+        });
+
+    long long sum = 0;
+    int batch[BATCH_SIZE];
+    for ( int received = 0; received < NUM_MESSAGES; )
+    {
+        const size_t count = channel.PopBatch(batch, BATCH_SIZE);
+        for ( size_t i = 0; i < count; i++ )
+            sum += batch[i];
+
+        received += count;
+    }
+
+    producer.join();
+
+    return sum == NUM_MESSAGES*(NUM_MESSAGES + 1LL)/2;
+}
+
+#endif // wxUSE_THREADS
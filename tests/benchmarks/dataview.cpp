@@ -0,0 +1,177 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/dataview.cpp
+// Purpose:     wxDataViewCtrl benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/dataview.h"
+
+#include "bench.h"
+
+// Only the generic version provides the functions used here.
+#if wxUSE_DATAVIEWCTRL && defined(wxHAS_GENERIC_DATAVIEWCTRL)
+
+namespace
+{
+
+// Model with the given number of top level containers, each containing the
+// same number of leaf items, without storing any data.
+//
+// Items are identified by their indices: the containers use the indices from 1
+// to the number of containers and the leaves use the indices following them.
+class BigTreeModel : public wxDataViewModel
+{
+public:
+    explicit BigTreeModel(unsigned numContainers)
+        : m_numContainers(numContainers)
+    {
+    }
+
+    wxDataViewItem GetContainer(unsigned n) const
+    {
+        return wxDataViewItem(wxUIntToPtr(n + 1));
+    }
+
+    wxDataViewItem GetLeaf(unsigned container, unsigned n) const
+    {
+        return wxDataViewItem(wxUIntToPtr(m_numContainers*(container + 1) + n + 1));
+    }
+
+    virtual void GetValue(wxVariant& variant,
+                          const wxDataViewItem& WXUNUSED(item),
+                          unsigned int WXUNUSED(col)) const override
+    {
+        variant = wxString("item");
+    }
+
+    virtual bool SetValue(const wxVariant& WXUNUSED(variant),
+                          const wxDataViewItem& WXUNUSED(item),
+                          unsigned int WXUNUSED(col)) override
+    {
+        return false;
+    }
+
+    virtual wxDataViewItem GetParent(const wxDataViewItem& item) const override
+    {
+        const unsigned index = GetIndex(item);
+        if ( index <= m_numContainers )
+            return wxDataViewItem();
+
+        return GetContainer((index - 1)/m_numContainers - 1);
+    }
+
+    virtual bool IsContainer(const wxDataViewItem& item) const override
+    {
+        return GetIndex(item) <= m_numContainers;
+    }
+
+    virtual unsigned int GetChildren(const wxDataViewItem& item,
+                                     wxDataViewItemArray& children) const override
+    {
+        if ( !item.IsOk() )
+        {
+            for ( unsigned n = 0; n < m_numContainers; n++ )
+                children.push_back(GetContainer(n));
+        }
+        else
+        {
+            const unsigned container = GetIndex(item) - 1;
+            for ( unsigned n = 0; n < m_numContainers; n++ )
+                children.push_back(GetLeaf(container, n));
+        }
+
+        return children.size();
+    }
+
+private:
+    static unsigned GetIndex(const wxDataViewItem& item)
+    {
+        return wxPtrToUInt(item.GetID());
+    }
+
+    const unsigned m_numContainers;
+};
+
+// Row and item mapping functions are protected in wxDataViewCtrl.
+class BigTreeDataViewCtrl : public wxDataViewCtrl
+{
+public:
+    explicit BigTreeDataViewCtrl(wxWindow* parent)
+        : wxDataViewCtrl(parent, wxID_ANY)
+    {
+    }
+
+    using wxDataViewCtrl::GetItemByRow;
+    using wxDataViewCtrl::GetRowByItem;
+};
+
+BigTreeDataViewCtrl* gs_dvc = nullptr;
+BigTreeModel* gs_model = nullptr;
+
+// Number of lookups done during each benchmark iteration.
+const int NUM_LOOKUPS = 1000;
+
+} // anonymous namespace
+
+// The benchmarks below use a tree with the number of containers given by the
+// numeric parameter, 1000 by default, each containing the same number of
+// leaves, i.e. with a million of items by default.
+
+static bool CreateDataView()
+{
+    gs_dvc = new BigTreeDataViewCtrl(wxTheApp->GetTopWindow());
+    gs_dvc->AppendTextColumn("Value", 0);
+
+    gs_model = new BigTreeModel(Bench::GetNumericParameter(1000));
+    gs_dvc->AssociateModel(gs_model);
+    gs_model->DecRef();
+
+    for ( int n = 0; n < Bench::GetNumericParameter(1000); n++ )
+        gs_dvc->Expand(gs_model->GetContainer(n));
+
+    return true;
+}
+
+static void DeleteDataView()
+{
+    delete gs_dvc;
+    gs_dvc = nullptr;
+    gs_model = nullptr;
+}
+
+// Find the rows of the items spread over the entire tree.
+BENCHMARK_FUNC_WITH_INIT(DataViewRowByItem, CreateDataView, DeleteDataView)
+{
+    const unsigned numContainers = Bench::GetNumericParameter(1000);
+
+    long total = 0;
+    for ( int n = 0; n < NUM_LOOKUPS; n++ )
+    {
+        const unsigned container = (n * 7919) % numContainers;
+        total += gs_dvc->GetRowByItem(gs_model->GetLeaf(container, n % numContainers));
+    }
+
+    return total > 0;
+}
+
+// Find the items at the rows spread over the entire tree.
+BENCHMARK_FUNC_WITH_INIT(DataViewItemByRow, CreateDataView, DeleteDataView)
+{
+    const unsigned numContainers = Bench::GetNumericParameter(1000);
+    const unsigned numRows = numContainers*(numContainers + 1);
+
+    int found = 0;
+    for ( int n = 0; n < NUM_LOOKUPS; n++ )
+    {
+        if ( gs_dvc->GetItemByRow((numRows / NUM_LOOKUPS)*n).IsOk() )
+            found++;
+    }
+
+    return found == NUM_LOOKUPS;
+}
+
+#endif // wxUSE_DATAVIEWCTRL && wxHAS_GENERIC_DATAVIEWCTRL
@@ -0,0 +1,144 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/grid.cpp
+// Purpose:     wxGrid benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/grid.h"
+
+#include "bench.h"
+
+#if wxUSE_GRID
+
+namespace
+{
+
+// Table with the given number of rows and a single column not storing any
+// data, to avoid measuring the time needed for creating the table itself.
+class EmptyGridTable : public wxGridTableBase
+{
+public:
+    explicit EmptyGridTable(int numRows) : m_numRows(numRows) { }
+
+    virtual int GetNumberRows() override { return m_numRows; }
+    virtual int GetNumberCols() override { return 1; }
+    virtual wxString GetValue(int, int) override { return wxString(); }
+    virtual void SetValue(int, int, const wxString&) override { }
+
+private:
+    const int m_numRows;
+};
+
+wxGrid* gs_grid = nullptr;
+
+// Return the total height of all rows.
+int GetGridHeight()
+{
+    return gs_grid->CellToRect(gs_grid->GetNumberRows() - 1, 0).GetBottom();
+}
+
+// Number of rows resized during each benchmark iteration.
+const int NUM_RESIZES = 100;
+
+} // anonymous namespace
+
+// The benchmarks below use a grid with the number of rows given by the
+// numeric parameter, 5 million by default.
+
+static bool CreateGrid()
+{
+    gs_grid = new wxGrid(wxTheApp->GetTopWindow(), wxID_ANY);
+    gs_grid->SetTable(new EmptyGridTable(Bench::GetNumericParameter(5000000)),
+                      true);
+
+    // Use a non-default size for a row to ensure that the grid stores the
+    // sizes of all rows.
+    gs_grid->SetRowSize(0, 2*gs_grid->GetDefaultRowSize());
+
+    return true;
+}
+
+static void DeleteGrid()
+{
+    delete gs_grid;
+    gs_grid = nullptr;
+}
+
+// Resize the rows at the beginning of the grid, which affects the positions
+// of all the rows after them.
+BENCHMARK_FUNC_WITH_INIT(GridSetRowSize, CreateGrid, DeleteGrid)
+{
+    static int s_iteration = 0;
+    s_iteration++;
+
+    gs_grid->BeginBatch();
+    for ( int row = 0; row < NUM_RESIZES; row++ )
+        gs_grid->SetRowSize(row, 20 + (row + s_iteration) % 10);
+    gs_grid->EndBatch();
+
+    return GetGridHeight() > 0;
+}
+
+// Hide and show the rows at the beginning of the grid.
+BENCHMARK_FUNC_WITH_INIT(GridHideRows, CreateGrid, DeleteGrid)
+{
+    gs_grid->BeginBatch();
+    for ( int row = 0; row < NUM_RESIZES; row++ )
+        gs_grid->HideRow(row);
+    for ( int row = 0; row < NUM_RESIZES; row++ )
+        gs_grid->ShowRow(row);
+    gs_grid->EndBatch();
+
+    return gs_grid->IsRowShown(0);
+}
+
+// Find the rows at different positions in the grid.
+BENCHMARK_FUNC_WITH_INIT(GridYToRow, CreateGrid, DeleteGrid)
+{
+    const int height = GetGridHeight();
+
+    int total = 0;
+    for ( int n = 1; n <= NUM_RESIZES; n++ )
+        total += gs_grid->YToRow((height / NUM_RESIZES)*n - 1);
+
+    return total > 0;
+}
+
+// Style a 1000*1000 block of cells and a few smaller blocks inside it and
+// retrieve the attributes of all of its cells.
+BENCHMARK_FUNC(GridBlockAttr)
+{
+    wxGridCellAttrProvider provider;
+
+    wxGridCellAttr* const attr = new wxGridCellAttr;
+    attr->SetAlignment(wxALIGN_RIGHT, wxALIGN_CENTRE);
+    provider.SetBlockAttr(attr, wxGridBlockCoords(0, 0, 999, 999));
+
+    for ( int n = 0; n < 100; n++ )
+    {
+        wxGridCellAttr* const attrInner = new wxGridCellAttr;
+        attrInner->SetReadOnly();
+        provider.SetBlockAttr(attrInner,
+                              wxGridBlockCoords(10*n, 10*n, 10*n + 5, 10*n + 5));
+    }
+
+    int numReadOnly = 0;
+    for ( int row = 0; row < 1000; row++ )
+    {
+        for ( int col = 0; col < 1000; col++ )
+        {
+            wxGridCellAttrPtr cellAttr = provider.GetAttrPtr(row, col,
+                                                             wxGridCellAttr::Any);
+            if ( cellAttr && cellAttr->IsReadOnly() )
+                numReadOnly++;
+        }
+    }
+
+    return numReadOnly == 3600;
+}
+
+#endif // wxUSE_GRID
@@ -0,0 +1,113 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/html.cpp
+// Purpose:     wxHtmlWindow benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/bitmap.h"
+#include "wx/dcmemory.h"
+#include "wx/html/htmlwin.h"
+
+#include "bench.h"
+
+#if wxUSE_HTML
+
+namespace
+{
+
+wxHtmlWindow* gs_html = nullptr;
+
+// Number of hit tests or redraws done during each benchmark iteration.
+const int NUM_HIT_TESTS = 10000;
+const int NUM_REDRAWS = 100;
+
+// Size of the area drawn by HtmlDrawPage benchmark.
+const int PAGE_WIDTH = 800;
+const int PAGE_HEIGHT = 600;
+
+} // anonymous namespace
+
+// The benchmarks below use a document with the number of words given by the
+// numeric parameter, 100000 by default, split into paragraphs of 100 words
+// with every tenth word being a link.
+
+static bool CreateHtmlWindow()
+{
+    const int numWords = Bench::GetNumericParameter(100000);
+
+    wxString page("<html><body>");
+    for ( int n = 0; n < numWords; n++ )
+    {
+        if ( n % 100 == 0 )
+            page += n ? "</p><p>" : "<p>";
+
+        if ( n % 10 == 0 )
+            page += wxString::Format("<a href=\"#%d\">link%d</a> ", n, n);
+        else
+            page += wxString::Format("word%d ", n);
+    }
+    page += "</p></body></html>";
+
+    gs_html = new wxHtmlWindow(wxTheApp->GetTopWindow(), wxID_ANY,
+                               wxDefaultPosition,
+                               wxSize(PAGE_WIDTH, PAGE_HEIGHT));
+    gs_html->SetPage(page);
+
+    return true;
+}
+
+static void DeleteHtmlWindow()
+{
+    delete gs_html;
+    gs_html = nullptr;
+}
+
+// Find the cells under the positions spread over the entire document, as is
+// done when checking for the links under mouse.
+BENCHMARK_FUNC_WITH_INIT(HtmlFindCellByPos, CreateHtmlWindow, DeleteHtmlWindow)
+{
+    const wxHtmlContainerCell* const cell = gs_html->GetInternalRepresentation();
+    const int width = cell->GetWidth();
+    const int height = cell->GetHeight();
+
+    int found = 0;
+    for ( int n = 0; n < NUM_HIT_TESTS; n++ )
+    {
+        const int x = (n * 7919) % width;
+        const int y = static_cast<int>((static_cast<wxLongLong_t>(height) * n)
+                                        / NUM_HIT_TESTS);
+        if ( cell->FindCellByPos(x, y) )
+            found++;
+    }
+
+    return found > 0;
+}
+
+// Draw the pages spread over the entire document.
+BENCHMARK_FUNC_WITH_INIT(HtmlDrawPage, CreateHtmlWindow, DeleteHtmlWindow)
+{
+    wxHtmlContainerCell* const cell = gs_html->GetInternalRepresentation();
+    const int height = cell->GetHeight();
+
+    wxBitmap bmp(PAGE_WIDTH, PAGE_HEIGHT);
+    wxMemoryDC dc(bmp);
+    wxDefaultHtmlRenderingStyle style(gs_html);
+
+    for ( int n = 0; n < NUM_REDRAWS; n++ )
+    {
+        const int top = static_cast<int>((static_cast<wxLongLong_t>(height) * n)
+                                          / NUM_REDRAWS);
+
+        wxHtmlRenderingInfo info;
+        info.SetStyle(&style);
+        cell->Draw(dc, 0, -top, 0, PAGE_HEIGHT, info);
+    }
+
+    return true;
+}
+
+#endif // wxUSE_HTML
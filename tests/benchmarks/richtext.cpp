@@ -0,0 +1,92 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/richtext.cpp
+// Purpose:     wxRichTextCtrl file I/O benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/font.h"
+#include "wx/mstream.h"
+#include "wx/richtext/richtextbuffer.h"
+#include "wx/richtext/richtextxml.h"
+
+#include "bench.h"
+
+#if wxUSE_RICHTEXT && wxUSE_XML
+
+namespace
+{
+
+wxRichTextBuffer* gs_buffer = nullptr;
+wxMemoryOutputStream* gs_xml = nullptr;
+
+} // anonymous namespace
+
+// The benchmarks below use a document with the number of paragraphs given by
+// the numeric parameter, 10000 by default, each containing 20 words, with
+// every third paragraph being bold and some of the words containing the
+// characters which need to be escaped in XML.
+
+static bool CreateRichTextBuffer()
+{
+    const int numParagraphs = Bench::GetNumericParameter(10000);
+
+    gs_buffer = new wxRichTextBuffer;
+
+    wxRichTextAttr attrBold;
+    attrBold.SetFontWeight(wxFONTWEIGHT_BOLD);
+
+    for ( int n = 0; n < numParagraphs; n++ )
+    {
+        wxString text;
+        for ( int w = 0; w < 20; w++ )
+        {
+            if ( w % 5 == 0 )
+                text += wxString::Format("<word&%d> ", n);
+            else if ( w % 7 == 0 )
+                text += wxString::FromUTF8("na\xc3\xafve ");
+            else
+                text += wxString::Format("word%d ", w);
+        }
+
+        gs_buffer->AddParagraph(text, n % 3 == 0 ? &attrBold : nullptr);
+    }
+
+    wxRichTextXMLHandler handler;
+    gs_xml = new wxMemoryOutputStream;
+    return handler.SaveFile(gs_buffer, *gs_xml);
+}
+
+static void DeleteRichTextBuffer()
+{
+    delete gs_xml;
+    gs_xml = nullptr;
+
+    delete gs_buffer;
+    gs_buffer = nullptr;
+}
+
+// Save the document in XML format to memory.
+BENCHMARK_FUNC_WITH_INIT(RichTextXMLSave, CreateRichTextBuffer, DeleteRichTextBuffer)
+{
+    wxRichTextXMLHandler handler;
+    wxMemoryOutputStream stream;
+
+    return handler.SaveFile(gs_buffer, stream) &&
+            stream.GetLength() == gs_xml->GetLength();
+}
+
+// Load the document from XML in memory.
+BENCHMARK_FUNC_WITH_INIT(RichTextXMLLoad, CreateRichTextBuffer, DeleteRichTextBuffer)
+{
+    wxRichTextXMLHandler handler;
+    wxMemoryInputStream stream(*gs_xml);
+    wxRichTextBuffer buffer;
+
+    return handler.LoadFile(&buffer, stream) &&
+            buffer.GetChildCount() >= (size_t)Bench::GetNumericParameter(10000);
+}
+
+#endif // wxUSE_RICHTEXT && wxUSE_XML
@@ -0,0 +1,103 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/stc.cpp
+// Purpose:     wxStyledTextCtrl benchmarks
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/app.h"
+#include "wx/stc/stc.h"
+
+#include "bench.h"
+
+#if wxUSE_STC
+
+namespace
+{
+
+wxStyledTextCtrl* gs_stc = nullptr;
+
+// Number of pages shown during each benchmark iteration.
+const int NUM_PAGES = 100;
+
+// Number of lines in each page.
+const int PAGE_LINES = 50;
+
+} // anonymous namespace
+
+// The benchmark below uses a C++ document with the number of lines given by
+// the numeric parameter, 1000000 by default, highlighted using the lexer and
+// with the keywords shown in bold, so that the lines consist of many short
+// runs using different fonts, some of them containing non-ASCII characters.
+
+static bool CreateSTC()
+{
+    const int numLines = Bench::GetNumericParameter(1000000);
+
+    wxString text;
+    for ( int n = 0; n < numLines; n++ )
+    {
+        switch ( n % 4 )
+        {
+            case 0:
+                text += wxString::Format(wxString::FromUTF8(
+                            "    // Compute the na\xc3\xafve value of item %d\n"), n);
+                break;
+
+            case 1:
+                text += wxString::Format("    int value%d = ComputeValue(items[%d], 42);\n", n, n);
+                break;
+
+            case 2:
+                text += wxString::Format("    if ( value%d > maxValue )\n", n - 1);
+                break;
+
+            case 3:
+                text += wxString::Format("        maxValue = value%d;\n", n - 2);
+                break;
+        }
+    }
+
+    gs_stc = new wxStyledTextCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                                  wxDefaultPosition, wxSize(800, 600));
+    gs_stc->SetLexer(wxSTC_LEX_CPP);
+    gs_stc->SetKeyWords(0, "if int return");
+    gs_stc->StyleSetBold(wxSTC_C_WORD, true);
+    gs_stc->StyleSetItalic(wxSTC_C_COMMENTLINE, true);
+    gs_stc->SetText(text);
+
+    // Don't include the time needed for lexing the document in the results.
+    gs_stc->Colourise(0, -1);
+
+    return true;
+}
+
+static void DeleteSTC()
+{
+    delete gs_stc;
+    gs_stc = nullptr;
+}
+
+// Show the pages spread over the entire document, laying out all their lines
+// as is done when drawing them.
+BENCHMARK_FUNC_WITH_INIT(STCScroll, CreateSTC, DeleteSTC)
+{
+    const int numLines = gs_stc->GetLineCount();
+
+    int total = 0;
+    for ( int n = 0; n < NUM_PAGES; n++ )
+    {
+        const int first = static_cast<int>((static_cast<wxLongLong_t>(numLines - PAGE_LINES) * n)
+                                            / NUM_PAGES);
+        gs_stc->ScrollToLine(first);
+
+        for ( int line = first; line < first + PAGE_LINES; line++ )
+            total += gs_stc->PointFromPosition(gs_stc->GetLineEndPosition(line)).x;
+    }
+
+    return total > 0;
+}
+
+#endif // wxUSE_STC
@@ -0,0 +1,127 @@
+/////////////////////////////////////////////////////////////////////////////
+// Name:        tests/benchmarks/wakeup.cpp
+// Purpose:     Benchmarks for waking up the event loop from other threads
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+/////////////////////////////////////////////////////////////////////////////
+
+#include "wx/evtloop.h"
+
+#include "bench.h"
+
+#if wxUSE_THREADS
+
+#include "wx/thread.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Number of wake ups done by each thread in a single benchmark run.
+static const int NUM_WAKEUPS = 10000;
+
+// Number of round trips in the latency benchmark.
+static const int NUM_ROUND_TRIPS = 1000;
+
+// Measure the throughput of WakeUp() calls done concurrently from the number
+// of threads given by the numeric parameter (4 by default).
+//
+// As consecutive wake ups are coalesced, this mostly measures the cost of the
+// calls done while the event loop has already been woken up.
+BENCHMARK_FUNC(EventLoopWakeUpThroughput)
+{
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    const long numThreads = Bench::GetNumericParameter(4);
+
+    std::atomic<long> numRunning(numThreads);
+
+    // Set by the threads before waking up the loop and reset by it after
+    // being woken up, so that it remains set if a wake up gets lost.
+    std::atomic<bool> wakeUpPending(false);
+
+    std::vector<std::thread> threads;
+    for ( long n = 0; n < numThreads; n++ )
+    {
+        threads.emplace_back([&loop, &numRunning, &wakeUpPending]()
+            {
+                for ( int i = 0; i < NUM_WAKEUPS; i++ )
+                {
+                    wakeUpPending = true;
+                    loop.WakeUp();
+                }
+
+                numRunning--;
+            });
+    }
+
+    long numDispatched = 0;
+    while ( numRunning )
+    {
+        if ( loop.DispatchTimeout(10) > 0 )
+        {
+            numDispatched++;
+            wakeUpPending = false;
+        }
+    }
+
+    for ( auto& t : threads )
+        t.join();
+
+    // Wait for the last wake up, it must arrive if it hasn't been processed
+    // yet, and consume the extra one, if any.
+    if ( wakeUpPending )
+    {
+        // Use a timeout just to avoid hanging forever if something goes wrong.
+        if ( loop.DispatchTimeout(1000) <= 0 )
+            return false;
+
+        numDispatched++;
+    }
+
+    loop.DispatchTimeout(0);
+
+    // Consecutive wake ups are coalesced, so there may be fewer of them than
+    // WakeUp() calls, but there must have been at least one of them and
+    // never more than the number of calls.
+    return numDispatched > 0 && numDispatched <= numThreads*NUM_WAKEUPS;
+}
+
+// Measure the latency of waking up the event loop from another thread: the
+// other thread wakes up the main one and waits until it signals back that it
+// has been woken up, so this measures the round trip time.
+BENCHMARK_FUNC(EventLoopWakeUpLatency)
+{
+    wxEventLoop loop;
+    wxEventLoopActivator activate(&loop);
+
+    wxSemaphore sem;
+
+    std::thread thread([&loop, &sem]()
+        {
+            for ( int i = 0; i < NUM_ROUND_TRIPS; i++ )
+            {
+                loop.WakeUp();
+                sem.Wait();
+            }
+        });
+
+    bool ok = true;
+    for ( int i = 0; i < NUM_ROUND_TRIPS; i++ )
+    {
+        // Use a timeout just to avoid hanging forever if something goes wrong.
+        if ( loop.DispatchTimeout(1000) <= 0 )
+            ok = false;
+
+        sem.Post();
+    }
+
+    thread.join();
+
+    return ok;
+}
+
+#endif // wxUSE_THREADS
@@ -26,6 +26,8 @@
 #include "testableframe.h"
 #include "asserthelper.h"
 
+#include <memory>
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -861,6 +863,259 @@ TEST_CASE_METHOD(MultiColumnsDataViewCtrlTestCase,
     CHECK( m_lastColumn->GetWidth() >= lastColumnMinWidth );
 }
 
+#ifdef wxHAS_GENERIC_DATAVIEWCTRL
+
+// Row and item mapping functions are protected in wxDataViewCtrl, make them
+// accessible for testing them.
+class RowsDataViewTreeCtrl : public wxDataViewTreeCtrl
+{
+public:
+    explicit RowsDataViewTreeCtrl(wxWindow* parent)
+        : wxDataViewTreeCtrl(parent, wxID_ANY)
+    {
+    }
+
+    using wxDataViewCtrl::GetItemByRow;
+    using wxDataViewCtrl::GetRowByItem;
+};
+
+TEST_CASE("wxDVC::RowByItem", "[wxDataViewCtrl][item]")
+{
+    std::unique_ptr<RowsDataViewTreeCtrl>
+        dvc(new RowsDataViewTreeCtrl(wxTheApp->GetTopWindow()));
+
+    const wxDataViewItem root = dvc->AppendContainer(wxDataViewItem(), "root");
+    const wxDataViewItem child1 = dvc->AppendContainer(root, "child1");
+    const wxDataViewItem grandchild = dvc->AppendItem(child1, "grandchild");
+    const wxDataViewItem child2 = dvc->AppendItem(root, "child2");
+    dvc->Expand(root);
+
+    // Check that GetRowByItem() and GetItemByRow() are consistent with each
+    // other and with the expected order of the items.
+    const auto checkRows = [&dvc](const wxVector<wxDataViewItem>& items)
+    {
+        for ( size_t n = 0; n < items.size(); n++ )
+        {
+            INFO("Row " << n);
+            CHECK( dvc->GetRowByItem(items[n]) == static_cast<int>(n) );
+            CHECK( dvc->GetItemByRow(n) == items[n] );
+        }
+
+        CHECK( !dvc->GetItemByRow(items.size()).IsOk() );
+    };
+
+    checkRows({root, child1, child2});
+
+    dvc->Expand(child1);
+    checkRows({root, child1, grandchild, child2});
+
+    wxVector<wxDataViewItem> items{root, child1, grandchild, child2};
+    for ( int i = 3; i < 100; ++i )
+        items.push_back(dvc->AppendItem(root, wxString::Format("child%d", i)));
+    checkRows(items);
+
+    dvc->Collapse(child1);
+    items.erase(items.begin() + 2);
+    checkRows(items);
+
+    // The collapsed items are still found, but not in the expanded ones.
+    CHECK( dvc->GetRowByItem(grandchild) == 2 );
+
+    const wxDataViewItem grandchild2 = dvc->AppendItem(child1, "grandchild2");
+    dvc->Expand(child1);
+    items.insert(items.begin() + 2, grandchild);
+    items.insert(items.begin() + 3, grandchild2);
+    checkRows(items);
+
+    dvc->DeleteItem(items[10]);
+    items.erase(items.begin() + 10);
+    checkRows(items);
+
+    dvc->DeleteItem(child1);
+    items.erase(items.begin() + 1, items.begin() + 4);
+    checkRows(items);
+
+    CHECK( dvc->GetRowByItem(grandchild2) == -1 );
+}
+
+TEST_CASE("wxDVC::Batch", "[wxDataViewCtrl][item]")
+{
+    std::unique_ptr<RowsDataViewTreeCtrl>
+        dvc(new RowsDataViewTreeCtrl(wxTheApp->GetTopWindow()));
+
+    const wxDataViewItem root = dvc->AppendContainer(wxDataViewItem(), "root");
+    const wxDataViewItem last = dvc->AppendItem(root, "last");
+    dvc->Expand(root);
+
+    dvc->Select(last);
+    dvc->SetCurrentItem(last);
+
+    wxDataViewModel* const model = dvc->GetModel();
+    model->BeginBatch();
+    CHECK( model->IsInBatch() );
+
+    // The new items are appended to the tree during the batch and moved to
+    // their correct positions only at its end.
+    const wxDataViewItem middle = dvc->PrependItem(root, "middle");
+    const wxDataViewItem first = dvc->PrependItem(root, "first");
+
+    model->EndBatch();
+    CHECK( !model->IsInBatch() );
+
+    CHECK( dvc->GetItemByRow(1) == first );
+    CHECK( dvc->GetItemByRow(2) == middle );
+    CHECK( dvc->GetItemByRow(3) == last );
+
+    // The selection must have been preserved.
+    CHECK( dvc->IsSelected(last) );
+    CHECK( !dvc->IsSelected(middle) );
+    CHECK( dvc->GetCurrentItem() == last );
+}
+
+class RowsDataViewListCtrl : public wxDataViewListCtrl
+{
+public:
+    explicit RowsDataViewListCtrl(wxWindow* parent)
+        : wxDataViewListCtrl(parent, wxID_ANY)
+    {
+    }
+
+    using wxDataViewCtrl::GetItemByRow;
+    using wxDataViewCtrl::GetRowByItem;
+
+    // Check that all the rows are sorted by their values, with the items with
+    // the same value sorted by their IDs.
+    bool IsSortedByValue(bool ascending)
+    {
+        const int count = GetItemCount();
+        wxDataViewItem prevItem = GetItemByRow(0);
+        wxString prevValue = GetValue(prevItem);
+        for ( int row = 1; row < count; row++ )
+        {
+            const wxDataViewItem item = GetItemByRow(row);
+            const wxString value = GetValue(item);
+
+            int cmp = prevValue.Cmp(value);
+            if ( !cmp )
+                cmp = prevItem.GetID() < item.GetID() ? -1 : 1;
+
+            if ( ascending ? cmp > 0 : cmp < 0 )
+                return false;
+
+            prevItem = item;
+            prevValue = value;
+        }
+
+        return true;
+    }
+
+private:
+    wxString GetValue(const wxDataViewItem& item) const
+    {
+        wxVariant value;
+        GetModel()->GetValue(value, item, 0);
+        return value.GetString();
+    }
+};
+
+TEST_CASE("wxDVC::BackgroundSort", "[wxDataViewCtrl][sort]")
+{
+    std::unique_ptr<RowsDataViewListCtrl>
+        dvc(new RowsDataViewListCtrl(wxTheApp->GetTopWindow()));
+
+    wxDataViewColumn* const column = dvc->AppendTextColumn("Value");
+    column->SetSortable(true);
+
+    // Use enough items to sort them in background and with duplicate values
+    // to check that the secondary sort key is used.
+    const int count = 60000;
+    wxVector<wxVariant> values(1);
+    for ( int n = 0; n < count; n++ )
+    {
+        values[0] = wxString::Format("%05d", (n*7919) % (count / 2));
+        dvc->AppendItem(values);
+    }
+
+    const wxDataViewItem selected = dvc->GetItemByRow(17);
+    dvc->Select(selected);
+
+    column->SetSortOrder(true);
+    dvc->GetModel()->Resort();
+
+    // Wait until the sort completes, if it's done in background.
+    wxStopWatch sw;
+    while ( !dvc->IsSortedByValue(true) && sw.Time() < 10000 )
+        wxYield();
+
+    CHECK( dvc->IsSortedByValue(true) );
+    CHECK( dvc->IsSelected(selected) );
+    CHECK( dvc->GetSelectedItemsCount() == 1 );
+
+    // Modifying the model while sorting must finish sorting immediately.
+    column->SetSortOrder(false);
+    dvc->GetModel()->Resort();
+
+    values[0] = "00000";
+    dvc->AppendItem(values);
+
+    CHECK( dvc->GetItemCount() == count + 1 );
+    CHECK( dvc->IsSortedByValue(false) );
+    CHECK( dvc->IsSelected(selected) );
+
+    // And the order must not change later.
+    wxYield();
+    CHECK( dvc->IsSortedByValue(false) );
+}
+
+// Store using the reverse of the default order.
+class ReverseCompareListStore : public wxDataViewListStore
+{
+public:
+    virtual int Compare(const wxDataViewItem& item1,
+                        const wxDataViewItem& item2,
+                        unsigned int column,
+                        bool ascending) const override
+    {
+        return wxDataViewListStore::Compare(item2, item1, column, ascending);
+    }
+};
+
+TEST_CASE("wxDVC::CustomCompareSort", "[wxDataViewCtrl][sort]")
+{
+    std::unique_ptr<RowsDataViewListCtrl>
+        dvc(new RowsDataViewListCtrl(wxTheApp->GetTopWindow()));
+
+    // The default store can be sorted without calling Compare(), but not the
+    // one deriving from it and overriding Compare().
+    CHECK( dvc->GetModel()->UsesDefaultCompare() );
+
+    wxObjectDataPtr<ReverseCompareListStore> store(new ReverseCompareListStore);
+    dvc->AssociateModel(store.get());
+    CHECK( !dvc->GetModel()->UsesDefaultCompare() );
+
+    wxDataViewColumn* const column = dvc->AppendTextColumn("Value");
+    column->SetSortable(true);
+
+    // Use enough items for them to be sorted in background if Compare() were
+    // not used, and all different values.
+    const int count = 60000;
+    wxVector<wxVariant> values(1);
+    for ( int n = 0; n < count; n++ )
+    {
+        values[0] = wxString::Format("%05d", (n*7919) % count);
+        dvc->AppendItem(values);
+    }
+
+    column->SetSortOrder(true);
+    store->Resort();
+
+    // The order defined by our Compare() must be used, i.e. the items must be
+    // in descending order even though they're sorted in ascending one.
+    CHECK( dvc->IsSortedByValue(false) );
+}
+
+#endif // wxHAS_GENERIC_DATAVIEWCTRL
+
 #if wxUSE_UIACTIONSIMULATOR
 
 TEST_CASE_METHOD(SingleSelectDataViewCtrlTestCase,
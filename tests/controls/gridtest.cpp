@@ -1838,6 +1838,99 @@ TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeColumn", "[grid]")
     }
 }
 
+TEST_CASE_METHOD(GridTestCase, "Grid::AutoSizeMode", "[grid]")
+{
+    CHECK( m_grid->GetAutoSizeMode() == wxGRID_AUTOSIZE_ALL );
+    CHECK( m_grid->GetAutoSizePercentile() == 100 );
+
+    // Use empty label to only take the cells into account.
+    m_grid->SetColLabelValue(0, wxString());
+
+    const wxString shortStr = "W";
+    const wxString longStr  = "WWWWWWWWWWWWWWWW";
+
+    for ( int row = 0; row < m_grid->GetNumberRows(); row++ )
+        m_grid->SetCellValue(row, 0, shortStr);
+    m_grid->SetCellValue(3, 0, longStr);
+
+    const int margin = m_grid->FromDIP(10);
+
+    wxClientDC dc(m_grid->GetGridWindow());
+    const wxFont font = m_grid->GetDefaultCellFont();
+    const int shortWidth = m_grid->GetCellTextExtent(dc, font, shortStr).x;
+    const int longWidth = m_grid->GetCellTextExtent(dc, font, longStr).x;
+
+    SECTION("All")
+    {
+        CheckFirstColAutoSize( longWidth + margin );
+    }
+
+    SECTION("Sample")
+    {
+        // Only rows 0 and 5 are measured.
+        m_grid->SetAutoSizeMode(wxGRID_AUTOSIZE_SAMPLE, 2);
+        CHECK( m_grid->GetAutoSizeSampleSize() == 2 );
+        CheckFirstColAutoSize( shortWidth + margin );
+
+        // And all of them are if the sample is big enough.
+        m_grid->SetAutoSizeMode(wxGRID_AUTOSIZE_SAMPLE, 100);
+        CheckFirstColAutoSize( longWidth + margin );
+    }
+
+    SECTION("Visible")
+    {
+        m_grid->SetAutoSizeMode(wxGRID_AUTOSIZE_VISIBLE);
+        m_grid->SetCellValue(3, 0, shortStr);
+
+        m_grid->SetCellValue(m_grid->GetNumberRows() - 1, 0, longStr);
+
+        // Make the second row so big that the last one can't be visible.
+        m_grid->SetRowSize(1, 2*m_grid->GetGridWindow()->GetClientSize().y);
+        m_grid->Scroll(0, 0);
+
+        CheckFirstColAutoSize( shortWidth + margin );
+    }
+
+    SECTION("Percentile")
+    {
+        m_grid->SetAutoSizePercentile(50);
+        CheckFirstColAutoSize( shortWidth + margin );
+    }
+}
+
+TEST_CASE_METHOD(GridTestCase, "Grid::RenderCache", "[grid]")
+{
+    CHECK( !m_grid->IsRenderCacheEnabled() );
+
+    m_grid->EnableRenderCache();
+    CHECK( m_grid->IsRenderCacheEnabled() );
+
+    m_grid->Refresh();
+    m_grid->Update();
+
+    wxGridCellCoordsVector cells;
+    for ( int row = 0; row < m_grid->GetNumberRows(); row += 2 )
+    {
+        m_grid->SetCellValue(row, 1, wxString::Format("%d", row));
+        cells.push_back(wxGridCellCoords(row, 1));
+    }
+
+    // Out of range cells must be ignored.
+    cells.push_back(wxGridCellCoords(m_grid->GetNumberRows(), 0));
+
+    m_grid->RefreshCells(cells);
+    wxYield();
+    m_grid->Update();
+
+    m_grid->Scroll(0, 1);
+    m_grid->Update();
+
+    CHECK( m_grid->GetCellValue(2, 1) == "2" );
+
+    m_grid->EnableRenderCache(false);
+    CHECK( !m_grid->IsRenderCacheEnabled() );
+}
+
 TEST_CASE_METHOD(GridTestCase, "Grid::DrawInvalidCell", "[grid][multicell]")
 {
     // Set up a multicell with inside an overflowing cell.
@@ -2128,6 +2221,104 @@ TEST_CASE_METHOD(GridTestCase, "Grid::SetTable_ClearAttrCache", "[grid]")
 #endif // !__WXOSX__
 }
 
+TEST_CASE("GridCellAttrProvider::Blocks", "[attr][grid]")
+{
+    wxGridCellAttrProvider provider;
+
+    // Return the background colour of the attribute of the given cell or
+    // invalid colour if there is no attribute.
+    const auto getColour = [&provider](int row, int col)
+    {
+        wxGridCellAttrPtr attr = provider.GetAttrPtr(row, col,
+                                                     wxGridCellAttr::Any);
+        return attr && attr->HasBackgroundColour() ? attr->GetBackgroundColour()
+                                                   : wxColour();
+    };
+
+    const auto makeAttr = [](const wxColour& colour)
+    {
+        wxGridCellAttr* const attr = new wxGridCellAttr;
+        attr->SetBackgroundColour(colour);
+        return attr;
+    };
+
+    // Note that the block doesn't need to be canonical.
+    provider.SetBlockAttr(makeAttr(*wxRED), wxGridBlockCoords(999, 999, 0, 0));
+    CHECK( getColour(0, 0) == *wxRED );
+    CHECK( getColour(500, 999) == *wxRED );
+    CHECK( !getColour(1000, 0).IsOk() );
+    CHECK( !getColour(0, 1000).IsOk() );
+
+    // Blocks are not cell attributes.
+    CHECK( !provider.GetAttrPtr(0, 0, wxGridCellAttr::Cell) );
+
+    SECTION("Overlapping")
+    {
+        provider.SetBlockAttr(makeAttr(*wxGREEN), wxGridBlockCoords(10, 10, 19, 19));
+        CHECK( getColour(9, 10) == *wxRED );
+        CHECK( getColour(10, 10) == *wxGREEN );
+        CHECK( getColour(19, 19) == *wxGREEN );
+        CHECK( getColour(20, 19) == *wxRED );
+
+        provider.SetBlockAttr(nullptr, wxGridBlockCoords(15, 0, 15, 999));
+        CHECK( getColour(14, 15) == *wxGREEN );
+        CHECK( !getColour(15, 15).IsOk() );
+        CHECK( !getColour(15, 500).IsOk() );
+        CHECK( getColour(16, 500) == *wxRED );
+
+        // This block hides all the previous ones.
+        provider.SetBlockAttr(makeAttr(*wxBLUE), wxGridBlockCoords(0, 0, 999, 999));
+        CHECK( getColour(15, 15) == *wxBLUE );
+        CHECK( getColour(10, 10) == *wxBLUE );
+    }
+
+    SECTION("Merge")
+    {
+        wxGridCellAttr* const attr = new wxGridCellAttr;
+        attr->SetTextColour(*wxGREEN);
+        provider.SetAttr(attr, 1, 1);
+
+        provider.SetColAttr(makeAttr(*wxBLUE), 1);
+
+        wxGridCellAttrPtr merged = provider.GetAttrPtr(1, 1, wxGridCellAttr::Any);
+        REQUIRE( merged );
+        CHECK( merged->GetTextColour() == *wxGREEN );
+        CHECK( merged->GetBackgroundColour() == *wxRED );
+
+        CHECK( getColour(1000, 1) == *wxBLUE );
+    }
+
+    SECTION("InsertRows")
+    {
+        provider.UpdateAttrRows(10, 5);
+        CHECK( getColour(9, 0) == *wxRED );
+        CHECK( !getColour(10, 0).IsOk() );
+        CHECK( !getColour(14, 0).IsOk() );
+        CHECK( getColour(15, 0) == *wxRED );
+        CHECK( getColour(1004, 0) == *wxRED );
+        CHECK( !getColour(1005, 0).IsOk() );
+
+        provider.UpdateAttrRows(0, 1);
+        CHECK( !getColour(0, 0).IsOk() );
+        CHECK( getColour(1, 0) == *wxRED );
+    }
+
+    SECTION("DeleteCols")
+    {
+        provider.UpdateAttrCols(990, -20);
+        CHECK( getColour(0, 989) == *wxRED );
+        CHECK( !getColour(0, 990).IsOk() );
+
+        provider.UpdateAttrCols(0, -10);
+        CHECK( getColour(0, 0) == *wxRED );
+        CHECK( getColour(0, 979) == *wxRED );
+        CHECK( !getColour(0, 980).IsOk() );
+
+        provider.UpdateAttrCols(0, -980);
+        CHECK( !getColour(0, 0).IsOk() );
+    }
+}
+
 #define CHECK_MULTICELL() CHECK_THAT( *m_grid, HasMulticellOnly(multi) )
 
 #define CHECK_NO_MULTICELL() CHECK_THAT( *m_grid, HasEmptyGrid() )
@@ -2621,6 +2812,76 @@ TEST_CASE("GridBlockCoords::SymDifference", "[grid]")
     }
 }
 
+TEST_CASE("GridLineEnds", "[grid]")
+{
+    // Compare the results with those computed naively for the given sizes.
+    std::vector<int> sizes;
+    wxGridLineEnds ends;
+
+    const auto checkAll = [&sizes, &ends]()
+    {
+        REQUIRE( ends.size() == sizes.size() );
+
+        int end = 0;
+        for ( size_t pos = 0; pos < sizes.size(); pos++ )
+        {
+            CHECK( ends.GetStart(pos) == end );
+
+            end += sizes[pos];
+            CHECK( ends.GetEnd(pos) == end );
+
+            if ( sizes[pos] )
+            {
+                CHECK( ends.FindLine(end - sizes[pos]) == pos );
+                CHECK( ends.FindLine(end - 1) == pos );
+            }
+        }
+
+        CHECK( ends.GetTotal() == end );
+        CHECK( ends.FindLine(end) == sizes.size() );
+    };
+
+    ends.Assign(37, 10);
+    sizes.assign(37, 10);
+    checkAll();
+
+    ends.Add(0, 5);
+    sizes[0] += 5;
+    ends.Add(20, -10);
+    sizes[20] -= 10;
+    checkAll();
+
+    ends.Insert(3, 5, 7);
+    sizes.insert(sizes.begin() + 3, 5, 7);
+    checkAll();
+
+    ends.Insert(ends.size(), 30, 3);
+    sizes.insert(sizes.end(), 30, 3);
+    checkAll();
+
+    ends.Remove(10, 20);
+    sizes.erase(sizes.begin() + 10, sizes.begin() + 30);
+    checkAll();
+
+    ends.Remove(40, ends.size() - 40);
+    sizes.resize(40);
+    checkAll();
+
+    // Check using the sizes of reordered lines with some hidden ones.
+    wxArrayInt sizesAt, lineAt;
+    for ( int n = 0; n < 10; n++ )
+    {
+        sizesAt.push_back(n % 3 ? n : -n);
+        lineAt.push_back(9 - n);
+    }
+
+    ends.Assign(sizesAt, lineAt);
+    sizes.clear();
+    for ( int n = 0; n < 10; n++ )
+        sizes.push_back((9 - n) % 3 ? 9 - n : 0);
+    checkAll();
+}
+
 TEST_CASE("wxGrid::Events", "[grid][event]")
 {
     const std::unique_ptr<wxGrid> grid(new wxGrid());
@@ -2634,6 +2895,175 @@ TEST_CASE("wxGrid::Events", "[grid][event]")
     CHECK( selectEvents.GetCount() == 0 );
 }
 
+TEST_CASE("GridColumnarTable::Values", "[grid][table]")
+{
+    wxGridColumnarTable table(3);
+    table.AppendColumn(wxGRID_COLUMN_STRING, "Name");
+    table.AppendColumn(wxGRID_COLUMN_INT);
+    table.AppendColumn(wxGRID_COLUMN_DOUBLE);
+    table.AppendColumn(wxGRID_COLUMN_BOOL);
+
+    REQUIRE( table.GetNumberRows() == 3 );
+    REQUIRE( table.GetNumberCols() == 4 );
+
+    CHECK( table.GetColLabelValue(0) == "Name" );
+    CHECK( table.GetColLabelValue(1) == "B" );
+
+    CHECK( table.GetTypeName(0, 0) == wxGRID_VALUE_STRING );
+    CHECK( table.GetTypeName(0, 1) == wxGRID_VALUE_NUMBER );
+    CHECK( table.GetTypeName(0, 2) == wxGRID_VALUE_FLOAT );
+    CHECK( table.GetTypeName(0, 3) == wxGRID_VALUE_BOOL );
+
+    // All cells are initially empty and can't be retrieved as typed values.
+    for ( int col = 0; col < table.GetNumberCols(); col++ )
+    {
+        CHECK( table.IsEmptyCell(0, col) );
+        CHECK( table.GetValue(0, col) == "" );
+        CHECK( table.CanGetValueAs(0, col, wxGRID_VALUE_STRING) );
+
+        if ( col > 0 )
+            CHECK( !table.CanGetValueAs(0, col, table.GetTypeName(0, col)) );
+    }
+
+    table.SetValue(0, 0, "foo");
+    CHECK( table.GetValue(0, 0) == "foo" );
+
+    table.SetValueAsLong(0, 1, 17);
+    CHECK( table.CanGetValueAs(0, 1, wxGRID_VALUE_NUMBER) );
+    CHECK( table.GetValueAsLong(0, 1) == 17 );
+    CHECK( table.GetValue(0, 1) == "17" );
+
+    table.SetValue(1, 1, "-42");
+    CHECK( table.GetValueAsLong(1, 1) == -42 );
+
+    table.SetValueAsInt64(2, 1, wxLL(1234567890123));
+    CHECK( table.GetValueAsInt64(2, 1) == wxLL(1234567890123) );
+    CHECK( table.GetValue(2, 1) == "1234567890123" );
+
+    table.SetValueAsDouble(0, 2, 0.5);
+    CHECK( table.GetValueAsDouble(0, 2) == 0.5 );
+
+    table.SetValueAsBool(0, 3, false);
+    CHECK( !table.IsEmptyCell(0, 3) );
+    CHECK( table.CanGetValueAs(0, 3, wxGRID_VALUE_BOOL) );
+    CHECK( !table.GetValueAsBool(0, 3) );
+
+    table.SetValue(1, 3, "1");
+    CHECK( table.GetValueAsBool(1, 3) );
+
+    // Setting a value which can't be parsed makes the cell empty.
+    table.SetValue(0, 1, "bar");
+    CHECK( table.IsEmptyCell(0, 1) );
+
+    table.ClearCell(0, 0);
+    CHECK( table.IsEmptyCell(0, 0) );
+
+    table.Clear();
+    CHECK( table.IsEmptyCell(1, 1) );
+    CHECK( table.GetNumberRows() == 3 );
+}
+
+TEST_CASE("GridColumnarTable::Strings", "[grid][table]")
+{
+    wxGridColumnarTable table(4);
+    table.AppendColumn(wxGRID_COLUMN_STRING);
+
+    table.SetValue(0, 0, "foo");
+    table.SetValue(1, 0, "bar");
+    table.SetValue(2, 0, "foo");
+
+    // Changing one of the cells sharing the string must not affect the other.
+    table.SetValue(0, 0, "baz");
+    CHECK( table.GetValue(2, 0) == "foo" );
+
+    // Reusing the string which is not used any longer must work too.
+    table.SetValue(1, 0, "");
+    table.SetValue(3, 0, "qux");
+    CHECK( table.GetValue(0, 0) == "baz" );
+    CHECK( table.GetValue(1, 0) == "" );
+    CHECK( table.GetValue(2, 0) == "foo" );
+    CHECK( table.GetValue(3, 0) == "qux" );
+
+    table.DeleteRows(0, 1);
+    CHECK( table.GetValue(1, 0) == "foo" );
+
+    table.SetValue(0, 0, "baz");
+    CHECK( table.GetValue(0, 0) == "baz" );
+}
+
+TEST_CASE("GridColumnarTable::InsertDelete", "[grid][table]")
+{
+    wxGridColumnarTable table(2);
+    table.AppendColumn(wxGRID_COLUMN_INT);
+    table.AppendColumn(wxGRID_COLUMN_DOUBLE);
+
+    table.SetValueAsLong(0, 0, 1);
+    table.SetValueAsLong(1, 0, 2);
+    table.SetValueAsDouble(1, 1, 2.5);
+
+    table.InsertRows(1, 2);
+    REQUIRE( table.GetNumberRows() == 4 );
+    CHECK( table.GetValueAsLong(0, 0) == 1 );
+    CHECK( table.IsEmptyCell(1, 0) );
+    CHECK( table.IsEmptyCell(2, 1) );
+    CHECK( table.GetValueAsLong(3, 0) == 2 );
+    CHECK( table.GetValueAsDouble(3, 1) == 2.5 );
+
+    table.DeleteRows(0, 3);
+    REQUIRE( table.GetNumberRows() == 1 );
+    CHECK( table.GetValueAsLong(0, 0) == 2 );
+
+    REQUIRE( table.InsertColumn(1, wxGRID_COLUMN_BOOL, "Flag") );
+    REQUIRE( table.GetNumberCols() == 3 );
+    CHECK( table.GetColumnType(1) == wxGRID_COLUMN_BOOL );
+    CHECK( table.GetColLabelValue(1) == "Flag" );
+    CHECK( table.GetValueAsDouble(0, 2) == 2.5 );
+
+    table.InsertCols(0);
+    CHECK( table.GetColumnType(0) == wxGRID_COLUMN_STRING );
+
+    // Delete the string and bool columns.
+    table.DeleteCols(0);
+    table.DeleteCols(1);
+    REQUIRE( table.GetNumberCols() == 2 );
+    CHECK( table.GetValueAsLong(0, 0) == 2 );
+    CHECK( table.GetValueAsDouble(0, 1) == 2.5 );
+}
+
+TEST_CASE("GridColumnarTable::ManyRows", "[grid][table]")
+{
+    // Use enough rows to have more than one chunk of storage.
+    wxGridColumnarTable table(10000);
+    table.AppendColumn(wxGRID_COLUMN_INT);
+    table.AppendColumn(wxGRID_COLUMN_STRING);
+
+    table.SetValueAsInt64(5, 0, 5);
+    table.SetValue(5, 1, "five");
+    table.SetValueAsInt64(9999, 0, 9999);
+    table.SetValue(9999, 1, "last");
+
+    CHECK( table.IsEmptyCell(4000, 0) );
+    CHECK( table.IsEmptyCell(4000, 1) );
+
+    table.InsertRows(1, 3000);
+    REQUIRE( table.GetNumberRows() == 13000 );
+    CHECK( table.IsEmptyCell(5, 0) );
+    CHECK( table.GetValueAsInt64(3005, 0) == 5 );
+    CHECK( table.GetValue(3005, 1) == "five" );
+    CHECK( table.GetValueAsInt64(12999, 0) == 9999 );
+    CHECK( table.GetValue(12999, 1) == "last" );
+
+    table.DeleteRows(0, 5000);
+    REQUIRE( table.GetNumberRows() == 8000 );
+    CHECK( table.IsEmptyCell(0, 0) );
+    CHECK( table.GetValueAsInt64(7999, 0) == 9999 );
+    CHECK( table.GetValue(7999, 1) == "last" );
+
+    table.ClearCell(7999, 1);
+    CHECK( table.IsEmptyCell(7999, 1) );
+    CHECK( table.GetValueAsInt64(7999, 0) == 9999 );
+}
+
 //
 // TestableGrid
 //
@@ -17,6 +17,8 @@
 
 #include "wx/richtext/richtextctrl.h"
 #include "wx/richtext/richtextstyles.h"
+#include "wx/richtext/richtextxml.h"
+#include "wx/mstream.h"
 #include "testableframe.h"
 #include "asserthelper.h"
 #include "wx/uiaction.h"
@@ -60,6 +62,10 @@ private:
         CPPUNIT_TEST( Delete );
         CPPUNIT_TEST( Url );
         CPPUNIT_TEST( Table );
+        CPPUNIT_TEST( ParagraphAtPosition );
+        CPPUNIT_TEST( LazyLayout );
+        CPPUNIT_TEST( XMLLoadSave );
+        CPPUNIT_TEST( InsertText );
     CPPUNIT_TEST_SUITE_END();
 
     void IsModified();
@@ -91,6 +97,10 @@ private:
     void Delete();
     void Url();
     void Table();
+    void ParagraphAtPosition();
+    void LazyLayout();
+    void XMLLoadSave();
+    void InsertText();
 
     wxRichTextCtrl* m_rich;
 
@@ -878,4 +888,190 @@ void RichTextCtrlTestCase::Table()
     m_rich->SetFocusObject(nullptr);
 }
 
+// Helper function for ::ParagraphAtPosition(): check that the paragraph found
+// for every position in the buffer is the one containing it.
+static void CheckParagraphsAtPositions(wxRichTextBuffer& buffer)
+{
+    buffer.UpdateRanges();
+
+    const wxRichTextObjectList& children = buffer.GetChildren();
+    for ( wxRichTextObjectList::compatibility_iterator node = children.GetFirst();
+          node;
+          node = node->GetNext() )
+    {
+        wxRichTextParagraph* para = wxDynamicCast(node->GetData(), wxRichTextParagraph);
+        CPPUNIT_ASSERT(para);
+
+        const wxRichTextRange range = para->GetRange();
+        for ( long pos = range.GetStart(); pos <= range.GetEnd(); pos++ )
+        {
+            CPPUNIT_ASSERT(buffer.GetParagraphAtPosition(pos) == para);
+
+            wxRichTextLine* line = buffer.GetLineAtPosition(pos);
+            CPPUNIT_ASSERT(line);
+            CPPUNIT_ASSERT(line->GetParent() == para);
+        }
+    }
+
+    CPPUNIT_ASSERT(!buffer.GetParagraphAtPosition(-1));
+    CPPUNIT_ASSERT(!buffer.GetParagraphAtPosition(buffer.GetOwnRange().GetEnd() + 1));
+}
+
+void RichTextCtrlTestCase::ParagraphAtPosition()
+{
+    // Use enough paragraphs for the buffer to index them.
+    for ( int n = 0; n < 100; n++ )
+        m_rich->AddParagraph(wxString::Format("Paragraph number %d", n));
+    m_rich->LayoutContent();
+
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    CheckParagraphsAtPositions(buffer);
+
+    wxRichTextParagraph* para = buffer.GetParagraphAtLine(50);
+    CPPUNIT_ASSERT(para);
+    CPPUNIT_ASSERT(buffer.GetParagraphAtPosition(para->GetRange().GetStart()) == para);
+
+    // Modify the buffer in different ways and check that the paragraphs are
+    // still found correctly.
+    m_rich->SetInsertionPoint(para->GetRange().GetStart() + 3);
+    m_rich->WriteText("inserted\nmulti\nline text");
+    m_rich->LayoutContent();
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Delete(wxRichTextRange(100, 400));
+    m_rich->LayoutContent();
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Undo();
+    m_rich->LayoutContent();
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Redo();
+    m_rich->LayoutContent();
+    CheckParagraphsAtPositions(buffer);
+
+    m_rich->Clear();
+    CPPUNIT_ASSERT(!buffer.GetParagraphAtPosition(10));
+}
+
+void RichTextCtrlTestCase::LazyLayout()
+{
+    m_rich->EnableLazyLayout();
+
+    m_rich->Freeze();
+    for ( int n = 0; n < 1000; n++ )
+        m_rich->AddParagraph(wxString::Format("This is the paragraph number %d", n));
+    m_rich->Thaw();
+
+    // Only the beginning of the buffer should have been laid out.
+    wxRichTextBuffer& buffer = m_rich->GetBuffer();
+    CPPUNIT_ASSERT(buffer.HasPendingLayout());
+    CPPUNIT_ASSERT(!buffer.GetParagraphAtLine(0)->GetLines().empty());
+    CPPUNIT_ASSERT(buffer.GetParagraphAtLine(999)->GetLines().empty());
+
+    // Making the end visible must lay it out.
+    m_rich->ShowPosition(buffer.GetOwnRange().GetEnd());
+    CPPUNIT_ASSERT(!buffer.GetParagraphAtLine(999)->GetLines().empty());
+
+    m_rich->ForceDelayedLayout();
+    CPPUNIT_ASSERT(!buffer.HasPendingLayout());
+
+    // The result must be the same as without using lazy layout.
+    const int height = buffer.GetCachedSize().y;
+
+    m_rich->EnableLazyLayout(false);
+    buffer.Invalidate(wxRICHTEXT_ALL);
+    m_rich->LayoutContent();
+    CPPUNIT_ASSERT(!buffer.HasPendingLayout());
+    CPPUNIT_ASSERT_EQUAL(height, buffer.GetCachedSize().y);
+}
+
+void RichTextCtrlTestCase::XMLLoadSave()
+{
+#if wxUSE_XML
+    m_rich->WriteText("Plain text with <special> & \"escaped\" characters");
+    m_rich->Newline();
+    m_rich->BeginBold();
+    m_rich->WriteText(wxString::FromUTF8("Bold na\xc3\xafve text"));
+    m_rich->EndBold();
+    m_rich->Newline();
+    m_rich->WriteTable(2, 2);
+
+    wxRichTextXMLHandler handler;
+    wxMemoryOutputStream out;
+    CPPUNIT_ASSERT(handler.SaveFile(&m_rich->GetBuffer(), out));
+
+    wxRichTextBuffer buffer;
+    wxMemoryInputStream in(out);
+    CPPUNIT_ASSERT(handler.LoadFile(&buffer, in));
+
+    CPPUNIT_ASSERT_EQUAL(m_rich->GetBuffer().GetText(), buffer.GetText());
+    CPPUNIT_ASSERT_EQUAL(m_rich->GetBuffer().GetChildCount(), buffer.GetChildCount());
+
+    wxRichTextAttr attr;
+    CPPUNIT_ASSERT(buffer.GetStyle(m_rich->GetBuffer().GetText().find("Bold"), attr));
+    CPPUNIT_ASSERT(attr.GetFontWeight() == wxFONTWEIGHT_BOLD);
+
+    // The table must have been loaded too.
+    wxRichTextParagraph* const para = wxDynamicCast(buffer.GetChild(2), wxRichTextParagraph);
+    CPPUNIT_ASSERT(para);
+
+    wxRichTextTable* table = nullptr;
+    for ( size_t n = 0; n < para->GetChildCount() && !table; n++ )
+        table = wxDynamicCast(para->GetChild(n), wxRichTextTable);
+    CPPUNIT_ASSERT(table);
+    CPPUNIT_ASSERT_EQUAL(2, table->GetRowCount());
+    CPPUNIT_ASSERT_EQUAL(2, table->GetColumnCount());
+
+    // Loading invalid document must fail and leave the buffer empty.
+    const char* const invalid = "<?xml version=\"1.0\"?><richtext><paragraphlayout>"
+                                "<paragraph><text>Unfinished</text></paragraph>";
+    wxMemoryInputStream inInvalid(invalid, strlen(invalid));
+    {
+        wxLogNull noLog;
+        CPPUNIT_ASSERT(!handler.LoadFile(&buffer, inInvalid));
+    }
+    CPPUNIT_ASSERT(buffer.GetText().empty());
+#endif // wxUSE_XML
+}
+
+void RichTextCtrlTestCase::InsertText()
+{
+    m_rich->WriteText("hello world");
+    m_rich->SetInsertionPoint(5);
+    m_rich->WriteText(",");
+
+    // Text with the same style is inserted into the existing text object.
+    wxRichTextParagraph* const para = wxDynamicCast(m_rich->GetBuffer().GetChild(0), wxRichTextParagraph);
+    CPPUNIT_ASSERT(para);
+    CPPUNIT_ASSERT_EQUAL(1, (int)para->GetChildCount());
+    CPPUNIT_ASSERT_EQUAL("hello, world", m_rich->GetValue());
+
+    m_rich->BeginBold();
+    m_rich->WriteText("!");
+    m_rich->EndBold();
+    CPPUNIT_ASSERT_EQUAL("hello,! world", m_rich->GetValue());
+    CPPUNIT_ASSERT_EQUAL(3, (int)para->GetChildCount());
+
+    m_rich->Undo();
+    m_rich->Undo();
+    CPPUNIT_ASSERT_EQUAL("hello world", m_rich->GetValue());
+
+    m_rich->Redo();
+    CPPUNIT_ASSERT_EQUAL("hello, world", m_rich->GetValue());
+
+    // Copies of the text objects share the text until it is modified.
+    wxRichTextPlainText text("abc");
+    text.SetRange(wxRichTextRange(0, 2));
+
+    wxRichTextPlainText copy(text);
+    CPPUNIT_ASSERT(&text.GetText() == &copy.GetText());
+
+    CPPUNIT_ASSERT(copy.InsertText(3, "d"));
+    CPPUNIT_ASSERT(!copy.InsertText(5, "e"));
+    CPPUNIT_ASSERT_EQUAL("abc", text.GetText());
+    CPPUNIT_ASSERT_EQUAL("abcd", copy.GetText());
+    CPPUNIT_ASSERT_EQUAL(3, copy.GetRange().GetEnd());
+}
+
 #endif //wxUSE_RICHTEXT
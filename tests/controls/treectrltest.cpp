@@ -702,4 +702,49 @@ TEST_CASE_METHOD(TreeCtrlTestCase, "wxTreeCtrl::Sort", "[treectrl]")
     CHECK(m_tree->GetNextChild(m_root, cookie) == zitem);
 }
 
+TEST_CASE_METHOD(TreeCtrlTestCase, "wxTreeCtrl::ManyItems", "[treectrl]")
+{
+    const int count = 10000;
+
+    const wxTreeItemId parent = m_tree->AppendItem(m_root, "parent");
+    wxTreeItemId first,
+                 last;
+    for ( int n = 0; n < count; n++ )
+    {
+        last = m_tree->AppendItem(parent, wxString::Format("item %d", n));
+        if ( !first.IsOk() )
+            first = last;
+    }
+
+    m_tree->Expand(parent);
+
+    wxRect rectParent, rectLast;
+    REQUIRE( m_tree->GetBoundingRect(parent, rectParent) );
+    REQUIRE( m_tree->GetBoundingRect(last, rectLast) );
+
+    const int height = rectParent.height;
+    CHECK( rectLast.y == rectParent.y + count*height );
+
+    // Collapsing or deleting items above the last one must move it up.
+    m_tree->Collapse(m_child1);
+
+    wxRect rect;
+    REQUIRE( m_tree->GetBoundingRect(last, rect) );
+    CHECK( rect.y == rectLast.y - height );
+
+    m_tree->Delete(first);
+
+    REQUIRE( m_tree->GetBoundingRect(last, rect) );
+    CHECK( rect.y == rectLast.y - 2*height );
+
+    // And hit testing must find it once it's scrolled into view.
+    m_tree->EnsureVisible(last);
+
+    REQUIRE( m_tree->GetBoundingRect(last, rect, true) );
+
+    int flags = 0;
+    CHECK( m_tree->HitTest(wxPoint(rect.x + 1, rect.y + height/2), flags) == last );
+    CHECK( (flags & wxTREE_HITTEST_ONITEMLABEL) );
+}
+
 #endif //wxUSE_TREECTRL
@@ -23,6 +23,8 @@
 #include "testableframe.h"
 #include "wx/uiaction.h"
 
+#include <memory>
+
 // ----------------------------------------------------------------------------
 // test class
 // ----------------------------------------------------------------------------
@@ -149,4 +151,98 @@ void VirtListCtrlTestCase::DeselectedEvent()
 #endif
 }
 
+TEST_CASE("wxListCtrl::VirtualCache", "[listctrl][virtual]")
+{
+    // Virtual list control returning the texts depending on the "version"
+    // which can be changed to check that the cache is invalidated.
+    class CountingListCtrl : public wxListCtrl
+    {
+    public:
+        CountingListCtrl()
+            : wxListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                         wxPoint(0, 0), wxSize(400, 200),
+                         wxLC_REPORT | wxLC_VIRTUAL)
+        {
+            AppendColumn("Col0");
+            AppendColumn("Col1");
+        }
+
+        mutable int m_calls = 0;
+        int m_version = 0;
+
+    protected:
+        virtual wxString OnGetItemText(long item, long column) const override
+        {
+            m_calls++;
+            return wxString::Format("%d: %ld, %ld", m_version, item, column);
+        }
+    };
+
+    std::unique_ptr<CountingListCtrl> list(new CountingListCtrl);
+    list->SetItemCount(1000);
+    list->EnableVirtualCache();
+
+    CHECK( list->GetItemText(500, 1) == "0: 500, 1" );
+    CHECK( list->GetItemText(10) == "0: 10, 0" );
+
+    list->m_version = 1;
+    list->RefreshItem(500);
+    CHECK( list->GetItemText(500, 1) == "1: 500, 1" );
+
+    // The item 10 is on a different page which must not have been affected.
+    // Notice that only the generic version really uses the cache.
+#if !(defined(__WXMSW__) || defined(__WXQT__)) || defined(__WXUNIVERSAL__)
+    const int calls = list->m_calls;
+    CHECK( list->GetItemText(10) == "0: 10, 0" );
+    CHECK( list->GetItemText(11, 1) == "0: 11, 1" );
+    CHECK( list->m_calls == calls );
+#endif
+
+    list->InvalidateVirtualCache();
+    CHECK( list->GetItemText(10) == "1: 10, 0" );
+}
+
+TEST_CASE("wxListCtrl::VirtualCachePrefetch", "[listctrl][virtual]")
+{
+    // Virtual list control with thread-safe OnGetItemText(), as required for
+    // prefetching the items in background.
+    class PrefetchListCtrl : public wxListCtrl
+    {
+    public:
+        PrefetchListCtrl()
+            : wxListCtrl(wxTheApp->GetTopWindow(), wxID_ANY,
+                         wxPoint(0, 0), wxSize(400, 200),
+                         wxLC_REPORT | wxLC_VIRTUAL)
+        {
+            AppendColumn("Col0");
+        }
+
+        ~PrefetchListCtrl()
+        {
+            // This must be done to ensure that OnGetItemText() is not called
+            // from the worker threads after this object is destroyed.
+            EnableVirtualCache(false);
+        }
+
+    protected:
+        virtual wxString OnGetItemText(long item, long column) const override
+        {
+            return wxString::Format("%ld, %ld", item, column);
+        }
+    };
+
+    std::unique_ptr<PrefetchListCtrl> list(new PrefetchListCtrl);
+    list->SetItemCount(100000);
+    list->EnableVirtualCache(true, true /* prefetch */);
+
+    // Drawing the control starts prefetching the items around the visible
+    // ones, destroying it while this is in progress must be safe.
+    list->Refresh();
+    list->Update();
+    wxYield();
+
+    CHECK( list->GetItemText(0) == "0, 0" );
+    CHECK( list->GetItemText(99999) == "99999, 0" );
+}
+
 #endif // wxUSE_LISTCTRL
@@ -30,6 +30,7 @@
 #include "wx/dcmemory.h"
 #include "wx/dcps.h"
 #include "wx/metafile.h"
+#include "wx/textextentcache.h"
 
 #include "asserthelper.h"
 
@@ -167,6 +168,56 @@ TEST_CASE("wxDC::GetPartialTextExtent", "[dc][text-extent][partial]")
     CHECK( widths[4] == dc.GetTextExtent("Hello").x );
 }
 
+// Only these ports use wxTextMeasure, and hence the cache, for measuring the
+// text in the windows.
+#if defined(__WXGTK__) || defined(__WXMSW__)
+
+TEST_CASE("wxTextExtentCache", "[window][text-extent][cache]")
+{
+    wxWindow* const win = wxTheApp->GetTopWindow();
+
+    const size_t maxMemoryOrig = wxTextExtentCache::GetMaxMemory();
+
+    wxTextExtentCache::Clear();
+    wxTextExtentCache::ResetStats();
+
+    const wxSize size = win->GetTextExtent("Measured twice");
+    CHECK( wxTextExtentCache::GetStats().hits == 0 );
+    CHECK( wxTextExtentCache::GetStats().entries == 1 );
+
+    CHECK( win->GetTextExtent("Measured twice") == size );
+    CHECK( wxTextExtentCache::GetStats().hits == 1 );
+    CHECK( wxTextExtentCache::GetStats().GetHitRate() == 0.5 );
+
+    SECTION("Memory limit")
+    {
+        wxTextExtentCache::SetMaxMemory(4096);
+        for ( int n = 0; n < 1000; n++ )
+            win->GetTextExtent(wxString::Format("String #%d", n));
+
+        const wxTextExtentCache::Stats stats = wxTextExtentCache::GetStats();
+        CHECK( stats.memoryUsed <= 4096 );
+        CHECK( stats.evictions > 0 );
+        CHECK( stats.entries < 1000 );
+
+        // The evicted strings must still be measured correctly.
+        CHECK( win->GetTextExtent("Measured twice") == size );
+    }
+
+    SECTION("Disabled")
+    {
+        wxTextExtentCache::SetMaxMemory(0);
+        CHECK( wxTextExtentCache::GetStats().entries == 0 );
+
+        CHECK( win->GetTextExtent("Measured twice") == size );
+        CHECK( wxTextExtentCache::GetStats().entries == 0 );
+    }
+
+    wxTextExtentCache::SetMaxMemory(maxMemoryOrig);
+}
+
+#endif // __WXGTK__ || __WXMSW__
+
 #ifdef TEST_GC
 
 TEST_CASE("wxGC::GetTextExtent", "[dc][text-extent]")
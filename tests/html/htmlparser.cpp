@@ -42,6 +42,52 @@ TEST_CASE("wxHtmlParser::ParseInvalid", "[html][parser][error]")
     delete p.Parse("<!---");
 }
 
+TEST_CASE("wxHtmlParser::Params", "[html][parser]")
+{
+    class ParamsHandler : public wxHtmlTagHandler
+    {
+    public:
+        explicit ParamsHandler(wxArrayString& params) : m_params(params) { }
+
+        wxString GetSupportedTags() override { return "A,DIV,P"; }
+
+        bool HandleTag(const wxHtmlTag& tag) override
+        {
+            m_params.push_back(tag.GetName() + ":" + tag.GetAllParams());
+            return false;
+        }
+
+    private:
+        wxArrayString& m_params;
+    };
+
+    class ParamsParser : public wxHtmlParser
+    {
+    public:
+        explicit ParamsParser(wxArrayString& params)
+        {
+            AddTagHandler(new ParamsHandler(params));
+        }
+
+        wxObject* GetProduct() override { return nullptr; }
+
+    protected:
+        void AddText(const wxString& WXUNUSED(txt)) override { }
+    };
+
+    wxArrayString params;
+    ParamsParser p(params);
+
+    p.Parse("<p align=center class=x>"
+            "<a HREF=\"a&amp;b.html\" title='1 > 0' hidden>"
+            "<div style=\"text-align: right\"></div>");
+
+    REQUIRE( params.size() == 3 );
+    CHECK( params[0] == "P:align=\"CENTER\"class=\"x\"" );
+    CHECK( params[1] == "A:HREF=\"a&b.html\"title=\"1 > 0\"hidden=\"\"" );
+    CHECK( params[2] == "DIV:style=\"text-align: right\"ALIGN=\"right\"" );
+}
+
 TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
 {
     wxMemoryDC dc;
@@ -102,4 +148,32 @@ TEST_CASE("wxHtmlCell::Detach", "[html][cell]")
     }
 }
 
+TEST_CASE("wxHtmlContainerCell::CanLayoutChildrenLazily", "[html][cell]")
+{
+    wxHtmlWinParser p;
+    wxMemoryDC dc;
+    p.SetDC(&dc);
+
+    // The containers created by the parser itself use the default layout.
+    std::unique_ptr<wxHtmlContainerCell> const
+        top(static_cast<wxHtmlContainerCell*>(p.Parse("<p>Hello</p>")));
+    REQUIRE( top );
+    CHECK( top->CanLayoutChildrenLazily() );
+
+    // But the ones created by the application are not assumed to do it.
+    class MyContainerCell : public wxHtmlContainerCell
+    {
+    public:
+        MyContainerCell() : wxHtmlContainerCell(nullptr) { }
+
+        virtual void Layout(int w) override
+        {
+            wxHtmlContainerCell::Layout(w);
+        }
+    };
+
+    MyContainerCell cont;
+    CHECK( !cont.CanLayoutChildrenLazily() );
+}
+
 #endif //wxUSE_HTML
@@ -44,6 +44,8 @@ private:
         WXUISIM_TEST( LinkClick );
 #endif // wxUSE_UIACTIONSIMULATOR
         CPPUNIT_TEST( AppendToPage );
+        CPPUNIT_TEST( LazyLayout );
+        CPPUNIT_TEST( FindCellByPos );
     CPPUNIT_TEST_SUITE_END();
 
     void SelectionToText();
@@ -51,6 +53,8 @@ private:
     void CellClick();
     void LinkClick();
     void AppendToPage();
+    void LazyLayout();
+    void FindCellByPos();
 
     wxHtmlWindow *m_win;
 
@@ -166,4 +170,93 @@ void HtmlWindowTestCase::AppendToPage()
 #endif // wxUSE_CLIPBOARD
 }
 
+void HtmlWindowTestCase::LazyLayout()
+{
+    wxString page("<html><body>");
+    for ( int n = 0; n < 500; n++ )
+    {
+        page += wxString::Format("<p>Paragraph %d containing enough words to "
+                                 "be wrapped over several lines.</p>", n);
+    }
+    page += "<div><p>Last paragraph with <a name=\"end\">anchor</a>.</p></div>"
+            "</body></html>";
+
+    m_win->SetPage(page);
+
+    wxHtmlContainerCell* cell = m_win->GetInternalRepresentation();
+    CPPUNIT_ASSERT( !cell->HasPendingLayout() );
+
+    const wxString anchor("end");
+    const wxHtmlCell* anchorCell = cell->Find(wxHTML_COND_ISANCHOR, &anchor);
+    CPPUNIT_ASSERT( anchorCell );
+
+    const int height = cell->GetHeight();
+    const wxPoint anchorPos = anchorCell->GetAbsPos();
+    const wxPoint anchorPosInParent = anchorCell->GetAbsPos(anchorCell->GetParent());
+
+    // Only the beginning of the page is laid out immediately.
+    m_win->EnableLazyLayout();
+    CPPUNIT_ASSERT( cell->HasPendingLayout() );
+
+    // But the anchor position must be correct if it's requested explicitly,
+    // at least relatively to its container as the paragraphs above it are
+    // still not laid out.
+    cell->EnsureLaidOut(anchorCell);
+    CPPUNIT_ASSERT_EQUAL( anchorPosInParent,
+                          anchorCell->GetAbsPos(anchorCell->GetParent()) );
+
+    // And once everything is laid out, the result must be the same as without
+    // lazy layout.
+    while ( cell->HasPendingLayout() )
+        cell->LayoutPending(10);
+
+    CPPUNIT_ASSERT_EQUAL( height, cell->GetHeight() );
+    CPPUNIT_ASSERT_EQUAL( anchorPos, anchorCell->GetAbsPos() );
+}
+
+void HtmlWindowTestCase::FindCellByPos()
+{
+    // Use enough paragraphs and words in them for the containers to use the
+    // index of their children.
+    wxString page("<html><body>");
+    for ( int n = 0; n < 100; n++ )
+    {
+        page += wxString::Format("<p>Paragraph %d containing", n);
+        for ( int m = 0; m < 50; m++ )
+            page += wxString::Format(" <a href=\"#%d\">word</a>", m);
+        page += "</p>";
+    }
+    page += "</body></html>";
+
+    m_win->SetPage(page);
+
+    const wxHtmlContainerCell* const cell = m_win->GetInternalRepresentation();
+
+    int checked = 0;
+    const wxHtmlCell* last = nullptr;
+    for ( wxHtmlTerminalCellsInterator i(cell->GetFirstTerminal(),
+                                         cell->GetLastTerminal()); i; ++i )
+    {
+        if ( !i->GetWidth() || !i->GetHeight() )
+            continue;
+
+        const wxPoint pos = i->GetAbsPos();
+        const int x = pos.x + i->GetWidth() / 2;
+        const int y = pos.y + i->GetHeight() / 2;
+        CPPUNIT_ASSERT_EQUAL( *i, cell->FindCellByPos(x, y) );
+        CPPUNIT_ASSERT_EQUAL( *i, cell->FindCellByPos(x, y, wxHTML_FIND_NEAREST_BEFORE) );
+        CPPUNIT_ASSERT_EQUAL( *i, cell->FindCellByPos(x, y, wxHTML_FIND_NEAREST_AFTER) );
+
+        last = *i;
+        checked++;
+    }
+
+    CPPUNIT_ASSERT( checked > 5000 );
+
+    // Positions outside of any cell are handled too.
+    CPPUNIT_ASSERT( !cell->FindCellByPos(0, cell->GetHeight() + 10) );
+    CPPUNIT_ASSERT_EQUAL( last, cell->FindCellByPos(0, cell->GetHeight() + 10,
+                                                    wxHTML_FIND_NEAREST_BEFORE) );
+}
+
 #endif //wxUSE_HTML
@@ -193,6 +193,22 @@ TEST_CASE("wxHtmlPrintout::Pagination", "[html][print]")
        );
     INFO("Using base font size " << fontFixedPixelSize.GetPointSize());
     CHECK( CountPages(pr) == 3 );
+
+    // Check that explicit page breaks work in long documents too.
+    wxString longText;
+    for ( int n = 0; n < 100; n++ )
+    {
+        if ( n )
+            longText += "<div style=\"page-break-before:always\"/>";
+        longText += wxString::Format("<p>Paragraph %d</p>", n);
+    }
+
+    pr.SetHtmlText(longText);
+    CHECK( CountPages(pr) == 100 );
+
+    // Preparing the same document for printing again reuses its layout, but
+    // must still give the same result.
+    CHECK( CountPages(pr) == 100 );
 }
 
 #endif //wxUSE_HTML
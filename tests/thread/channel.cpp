@@ -0,0 +1,228 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/channel.cpp
+// Purpose:     Unit test for wxSPSCChannel and wxMPMCChannel
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#include "wx/channel.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+template <typename Channel>
+void DoTryTest()
+{
+    Channel channel(3);
+    REQUIRE( channel.IsOk() );
+    CHECK( channel.GetCapacity() == 4 );
+    CHECK( channel.IsEmpty() );
+
+    int n;
+    CHECK( !channel.TryPop(n) );
+
+    for ( int i = 0; i < 4; i++ )
+        CHECK( channel.TryPush(i) );
+
+    CHECK( !channel.TryPush(4) );
+    CHECK( channel.GetSize() == 4 );
+
+    for ( int i = 0; i < 4; i++ )
+    {
+        REQUIRE( channel.TryPop(n) );
+        CHECK( n == i );
+    }
+
+    CHECK( !channel.TryPop(n) );
+    CHECK( channel.IsEmpty() );
+}
+
+template <typename Channel>
+void DoTimeoutTest()
+{
+    Channel channel(2);
+
+    int n = 0;
+    CHECK( channel.PopTimeout(0, n) == wxMSGQUEUE_TIMEOUT );
+    CHECK( channel.PopTimeout(10, n) == wxMSGQUEUE_TIMEOUT );
+
+    CHECK( channel.Push(1) == wxMSGQUEUE_NO_ERROR );
+    CHECK( channel.Push(2) == wxMSGQUEUE_NO_ERROR );
+    CHECK( channel.PushTimeout(10, 3) == wxMSGQUEUE_TIMEOUT );
+
+    CHECK( channel.PopTimeout(10, n) == wxMSGQUEUE_NO_ERROR );
+    CHECK( n == 1 );
+}
+
+template <typename Channel>
+void DoBatchTest()
+{
+    Channel channel(8);
+
+    const int in[] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    CHECK( channel.TryPushBatch(in, WXSIZEOF(in)) == 8 );
+
+    int out[10];
+    CHECK( channel.TryPopBatch(out, 5) == 5 );
+    CHECK( out[4] == 5 );
+
+    CHECK( channel.PopBatch(out, WXSIZEOF(out)) == 3 );
+    CHECK( out[0] == 6 );
+    CHECK( out[2] == 8 );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxChannel::Capacity", "[channel]")
+{
+    using wxPrivate::ChannelRoundCapacity;
+
+    CHECK( ChannelRoundCapacity(0) == 2 );
+    CHECK( ChannelRoundCapacity(2) == 2 );
+    CHECK( ChannelRoundCapacity(5) == 8 );
+    CHECK( ChannelRoundCapacity(1024) == 1024 );
+
+    const size_t maxCapacity = static_cast<size_t>(-1) / 2 + 1;
+    CHECK( ChannelRoundCapacity(maxCapacity) == maxCapacity );
+    WX_ASSERT_FAILS_WITH_ASSERT( ChannelRoundCapacity(maxCapacity + 1) );
+}
+
+TEST_CASE("wxChannel::Try", "[channel]")
+{
+    SECTION("SPSC") { DoTryTest<wxSPSCChannel<int>>(); }
+    SECTION("MPMC") { DoTryTest<wxMPMCChannel<int>>(); }
+}
+
+TEST_CASE("wxChannel::Timeout", "[channel]")
+{
+    SECTION("SPSC") { DoTimeoutTest<wxSPSCChannel<int>>(); }
+    SECTION("MPMC") { DoTimeoutTest<wxMPMCChannel<int>>(); }
+}
+
+TEST_CASE("wxChannel::Batch", "[channel]")
+{
+    SECTION("SPSC") { DoBatchTest<wxSPSCChannel<int>>(); }
+    SECTION("MPMC") { DoBatchTest<wxMPMCChannel<int>>(); }
+}
+
+TEST_CASE("wxSPSCChannel::Threads", "[channel]")
+{
+    // Use a small channel to make both the producer and the consumer block.
+    wxSPSCChannel<int> channel(16);
+
+    const int count = 100000;
+
+    std::thread producer([&channel]()
+        {
+            std::vector<int> batch;
+            for ( int i = 0; i < count; )
+            {
+                if ( i % 3 )
+                {
+                    channel.Push(i++);
+                    continue;
+                }
+
+                batch.clear();
+                for ( int j = 0; j < 10 && i < count; j++ )
+                    batch.push_back(i++);
+
+                channel.PushBatch(&batch[0], batch.size());
+            }
+        });
+
+    int next = 0;
+    while ( next < count )
+    {
+        int n = -1;
+        REQUIRE( channel.Pop(n) == wxMSGQUEUE_NO_ERROR );
+        if ( n != next )
+        {
+            FAIL_CHECK( "Expected " << next << " but got " << n );
+            break;
+        }
+
+        next++;
+    }
+
+    producer.join();
+
+    CHECK( channel.IsEmpty() );
+}
+
+TEST_CASE("wxMPMCChannel::Threads", "[channel]")
+{
+    wxMPMCChannel<long> channel(64);
+
+    const int numProducers = 4,
+              numConsumers = 3;
+    const long count = 50000;
+
+    std::vector<std::thread> threads;
+    for ( int i = 0; i < numProducers; i++ )
+    {
+        threads.emplace_back([&channel]()
+            {
+                for ( long n = 1; n <= count; n++ )
+                    channel.Push(n);
+            });
+    }
+
+    // Each consumer stops when it gets 0, which is never sent by producers.
+    std::vector<long> sums(numConsumers);
+    for ( int i = 0; i < numConsumers; i++ )
+    {
+        threads.emplace_back([&channel, &sums, i]()
+            {
+                long n;
+                while ( channel.Pop(n) == wxMSGQUEUE_NO_ERROR && n )
+                    sums[i] += n;
+            });
+    }
+
+    for ( int i = 0; i < numProducers; i++ )
+        threads[i].join();
+
+    for ( int i = 0; i < numConsumers; i++ )
+        channel.Push(0);
+
+    for ( int i = 0; i < numConsumers; i++ )
+        threads[numProducers + i].join();
+
+    long total = 0;
+    for ( int i = 0; i < numConsumers; i++ )
+        total += sums[i];
+
+    CHECK( total == numProducers*count*(count + 1)/2 );
+}
+
+TEST_CASE("wxChannel::NonCopyable", "[channel]")
+{
+    wxMPMCChannel<std::unique_ptr<int>> channel(4);
+
+    CHECK( channel.TryPush(std::unique_ptr<int>(new int(17))) );
+    CHECK( channel.Push(std::unique_ptr<int>(new int(42))) == wxMSGQUEUE_NO_ERROR );
+
+    std::unique_ptr<int> p;
+    REQUIRE( channel.Pop(p) == wxMSGQUEUE_NO_ERROR );
+    CHECK( *p == 17 );
+
+    // The remaining element must be destroyed by the channel dtor.
+}
@@ -19,7 +19,9 @@
 #include "wx/thread.h"
 #include "wx/utils.h"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 #include <vector>
 
 // ----------------------------------------------------------------------------
@@ -418,3 +420,191 @@ void MiscThreadTestCase::TestThreadConditions()
         nFinished++;
     }
 }
+
+// ----------------------------------------------------------------------------
+// synchronization objects tests
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// Increment the counter from several threads while holding the lock.
+template <typename Lock, typename Locker>
+void IncrementConcurrently(Lock& lock, long& counter)
+{
+    const int numThreads = 4;
+    const long numIterations = 100000;
+
+    std::vector<std::thread> threads;
+    for ( int n = 0; n < numThreads; n++ )
+    {
+        threads.emplace_back([&lock, &counter]()
+            {
+                for ( long i = 0; i < numIterations; i++ )
+                {
+                    Locker locker(lock);
+                    counter++;
+                }
+            });
+    }
+
+    for ( auto& t : threads )
+        t.join();
+
+    CHECK( counter == numThreads*numIterations );
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxCriticalSection::Recursive", "[thread][critsect]")
+{
+    wxCriticalSection cs;
+
+    cs.Enter();
+    cs.Enter();
+    CHECK( cs.TryEnter() );
+    cs.Leave();
+    cs.Leave();
+
+    // The critical section is still owned by this thread.
+    bool entered = true;
+    std::thread([&cs, &entered]() { entered = cs.TryEnter(); }).join();
+    CHECK( !entered );
+
+    cs.Leave();
+
+    std::thread([&cs, &entered]()
+        {
+            entered = cs.TryEnter();
+            if ( entered )
+                cs.Leave();
+        }).join();
+    CHECK( entered );
+}
+
+TEST_CASE("wxCriticalSection::NonRecursive", "[thread][critsect]")
+{
+    wxCriticalSection cs(wxCRITSEC_NON_RECURSIVE);
+
+    cs.Enter();
+
+    // Under MSW, critical sections are always recursive, so we can only check
+    // that a non-recursive one can't be re-entered under the other platforms.
+#ifndef __WINDOWS__
+    CHECK( !cs.TryEnter() );
+#endif
+
+    cs.Leave();
+
+    CHECK( cs.TryEnter() );
+    cs.Leave();
+}
+
+TEST_CASE("wxCriticalSection::Contention", "[thread][critsect]")
+{
+    long counter = 0;
+
+    SECTION("Recursive")
+    {
+        wxCriticalSection cs;
+        IncrementConcurrently<wxCriticalSection, wxCriticalSectionLocker>(cs, counter);
+    }
+
+    SECTION("NonRecursive")
+    {
+        wxCriticalSection cs(wxCRITSEC_NON_RECURSIVE);
+        IncrementConcurrently<wxCriticalSection, wxCriticalSectionLocker>(cs, counter);
+    }
+}
+
+TEST_CASE("wxMutex::Adaptive", "[thread][mutex]")
+{
+    wxMutex mutex(wxMUTEX_ADAPTIVE);
+    REQUIRE( mutex.IsOk() );
+
+    CHECK( mutex.Lock() == wxMUTEX_NO_ERROR );
+    CHECK( mutex.Lock() == wxMUTEX_DEAD_LOCK );
+    CHECK( mutex.Unlock() == wxMUTEX_NO_ERROR );
+
+    long counter = 0;
+    IncrementConcurrently<wxMutex, wxMutexLocker>(mutex, counter);
+}
+
+TEST_CASE("wxSharedMutex", "[thread][mutex]")
+{
+    wxSharedMutex mutex;
+    REQUIRE( mutex.IsOk() );
+
+    SECTION("Shared")
+    {
+        CHECK( mutex.LockShared() == wxMUTEX_NO_ERROR );
+
+        // Other readers can lock it, but not the writers.
+        wxMutexError rcShared = wxMUTEX_MISC_ERROR,
+                     rcExclusive = wxMUTEX_MISC_ERROR;
+        std::thread([&]()
+            {
+                rcShared = mutex.TryLockShared();
+                if ( rcShared == wxMUTEX_NO_ERROR )
+                    mutex.UnlockShared();
+
+                rcExclusive = mutex.TryLock();
+            }).join();
+
+        CHECK( rcShared == wxMUTEX_NO_ERROR );
+        CHECK( rcExclusive == wxMUTEX_BUSY );
+
+        CHECK( mutex.UnlockShared() == wxMUTEX_NO_ERROR );
+    }
+
+    SECTION("Exclusive")
+    {
+        CHECK( mutex.Lock() == wxMUTEX_NO_ERROR );
+
+        wxMutexError rc = wxMUTEX_MISC_ERROR;
+        std::thread([&]() { rc = mutex.TryLockShared(); }).join();
+        CHECK( rc == wxMUTEX_BUSY );
+
+        CHECK( mutex.Unlock() == wxMUTEX_NO_ERROR );
+    }
+
+    SECTION("Concurrent")
+    {
+        long counter = 0;
+        IncrementConcurrently<wxSharedMutex, wxWriteLocker>(mutex, counter);
+
+        // Check that readers see consistent values while writers modify them.
+        long values[2] = { 0, 0 };
+        std::atomic<bool> consistent(true);
+
+        std::vector<std::thread> threads;
+        threads.emplace_back([&]()
+            {
+                for ( int i = 0; i < 10000; i++ )
+                {
+                    wxWriteLocker lock(mutex);
+                    values[0]++;
+                    values[1]++;
+                }
+            });
+
+        for ( int n = 0; n < 3; n++ )
+        {
+            threads.emplace_back([&]()
+                {
+                    for ( int i = 0; i < 10000; i++ )
+                    {
+                        wxReadLocker lock(mutex);
+                        if ( values[0] != values[1] )
+                            consistent = false;
+                    }
+                });
+        }
+
+        for ( auto& t : threads )
+            t.join();
+
+        CHECK( consistent );
+        CHECK( values[0] == 10000 );
+    }
+}
@@ -0,0 +1,203 @@
+///////////////////////////////////////////////////////////////////////////////
+// Name:        tests/thread/threadpool.cpp
+// Purpose:     Unit test for wxThreadPool and parallel algorithms
+// Author:      wxWidgets development team
+// Created:     2026-10-18
+// Copyright:   (c) 2026 wxWidgets development team
+// Licence:     wxWindows licence
+///////////////////////////////////////////////////////////////////////////////
+
+// ----------------------------------------------------------------------------
+// headers
+// ----------------------------------------------------------------------------
+
+#include "testprec.h"
+
+
+#include "wx/threadpool.h"
+#include "wx/module.h"
+#include "wx/parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// tests
+// ----------------------------------------------------------------------------
+
+TEST_CASE("wxThreadPool::Post", "[threadpool]")
+{
+    wxThreadPool pool(4);
+    CHECK( pool.GetThreadCount() == 4 );
+
+    std::atomic<int> count(0);
+    for ( int n = 0; n < 1000; n++ )
+        pool.Post([&count]() { count++; });
+
+    pool.WaitAll();
+
+    CHECK( count == 1000 );
+    CHECK( pool.GetUnfinishedCount() == 0 );
+}
+
+TEST_CASE("wxThreadPool::Submit", "[threadpool]")
+{
+    wxThreadPool pool(2);
+
+    wxFuture<int> f = pool.Submit([]() { return 17; });
+    REQUIRE( f.IsValid() );
+    CHECK( f.Get() == 17 );
+    CHECK( f.IsReady() );
+    CHECK( !f.IsCancelled() );
+
+    wxFuture<void> v = pool.Submit([]() { });
+    v.Wait();
+    CHECK( v.IsReady() );
+
+    SECTION("Cancel")
+    {
+        wxCancellationSource source;
+        source.Cancel();
+
+        bool executed = false;
+        wxFuture<int> c = pool.Submit([&executed]() { executed = true; return 1; },
+                                      source.GetToken());
+        c.Wait();
+        CHECK( c.IsCancelled() );
+        CHECK( c.Get() == 0 );
+        CHECK( !executed );
+    }
+
+#if wxUSE_EXCEPTIONS
+    SECTION("Exception")
+    {
+        wxFuture<int> e = pool.Submit([]() -> int { throw 42; });
+        CHECK_THROWS_AS( e.Get(), int );
+    }
+#endif // wxUSE_EXCEPTIONS
+}
+
+namespace
+{
+
+// Recursive function submitting tasks from the worker threads and waiting for
+// them: this would deadlock if waiting in a worker didn't run other tasks.
+int Fibonacci(wxThreadPool& pool, int n)
+{
+    if ( n < 2 )
+        return n;
+
+    wxFuture<int> f = pool.Submit([&pool, n]() { return Fibonacci(pool, n - 1); });
+    const int b = Fibonacci(pool, n - 2);
+
+    return f.Get() + b;
+}
+
+} // anonymous namespace
+
+TEST_CASE("wxThreadPool::Nested", "[threadpool]")
+{
+    wxThreadPool pool(2);
+
+    CHECK( Fibonacci(pool, 15) == 610 );
+}
+
+TEST_CASE("wxThreadPool::Shutdown", "[threadpool]")
+{
+    // Use a separate instance of the module cleaning up the global pool to
+    // simulate the library shutdown and initialization.
+    wxClassInfo* const ci = wxClassInfo::FindClass("wxThreadPoolModule");
+    REQUIRE( ci );
+
+    std::unique_ptr<wxModule> module(wxDynamicCast(ci->CreateObject(), wxModule));
+    REQUIRE( module );
+
+    // The tasks running while the pool is being destroyed must still complete
+    // and see that the global pool can't be used any more.
+    std::atomic<bool> sawUnavailable(false);
+    wxThreadPool::Get().Post([&sawUnavailable]()
+        {
+            // Wait for the cleanup to start, but not forever.
+            for ( int n = 0; n < 5000; n++ )
+            {
+                if ( !wxThreadPool::GetIfAvailable() )
+                {
+                    sawUnavailable = true;
+                    break;
+                }
+
+                wxMilliSleep(1);
+            }
+        });
+
+    module->Exit();
+    CHECK( sawUnavailable );
+
+    // After the cleanup the pool can't be used.
+    CHECK( !wxThreadPool::GetIfAvailable() );
+    WX_ASSERT_FAILS_WITH_ASSERT( wxThreadPool::Get() );
+
+    // But it can be used again after initializing the library again.
+    CHECK( module->Init() );
+    REQUIRE( wxThreadPool::GetIfAvailable() );
+    CHECK( wxThreadPool::Get().Submit([]() { return 17; }).Get() == 17 );
+}
+
+TEST_CASE("wxCancellationToken", "[threadpool]")
+{
+    wxCancellationToken never;
+    CHECK( !never.CanBeCancelled() );
+    CHECK( !never.IsCancelled() );
+
+    wxCancellationSource source;
+    wxCancellationToken token = source.GetToken();
+    CHECK( token.CanBeCancelled() );
+    CHECK( !token.IsCancelled() );
+
+    source.Cancel();
+    CHECK( token.IsCancelled() );
+    CHECK( source.IsCancelled() );
+}
+
+TEST_CASE("wxParallelFor", "[threadpool][parallel]")
+{
+    wxThreadPool pool(4);
+
+    std::vector<int> v(10000);
+    wxParallelFor(0, v.size(), [&v](size_t n) { v[n] = n % 7; }, 100, &pool);
+
+    for ( size_t n = 0; n < v.size(); n++ )
+    {
+        if ( v[n] != static_cast<int>(n % 7) )
+        {
+            FAIL_CHECK( "Wrong value at " << n );
+            break;
+        }
+    }
+}
+
+TEST_CASE("wxParallelSort", "[threadpool][parallel]")
+{
+    wxThreadPool pool(4);
+
+    // Use pairs to check that the sort is stable by comparing only the first
+    // elements of them.
+    typedef std::pair<int, int> Pair;
+    std::vector<Pair> v(100000);
+    for ( size_t n = 0; n < v.size(); n++ )
+        v[n] = Pair((n * 7919) % 1000, static_cast<int>(n));
+
+    std::vector<Pair> expected(v);
+
+    const auto cmp = [](const Pair& p1, const Pair& p2)
+    {
+        return p1.first < p2.first;
+    };
+
+    std::stable_sort(expected.begin(), expected.end(), cmp);
+    wxParallelSort(v.begin(), v.end(), cmp, &pool);
+
+    CHECK( v == expected );
+}
@@ -610,6 +610,57 @@ void XmlTestCase::Doctype()
     CPPUNIT_ASSERT( !dt.IsValid() );
 }
 
+TEST_CASE("XML::ParseHandler", "[xml]")
+{
+    // Handler removing all "item" elements from the document after
+    // remembering their names and depths.
+    class ItemsHandler : public wxXmlParseHandler
+    {
+    public:
+        virtual bool OnElementEnd(wxXmlNode* node) override
+        {
+            m_elements << node->GetName() << node->GetDepth() << ' ';
+
+            if ( node->GetName() != "item" )
+                return false;
+
+            m_items << node->GetNodeContent() << ' ';
+            return true;
+        }
+
+        wxString m_elements,
+                 m_items;
+    };
+
+    const char *xmlText =
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<root>\n"
+        "  <item>1</item>\n"
+        "  <other><item>2</item></other>\n"
+        "  <item>3</item>\n"
+        "  <last/>\n"
+        "</root>\n"
+    ;
+
+    wxStringInputStream sis(xmlText);
+    ItemsHandler handler;
+    wxXmlDocument doc;
+    REQUIRE( doc.Load(sis, handler) );
+
+    CHECK( handler.m_elements == "item2 item3 other2 item2 last2 root1 " );
+    CHECK( handler.m_items == "1 2 3 " );
+
+    wxStringOutputStream sos;
+    REQUIRE( doc.Save(sos) );
+    CHECK( sos.GetString() ==
+        "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<root>\n"
+        "  <other/>\n"
+        "  <last/>\n"
+        "</root>\n"
+    );
+}
+
 // This test is disabled by default as it requires the environment variable
 // below to be defined to point to a XML file to load.
 TEST_CASE("XML::Load", "[xml][.]")